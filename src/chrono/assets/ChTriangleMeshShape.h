@@ -33,7 +33,8 @@ class ChApi ChTriangleMeshShape : public ChVisualization {
     //
     // DATA
     //
-    geometry::ChTriangleMeshConnected trimesh;
+    std::shared_ptr<geometry::ChTriangleMeshConnected> trimesh;
+    bool shared;  // trimesh is shared with other owners and is copied before any modification
 
     bool wireframe;
     bool backface_cull;
@@ -46,7 +47,7 @@ class ChApi ChTriangleMeshShape : public ChVisualization {
     // CONSTRUCTORS
     //
 
-    ChTriangleMeshShape() {
+    ChTriangleMeshShape() : trimesh(std::make_shared<geometry::ChTriangleMeshConnected>()), shared(false) {
         wireframe = false;
         backface_cull = false;
     };
@@ -57,8 +58,29 @@ class ChApi ChTriangleMeshShape : public ChVisualization {
     // FUNCTIONS
     //
 
-    geometry::ChTriangleMeshConnected& GetMesh() { return trimesh; }
-    void SetMesh(const geometry::ChTriangleMeshConnected& mesh) { trimesh = mesh; }
+    /// Access the mesh for modification. A shared mesh (see SetMesh) is
+    /// copied first, so that the other owners do not see the changes.
+    geometry::ChTriangleMeshConnected& GetMesh() {
+        if (shared) {
+            trimesh = std::make_shared<geometry::ChTriangleMeshConnected>(*trimesh);
+            shared = false;
+        }
+        return *trimesh;
+    }
+    const geometry::ChTriangleMeshConnected& GetMesh() const { return *trimesh; }
+
+    /// Set the mesh (copied).
+    void SetMesh(const geometry::ChTriangleMeshConnected& mesh) {
+        trimesh = std::make_shared<geometry::ChTriangleMeshConnected>(mesh);
+        shared = false;
+    }
+
+    /// Set the mesh, shared with other owners (e.g. other assets using the same
+    /// mesh file) rather than copied. The mesh is not modified through this asset.
+    void SetMesh(std::shared_ptr<const geometry::ChTriangleMeshConnected> mesh) {
+        trimesh = std::const_pointer_cast<geometry::ChTriangleMeshConnected>(mesh);
+        shared = true;
+    }
 
     bool IsWireframe() { return wireframe; }
     void SetWireframe(bool mw) { wireframe = mw; }
@@ -84,7 +106,7 @@ class ChApi ChTriangleMeshShape : public ChVisualization {
         // serialize parent class
         ChVisualization::ArchiveOUT(marchive);
         // serialize all member data:
-        marchive << CHNVP(trimesh);
+        marchive << CHNVP(*trimesh, "trimesh");
         marchive << CHNVP(wireframe);
         marchive << CHNVP(backface_cull);
         marchive << CHNVP(name);
@@ -99,7 +121,7 @@ class ChApi ChTriangleMeshShape : public ChVisualization {
         // deserialize parent class
         ChVisualization::ArchiveIN(marchive);
         // stream in all member data:
-        marchive >> CHNVP(trimesh);
+        marchive >> CHNVP(GetMesh(), "trimesh");
         marchive >> CHNVP(wireframe);
         marchive >> CHNVP(backface_cull);
         marchive >> CHNVP(name);
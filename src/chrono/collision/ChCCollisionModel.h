@@ -258,6 +258,11 @@ class ChApi ChCollisionModel {
     /// By default it uses GetCsysForCollisionModel 
     virtual void SyncPosition() =0;
 
+    /// Informs the collision model that the owner is sleeping (or waking up).
+    /// Collision engines may use this to skip the tests between pairs of
+    /// sleeping models. By default, does nothing.
+    virtual void SetSleeping(bool msleeping) {}
+
     /// By default, all collsion objects belong to family n.0,
     /// but you can set family in range 0..15. This is used when
     /// the objects collided with another: the contact is created
@@ -28,6 +28,8 @@
 // ------------------------------------------------
 ///////////////////////////////////////////////////
 
+#include <vector>
+
 #include "collision/ChCCollisionInfo.h"
 #include "core/ChFrame.h"
 #include "core/ChApiCE.h"
@@ -104,6 +106,13 @@ class ChApi ChCollisionSystem {
     /// engine (custom data may be allocated).
     virtual void Add(ChCollisionModel* model) = 0;
 
+    /// Tells the collision engine that the given collision models
+    /// are about to be added, one by one, with Add(). This is only
+    /// a hint: it does nothing by default, and children classes can
+    /// override it to allocate their internal data only once for
+    /// the whole batch.
+    virtual void ReserveModels(const std::vector<ChCollisionModel*>& models) {}
+
     /// Removes a collision model from the collision
     /// engine (custom data may be deallocated).
     virtual void Remove(ChCollisionModel* model) = 0;
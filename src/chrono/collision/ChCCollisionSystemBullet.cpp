@@ -31,6 +31,10 @@
 #include "BulletCollision/CollisionShapes/bt2DShape.h"
 #include "BulletCollision/CollisionShapes/btCEtriangleShape.h"
 #include "BulletCollision/CollisionDispatch/btEmptyCollisionAlgorithm.h"
+#include "parallel/ChOpenMP.h"
+
+#include <algorithm>
+#include <mutex>
 
 extern btScalar gContactBreakingThreshold;
 
@@ -1133,6 +1137,128 @@ public:
 
 
 
+////////////////////////////////////
+////////////////////////////////////
+
+// Collision dispatcher that can process the overlapping pairs of the broadphase
+// in parallel. Collision algorithms of new pairs are created in a serial pass;
+// then all pairs run their narrow phase concurrently. Algorithms and manifolds
+// can still be created or deleted inside processCollision() (manifolds created
+// at the first contact, triangles of concave meshes, children of compounds):
+// these go through the shared Bullet pools, protected by a lock.
+class ChCollisionDispatcherParallel : public btCollisionDispatcher {
+  public:
+    ChCollisionDispatcherParallel(btCollisionConfiguration* collisionConfiguration)
+        : btCollisionDispatcher(collisionConfiguration), num_threads(1) {}
+
+    void SetNumThreads(int mthreads) { num_threads = mthreads; }
+    int GetNumThreads() const { return num_threads; }
+
+    virtual btPersistentManifold* getNewManifold(void* b0, void* b1) {
+        std::lock_guard<std::recursive_mutex> lock(pool_mutex);
+        return btCollisionDispatcher::getNewManifold(b0, b1);
+    }
+
+    virtual void releaseManifold(btPersistentManifold* manifold) {
+        std::lock_guard<std::recursive_mutex> lock(pool_mutex);
+        btCollisionDispatcher::releaseManifold(manifold);
+    }
+
+    virtual btCollisionAlgorithm* findAlgorithm(btCollisionObject* body0,
+                                                btCollisionObject* body1,
+                                                btPersistentManifold* sharedManifold = 0) {
+        std::lock_guard<std::recursive_mutex> lock(pool_mutex);
+        return btCollisionDispatcher::findAlgorithm(body0, body1, sharedManifold);
+    }
+
+    virtual void* allocateCollisionAlgorithm(int size) {
+        std::lock_guard<std::recursive_mutex> lock(pool_mutex);
+        return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+    }
+
+    virtual void freeCollisionAlgorithm(void* ptr) {
+        std::lock_guard<std::recursive_mutex> lock(pool_mutex);
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+    }
+
+    virtual void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,
+                                           const btDispatcherInfo& dispatchInfo,
+                                           btDispatcher* dispatcher) {
+        // The time of impact of continuous collision detection is a shared result: use the serial version.
+        if (num_threads < 2 || dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE) {
+            btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+            return;
+        }
+
+        int num_pairs = pairCache->getNumOverlappingPairs();
+        btBroadphasePair* pairs = pairCache->getOverlappingPairArrayPtr();
+
+        // Create the collision algorithms of the new pairs.
+        for (int i = 0; i < num_pairs; i++) {
+            btCollisionObject* colObj0 = (btCollisionObject*)pairs[i].m_pProxy0->m_clientObject;
+            btCollisionObject* colObj1 = (btCollisionObject*)pairs[i].m_pProxy1->m_clientObject;
+            if (!pairs[i].m_algorithm && needsCollision(colObj0, colObj1))
+                pairs[i].m_algorithm = btCollisionDispatcher::findAlgorithm(colObj0, colObj1);
+        }
+
+        // Narrow phase: each pair only writes into its own algorithm and manifolds.
+        btNearCallback near_callback = getNearCallback();
+
+#pragma omp parallel for schedule(dynamic, 16) num_threads(num_threads)
+        for (int i = 0; i < num_pairs; i++) {
+            near_callback(pairs[i], *this, dispatchInfo);
+        }
+
+        SortManifolds(pairCache);
+    }
+
+  private:
+    // The threads append new manifolds in a timing-dependent order. Put the array of
+    // manifolds in the order of the broadphase pairs, so that the contacts are then
+    // reported in the same order at each run. Manifolds not reachable through the pairs
+    // are kept at the end, in their current order.
+    void SortManifolds(btOverlappingPairCache* pairCache) {
+        int num_manifolds = getNumManifolds();
+        if (num_manifolds == 0)
+            return;
+        btPersistentManifold** manifolds = getInternalManifoldPointer();
+
+        pair_manifolds.resize(0);
+        int num_pairs = pairCache->getNumOverlappingPairs();
+        btBroadphasePair* pairs = pairCache->getOverlappingPairArrayPtr();
+        for (int i = 0; i < num_pairs; i++) {
+            if (pairs[i].m_algorithm)
+                pairs[i].m_algorithm->getAllContactManifolds(pair_manifolds);
+        }
+
+        sorted_manifolds.resize(0);
+        listed.assign(num_manifolds, 0);
+        for (int i = 0; i < pair_manifolds.size(); i++) {
+            int index = pair_manifolds[i]->m_index1a;
+            if (index >= 0 && index < num_manifolds && manifolds[index] == pair_manifolds[i] && !listed[index]) {
+                listed[index] = 1;
+                sorted_manifolds.push_back(pair_manifolds[i]);
+            }
+        }
+        for (int i = 0; i < num_manifolds; i++) {
+            if (!listed[i])
+                sorted_manifolds.push_back(manifolds[i]);
+        }
+
+        // releaseManifold() finds a manifold through its m_index1a.
+        for (int i = 0; i < num_manifolds; i++) {
+            manifolds[i] = sorted_manifolds[i];
+            manifolds[i]->m_index1a = i;
+        }
+    }
+
+    int num_threads;
+    std::recursive_mutex pool_mutex;
+    btManifoldArray pair_manifolds;
+    std::vector<btPersistentManifold*> sorted_manifolds;
+    std::vector<char> listed;
+};
+
 ////////////////////////////////////
 ////////////////////////////////////
 
@@ -1141,7 +1267,8 @@ ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, doubl
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
-    bt_dispatcher = new btCollisionDispatcher(bt_collision_configuration);
+    bt_dispatcher = new ChCollisionDispatcherParallel(bt_collision_configuration);
+    num_threads = 1;
     //((btDefaultCollisionConfiguration*)bt_collision_configuration)->setConvexConvexMultipointIterations(4,4);
 
     //***OLD***
@@ -1156,6 +1283,9 @@ ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, doubl
 
     bt_collision_world = new btCollisionWorld(bt_dispatcher, bt_broadphase, bt_collision_configuration);
 
+    // AABBs of models that are flagged as inactive (i.e. sleeping bodies) need no update
+    bt_collision_world->setForceUpdateAllAabbs(false);
+
     // custom collision for sphere-sphere case ***OBSOLETE*** // already registered by btDefaultCollisionConfiguration
     // bt_dispatcher->registerCollisionCreateFunc(SPHERE_SHAPE_PROXYTYPE,SPHERE_SHAPE_PROXYTYPE,new
     // btSphereSphereCollisionAlgorithm::CreateFunc);
@@ -1224,6 +1354,14 @@ void ChCollisionSystemBullet::Add(ChCollisionModel* model) {
     }
 }
 
+void ChCollisionSystemBullet::ReserveModels(const std::vector<ChCollisionModel*>& models) {
+    // Grow geometrically, so that many small batches do not reallocate each time.
+    btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    int needed = objects.size() + (int)models.size();
+    if (needed > objects.capacity())
+        objects.reserve(std::max(needed, 2 * objects.capacity()));
+}
+
 void ChCollisionSystemBullet::Remove(ChCollisionModel* model) {
     if (((ChModelBullet*)model)->GetBulletModel()->getCollisionShape()) {
         bt_collision_world->removeCollisionObject(((ChModelBullet*)model)->GetBulletModel());
@@ -1236,7 +1374,48 @@ void ChCollisionSystemBullet::Run() {
     }
 }
 
+void ChCollisionSystemBullet::SetNumThreads(int mthreads) {
+    num_threads = std::max(mthreads, 1);
+    ((ChCollisionDispatcherParallel*)bt_dispatcher)->SetNumThreads(num_threads);
+}
+
+// Fill the collision info with the data of a manifold point, if the point is not
+// too far (the Bullet engine also has its threshold). Return false otherwise.
+static bool GetContactInfo(btManifoldPoint& pt,
+                           double envelopeA,
+                           double envelopeB,
+                           double marginA,
+                           double marginB,
+                           ChCollisionInfo& icontact) {
+    if (pt.getDistance() >= marginA + marginB)
+        return false;
+
+    btVector3 ptA = pt.getPositionWorldOnA();
+    btVector3 ptB = pt.getPositionWorldOnB();
+
+    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
+    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
+
+    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(), -pt.m_normalWorldOnB.getZ());
+    icontact.vN.Normalize();
+
+    double ptdist = pt.getDistance();
+
+    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
+    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
+    icontact.distance = ptdist + envelopeA + envelopeB;
+
+    icontact.reaction_cache = pt.reactions_cache;
+
+    return true;
+}
+
 void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcontainer) {
+    if (num_threads > 1) {
+        ReportContactsParallel(mcontactcontainer);
+        return;
+    }
+
     // This should remove all old contacts (or at least rewind the index)
     mcontactcontainer->BeginAddContact();
 
@@ -1269,27 +1448,7 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcon
             for (int j = 0; j < numContacts; j++) {
                 btManifoldPoint& pt = contactManifold->getContactPoint(j);
 
-                if (pt.getDistance() <
-                    marginA + marginB)  // to discard "too far" constraints (the Bullet engine also has its threshold)
-                {
-                    btVector3 ptA = pt.getPositionWorldOnA();
-                    btVector3 ptB = pt.getPositionWorldOnB();
-
-                    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
-                    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
-
-                    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(),
-                                    -pt.m_normalWorldOnB.getZ());
-                    icontact.vN.Normalize();
-
-                    double ptdist = pt.getDistance();
-
-                    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
-                    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
-                    icontact.distance = ptdist + envelopeA + envelopeB;
-
-                    icontact.reaction_cache = pt.reactions_cache;
-
+                if (GetContactInfo(pt, envelopeA, envelopeB, marginA, marginB, icontact)) {
                     // Execute some user custom callback, if any
                     if (this->narrow_callback)
                         this->narrow_callback->NarrowCallback(icontact);
@@ -1306,6 +1465,77 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainerBase* mcontactcon
     mcontactcontainer->EndAddContact();
 }
 
+void ChCollisionSystemBullet::ReportContactsParallel(ChContactContainerBase* mcontactcontainer) {
+    // Same order as ReportContacts(): the order of the manifolds of the dispatcher, which
+    // the parallel narrow phase sorts in the order of the broadphase pairs.
+    btDispatcher* dispatcher = bt_collision_world->getDispatcher();
+    int numManifolds = dispatcher->getNumManifolds();
+
+    // Custom broadphase callback, if any (user callbacks are always called from this thread)
+    report_narrow.assign(numManifolds, 1);
+    if (this->broad_callback) {
+        for (int i = 0; i < numManifolds; i++) {
+            btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+            ChCollisionModel* modelA = (ChCollisionModel*)((btCollisionObject*)contactManifold->getBody0())->getUserPointer();
+            ChCollisionModel* modelB = (ChCollisionModel*)((btCollisionObject*)contactManifold->getBody1())->getUserPointer();
+            report_narrow[i] = this->broad_callback->BroadCallback(modelA, modelB);
+        }
+    }
+
+    // Convert the manifold points into per-thread buffers. With a static schedule each
+    // thread processes a contiguous range of manifolds, in thread order, so the buffers
+    // can be merged back in the order of the manifolds.
+    report_buffers.resize(num_threads);
+    for (int t = 0; t < num_threads; t++)
+        report_buffers[t].clear();
+
+#pragma omp parallel num_threads(num_threads)
+    {
+        std::vector<ChCollisionInfo>& buffer = report_buffers[CHOMPfunctions::GetThreadNum()];
+        ChCollisionInfo icontact;
+
+#pragma omp for schedule(static)
+        for (int i = 0; i < numManifolds; i++) {
+            btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+            btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+            btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+            contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
+
+            if (!report_narrow[i])
+                continue;
+
+            icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
+            icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
+
+            double envelopeA = icontact.modelA->GetEnvelope();
+            double envelopeB = icontact.modelB->GetEnvelope();
+
+            double marginA = icontact.modelA->GetSafeMargin();
+            double marginB = icontact.modelB->GetSafeMargin();
+
+            int numContacts = contactManifold->getNumContacts();
+            for (int j = 0; j < numContacts; j++) {
+                if (GetContactInfo(contactManifold->getContactPoint(j), envelopeA, envelopeB, marginA, marginB, icontact))
+                    buffer.push_back(icontact);
+            }
+        }
+    }
+
+    // Add all contacts to the container, in the order of the manifolds
+    mcontactcontainer->BeginAddContact();
+    for (int t = 0; t < num_threads; t++) {
+        std::vector<ChCollisionInfo>& buffer = report_buffers[t];
+        for (size_t k = 0; k < buffer.size(); k++) {
+            // Execute some user custom callback, if any
+            if (this->narrow_callback)
+                this->narrow_callback->NarrowCallback(buffer[k]);
+
+            mcontactcontainer->AddContact(buffer[k]);
+        }
+    }
+    mcontactcontainer->EndAddContact();
+}
+
 void ChCollisionSystemBullet::ReportProximities(ChProximityContainerBase* mproximitycontainer) {
     mproximitycontainer->BeginAddProximities();
     /*
@@ -27,6 +27,8 @@
 // ------------------------------------------------
 ///////////////////////////////////////////////////
 
+#include <vector>
+
 #include "core/ChApiCE.h"
 #include "collision/ChCCollisionSystem.h"
 #include "collision/bullet/btBulletCollisionCommon.h"
@@ -57,6 +59,10 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// engine (custom data may be allocated).
     virtual void Add(ChCollisionModel* model);
 
+    /// Grows the array of collision objects of the Bullet world
+    /// once, before the given models are added.
+    virtual void ReserveModels(const std::vector<ChCollisionModel*>& models);
+
     /// Removes a collision model from the collision
     /// engine (custom data may be deallocated).
     virtual void Remove(ChCollisionModel* model);
@@ -93,16 +99,36 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
+    /// Set the number of threads for the narrow phase and for ReportContacts() (default 1).
+    /// With more than one thread, the overlapping pairs found by the broadphase are
+    /// processed in parallel, and contact points are converted in parallel too. Contacts
+    /// are then reported in the order of the broadphase pairs, so that results do not
+    /// depend on the number of threads or on their scheduling. User callbacks are
+    /// always called from the calling thread.
+    void SetNumThreads(int mthreads);
+
+    /// Get the number of threads for the narrow phase.
+    int GetNumThreads() const { return num_threads; }
+
     // Tweak the default contact breaking/merging threshold tolerance
     // of Bullet (is it the static gContactBreakingThreshold scalar in Bullet).
     // Call it only once, before running the simulation.
     static void SetContactBreakingThreshold(double threshold);
 
   private:
+    /// Parallel version of ReportContacts().
+    void ReportContactsParallel(ChContactContainerBase* mcontactcontainer);
+
     btCollisionConfiguration* bt_collision_configuration;
     btCollisionDispatcher* bt_dispatcher;
     btBroadphaseInterface* bt_broadphase;
     btCollisionWorld* bt_collision_world;
+
+    int num_threads;
+
+    // work data for ReportContactsParallel()
+    std::vector<char> report_narrow;
+    std::vector<std::vector<ChCollisionInfo> > report_buffers;
 };
 
 }  // END_OF_NAMESPACE____
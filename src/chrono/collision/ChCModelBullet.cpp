@@ -810,6 +810,10 @@ void ChModelBullet::SyncPosition()
 }
 
 
+void ChModelBullet::SetSleeping(bool msleeping) {
+    bt_collision_object->forceActivationState(msleeping ? ISLAND_SLEEPING : ACTIVE_TAG);
+}
+
 bool ChModelBullet::SetSphereRadius(double coll_radius, double out_envelope) {
     if (this->shapes.size() != 1)
         return false;
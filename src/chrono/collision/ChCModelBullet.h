@@ -280,6 +280,11 @@ class ChApi ChModelBullet : public ChCollisionModel {
     /// model as the current position of the corresponding ChContactable
     virtual void SyncPosition();
 
+    /// Sleeping models are flagged as inactive in the Bullet world, so
+    /// that pairs of sleeping (or fixed) models are not processed by the
+    /// narrow phase, and their AABBs are not updated.
+    virtual void SetSleeping(bool msleeping);
+
     /// If the collision shape is a sphere, resize it and return true (if no
     /// sphere is found in this collision shape, return false).
     /// It can also change the outward envelope; the inward margin is automatically the radius of the sphere.
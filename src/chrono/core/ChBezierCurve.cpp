@@ -38,6 +38,7 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <limits>
 
 #include "chrono/core/ChBezierCurve.h"
 #include "chrono/core/ChMathematics.h"
@@ -52,6 +53,9 @@ const double ChBezierCurve::m_sqrDistTol = 1e-4;
 const double ChBezierCurve::m_cosAngleTol = 1e-4;
 const double ChBezierCurve::m_paramTol = 1e-4;
 
+const size_t ChBezierCurve::m_bvhLeafSize = 4;
+const int ChBezierCurve::m_numSamples = 8;
+
 // -----------------------------------------------------------------------------
 // ChBezierCurve::ChBezierCurve()
 //
@@ -67,6 +71,8 @@ ChBezierCurve::ChBezierCurve(const std::vector<ChVector<> >& points,
     assert(points.size() > 1);
     assert(points.size() == inCV.size());
     assert(points.size() == outCV.size());
+
+    buildBVH();
 }
 
 ChBezierCurve::ChBezierCurve(const std::vector<ChVector<> >& points) : m_points(points) {
@@ -84,6 +90,7 @@ ChBezierCurve::ChBezierCurve(const std::vector<ChVector<> >& points) : m_points(
     if (numPoints == 2) {
         m_outCV[0] = (2.0 * points[0] + points[1]) / 3.0;
         m_inCV[1] = (points[0] + 2.0 * points[1]) / 3.0;
+        buildBVH();
         return;
     }
 
@@ -129,6 +136,8 @@ ChBezierCurve::ChBezierCurve(const std::vector<ChVector<> >& points) : m_points(
     delete[] x;
     delete[] y;
     delete[] z;
+
+    buildBVH();
 }
 
 // Utility function for solving the tridiagonal system for one of the
@@ -373,53 +382,208 @@ ChVector<> ChBezierCurve::calcClosestPoint(const ChVector<>& loc, size_t i, doub
 }
 
 // -----------------------------------------------------------------------------
-// ChBezierCurveTracker::reset()
+// ChBezierCurve::buildBVH()
 //
-// This function reinitializes the pathTracker at the specified location. It
-// calculates an appropriate initial guess for the curve segment and sets the
-// curve parameter to 0.5.
+// This function builds a bounding volume hierarchy of the curve intervals. The
+// box of each interval is the box of its four control points. Intervals are
+// split recursively at the median of their box centers along the longest side
+// of the box, down to leaves of at most m_bvhLeafSize intervals.
 // -----------------------------------------------------------------------------
-class PointSpec {
+void ChBezierCurve::buildBVH() {
+    m_bvhNodes.clear();
+    m_bvhIntervals.clear();
+
+    if (m_points.size() < 2)
+        return;
+
+    size_t numIntervals = m_points.size() - 1;
+    std::vector<ChVector<> > centers(numIntervals);
+    m_bvhIntervals.resize(numIntervals);
+
+    for (size_t i = 0; i < numIntervals; i++) {
+        m_bvhIntervals[i] = i;
+        centers[i] = (m_points[i] + m_outCV[i] + m_inCV[i + 1] + m_points[i + 1]) / 4;
+    }
+
+    m_bvhNodes.reserve(2 * numIntervals / m_bvhLeafSize + 1);
+    buildBVHNode(0, numIntervals, centers);
+}
+
+// Comparison of intervals by the coordinate of the center of their box along one axis.
+class IntervalCenterLess {
   public:
-    PointSpec() {}
-    PointSpec(size_t index, double dist2) : m_index(index), m_dist2(dist2) {}
+    IntervalCenterLess(const std::vector<ChVector<> >& centers, int axis) : m_centers(centers), m_axis(axis) {}
+    bool operator()(size_t i1, size_t i2) const {
+        return m_centers[i1](m_axis) < m_centers[i2](m_axis);
+    }
 
-    size_t m_index;
-    double m_dist2;
+  private:
+    const std::vector<ChVector<> >& m_centers;
+    int m_axis;
 };
 
-static bool comparePoints(const PointSpec& p1, const PointSpec& p2) {
-    return p1.m_dist2 < p2.m_dist2;
+int ChBezierCurve::buildBVHNode(size_t first, size_t count, const std::vector<ChVector<> >& centers) {
+    int index = (int)m_bvhNodes.size();
+    m_bvhNodes.push_back(BVHNode());
+
+    // Box of all the control points of the intervals in this node.
+    ChVector<> bmin = m_points[m_bvhIntervals[first]];
+    ChVector<> bmax = bmin;
+    for (size_t k = first; k < first + count; k++) {
+        size_t i = m_bvhIntervals[k];
+        const ChVector<>* cp[4] = {&m_points[i], &m_outCV[i], &m_inCV[i + 1], &m_points[i + 1]};
+        for (int j = 0; j < 4; j++) {
+            bmin.x = std::min(bmin.x, cp[j]->x);
+            bmin.y = std::min(bmin.y, cp[j]->y);
+            bmin.z = std::min(bmin.z, cp[j]->z);
+            bmax.x = std::max(bmax.x, cp[j]->x);
+            bmax.y = std::max(bmax.y, cp[j]->y);
+            bmax.z = std::max(bmax.z, cp[j]->z);
+        }
+    }
+
+    int left = -1;
+    int right = -1;
+
+    if (count > m_bvhLeafSize) {
+        // Split at the median along the longest side of the box.
+        ChVector<> size = bmax - bmin;
+        int axis = (size.x >= size.y && size.x >= size.z) ? 0 : (size.y >= size.z ? 1 : 2);
+        size_t half = count / 2;
+        std::nth_element(m_bvhIntervals.begin() + first, m_bvhIntervals.begin() + first + half,
+                         m_bvhIntervals.begin() + first + count, IntervalCenterLess(centers, axis));
+
+        left = buildBVHNode(first, half, centers);
+        right = buildBVHNode(first + half, count - half, centers);
+    }
+
+    // Note: do not keep references into m_bvhNodes across the recursive calls above.
+    BVHNode& node = m_bvhNodes[index];
+    node.m_min = bmin;
+    node.m_max = bmax;
+    node.m_left = left;
+    node.m_right = right;
+    node.m_first = first;
+    node.m_count = count;
+
+    return index;
 }
 
-void ChBezierCurveTracker::reset(const ChVector<>& loc) {
-    // Walk all curve points and calculate the distance to the specified reset
-    // location, then sort them in increasing order.
-    std::vector<PointSpec> points;
+// -----------------------------------------------------------------------------
+// ChBezierCurve::findClosestPoint()
+// ChBezierCurve::findClosestPoints()
+//
+// These functions calculate the closest point on the whole curve to the given
+// location(s). The bounding volume hierarchy is traversed depth first, visiting
+// first the child whose box is closer to the location, and skipping the nodes
+// whose box is farther than the closest point found so far.
+// -----------------------------------------------------------------------------
 
-    for (size_t i = 0; i < m_path->getNumPoints(); i++)
-        points.push_back(PointSpec(i, (loc - m_path->m_points[i]).Length2()));
+// Squared distance between a point and an axis-aligned box.
+static double BoxDist2(const ChVector<>& loc, const ChVector<>& bmin, const ChVector<>& bmax) {
+    double d2 = 0;
+    for (int k = 0; k < 3; k++) {
+        double d = std::max(std::max(bmin(k) - loc(k), loc(k) - bmax(k)), 0.0);
+        d2 += d * d;
+    }
+    return d2;
+}
 
-    std::sort(points.begin(), points.end(), comparePoints);
+ChVector<> ChBezierCurve::calcClosestPointInterval(const ChVector<>& loc, size_t i, double& t) const {
+    // Initial guess: the closest of some equally spaced points on the interval.
+    double best_d2 = (eval(i, 0) - loc).Length2();
+    t = 0;
+    for (int k = 1; k <= m_numSamples; k++) {
+        double tk = (double)k / m_numSamples;
+        double d2 = (eval(i, tk) - loc).Length2();
+        if (d2 < best_d2) {
+            best_d2 = d2;
+            t = tk;
+        }
+    }
 
-    // Set the initial guess to be at t=0.5 in either the interval starting at
-    // the point with minimum distance or in the previous interval.
-    m_curParam = 0.5f;
-    m_curInterval = points[0].m_index;
+    // Refine with Newton iterations, keeping the initial guess if these do not improve on it.
+    double t0 = t;
+    ChVector<> Q = calcClosestPoint(loc, i, t);
+    if ((Q - loc).Length2() > best_d2) {
+        t = t0;
+        Q = eval(i, t);
+    }
 
-    if (m_curInterval == 0)
-        return;
+    return Q;
+}
 
-    if (m_curInterval == m_path->getNumPoints() - 1) {
-        m_curInterval--;
-        return;
+ChVector<> ChBezierCurve::findClosestPoint(const ChVector<>& loc, size_t& i, double& t) const {
+    assert(!m_bvhNodes.empty());
+
+    double best_d2 = std::numeric_limits<double>::max();
+    ChVector<> best_point;
+
+    std::vector<int> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+
+    while (!stack.empty()) {
+        const BVHNode& node = m_bvhNodes[stack.back()];
+        stack.pop_back();
+
+        if (BoxDist2(loc, node.m_min, node.m_max) >= best_d2)
+            continue;
+
+        if (node.m_left < 0) {
+            for (size_t k = node.m_first; k < node.m_first + node.m_count; k++) {
+                size_t ik = m_bvhIntervals[k];
+                double tk;
+                ChVector<> Q = calcClosestPointInterval(loc, ik, tk);
+                double d2 = (Q - loc).Length2();
+                if (d2 < best_d2) {
+                    best_d2 = d2;
+                    best_point = Q;
+                    i = ik;
+                    t = tk;
+                }
+            }
+            continue;
+        }
+
+        // Push the farther child first, so that the closer one is visited first.
+        const BVHNode& left = m_bvhNodes[node.m_left];
+        const BVHNode& right = m_bvhNodes[node.m_right];
+        if (BoxDist2(loc, left.m_min, left.m_max) < BoxDist2(loc, right.m_min, right.m_max)) {
+            stack.push_back(node.m_right);
+            stack.push_back(node.m_left);
+        } else {
+            stack.push_back(node.m_left);
+            stack.push_back(node.m_right);
+        }
     }
 
-    ChVector<> loc2cur = m_path->m_points[m_curInterval] - loc;
-    ChVector<> loc2prev = m_path->m_points[m_curInterval - 1] - loc;
+    return best_point;
+}
+
+void ChBezierCurve::findClosestPoints(const std::vector<ChVector<> >& locs,
+                                      std::vector<ChVector<> >& points,
+                                      std::vector<size_t>& intervals,
+                                      std::vector<double>& params) const {
+    int numLocs = (int)locs.size();
+    points.resize(numLocs);
+    intervals.resize(numLocs);
+    params.resize(numLocs);
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (int k = 0; k < numLocs; k++)
+        points[k] = findClosestPoint(locs[k], intervals[k], params[k]);
+}
 
-    if (loc2cur * loc2prev < 0)
-        m_curInterval--;
+// -----------------------------------------------------------------------------
+// ChBezierCurveTracker::reset()
+//
+// This function reinitializes the pathTracker at the specified location. It
+// sets the current interval and curve parameter to those of the closest point
+// on the whole curve.
+// -----------------------------------------------------------------------------
+void ChBezierCurveTracker::reset(const ChVector<>& loc) {
+    m_path->findClosestPoint(loc, m_curInterval, m_curParam);
 }
 
 // -----------------------------------------------------------------------------
@@ -440,13 +604,24 @@ void ChBezierCurveTracker::reset(const ChVector<>& loc) {
 //  - if the curve parameter is close to 0, check the previous interval, unless
 //    at the previous iteration the parameter was close to 1;
 //  - if the curve parameter is close to 1, check the next interval, unless at
-//    the previous iteration the parameter was close to 0.
+//    the previous iteration the parameter was close to 0;
+//  - if more than m_maxWalk intervals were checked (no limit by default), the
+//    tracking was lost: reset the tracker with a search of the whole curve.
 // -----------------------------------------------------------------------------
 int ChBezierCurveTracker::calcClosestPoint(const ChVector<>& loc, ChVector<>& point) {
     bool lastAtMin = false;
     bool lastAtMax = false;
 
-    while (true) {
+    for (size_t walk = 0; true; walk++) {
+        if (walk > m_maxWalk) {
+            point = m_path->findClosestPoint(loc, m_curInterval, m_curParam);
+            if (m_curInterval == 0 && m_curParam < ChBezierCurve::m_paramTol)
+                return -1;
+            if (m_curInterval == m_path->getNumPoints() - 2 && m_curParam > 1 - ChBezierCurve::m_paramTol)
+                return +1;
+            return 0;
+        }
+
         point = m_path->calcClosestPoint(loc, m_curInterval, m_curParam);
 
         if (m_curParam < ChBezierCurve::m_paramTol) {
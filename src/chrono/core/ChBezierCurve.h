@@ -39,6 +39,7 @@
 
 #include <vector>
 #include <string>
+#include <limits>
 
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChVector.h"
@@ -113,6 +114,22 @@ class ChApi ChBezierCurve {
     /// to the closest point.
     ChVector<> calcClosestPoint(const ChVector<>& loc, size_t i, double& t) const;
 
+    /// Calculate the closest point on the whole curve to the given location.
+    /// This function searches all intervals of the curve, using a bounding volume
+    /// hierarchy of the intervals (built with the curve) so that only the intervals
+    /// near the given location are checked. On return, 'i' and 't' contain the
+    /// interval and the curve parameter corresponding to the closest point.
+    /// This function can be called concurrently from multiple threads.
+    ChVector<> findClosestPoint(const ChVector<>& loc, size_t& i, double& t) const;
+
+    /// Calculate the closest points on the whole curve to the given locations.
+    /// This is the same as calling findClosestPoint() for each location, but the
+    /// locations are processed in parallel.
+    void findClosestPoints(const std::vector<ChVector<> >& locs,
+                           std::vector<ChVector<> >& points,
+                           std::vector<size_t>& intervals,
+                           std::vector<double>& params) const;
+
     /// Write the knots and control points to the specified file.
     void write(const std::string& filename);
 
@@ -163,6 +180,8 @@ class ChApi ChBezierCurve {
         marchive >> CHNVP(m_sqrDistTol);
         marchive >> CHNVP(m_cosAngleTol);
         marchive >> CHNVP(m_paramTol);
+
+        buildBVH();
     }
 
   private:
@@ -172,15 +191,43 @@ class ChApi ChBezierCurve {
     /// resulting Bezier curve is a spline interpolant of the knots.
     static void solveTriDiag(size_t n, double* rhs, double* x);
 
+    /// Node of the bounding volume hierarchy of the curve intervals.
+    /// The box of an interval is the box of its four control points, which
+    /// contains the interval (convex hull property of Bezier curves).
+    struct BVHNode {
+        ChVector<> m_min;  ///< lower corner of the bounding box
+        ChVector<> m_max;  ///< upper corner of the bounding box
+        int m_left;        ///< index of the first child node (-1 for leaves)
+        int m_right;       ///< index of the second child node (-1 for leaves)
+        size_t m_first;    ///< first interval of a leaf, in m_bvhIntervals
+        size_t m_count;    ///< number of intervals of a leaf
+    };
+
+    /// Build the bounding volume hierarchy of the curve intervals.
+    void buildBVH();
+
+    /// Build the node of the hierarchy for the intervals m_bvhIntervals[first, first+count).
+    int buildBVHNode(size_t first, size_t count, const std::vector<ChVector<> >& centers);
+
+    /// Calculate the closest point in the specified interval without an initial guess:
+    /// the Newton iteration starts from the closest of some points sampled on the interval.
+    ChVector<> calcClosestPointInterval(const ChVector<>& loc, size_t i, double& t) const;
+
     std::vector<ChVector<> > m_points;  ///< set of knot points
     std::vector<ChVector<> > m_inCV;    ///< set on "incident" control points
     std::vector<ChVector<> > m_outCV;   ///< set of "outgoing" control points
 
+    std::vector<BVHNode> m_bvhNodes;     ///< hierarchy of the intervals (root is the first node)
+    std::vector<size_t> m_bvhIntervals;  ///< intervals, in the order of the leaves of the hierarchy
+
     static const size_t m_maxNumIters;  ///< maximum number of Newton iterations
     static const double m_sqrDistTol;   ///< tolerance on squared distance
     static const double m_cosAngleTol;  ///< tolerance for orthogonality test
     static const double m_paramTol;     ///< tolerance for change in parameter value
 
+    static const size_t m_bvhLeafSize;   ///< maximum number of intervals in a leaf of the hierarchy
+    static const int m_numSamples;       ///< number of initial guesses sampled on an interval
+
     friend class ChBezierCurveTracker;
 };
 
@@ -194,15 +241,16 @@ class ChApi ChBezierCurve {
 class ChApi ChBezierCurveTracker {
   public:
     /// Create a tracker associated with the specified Bezier curve.
-    ChBezierCurveTracker(ChBezierCurve* path) : m_path(path), m_curInterval(0), m_curParam(0) {}
+    ChBezierCurveTracker(ChBezierCurve* path)
+        : m_path(path), m_curInterval(0), m_curParam(0), m_maxWalk(std::numeric_limits<size_t>::max()) {}
 
     /// Destructor for ChBezierCurveTracker.
     ~ChBezierCurveTracker() {}
 
     /// Reset the tracker at the specified location.
     /// This function reinitializes the pathTracker at the specified location. It
-    /// calculates an appropriate initial guess for the curve segment and sets the
-    /// curve parameter to 0.5.
+    /// sets the curve segment and the curve parameter to those of the closest point
+    /// on the whole curve (see ChBezierCurve::findClosestPoint).
     void reset(const ChVector<>& loc);
 
     /// Calculate the closest point on the underlying curve to the specified location.
@@ -213,12 +261,22 @@ class ChApi ChBezierCurveTracker {
     /// for the Newton iteration, we use time coherence (by keeping track of the path
     /// interval and curve parameter within that interval from the last query). As
     /// such, this function should be called with a continuous sequence of locations.
+    /// See setMaxWalk() for locations that jump along the path.
     int calcClosestPoint(const ChVector<>& loc, ChVector<>& point);
 
+    /// Set the maximum number of curve intervals walked by calcClosestPoint().
+    /// Beyond that, the tracking is considered lost and the tracker is reset with
+    /// a search of the whole curve (see reset()). By default, the walk is not
+    /// limited, which is best for a continuous sequence of locations; a small
+    /// limit is faster when the location can jump far along a long path.
+    void setMaxWalk(size_t max_walk) { m_maxWalk = max_walk; }
+
   private:
     ChBezierCurve* m_path;  ///< associated Bezier curve
     size_t m_curInterval;   ///< current search interval
     double m_curParam;      ///< parameter for current closest point
+
+    size_t m_maxWalk;       ///< maximum number of intervals walked before a reset
 };
 
 }  // end of namespace chrono
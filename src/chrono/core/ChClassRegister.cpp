@@ -18,6 +18,8 @@
 // ------------------------------------------------
 ///////////////////////////////////////////////////
 
+#include <mutex>
+
 #include "core/ChClassRegister.h"
 
 namespace chrono {
@@ -33,19 +35,32 @@ ChClassRegisterCommon** ChClassRegisterCommon::GetStaticHeadAddr() {
 
 
 
+/// The unique class factory, and the mutex for its creation and deletion
+/// (the factory may be first used by concurrent threads, for example when
+/// loading archives in the systems of a ChSystemEnsemble).
+
+static ChClassFactory* global_factory = 0;
+
+static std::mutex& GetGlobalFactoryMutex() {
+    static std::mutex* mmutex = new std::mutex;  // never deleted: used also by static destructors
+    return *mmutex;
+}
+
 /// Access the unique class factory here. It is unique even 
 /// between dll boundaries. It is allocated the 1st time it is called, if null.
 
 ChClassFactory* ChClassFactory::GetGlobalClassFactory() {
-    static ChClassFactory* mfactory = 0;
-    if (!mfactory)
-        mfactory = new ChClassFactory;
-    return mfactory;
+    std::lock_guard<std::mutex> lock(GetGlobalFactoryMutex());
+    if (!global_factory)
+        global_factory = new ChClassFactory;
+    return global_factory;
 }
 
 /// Delete the global class factory
 void ChClassFactory::DisposeGlobalClassFactory() {
-    delete ChClassFactory::GetGlobalClassFactory();
+    std::lock_guard<std::mutex> lock(GetGlobalFactoryMutex());
+    delete global_factory;
+    global_factory = 0;
 }
 
 }  // END_OF_NAMESPACE____
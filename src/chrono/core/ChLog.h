@@ -27,6 +27,7 @@
 ///////////////////////////////////////////////////
 
 #include <assert.h>
+#include <atomic>
 #include "ChStream.h"
 #include "ChApiCE.h"
 #include "serialization/ChArchiveAsciiDump.h"
@@ -51,8 +52,9 @@ class ChApi ChLog : public ChStreamOutAscii {
     enum eChLogLevel { CHERROR = 0, CHWARNING, CHMESSAGE, CHSTATUS, CHQUIET };
 
   protected:
-    eChLogLevel current_level;
-    eChLogLevel default_level;
+    // atomic, since the default logger is shared by all threads
+    std::atomic<eChLogLevel> current_level;
+    std::atomic<eChLogLevel> default_level;
 
     /// Creates the ChLog, and sets the level at MESSAGE
     ChLog();
@@ -74,7 +76,7 @@ class ChApi ChLog : public ChStreamOutAscii {
     eChLogLevel GetCurrentLevel() { return current_level; };
 
     /// Restore the default level.
-    void RestoreDefaultLevel() { current_level = default_level; };
+    void RestoreDefaultLevel() { current_level = default_level.load(); };
 
     /// Using the - operator is easy to set the status of the
     /// log, so in you code you can write, for example:
@@ -112,7 +114,9 @@ class ChApi ChLogConsole : public ChLog, public ChStreamOstreamWrapper {
 ////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////
 
-/// Global function to get the current ChLog object
+/// Global function to get the current ChLog object.
+/// If no ChLog was set with SetLog(), this is a ChLogConsole shared by all threads;
+/// its level can be changed from any thread, and affects the messages of all threads.
 ChApi ChLog& GetLog();
 
 /// Global function to set another ChLog object as current 'global' logging system.
@@ -123,6 +127,7 @@ ChApi ChLog& GetLog();
 ///
 ///   chrono::GetLog() << "message";
 ///
+/// (ATTENTION: not thread safe; the ChLog object is shared by all threads)
 
 ChApi void SetLog(ChLog& new_logobject);
 
@@ -403,9 +403,11 @@ class ChMatrix {
 
             int tot_elements = GetRows() * GetColumns();
             marchive.out_array_pre("data", tot_elements, typeid(Real).name());
-            for (int i = 0; i < tot_elements; i++) {
-                marchive << CHNVP(ElementN(i), "");
-                marchive.out_array_between(tot_elements, typeid(Real).name());
+            if (!marchive.out_array_data(GetAddress(), tot_elements)) {
+                for (int i = 0; i < tot_elements; i++) {
+                    marchive << CHNVP(ElementN(i), "");
+                    marchive.out_array_between(tot_elements, typeid(Real).name());
+                }
             }
             marchive.out_array_end(tot_elements, typeid(Real).name());
         }
@@ -426,9 +428,11 @@ class ChMatrix {
         // custom input of matrix data as array
         size_t tot_elements = GetRows() * GetColumns();
         marchive.in_array_pre("data", tot_elements);
-        for (int i = 0; i < tot_elements; i++) {
-            marchive >> CHNVP(ElementN(i));
-            marchive.in_array_between("data");
+        if (!marchive.in_array_data(GetAddress(), tot_elements)) {
+            for (int i = 0; i < tot_elements; i++) {
+                marchive >> CHNVP(ElementN(i));
+                marchive.in_array_between("data");
+            }
         }
         marchive.in_array_end("data");
     }
@@ -27,6 +27,8 @@
 // ------------------------------------------------
 ///////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include "core/ChCoordsys.h"
 #include "core/ChStream.h"
 #include "core/ChException.h"
@@ -181,6 +183,14 @@ class ChMatrixDynamic : public ChMatrix<Real> {
                 this->address[i] = 0;
         }
     }
+
+    /// Swap the size and the elements of this matrix with those of another
+    /// dynamic matrix, without copying the elements.
+    void SwapData(ChMatrixDynamic<Real>& other) {
+        std::swap(this->rows, other.rows);
+        std::swap(this->columns, other.columns);
+        std::swap(this->address, other.address);
+    }
 };
 
 }  // END_OF_NAMESPACE____
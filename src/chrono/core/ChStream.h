@@ -359,6 +359,24 @@ class ChApi ChStreamOutBinary : public ChStreamOut, public ChBinaryArchive {
         this->Output((char*)&ogg, sizeof(T));
     }
 
+    /// Stores a contiguous array of n numbers (double, float, int, etc.)
+    /// with a single call to Output(). The data is the same that would be
+    /// written with the << operator for each number, so it can be read back
+    /// either with ChStreamInBinary::BlockInput() or number by number.
+    /// On big-endian machines numbers are swapped and written one by one.
+    template <class T>
+    void BlockOutput(const T* data, size_t n) {
+        if (big_endian_machine) {
+            for (size_t i = 0; i < n; ++i) {
+                T tmp = data[i];
+                StreamSwapBytes<T>(&tmp);
+                this->Output((char*)&tmp, sizeof(T));
+            }
+        } else {
+            this->Output((const char*)data, n * sizeof(T));
+        }
+    }
+
     /// Stores an object, given the pointer, into the archive.
     /// This function can be used to serialize objects from
     /// nontrivial class trees, where at load time one may wonder
@@ -477,6 +495,18 @@ class ChApi ChStreamInBinary : public ChStreamIn, public ChBinaryArchive {
         this->Input((char*)&ogg, sizeof(T));
     }
 
+    /// Loads a contiguous array of n numbers (double, float, int, etc.)
+    /// with a single call to Input(), as written by ChStreamOutBinary::BlockOutput()
+    /// or by the << operator for each number.
+    template <class T>
+    void BlockInput(T* data, size_t n) {
+        this->Input((char*)data, n * sizeof(T));
+        if (big_endian_machine) {
+            for (size_t i = 0; i < n; ++i)
+                StreamSwapBytes<T>(&data[i]);
+        }
+    }
+
     /// Extract an object from the archive, and assignes the pointer to it.
     /// This function can be used to load objects whose class is not
     /// known in advance (anyway, assuming the class had been registered
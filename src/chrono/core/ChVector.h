@@ -392,6 +392,7 @@ class ChVector {
     //
 
     /// Method to allow serialization of transient data in archives.
+    /// Note: if this is changed, update also ChArchiveBulk< ChVector<Real> > below.
     void ArchiveOUT(ChArchiveOut& marchive)
     {
         // suggested: use versioning
@@ -425,6 +426,16 @@ typedef ChVector<double> Vector;
 ///
 typedef ChVector<float> VectorF;
 
+/// Arrays of vectors (ex. std::vector< ChVector<> >) can be serialized as
+/// contiguous blocks of numbers: x,y,z after the version of ArchiveOUT().
+template <class Real>
+struct ChArchiveBulk< ChVector<Real> > {
+    static const bool value = ChArchiveBulk<Real>::value;
+    typedef Real scalar;
+    static const int components = 3;
+    static const int version = 1;
+};
+
 // Reversed operators
 
 /// Operator for scaling the vector by a scalar value, as s*V
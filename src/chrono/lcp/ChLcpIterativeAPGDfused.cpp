@@ -0,0 +1,308 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+///////////////////////////////////////////////////
+//
+//   ChLcpIterativeAPGDfused.cpp
+//
+//
+//    file for CHRONO HYPEROCTANT LCP solver
+//
+///////////////////////////////////////////////////
+
+#include <cmath>
+
+#include "ChLcpIterativeAPGDfused.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time
+// dynamic creation and persistence
+ChClassRegister<ChLcpIterativeAPGDfused> a_registration_ChLcpIterativeAPGDfused;
+
+void ChLcpIterativeAPGDfused::ShurBvectorCompute(ChLcpSystemDescriptor& sysd) {
+    // Compute the b_shur vector in the Shur complement equation N*l = b_shur
+    // (see ChIterativeAPGD::ShurBvectorCompute), flipping the sign of lambdas:
+    // b_shur = - b_i - D'*(M^-1)*k
+
+    // Put (M^-1)*k    in  q  sparse vector of each variable..
+    const std::vector<ChLcpVariables*>& mvariables = sysd.GetVariablesList();
+    for (unsigned int iv = 0; iv < mvariables.size(); iv++)
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+
+    // ...and now do  b_shur = - D'*q = - D'*(M^-1)*k ..
+    const std::vector<ChLcpConstraint*>& mconstraints = sysd.GetConstraintsList();
+    int s_i = 0;
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+        if (mconstraints[ic]->IsActive()) {
+            r(s_i, 0) = mconstraints[ic]->Compute_Cq_q();
+            ++s_i;
+        }
+
+    // ..and finally do   b_shur = b_shur - c
+    sysd.BuildBiVector(tmp);  // b_i   =   -c   = phi/h
+    r.MatrInc(tmp);
+}
+
+double ChLcpIterativeAPGDfused::Res4(ChLcpSystemDescriptor& sysd) {
+    // Same residual of ChIterativeAPGD::Res4 (projected gradient), but using
+    // the product N*gammaNew already available in NgammaNew.
+    double gdiff = 1.0 / pow(nc, 2.0);
+    double* a_tmp = tmp.GetAddress();
+    const double* a_gammaNew = gammaNew.GetAddress();
+    const double* a_NgammaNew = NgammaNew.GetAddress();
+    const double* a_r = r.GetAddress();
+
+    for (int i = 0; i < nc; i++)
+        a_tmp[i] = a_gammaNew[i] - gdiff * (a_NgammaNew[i] + a_r[i]);
+    sysd.ConstraintsProject(tmp);
+
+    double res2 = 0;
+    for (int i = 0; i < nc; i++) {
+        double d = (a_gammaNew[i] - a_tmp[i]) / gdiff;
+        res2 += d * d;
+    }
+
+    return sqrt(res2);
+}
+
+double ChLcpIterativeAPGDfused::Solve(ChLcpSystemDescriptor& sysd) {
+    const std::vector<ChLcpConstraint*>& mconstraints = sysd.GetConstraintsList();
+
+    // Update auxiliary data in all constraints before starting,
+    // that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+        mconstraints[ic]->Update_auxiliary();
+
+    // Work vectors are reallocated only if the number of constraints changed.
+    nc = sysd.CountActiveConstraints();
+    gamma_hat.Resize(nc, 1);
+    gamma.Resize(nc, 1);
+    gammaNew.Resize(nc, 1);
+    y.Resize(nc, 1);
+    yNew.Resize(nc, 1);
+    g.Resize(nc, 1);
+    r.Resize(nc, 1);
+    tmp.Resize(nc, 1);
+    Ngamma.Resize(nc, 1);
+    NgammaNew.Resize(nc, 1);
+    Ny.Resize(nc, 1);
+    NyNew.Resize(nc, 1);
+
+    residual = 10e30;
+    num_products = 0;
+    tot_iterations = 0;
+
+    // Compute the b_shur vector in the Shur complement equation N*l = b_shur
+    ShurBvectorCompute(sysd);
+
+    // Backup the  q  sparse data computed above, because   (M^-1)*k   will be
+    // needed at the end when computing primals.
+    sysd.FromVariablesToVector(Minvk, true);
+
+    if (nc == 0)
+        return 0;
+
+    // (1) gamma_0 = zeros(nc,1)
+    if (warm_start) {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            if (mconstraints[ic]->IsActive())
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    } else {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+    sysd.FromConstraintsToVector(gamma);
+
+    // (2) gamma_hat_0 = ones(nc,1)
+    gamma_hat.FillElem(1);
+
+    // (3) y_0 = gamma_0
+    y.CopyFromMatrix(gamma);
+
+    // (4) theta_0 = 1
+    double theta = 1.0;
+    double thetaNew;
+
+    // (5) L_k = norm(N * (gamma_0 - gamma_hat_0)) / norm(gamma_0 - gamma_hat_0)
+    tmp.MatrSub(gamma, gamma_hat);
+    double L = tmp.NormTwo();
+    sysd.ShurComplementProduct(NyNew, &tmp, 0);
+    num_products++;
+    L = NyNew.NormTwo() / L;
+
+    // (6) t_k = 1 / L_k
+    double t = 1.0 / L;
+
+    // N * gamma_0, and N * y_0 = N * gamma_0
+    sysd.ShurComplementProduct(Ngamma, &gamma);
+    num_products++;
+    Ny.CopyFromMatrix(Ngamma);
+
+    // (7) for k := 0 to N_max
+    for (tot_iterations = 0; tot_iterations < max_iterations; tot_iterations++) {
+        double* a_gamma = gamma.GetAddress();
+        double* a_gammaNew = gammaNew.GetAddress();
+        double* a_y = y.GetAddress();
+        double* a_yNew = yNew.GetAddress();
+        double* a_g = g.GetAddress();
+        double* a_r = r.GetAddress();
+        double* a_Ngamma = Ngamma.GetAddress();
+        double* a_NgammaNew = NgammaNew.GetAddress();
+        double* a_Ny = Ny.GetAddress();
+        double* a_NyNew = NyNew.GetAddress();
+
+        // (8) g = N * y_k - r   (N * y_k is known, no product needed)
+        // and the part of the objective that depends only on y_k: 0.5 * y_k' * N * y_k - y_k' * r
+        double obj_y = 0;
+        for (int i = 0; i < nc; i++) {
+            a_g[i] = a_Ny[i] + a_r[i];
+            obj_y += a_y[i] * (0.5 * a_Ny[i] + a_r[i]);
+        }
+
+        // N * y_k accumulates round-off from the linear combinations: it is
+        // recomputed exactly the first time the step must be shortened.
+        bool Ny_exact = false;
+
+        double obj1, obj2;
+        while (true) {
+            // (9) gamma_(k+1) = ProjectionOperator(y_k - t_k * g)
+            for (int i = 0; i < nc; i++)
+                a_gammaNew[i] = a_y[i] - t * a_g[i];
+            sysd.ConstraintsProject(gammaNew);
+
+            // The only product by N of the iteration (unless backtracking).
+            sysd.ShurComplementProduct(NgammaNew, &gammaNew);
+            num_products++;
+
+            // (10) while 0.5 * gamma_(k+1)' * N * gamma_(k+1) - gamma_(k+1)' * r >= 0.5 * y_k' * N * y_k - y_k' * r +
+            // g' * (gamma_(k+1) - y_k) + 0.5 * L_k * norm(gamma_(k+1) - y_k)^2
+            obj1 = 0;
+            double dot_dg = 0;
+            double dot_dd = 0;
+            for (int i = 0; i < nc; i++) {
+                obj1 += a_gammaNew[i] * (0.5 * a_NgammaNew[i] + a_r[i]);
+                double d = a_gammaNew[i] - a_y[i];
+                dot_dg += d * a_g[i];
+                dot_dd += d * d;
+            }
+            obj2 = obj_y + dot_dg + 0.5 * L * dot_dd;
+
+            if (obj1 < obj2 || dot_dd == 0)
+                break;
+
+            if (!Ny_exact) {
+                sysd.ShurComplementProduct(Ny, &y);
+                num_products++;
+                obj_y = 0;
+                for (int i = 0; i < nc; i++) {
+                    a_g[i] = a_Ny[i] + a_r[i];
+                    obj_y += a_y[i] * (0.5 * a_Ny[i] + a_r[i]);
+                }
+                Ny_exact = true;
+                continue;
+            }
+
+            // (11) L_k = 2 * L_k
+            L = 2.0 * L;
+
+            // (12) t_k = 1 / L_k
+            t = 1.0 / L;
+
+            // (13)-(14) recompute gamma_(k+1) and the condition
+        }
+
+        // (15) theta_(k+1) = (-theta_k^2 + theta_k * sqrt(theta_k^2 + 4)) / 2
+        thetaNew = (-theta * theta + theta * sqrt(theta * theta + 4.0)) / 2.0;
+
+        // (16) Beta_(k+1) = theta_k * (1 - theta_k) / (theta_k^2 + theta_(k+1))
+        double Beta = theta * (1.0 - theta) / (theta * theta + thetaNew);
+
+        // (17) y_(k+1) = gamma_(k+1) + Beta_(k+1) * (gamma_(k+1) - gamma_k)
+        // and, by linearity, N * y_(k+1) = (1 + Beta) * N * gamma_(k+1) - Beta * N * gamma_k
+        // Also compute g' * (gamma_(k+1) - gamma_k) for the restart test at (26).
+        double dot_restart = 0;
+        for (int i = 0; i < nc; i++) {
+            double d = a_gammaNew[i] - a_gamma[i];
+            a_yNew[i] = a_gammaNew[i] + Beta * d;
+            a_NyNew[i] = (1.0 + Beta) * a_NgammaNew[i] - Beta * a_Ngamma[i];
+            dot_restart += d * a_g[i];
+        }
+
+        // (18) r = r(gamma_(k+1)), only every residual_interval iterations
+        if ((tot_iterations + 1) % residual_interval == 0 || tot_iterations == max_iterations - 1) {
+            double res = Res4(sysd);
+
+            // (19) if r < epsilon_min
+            if (res < residual) {
+                // (20) r_min = r
+                residual = res;
+
+                // (21) gamma_hat = gamma_(k+1)
+                gamma_hat.CopyFromMatrix(gammaNew);
+            }
+
+            // (23) if r < Tau
+            if (residual < this->tolerance)
+                break;
+        }
+
+        // (26) if g' * (gamma_(k+1) - gamma_k) > 0
+        if (dot_restart > 0) {
+            // (27) y_(k+1) = gamma_(k+1)
+            yNew.CopyFromMatrix(gammaNew);
+            NyNew.CopyFromMatrix(NgammaNew);
+
+            // (28) theta_(k+1) = 1
+            thetaNew = 1.0;
+        }
+
+        // (30) L_k = 0.9 * L_k
+        L = 0.9 * L;
+
+        // (31) t_k = 1 / L_k
+        t = 1.0 / L;
+
+        // perform some tasks at the end of the iteration
+        if (this->record_violation_history) {
+            tmp.MatrSub(gammaNew, gamma);
+            AtIterationEnd(residual, tmp.NormInf(), tot_iterations);
+        }
+
+        // Update iterates (swapping buffers, without copies)
+        theta = thetaNew;
+        gamma.SwapData(gammaNew);
+        Ngamma.SwapData(NgammaNew);
+        y.SwapData(yNew);
+        Ny.SwapData(NyNew);
+
+        // (32) endfor
+    }
+
+    // (33) return Value at time step t_(l+1), gamma_(l+1) := gamma_hat
+    sysd.FromVectorToConstraints(gamma_hat);
+
+    // Resulting PRIMAL variables:
+    // compute the primal variables as   v = (M^-1)(k + D*l)
+    // v = (M^-1)*k  ...    (by rewinding to the backup vector computed at the beginning)
+    sysd.FromVectorToVariables(Minvk);
+
+    // ... + (M^-1)*D*l     (this increment and also stores 'qb' in the ChLcpVariable items)
+    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+        if (mconstraints[ic]->IsActive())
+            mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    }
+
+    return residual;
+}
+
+}  // END_OF_NAMESPACE____
@@ -0,0 +1,107 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#ifndef CHLCPITERATIVEAPGDFUSED_H
+#define CHLCPITERATIVEAPGDFUSED_H
+
+//////////////////////////////////////////////////
+//
+//   ChLcpIterativeAPGDfused.h
+//
+//  An iterative solver based on Nesterov's
+//  Projected Gradient Descent, with a single
+//  Schur complement product per iteration.
+//
+//   HEADER file for CHRONO HYPEROCTANT LCP solver
+//
+///////////////////////////////////////////////////
+
+#include "ChLcpIterativeSolver.h"
+
+namespace chrono {
+
+/// An iterative solver based on Nesterov's
+/// Projected Gradient Descent (same algorithm of ChIterativeAPGD).
+/// The problem is described by an LCP of type
+///
+///    | M -Cq'|*|q|- | f|= |0| ,   c>=0, l>=0, l*c=0;
+///    | Cq  0 | |l|  |-b|  |c|
+///
+/// or similar CCP problem.
+///
+/// Differently from ChIterativeAPGD, which computes three or four products
+/// by the Schur complement N per iteration, this solver computes only N*gamma
+/// for the new iterate: N*y is obtained as a linear combination of the products
+/// of the last two iterates, and the same product is used for the objective
+/// function and for the residual. Work vectors are kept between calls, and the
+/// residual can be evaluated only every few iterations.
+
+class ChApi ChLcpIterativeAPGDfused : public ChLcpIterativeSolver {
+    // Chrono RTTI, needed for serialization
+    CH_RTTI(ChLcpIterativeAPGDfused, ChLcpIterativeSolver);
+
+  protected:
+    //
+    // DATA
+    //
+
+    double residual;
+    int nc;
+    int residual_interval;
+    int num_products;
+    ChMatrixDynamic<> gamma_hat, gamma, gammaNew, y, yNew, g, r, tmp;
+    ChMatrixDynamic<> Ngamma, NgammaNew, Ny, NyNew;
+    ChMatrixDynamic<> Minvk;
+
+  public:
+    //
+    // CONSTRUCTORS
+    //
+
+    ChLcpIterativeAPGDfused(int mmax_iters = 1000,     ///< max.number of iterations
+                            bool mwarm_start = false,  ///< uses warm start?
+                            double mtolerance = 0.0    ///< tolerance for termination criterion
+                            )
+        : ChLcpIterativeSolver(mmax_iters, mwarm_start, mtolerance, 0.0001),
+          residual(0),
+          nc(0),
+          residual_interval(1),
+          num_products(0) {}
+
+    virtual ~ChLcpIterativeAPGDfused() {}
+
+    //
+    // FUNCTIONS
+    //
+
+    // Performs the solution of the LCP.
+    virtual double Solve(ChLcpSystemDescriptor& sysd);
+
+    /// Set the number of iterations between evaluations of the residual
+    /// (default 1: at each iteration). The residual is also evaluated at the
+    /// last iteration.
+    void SetResidualInterval(int minterval) { residual_interval = (minterval < 1) ? 1 : minterval; }
+    int GetResidualInterval() { return residual_interval; }
+
+    /// Return the residual of the solution found at the last call to Solve().
+    double GetResidual() { return residual; }
+
+    /// Return the number of Schur complement products computed at the last call to Solve().
+    int GetNumShurProducts() { return num_products; }
+
+  private:
+    void ShurBvectorCompute(ChLcpSystemDescriptor& sysd);
+    double Res4(ChLcpSystemDescriptor& sysd);
+};
+
+}  // END_OF_NAMESPACE____
+
+#endif  // END of ChLcpIterativeAPGDfused.h
@@ -125,6 +125,12 @@ void ChAssembly::AddBody(std::shared_ptr<ChBody> newbody) {
     bodylist.push_back(newbody);
 }
 
+void ChAssembly::AddBodies(const std::vector<std::shared_ptr<ChBody>>& newbodies) {
+    bodylist.reserve(bodylist.size() + newbodies.size());
+    for (size_t i = 0; i < newbodies.size(); ++i)
+        AddBody(newbodies[i]);
+}
+
 void ChAssembly::RemoveBody(std::shared_ptr<ChBody> mbody) {
     assert(std::find<std::vector<std::shared_ptr<ChBody>>::iterator>(bodylist.begin(), bodylist.end(), mbody) !=
            bodylist.end());
@@ -196,9 +202,17 @@ void ChAssembly::AddBatch(std::shared_ptr<ChPhysicsItem> newitem) {
 }
 
 void ChAssembly::FlushBatch() {
+    if (batch_to_insert.empty())
+        return;
+
+    std::vector<std::shared_ptr<ChBody>> bodies;
     for (int i = 0; i < this->batch_to_insert.size(); ++i) {
-        this->Add(batch_to_insert[i]);
+        if (auto item = std::dynamic_pointer_cast<ChBody>(batch_to_insert[i]))
+            bodies.push_back(item);
+        else
+            this->Add(batch_to_insert[i]);
     }
+    this->AddBodies(bodies);
     batch_to_insert.clear();
 }
 
@@ -61,6 +61,11 @@ public:
     /// Attach a body to this system. Must be an object of exactly ChBody class.
     virtual void AddBody(std::shared_ptr<ChBody> newbody);
     
+    /// Attach a batch of bodies to this system. This is equivalent to calling
+    /// AddBody() for each body, but faster when adding large amounts of
+    /// particles. Bodies must not belong to another system.
+    virtual void AddBodies(const std::vector<std::shared_ptr<ChBody>>& newbodies);
+
     /// Attach a link to this system. Must be an object of ChLink or derived classes.
     virtual void AddLink(std::shared_ptr<ChLink> newlink);
 
@@ -83,6 +88,7 @@ public:
 
     /// If some items are queued for addition in system, using AddBatch(), this will
     /// effectively add them and clean the batch. Called automatically at each Setup().
+    /// The queued bodies are added all together, with AddBodies().
     void FlushBatch();
 
     /// Remove a body from this system.
@@ -85,6 +85,7 @@ ChBody::ChBody(ChMaterialSurfaceBase::ContactMethod contact_method) {
 
     sleep_time = 0.6f;
     sleep_starttime = 0;
+    sleep_group = -1;
     sleep_minspeed = 0.1f;
     sleep_minwvel = 0.04f;
     SetUseSleeping(true);
@@ -131,6 +132,7 @@ ChBody::ChBody(ChCollisionModel* new_collision_model, ChMaterialSurfaceBase::Con
 
     sleep_time = 0.6f;
     sleep_starttime = 0;
+    sleep_group = -1;
     sleep_minspeed = 0.1f;
     sleep_minwvel = 0.04f;
     SetUseSleeping(true);
@@ -183,6 +185,7 @@ void ChBody::Copy(ChBody* source) {
 
     sleep_time = source->sleep_time;
     sleep_starttime = source->sleep_starttime;
+    sleep_group = -1;
     sleep_minspeed = source->sleep_minspeed;
     sleep_minwvel = source->sleep_minwvel;
 }
@@ -530,6 +533,22 @@ void ChBody::ComputeGyro() {
     gyro = Vcross(Wvel, (variables.GetBodyInertia().Matr_x_Vect(Wvel)));
 }
 
+void ChBody::SetSleeping(bool ms) {
+    // when waken, the body must stay at rest again for sleep_time before falling asleep
+    if (!ms && GetSleeping())
+        this->sleep_starttime = float(this->GetChTime());
+
+    // remember where the body fell asleep, to detect if it is moved while sleeping
+    if (ms && !GetSleeping())
+        this->sleep_coord = this->coord;
+
+    BFlagSet(BF_SLEEPING, ms);
+    this->variables.SetDisabled(!this->IsActive());
+
+    if (collision_model)
+        collision_model->SetSleeping(ms);
+}
+
 bool ChBody::TrySleeping() {
 
     BFlagSet(BF_COULDSLEEP, false);
@@ -786,15 +805,23 @@ int ChBody::RecomputeCollisionModel() {
 }
 
 void ChBody::SyncCollisionModels() {
-    if (this->GetCollide())
+    // A sleeping body does not move, so its collision model is already in sync,
+    // unless the body was moved from outside (e.g. with SetPos): then it is waken,
+    // together with its island at the next ManageSleepingBodies().
+    if (this->GetSleeping() && !(this->coord == this->sleep_coord))
+        SetSleeping(false);
+
+    if (this->GetCollide() && !this->GetSleeping())
         this->GetCollisionModel()->SyncPosition();
 }
 
 void ChBody::AddCollisionModelsToSystem() {
     assert(this->GetSystem());
-    SyncCollisionModels();
-    if (this->GetCollide())
+    if (this->GetCollide()) {
+        this->GetCollisionModel()->SyncPosition();
+        this->GetCollisionModel()->SetSleeping(this->GetSleeping());
         this->GetSystem()->GetCollisionSystem()->Add(this->GetCollisionModel());
+    }
 }
 
 void ChBody::RemoveCollisionModelsFromSystem() {
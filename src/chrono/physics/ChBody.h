@@ -118,6 +118,8 @@ class ChApi ChBody :            public ChPhysicsItem,
     float sleep_minspeed;
     float sleep_minwvel;
     float sleep_starttime;
+    int sleep_group;  // tag of the island that fell asleep together with this body [internal]
+    ChCoordsys<> sleep_coord;  // position when the body fell asleep [internal]
 
   public:
 
@@ -203,9 +205,17 @@ class ChApi ChBody :            public ChPhysicsItem,
 
     /// Force the body in sleeping mode or not (usually this state change is not
     /// handled by users, anyway, because it is mostly automatic).
-    void SetSleeping(bool ms) { BFlagSet(BF_SLEEPING, ms); }
+    /// A sleeping body is excluded from the solver and its collision model is
+    /// not tested against other sleeping or fixed models. A sleeping body that
+    /// is moved (e.g. with SetPos) is waken at the next collision detection.
+    void SetSleeping(bool ms);
     bool GetSleeping() { return BFlagGet(BF_SLEEPING); }
 
+    /// Tag shared by all the bodies of an island that fell asleep together
+    /// (usually this is handled automatically by the sleeping policy of ChSystem).
+    void SetSleepingGroup(int mgroup) { sleep_group = mgroup; }
+    int GetSleepingGroup() const { return sleep_group; }
+
     /// Test if a body could go in sleeping state if requirements are satisfied.
     /// Return true if state could be changed from no sleep to sleep. 
     bool TrySleeping();
@@ -0,0 +1,116 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+///////////////////////////////////////////////////
+//
+//   ChCellListSPH.cpp
+//
+///////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "physics/ChCellListSPH.h"
+
+namespace chrono {
+
+// Cell coordinates are stored with 21 bits each, so that the three of them
+// fit in a 64-bit Morton key.
+static const int max_cell_coord = (1 << 21) - 1;
+
+// Spread the lower 21 bits of v so that there are two zero bits between each of them.
+static uint64_t SpreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffffULL;
+    v = (v | v << 16) & 0x1f0000ff0000ffULL;
+    v = (v | v << 8) & 0x100f00f00f00f00fULL;
+    v = (v | v << 4) & 0x10c30c30c30c30c3ULL;
+    v = (v | v << 2) & 0x1249249249249249ULL;
+    return v;
+}
+
+uint64_t ChCellListSPH::MortonKey(int ix, int iy, int iz) {
+    return SpreadBits(ix) | (SpreadBits(iy) << 1) | (SpreadBits(iz) << 2);
+}
+
+void ChCellListSPH::GetCellCoords(const ChVector<>& pos, int& ix, int& iy, int& iz) const {
+    ix = std::min((int)std::floor((pos.x - origin.x) * inv_cell_size), max_cell_coord);
+    iy = std::min((int)std::floor((pos.y - origin.y) * inv_cell_size), max_cell_coord);
+    iz = std::min((int)std::floor((pos.z - origin.z) * inv_cell_size), max_cell_coord);
+}
+
+int ChCellListSPH::FindCell(int ix, int iy, int iz) const {
+    if (ix < 0 || iy < 0 || iz < 0 || ix > max_cell_coord || iy > max_cell_coord || iz > max_cell_coord)
+        return -1;
+    uint64_t key = MortonKey(ix, iy, iz);
+    std::vector<uint64_t>::const_iterator it = std::lower_bound(cell_keys.begin(), cell_keys.end(), key);
+    if (it == cell_keys.end() || *it != key)
+        return -1;
+    return (int)(it - cell_keys.begin());
+}
+
+void ChCellListSPH::Build(const std::vector<ChVector<> >& points, double mcell_size) {
+    int npoints = (int)points.size();
+
+    cell_size = mcell_size;
+    inv_cell_size = 1.0 / mcell_size;
+
+    sorted_index.resize(npoints);
+    sorted_pos.resize(npoints);
+    point_keys.resize(npoints);
+    cell_keys.clear();
+    cell_start.clear();
+
+    if (npoints == 0) {
+        cell_start.push_back(0);
+        return;
+    }
+
+    // Lower corner of the bounding box: all cell coordinates are non negative.
+    origin = points[0];
+    for (int i = 1; i < npoints; i++) {
+        origin.x = std::min(origin.x, points[i].x);
+        origin.y = std::min(origin.y, points[i].y);
+        origin.z = std::min(origin.z, points[i].z);
+    }
+
+    // Sort the points by the Morton key of their cell. Ties are broken by the
+    // index of the point, so that the order does not depend on the sort.
+    std::vector<std::pair<uint64_t, int> > order(npoints);
+
+#pragma omp parallel for
+    for (int i = 0; i < npoints; i++) {
+        int ix, iy, iz;
+        GetCellCoords(points[i], ix, iy, iz);
+        order[i] = std::make_pair(MortonKey(ix, iy, iz), i);
+    }
+
+    std::sort(order.begin(), order.end());
+
+#pragma omp parallel for
+    for (int k = 0; k < npoints; k++) {
+        sorted_index[k] = order[k].second;
+        sorted_pos[k] = points[order[k].second];
+        point_keys[k] = order[k].first;
+    }
+
+    // Find the range of points in each non-empty cell.
+    for (int k = 0; k < npoints; k++) {
+        if (k == 0 || point_keys[k] != point_keys[k - 1]) {
+            cell_keys.push_back(point_keys[k]);
+            cell_start.push_back(k);
+        }
+    }
+    cell_start.push_back(npoints);
+}
+
+}  // END_OF_NAMESPACE____
@@ -0,0 +1,108 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#ifndef CHCELLLISTSPH_H
+#define CHCELLLISTSPH_H
+
+//////////////////////////////////////////////////
+//
+//   ChCellListSPH.h
+//
+//   Uniform grid for the neighbour search of
+//   SPH particles.
+//
+//   HEADER file for CHRONO,
+//	 Multibody dynamics engine
+//
+///////////////////////////////////////////////////
+
+#include <stdint.h>
+#include <vector>
+
+#include "core/ChApiCE.h"
+#include "core/ChVector.h"
+
+namespace chrono {
+
+///
+/// Class for a uniform cell list, used to find the neighbours of a set of points
+/// (for example the nodes of a ChMatterSPH) within a given radius.
+///
+/// The space is divided in cubic cells whose side is the search radius, so that
+/// all neighbours of a point are in the 3x3x3 block of cells around it. Points
+/// are sorted by the Morton (Z-order) code of their cell: points in the same cell
+/// are contiguous, and nearby cells are mostly close in memory.
+/// The list must be rebuilt with Build() each time the points move.
+///
+/// Once built, ForEachNeighbor() can be called concurrently from many threads,
+/// so that per-point quantities can be computed in parallel gather loops.
+///
+
+class ChApi ChCellListSPH {
+  public:
+    ChCellListSPH() : cell_size(0), inv_cell_size(0) {}
+
+    /// Sort the given points in the cells of a grid with the given cell size
+    /// (usually the maximum kernel radius of the points).
+    void Build(const std::vector<ChVector<> >& points, double mcell_size);
+
+    /// Get the number of points in the list.
+    int GetNumPoints() const { return (int)sorted_index.size(); }
+
+    /// Get the number of non-empty cells.
+    int GetNumCells() const { return (int)cell_keys.size(); }
+
+    /// Get the index, in the array passed to Build(), of the k-th point in Morton order.
+    int GetSortedIndex(int k) const { return sorted_index[k]; }
+
+    /// Get the position of the k-th point in Morton order.
+    const ChVector<>& GetSortedPos(int k) const { return sorted_pos[k]; }
+
+    /// Call func(m) for all points m (in Morton order, and different from k) in
+    /// the 3x3x3 cells around the k-th point in Morton order. These are all the
+    /// points within cell_size from point k, plus some farther points that the
+    /// caller must discard. Points are visited always in the same order.
+    template <class Func>
+    void ForEachNeighbor(int k, Func& func) const {
+        int ix, iy, iz;
+        GetCellCoords(sorted_pos[k], ix, iy, iz);
+        for (int dz = -1; dz <= 1; dz++)
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++) {
+                    int cell = FindCell(ix + dx, iy + dy, iz + dz);
+                    if (cell < 0)
+                        continue;
+                    for (int m = cell_start[cell]; m < cell_start[cell + 1]; m++) {
+                        if (m != k)
+                            func(m);
+                    }
+                }
+    }
+
+  private:
+    void GetCellCoords(const ChVector<>& pos, int& ix, int& iy, int& iz) const;
+    int FindCell(int ix, int iy, int iz) const;
+    static uint64_t MortonKey(int ix, int iy, int iz);
+
+    double cell_size;
+    double inv_cell_size;
+    ChVector<> origin;
+
+    std::vector<int> sorted_index;     // original index of the points, in Morton order
+    std::vector<ChVector<> > sorted_pos;  // positions of the points, in Morton order
+    std::vector<uint64_t> point_keys;  // Morton key of the cell of each point
+    std::vector<uint64_t> cell_keys;   // sorted keys of the non-empty cells
+    std::vector<int> cell_start;       // first point of each cell (plus one past the last point)
+};
+
+}  // END_OF_NAMESPACE____
+
+#endif
@@ -23,6 +23,7 @@ ChLinkBase::ChLinkBase() {
     broken = false;
     valid = true;
     disabled = false;
+    sleeping = false;
 
     SetIdentifier(GetUniqueIntID());  // mark with unique ID
 }
@@ -38,6 +39,7 @@ void ChLinkBase::Copy(ChLinkBase* source) {
     broken = source->broken;
     valid = source->valid;
     disabled = source->disabled;
+    sleeping = false;
 }
 
 
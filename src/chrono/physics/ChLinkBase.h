@@ -89,6 +89,7 @@ class ChApi ChLinkBase : public ChPhysicsItem {
     bool disabled;  // all constraints of link disabled because of user needs
     bool valid;     // link data is valid
     bool broken;    // link is broken because of excessive pulling/pushing.
+    bool sleeping;  // link is deactivated because the connected bodies are sleeping [internal]
 
   public:
     //
@@ -125,8 +126,15 @@ class ChApi ChLinkBase : public ChPhysicsItem {
     /// Tells if the link is currently active, in general,
     /// that is tells if it must be included into the system solver or not.
     /// This method cumulates the effect of various flags (so a link may
-    /// be not active either because disabled, or broken, or not valid)
-    virtual bool IsActive() { return (valid && !disabled && !broken); }
+    /// be not active either because disabled, or broken, or not valid, or sleeping)
+    virtual bool IsActive() { return (valid && !disabled && !broken && !sleeping); }
+
+    /// Tells if the link is sleeping, because all the connected bodies are sleeping
+    /// (or fixed). Sleeping links are not included into the system solver.
+    virtual bool IsSleeping() { return sleeping; }
+    /// Set the sleeping status of the link (usually this state change is not
+    /// handled by users, because it is managed by the sleeping policy of ChSystem).
+    virtual void SetSleeping(bool ms) { sleeping = ms; }
 
     /// Get the type identifier of this link. Use if you don't want to use RTTI for performance.
     virtual int GetType() { return LNK_BASE; }
@@ -240,6 +240,7 @@ ChClassRegister<ChMatterSPH> a_registration_ChMatterSPH;
 
 ChMatterSPH::ChMatterSPH() {
     this->do_collide = false;
+    this->use_cell_list = false;
 
     this->nodes.clear();
 
@@ -259,6 +260,7 @@ void ChMatterSPH::Copy(ChMatterSPH* source) {
     ChIndexedNodes::Copy(source);
 
     do_collide = source->do_collide;
+    use_cell_list = source->use_cell_list;
 
     this->material = source->material;
 
@@ -402,30 +404,39 @@ void ChMatterSPH::IntStateScatterAcceleration(const unsigned int off_a, const Ch
     }
 }
 
-void ChMatterSPH::IntLoadResidual_F(
-    const unsigned int off,  ///< offset in R residual (not used here! use particle's offsets)
-    ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
-    const double c           ///< a scaling factor
-    ) {
-    // COMPUTE THE SPH FORCES HERE
+//// SPH FORCES
 
-    // First, find if any ChProximityContainerSPH object is present
-    // in the system,
+std::shared_ptr<ChProximityContainerSPH> ChMatterSPH::GetProximityContainer() {
+    std::shared_ptr<ChProximityContainerSPH> edges = proximity_container.lock();
+    if (edges && edges->GetSystem() == this->GetSystem())
+        return edges;
 
-    std::shared_ptr<ChProximityContainerSPH> edges;
+    edges.reset();
     std::vector<std::shared_ptr<ChPhysicsItem> >::iterator iterotherphysics = this->GetSystem()->Get_otherphysicslist()->begin();
     while (iterotherphysics != this->GetSystem()->Get_otherphysicslist()->end()) {
         if (edges = std::dynamic_pointer_cast<ChProximityContainerSPH>(*iterotherphysics))
             break;
         iterotherphysics++;
     }
-    assert(edges);  // If using a ChMatterSPH, you must add also a ChProximityContainerSPH.
-    if (!edges)
+    proximity_container = edges;
+    return edges;
+}
+
+void ChMatterSPH::ComputeSPHForces() {
+    std::shared_ptr<ChProximityContainerSPH> edges;
+    if (!use_cell_list)
+        edges = GetProximityContainer();
+
+    // Without a ChProximityContainerSPH, find the neighbours with the cell list.
+    if (!edges) {
+        ComputeSPHForcesCellList();
         return;
+    }
 
     // 1- Per-node initialization
 
-    for (unsigned int j = 0; j < nodes.size(); j++) {
+#pragma omp parallel for
+    for (int j = 0; j < (int)nodes.size(); j++) {
         this->nodes[j]->UserForce = VNULL;
         this->nodes[j]->density = 0;
     }
@@ -436,9 +447,9 @@ void ChMatterSPH::IntLoadResidual_F(
 
     // 3- Per-node volume and pressure computation
 
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        std::shared_ptr<ChNodeSPH> mnode(this->nodes[j]);
-        assert(mnode);
+#pragma omp parallel for
+    for (int j = 0; j < (int)nodes.size(); j++) {
+        ChNodeSPH* mnode = this->nodes[j].get();
 
         // node volume is v=mass/density
         if (mnode->density)
@@ -453,21 +464,137 @@ void ChMatterSPH::IntLoadResidual_F(
     // 4- Per-edge forces computation and accumulation
 
     edges->AccumulateStep2();
+}
 
-    // 5- Per-node load forces in LCP
+// Gather the density of a node from its neighbours in the cell list.
+struct ChDensityGatherSPH {
+    const ChCellListSPH* cells;
+    const double* mass;
+    const double* hrad;
+    int k;
+    double density;
 
-    for (unsigned int j = 0; j < nodes.size(); j++) {
+    void operator()(int m) {
+        double dist = (cells->GetSortedPos(m) - cells->GetSortedPos(k)).Length();
+        double h = 0.5 * (hrad[k] + hrad[m]);
+        if (dist < h)
+            density += mass[m] * ChProximityContainerSPH::W_poly6(dist, h);
+    }
+};
+
+// Gather the pressure and viscous forces on a node from its neighbours in the cell list.
+struct ChForceGatherSPH {
+    const ChCellListSPH* cells;
+    const ChVector<>* vel;
+    const double* hrad;
+    const double* volume;
+    const double* pressure;
+    double viscosity;
+    int k;
+    ChVector<> force;
+
+    void operator()(int m) {
+        ChVector<> r_mk = cells->GetSortedPos(m) - cells->GetSortedPos(k);
+        double dist = r_mk.Length();
+        double h = 0.5 * (hrad[k] + hrad[m]);
+        if (dist >= h)
+            return;
+
+        ChVector<> W_k_press;
+        ChProximityContainerSPH::W_gr_press(W_k_press, r_mk, dist, h);
+        double avg_press = 0.5 * (pressure[k] + pressure[m]);
+        force += W_k_press * (volume[k] * avg_press * volume[m]);
+
+        double W_k_visc = ChProximityContainerSPH::W_sq_visco(dist, h);
+        force += (vel[m] - vel[k]) * (volume[k] * viscosity * volume[m] * W_k_visc);
+    }
+};
+
+void ChMatterSPH::ComputeSPHForcesCellList() {
+    int nnodes = (int)nodes.size();
+    if (nnodes == 0)
+        return;
+
+    // 1- Sort the nodes in the cell list, with cell size equal to the largest kernel radius
+
+    node_pos.resize(nnodes);
+    double max_hrad = 0;
+    for (int j = 0; j < nnodes; j++) {
+        node_pos[j] = nodes[j]->GetPos();
+        max_hrad = std::max(max_hrad, nodes[j]->GetKernelRadius());
+    }
+
+    cell_list.Build(node_pos, max_hrad);
+
+    // 2- Gather the node data in Morton order, for locality in the neighbour loops
+
+    sorted_vel.resize(nnodes);
+    sorted_mass.resize(nnodes);
+    sorted_hrad.resize(nnodes);
+    sorted_density.resize(nnodes);
+    sorted_volume.resize(nnodes);
+    sorted_pressure.resize(nnodes);
+
+#pragma omp parallel for
+    for (int k = 0; k < nnodes; k++) {
+        ChNodeSPH* mnode = nodes[cell_list.GetSortedIndex(k)].get();
+        sorted_vel[k] = mnode->GetPos_dt();
+        sorted_mass[k] = mnode->GetMass();
+        sorted_hrad[k] = mnode->GetKernelRadius();
+    }
+
+    // 3- Per-node density, volume and pressure
+
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int k = 0; k < nnodes; k++) {
+        ChDensityGatherSPH gather = {&cell_list, sorted_mass.data(), sorted_hrad.data(), k, 0.0};
+        cell_list.ForEachNeighbor(k, gather);
+
+        sorted_density[k] = gather.density;
+        sorted_volume[k] = gather.density ? sorted_mass[k] / gather.density : 0;
+        sorted_pressure[k] = this->material.Get_pressure_stiffness() * (gather.density - this->material.Get_density());
+    }
+
+    // 4- Per-node pressure and viscous forces
+
+    double viscosity = this->material.Get_viscosity();
+
+#pragma omp parallel for schedule(dynamic, 256)
+    for (int k = 0; k < nnodes; k++) {
+        ChForceGatherSPH gather = {&cell_list,           sorted_vel.data(), sorted_hrad.data(), sorted_volume.data(),
+                                   sorted_pressure.data(), viscosity,       k,                  VNULL};
+        cell_list.ForEachNeighbor(k, gather);
+
+        ChNodeSPH* mnode = nodes[cell_list.GetSortedIndex(k)].get();
+        mnode->density = sorted_density[k];
+        mnode->volume = sorted_volume[k];
+        mnode->pressure = sorted_pressure[k];
+        mnode->UserForce = gather.force;
+    }
+}
+
+void ChMatterSPH::IntLoadResidual_F(
+    const unsigned int off,  ///< offset in R residual (not used here! use particle's offsets)
+    ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
+    const double c           ///< a scaling factor
+    ) {
+    // COMPUTE THE SPH FORCES HERE
+
+    ComputeSPHForces();
+
+    // Per-node load forces
+
+    ChVector<> G_acc = GetSystem()->Get_G_acc();
+
+#pragma omp parallel for
+    for (int j = 0; j < (int)nodes.size(); j++) {
         // particle gyroscopic force:
         // none.
 
         // add gravity
-        ChVector<> Gforce = GetSystem()->Get_G_acc() * this->nodes[j]->GetMass();
+        ChVector<> Gforce = G_acc * this->nodes[j]->GetMass();
         ChVector<> TotForce = this->nodes[j]->UserForce + Gforce;
 
-        // downcast
-        std::shared_ptr<ChNodeSPH> mnode(this->nodes[j]);
-        assert(mnode);
-
         R.PasteSumVector(TotForce * c, off + 3 * j, 0);
     }
 }
@@ -522,66 +649,22 @@ void ChMatterSPH::VariablesFbReset() {
 void ChMatterSPH::VariablesFbLoadForces(double factor) {
     // COMPUTE THE SPH FORCES HERE
 
-    // First, find if any ChProximityContainerSPH object is present
-    // in the system,
-
-    std::shared_ptr<ChProximityContainerSPH> edges;
-    std::vector<std::shared_ptr<ChPhysicsItem> >::iterator iterotherphysics = this->GetSystem()->Get_otherphysicslist()->begin();
-    while (iterotherphysics != this->GetSystem()->Get_otherphysicslist()->end()) {
-        if (edges = std::dynamic_pointer_cast<ChProximityContainerSPH>(*iterotherphysics))
-            break;
-        iterotherphysics++;
-    }
-    assert(edges);  // If using a ChMatterSPH, you must add also a ChProximityContainerSPH.
-    if (!edges)
-        return;
-
-    // 1- Per-node initialization
-
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        this->nodes[j]->UserForce = VNULL;
-        this->nodes[j]->density = 0;
-    }
-
-    // 2- Per-edge initialization and accumulation of particles's density
-
-    edges->AccumulateStep1();
-
-    // 3- Per-node volume and pressure computation
+    ComputeSPHForces();
 
-    for (unsigned int j = 0; j < nodes.size(); j++) {
-        std::shared_ptr<ChNodeSPH> mnode(this->nodes[j]);
-        assert(mnode);
+    // Per-node load forces in LCP
 
-        // node volume is v=mass/density
-        if (mnode->density)
-            mnode->volume = mnode->GetMass() / mnode->density;
-        else
-            mnode->volume = 0;
+    ChVector<> G_acc = GetSystem()->Get_G_acc();
 
-        // node pressure = k(dens - dens_0);
-        mnode->pressure = this->material.Get_pressure_stiffness() * (mnode->density - this->material.Get_density());
-    }
-
-    // 4- Per-edge forces computation and accumulation
-
-    edges->AccumulateStep2();
-
-    // 5- Per-node load forces in LCP
-
-    for (unsigned int j = 0; j < nodes.size(); j++) {
+#pragma omp parallel for
+    for (int j = 0; j < (int)nodes.size(); j++) {
         // particle gyroscopic force:
         // none.
 
         // add gravity
-        ChVector<> Gforce = GetSystem()->Get_G_acc() * this->nodes[j]->GetMass();
+        ChVector<> Gforce = G_acc * this->nodes[j]->GetMass();
         ChVector<> TotForce = this->nodes[j]->UserForce + Gforce;
 
-        // downcast
-        std::shared_ptr<ChNodeSPH> mnode(this->nodes[j]);
-        assert(mnode);
-
-        mnode->variables.Get_fb().PasteSumVector(TotForce * factor, 0, 0);
+        this->nodes[j]->variables.Get_fb().PasteSumVector(TotForce * factor, 0, 0);
     }
 }
 
@@ -35,6 +35,7 @@
 #include "physics/ChIndexedNodes.h"
 #include "physics/ChNodeXYZ.h"
 #include "physics/ChContinuumMaterial.h"
+#include "physics/ChCellListSPH.h"
 #include "collision/ChCCollisionModel.h"
 #include "lcp/ChLcpVariablesNode.h"
 
@@ -44,6 +45,7 @@ namespace chrono {
 
 class ChSystem;
 class ChMatterSPH;
+class ChProximityContainerSPH;
 
 /// Class for a single node in the SPH cluster
 /// (it does not define mass, inertia and shape becuase those
@@ -215,6 +217,22 @@ class ChApi ChMatterSPH : public ChIndexedNodes {
 
     bool do_collide;
 
+    // neighbour search with the cell list (see SetUseCellList)
+    bool use_cell_list;
+    ChCellListSPH cell_list;
+
+    // cached ChProximityContainerSPH of the system, if any
+    std::weak_ptr<ChProximityContainerSPH> proximity_container;
+
+    // per-node work data, in the Morton order of the cell list
+    std::vector<ChVector<> > sorted_vel;
+    std::vector<double> sorted_mass;
+    std::vector<double> sorted_hrad;
+    std::vector<double> sorted_density;
+    std::vector<double> sorted_volume;
+    std::vector<double> sorted_pressure;
+    std::vector<ChVector<> > node_pos;
+
   public:
     //
     // CONSTRUCTORS
@@ -241,6 +259,17 @@ class ChApi ChMatterSPH : public ChIndexedNodes {
     void SetCollide(bool mcoll);
     bool GetCollide() { return do_collide; }
 
+    /// Enable/disable the cell-list neighbour search. If enabled, the SPH
+    /// interactions between the nodes of this cluster are computed with a
+    /// uniform grid (with cell size equal to the largest kernel radius),
+    /// rebuilt at each force evaluation, and density and forces are computed in
+    /// parallel loops over the nodes. Nodes of other ChMatterSPH clusters are
+    /// not considered. If disabled (default), the pairs found by the collision
+    /// system and stored in the ChProximityContainerSPH of the system are used;
+    /// the cell list is used anyway if there is no such container in the system.
+    void SetUseCellList(bool muse) { use_cell_list = muse; }
+    bool GetUseCellList() const { return use_cell_list; }
+
     // STATISTICS  - override these in child classes if needed
     //
 
@@ -388,6 +417,19 @@ class ChApi ChMatterSPH : public ChIndexedNodes {
     /// Update all auxiliary data of the particles
     virtual void Update(bool update_assets = true);
 
+  private:
+    /// Compute density, volume and pressure of the nodes, and store the SPH
+    /// internal forces in the UserForce of the nodes.
+    void ComputeSPHForces();
+
+    /// Same as ComputeSPHForces, using the cell list for the neighbour search.
+    void ComputeSPHForcesCellList();
+
+    /// Find the ChProximityContainerSPH in the system (cached after the first search).
+    std::shared_ptr<ChProximityContainerSPH> GetProximityContainer();
+
+  public:
+
     // SERIALIZATION
 
     virtual void ArchiveOUT(ChArchiveOut& marchive);
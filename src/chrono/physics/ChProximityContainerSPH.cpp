@@ -124,21 +124,21 @@ void ChProximityContainerSPH::ReportAllProximities(ChReportProximityCallback* mc
 
 ////////// LCP INTERFACES ////
 
-static double W_poly6(double r, double h) {
+double ChProximityContainerSPH::W_poly6(double r, double h) {
     if (r < h) {
         return (315.0 / (64.0 * CH_C_PI * pow(h, 9))) * pow((h * h - r * r), 3);
     } else
         return 0;
 }
 
-static double W_sq_visco(double r, double h) {
+double ChProximityContainerSPH::W_sq_visco(double r, double h) {
     if (r < h) {
         return (45.0 / (CH_C_PI * pow(h, 6))) * (h - r);
     } else
         return 0;
 }
 
-static void W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_length, const double h) {
+void ChProximityContainerSPH::W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_length, const double h) {
     if (r_length < h) {
         Wresult = r;
         Wresult *= -(45.0 / (CH_C_PI * pow(h, 6))) * pow((h - r_length), 2.0);
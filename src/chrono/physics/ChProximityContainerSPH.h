@@ -147,6 +147,17 @@ class ChApi ChProximityContainerSPH : public ChProximityContainerBase {
     // Will be called by the ChMatterSPH item.
     virtual void AccumulateStep2();
 
+    // SPH kernels, shared with the cell-list neighbour search of ChMatterSPH.
+
+    /// Poly6 kernel, used for the density.
+    static double W_poly6(double r, double h);
+
+    /// Laplacian of the viscosity kernel.
+    static double W_sq_visco(double r, double h);
+
+    /// Gradient of the spiky kernel, used for the pressure forces.
+    static void W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_length, const double h);
+
     //
     // SERIALIZATION
     //
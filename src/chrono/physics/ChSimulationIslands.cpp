@@ -0,0 +1,182 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+///////////////////////////////////////////////////
+//
+//   ChSimulationIslands.cpp
+//
+///////////////////////////////////////////////////
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "physics/ChSimulationIslands.h"
+#include "physics/ChBody.h"
+#include "physics/ChLink.h"
+
+namespace chrono {
+
+void ChSimulationIslands::Reset(int nitems) {
+    if (nitems > num_allocated) {
+        parent.reset(new std::atomic<int>[nitems]);
+        num_allocated = nitems;
+    }
+
+    num_items = nitems;
+    num_islands = nitems;
+    island.resize(nitems);
+
+#pragma omp parallel for
+    for (int i = 0; i < nitems; ++i)
+        parent[i].store(i, std::memory_order_relaxed);
+}
+
+int ChSimulationIslands::Find(int item) {
+    // Path halving: each visited item is re-linked to its grandparent.
+    // A failed exchange only means that another thread already shortened the path.
+    while (true) {
+        int p = parent[item].load(std::memory_order_relaxed);
+        if (p == item)
+            return item;
+        int gp = parent[p].load(std::memory_order_relaxed);
+        if (p != gp)
+            parent[item].compare_exchange_weak(p, gp, std::memory_order_relaxed);
+        item = gp;
+    }
+}
+
+void ChSimulationIslands::Union(int itemA, int itemB) {
+    // Roots are always linked under the root with the smaller index: this
+    // prevents cycles when several threads link the same roots concurrently,
+    // and makes the final representatives independent of the thread scheduling.
+    while (true) {
+        itemA = Find(itemA);
+        itemB = Find(itemB);
+        if (itemA == itemB)
+            return;
+        if (itemA < itemB)
+            std::swap(itemA, itemB);
+        int expected = itemA;
+        if (parent[itemA].compare_exchange_strong(expected, itemB, std::memory_order_relaxed))
+            return;
+    }
+}
+
+int ChSimulationIslands::Finalize() {
+    // Representatives always have the smallest index of their island, so a
+    // single forward sweep is enough to number the islands in a compact way.
+    num_islands = 0;
+    for (int i = 0; i < num_items; ++i) {
+        int root = Find(i);
+        if (root == i)
+            island[i] = num_islands++;
+        else
+            island[i] = island[root];
+    }
+    return num_islands;
+}
+
+void ChSimulationIslands::UnionLinks(const std::vector<std::shared_ptr<ChBody> >& bodies,
+                                     const std::vector<std::shared_ptr<ChLink> >& links) {
+    int nbodies = (int)bodies.size();
+    int nlinks = (int)links.size();
+
+    // Index of a body in the island structure, or -1 if not a (non-fixed) body of the list
+    auto body_item = [&bodies, nbodies](ChBody* mbody) -> int {
+        if (!mbody || mbody->GetBodyFixed())
+            return -1;
+        int id = (int)mbody->GetId();
+        if (id >= nbodies || bodies[id].get() != mbody)
+            return -1;
+        return id;
+    };
+
+#pragma omp parallel for
+    for (int ip = 0; ip < nlinks; ++ip) {
+        ChLink* Lpointer = links[ip].get();
+        if (!Lpointer->IsValid() || Lpointer->IsDisabled() || Lpointer->IsBroken() || !Lpointer->IsRequiringWaking())
+            continue;
+        int i1 = body_item(dynamic_cast<ChBody*>(Lpointer->GetBody1()));
+        int i2 = body_item(dynamic_cast<ChBody*>(Lpointer->GetBody2()));
+        if (i1 >= 0 && i2 >= 0)
+            Union(i1, i2);
+    }
+}
+
+void ChSimulationIslands::UnionSleepingGroups(const std::vector<std::shared_ptr<ChBody> >& bodies) {
+    std::unordered_map<int, int> group_items;
+    for (int ip = 0; ip < (int)bodies.size(); ++ip) {
+        ChBody* Bpointer = bodies[ip].get();
+        if (Bpointer->GetBodyFixed() || Bpointer->GetSleepingGroup() < 0)
+            continue;
+        auto inserted = group_items.insert(std::make_pair(Bpointer->GetSleepingGroup(), ip));
+        if (!inserted.second)
+            Union(ip, inserted.first->second);
+    }
+}
+
+int ChSimulationIslands::UpdateSleeping(const std::vector<std::shared_ptr<ChBody> >& bodies) {
+    int nbodies = (int)bodies.size();
+
+    Finalize();
+
+    std::vector<char> island_awake(num_islands, 0);
+    for (int ip = 0; ip < nbodies; ++ip) {
+        ChBody* Bpointer = bodies[ip].get();
+        if (Bpointer->GetBodyFixed())
+            continue;
+        if (!Bpointer->GetSleeping() && !Bpointer->BFlagGet(BF_COULDSLEEP))
+            island_awake[island[ip]] = 1;
+    }
+    for (int ip = nbodies; ip < num_items; ++ip)
+        island_awake[island[ip]] = 1;
+
+    int nchanged = 0;
+
+#pragma omp parallel for reduction(+ : nchanged)
+    for (int ip = 0; ip < nbodies; ++ip) {
+        ChBody* Bpointer = bodies[ip].get();
+        Bpointer->BFlagSet(BF_COULDSLEEP, false);
+        if (Bpointer->GetBodyFixed())
+            continue;
+        bool msleep = !island_awake[island[ip]];
+        if (Bpointer->GetSleeping() != msleep) {
+            Bpointer->SetSleeping(msleep);
+            ++nchanged;
+        }
+        // the island index is unique among the islands of this step
+        Bpointer->SetSleepingGroup(msleep ? island[ip] : -1);
+    }
+
+    return nchanged;
+}
+
+int ChSimulationIslands::UpdateSleepingLinks(const std::vector<std::shared_ptr<ChLink> >& links) {
+    int nchanged = 0;
+
+#pragma omp parallel for reduction(+ : nchanged)
+    for (int ip = 0; ip < (int)links.size(); ++ip) {
+        ChLink* Lpointer = links[ip].get();
+        ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
+        ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
+        bool msleep = false;
+        if (b1 && b2)
+            msleep = !b1->IsActive() && !b2->IsActive() && (b1->GetSleeping() || b2->GetSleeping());
+        if (Lpointer->IsSleeping() != msleep) {
+            Lpointer->SetSleeping(msleep);
+            ++nchanged;
+        }
+    }
+
+    return nchanged;
+}
+
+}  // END_OF_NAMESPACE____
@@ -0,0 +1,120 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#ifndef CHSIMULATIONISLANDS_H
+#define CHSIMULATIONISLANDS_H
+
+//////////////////////////////////////////////////
+//
+//   ChSimulationIslands.h
+//
+//   Partitioning of bodies into simulation islands,
+//   i.e. groups of bodies that interact through
+//   links or contacts.
+//
+//   HEADER file for CHRONO,
+//	 Multibody dynamics engine
+//
+///////////////////////////////////////////////////
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "core/ChApiCE.h"
+
+namespace chrono {
+
+class ChBody;
+class ChLink;
+
+///
+/// Class for partitioning a set of N items (usually the bodies of a ChSystem,
+/// referenced by their index 0..N-1) into disjoint 'simulation islands', i.e.
+/// groups of items that are connected, directly or indirectly, by links or
+/// contacts. Islands are used by the sleeping policy of ChSystem, so that all
+/// bodies of an island fall asleep and wake up together.
+///
+/// This is a concurrent union-find (disjoint sets) structure: Union() and Find()
+/// are lock-free and can be called from multiple threads at the same time, for
+/// example inside an OpenMP parallel loop over links or contacts.
+///
+
+class ChApi ChSimulationIslands {
+  public:
+    ChSimulationIslands() : num_allocated(0), num_items(0), num_islands(0) {}
+
+    /// Reset the structure to N items, each one being an island by itself.
+    void Reset(int nitems);
+
+    /// Merge the islands containing items A and B. Thread safe.
+    void Union(int itemA, int itemB);
+
+    /// Return the representative item of the island containing the given item.
+    /// Thread safe; also compresses the path towards the representative.
+    int Find(int item);
+
+    /// Assign a compact island index (in range 0..GetNumIslands()-1) to all
+    /// items. Must be called, from a single thread, after all Union() calls
+    /// and before using GetIsland(). Returns the number of islands.
+    int Finalize();
+
+    /// Get the index of the island that contains the given item.
+    /// Valid only after Finalize() has been called.
+    int GetIsland(int item) const { return island[item]; }
+
+    /// Get the number of items in the structure.
+    int GetNumItems() const { return num_items; }
+
+    /// Get the number of islands, as computed by the last Finalize().
+    int GetNumIslands() const { return num_islands; }
+
+    //
+    // SLEEPING POLICY
+    //
+    // Shared by ChSystem and the systems derived from it. The first items are
+    // the bodies of the given list, by index; more items may follow (e.g. the
+    // particles of a parallel system), which never sleep.
+
+    /// Merge the islands of the bodies connected by the given links. Links that
+    /// are not active or do not require waking are skipped, and fixed bodies do
+    /// not connect islands. Thread safe with respect to other Union() calls.
+    void UnionLinks(const std::vector<std::shared_ptr<ChBody> >& bodies,
+                    const std::vector<std::shared_ptr<ChLink> >& links);
+
+    /// Merge the islands of the bodies that fell asleep together (same sleeping
+    /// group): contacts between sleeping bodies are usually not stored, so this
+    /// keeps them in one island. Bodies waken from outside since the last
+    /// UpdateSleeping() still have their tag, so that their group is waken too.
+    void UnionSleepingGroups(const std::vector<std::shared_ptr<ChBody> >& bodies);
+
+    /// Call Finalize(), then put to sleep or wake up whole islands: an island is
+    /// awake if at least one of its items is an awake body that is not a sleep
+    /// candidate (see ChBody::TrySleeping), or an item after the bodies. Sleeping
+    /// bodies are tagged with the index of their island.
+    /// Returns the number of bodies whose state changed.
+    int UpdateSleeping(const std::vector<std::shared_ptr<ChBody> >& bodies);
+
+    /// Deactivate the links whose bodies are all sleeping or fixed, and activate
+    /// the others. Returns the number of links whose state changed.
+    static int UpdateSleepingLinks(const std::vector<std::shared_ptr<ChLink> >& links);
+
+  private:
+    std::unique_ptr<std::atomic<int>[]> parent;
+    std::vector<int> island;
+    int num_allocated;
+    int num_items;
+    int num_islands;
+};
+
+}  // END_OF_NAMESPACE____
+
+#endif
@@ -36,6 +36,7 @@
 #include "lcp/ChLcpIterativeBB.h"
 #include "lcp/ChLcpIterativePCG.h"
 #include "lcp/ChLcpIterativeAPGD.h"
+#include "lcp/ChLcpIterativeAPGDfused.h"
 #include "parallel/ChOpenMP.h"
 
 #include "core/ChTimer.h"
@@ -255,6 +256,7 @@ ChSystem::ChSystem(unsigned int max_objects, double scene_size, bool init_sys) {
     }
 
     use_sleeping = false;
+    collision_detection = true;
 
     collisionpoint_callback = 0;
 
@@ -339,6 +341,7 @@ void ChSystem::Copy(ChSystem* source) {
     SetLcpSolverType(GetLcpSolverType());
     parallel_thread_number = source->parallel_thread_number;
     use_sleeping = source->use_sleeping;
+    collision_detection = source->collision_detection;
 
     ncontacts = source->ncontacts;
 
@@ -442,6 +445,10 @@ void ChSystem::SetLcpSolverType(eCh_lcpSolver mval) {
             LCP_solver_speed = new ChLcpIterativeMINRES();
             LCP_solver_stab = new ChLcpIterativeMINRES();
             break;
+        case LCP_ITERATIVE_APGD_FUSED:
+            LCP_solver_speed = new ChLcpIterativeAPGDfused();
+            LCP_solver_stab = new ChLcpIterativeAPGDfused();
+            break;
         default:
             LCP_solver_speed = new ChLcpIterativeSymmSOR();
             LCP_solver_stab = new ChLcpIterativeSymmSOR();
@@ -696,6 +703,32 @@ int ChSystem::ExecuteControlsFor3DStep() {
 // HIERARCHY HANDLERS
 //
 
+void ChSystem::AddBodies(const std::vector<std::shared_ptr<ChBody> >& newbodies) {
+    bodylist.reserve(bodylist.size() + newbodies.size());
+    for (size_t i = 0; i < newbodies.size(); ++i) {
+        assert(newbodies[i]->GetSystem() == 0);  // should remove from other system before adding here
+        bodylist.push_back(newbodies[i]);
+    }
+
+    AttachBodies(newbodies);
+}
+
+void ChSystem::AttachBodies(const std::vector<std::shared_ptr<ChBody> >& newbodies) {
+    std::vector<collision::ChCollisionModel*> models;
+    models.reserve(newbodies.size());
+    for (size_t i = 0; i < newbodies.size(); ++i) {
+        if (newbodies[i]->GetCollide())
+            models.push_back(newbodies[i]->GetCollisionModel());
+    }
+
+    // Let the collision engine allocate once for the whole batch, then attach
+    // the bodies one by one through the (virtual) SetSystem(), which also adds
+    // their collision models.
+    collision_system->ReserveModels(models);
+    for (size_t i = 0; i < newbodies.size(); ++i)
+        newbodies[i]->SetSystem(this);
+}
+
 void ChSystem::AddProbe(std::shared_ptr<ChProbe>& newprobe) {
     assert(std::find<std::vector<std::shared_ptr<ChProbe> >::iterator>(probelist.begin(), probelist.end(), newprobe) ==
            probelist.end());
@@ -820,24 +853,43 @@ bool ChSystem::ManageSleepingBodies() {
     if (!this->GetUseSleeping())
         return 0;
 
+    int nbodies_all = (int)bodylist.size();
+
     // STEP 1: 
-    // See if some body could change from no sleep-> sleep
+    // See if some body could change from no sleep-> sleep.
+    // Also number the bodies, so that islands can reference them by index.
 
-    for (int ip = 0; ip < bodylist.size(); ++ip)  {
+#pragma omp parallel for
+    for (int ip = 0; ip < nbodies_all; ++ip)  {
+        bodylist[ip]->SetId(ip);
         // mark as 'could sleep' candidate
         bodylist[ip]->TrySleeping();
     }
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one, 
-    // if so, set to no sleep.
+    // Partition the bodies in islands, merging bodies that are connected by links
+    // or touching each other. Fixed bodies do not connect islands (otherwise all
+    // the bodies resting on the ground would end up in a single island).
+
+    islands.Reset(nbodies_all);
+
+    islands.UnionLinks(bodylist, linklist);
+
+    // Index of a body in the island structure, or -1 if not a (non-fixed) body of this system
+    auto island_item = [this, nbodies_all](ChBody* mbody) -> int {
+        if (!mbody || mbody->GetBodyFixed())
+            return -1;
+        int id = (int)mbody->GetId();
+        if (id >= nbodies_all || this->bodylist[id].get() != mbody)
+            return -1;
+        return id;
+    };
 
-    // Make this class for iterating through contacts 
+    // Make this class for collecting the pairs of bodies in contact
 
-    class _wakeup_reporter_class : public ChReportContactCallback2 {
+    class _island_reporter_class : public ChReportContactCallback2 {
       public:
         /// Callback, used to report contact points already added to the container.
-        /// This must be implemented by a child class of ChReportContactCallback.
         /// If returns false, the contact scanning will be stopped.
         virtual bool ReportContactCallback2(
             const ChVector<>& pA,             ///< get contact pA
@@ -851,100 +903,44 @@ bool ChSystem::ManageSleepingBodies() {
             ) {
             if (!(contactobjA && contactobjB))
                 return true;
-            ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
-            ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(BF_COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(BF_COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2||could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1||could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2||could_sleep2) && !ground2) {
-                b1->BFlagSet(BF_COULDSLEEP,false);
-            }
-            if (could_sleep2 && !(sleep1||could_sleep1) && !ground1) {
-                b2->BFlagSet(BF_COULDSLEEP,false);
-            }
-            this->someone_sleeps = sleep1 | sleep2 | this->someone_sleeps;
-
+            pairs.push_back(std::make_pair(dynamic_cast<ChBody*>(contactobjA), dynamic_cast<ChBody*>(contactobjB)));
             return true;  // to continue scanning contacts
         }
 
         // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
+        std::vector<std::pair<ChBody*, ChBody*> > pairs;
     };
 
-    _wakeup_reporter_class my_waker;
-    my_waker.need_Setup_A=false;
+    _island_reporter_class my_reporter;
+    this->contact_container->ReportAllContacts2(&my_reporter);
 
-    bool need_Setup_L = false;
-
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker.someone_sleeps = false;
+    int npairs = (int)my_reporter.pairs.size();
+#pragma omp parallel for
+    for (int ic = 0; ic < npairs; ++ic)  {
+        int i1 = island_item(my_reporter.pairs[ic].first);
+        int i2 = island_item(my_reporter.pairs[ic].second);
+        if (i1 >= 0 && i2 >= 0)
+            islands.Union(i1, i2);
+    }
 
-        // scan all links and wake connected bodies
-        for (unsigned int ip = 0; ip < linklist.size(); ++ip)  // ITERATE on links
-        {
-            std::shared_ptr<ChLink> Lpointer = linklist[ip];
-
-            if (Lpointer->IsRequiringWaking()) {
-                ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                if (b1&&b2) {
-                    bool sleep1 = b1->GetSleeping();
-                    bool sleep2 = b2->GetSleeping();
-                    bool could_sleep1 = b1->BFlagGet(BF_COULDSLEEP);
-                    bool could_sleep2 = b2->BFlagGet(BF_COULDSLEEP);
-                    if (sleep1 && !(sleep2||could_sleep2)) {
-                        b1->SetSleeping(false);
-                        need_Setup_L = true;
-                    }
-                    if (sleep2 && !(sleep1||could_sleep1)) {
-                        b2->SetSleeping(false);
-                        need_Setup_L = true;
-                    }
-                    if (could_sleep1 && !(sleep2||could_sleep2)) {
-                        b1->BFlagSet(BF_COULDSLEEP,false);
-                    }
-                    if (could_sleep2 && !(sleep1||could_sleep1)) {
-                        b2->BFlagSet(BF_COULDSLEEP,false);
-                    }
-                }
-            }
-        }
+    // Contacts between two sleeping bodies are not stored in the contact container,
+    // so the bodies that fell asleep together are kept in the same island through
+    // their group tag: if one of them must be waken, the whole group is waken.
 
-        // scan all contacts and wake neighbouring bodies
-        this->contact_container->ReportAllContacts2(&my_waker);
+    islands.UnionSleepingGroups(bodylist);
 
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker.someone_sleeps)
-            break;
-    }
+    // STEP 3:
+    // An island is awake if at least one of its bodies is neither sleeping
+    // nor a sleep candidate. This propagates the wake-up along chains and stacks.
+    // Put to sleep or wake up whole islands, then deactivate the links
+    // whose bodies are all sleeping (or fixed).
 
-    /// If some body still must change from no sleep-> sleep, do it
-    int need_Setup_B = 0;
-    for (int ip = 0; ip < bodylist.size(); ++ip)  {
-        if (bodylist[ip]->BFlagGet(BF_COULDSLEEP)) {
-            bodylist[ip]->SetSleeping(true);
-            ++need_Setup_B;
-        }
-    }
+    int nchanged = islands.UpdateSleeping(bodylist);
+    nchanged += ChSimulationIslands::UpdateSleepingLinks(linklist);
 
     // if some body has been activated/deactivated because of sleep state changes, 
     // the offsets and DOF counts must be updated:
-    if (my_waker.need_Setup_A || need_Setup_B || need_Setup_L) {
+    if (nchanged) {
         this->Setup();
         return true;
     }
@@ -1789,6 +1785,10 @@ class SystemAddCollisionPointCallback : public ChAddContactCallback {
 double ChSystem::ComputeCollisions() {
     double mretC = 0.0;
 
+    // Keep the current contacts.
+    if (!collision_detection)
+        return mretC;
+
     timer_collision_broad.start();
 
     // Update all positions of collision models: delegate this to the ChAssembly
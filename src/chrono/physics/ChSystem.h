@@ -39,6 +39,7 @@
 #include "physics/ChScriptEngine.h"
 #include "physics/ChGlobal.h"
 #include "physics/ChContactContainerBase.h"
+#include "physics/ChSimulationIslands.h"
 #include "collision/ChCCollisionSystem.h"
 #include "timestepper/ChIntegrable.h"
 #include "timestepper/ChTimestepper.h"
@@ -243,6 +244,7 @@ class ChApi ChSystem : public ChAssembly,
         LCP_DEM,
         LCP_ITERATIVE_MINRES,
         LCP_CUSTOM,
+        LCP_ITERATIVE_APGD_FUSED,
     };
     CH_ENUM_MAPPER_BEGIN(eCh_lcpSolver);
       CH_ENUM_VAL(LCP_ITERATIVE_SOR);
@@ -257,6 +259,7 @@ class ChApi ChSystem : public ChAssembly,
       CH_ENUM_VAL(LCP_DEM);
       CH_ENUM_VAL(LCP_ITERATIVE_MINRES);
       CH_ENUM_VAL(LCP_CUSTOM);
+      CH_ENUM_VAL(LCP_ITERATIVE_APGD_FUSED);
     CH_ENUM_MAPPER_END(eCh_lcpSolver);
 
     /// Choose the LCP solver type, to be used for the simultaneous
@@ -379,6 +382,11 @@ class ChApi ChSystem : public ChAssembly,
     /// ChSystem.  Note that the body is *not* attached to this system.
     virtual ChBody* NewBody() { return new ChBody(ChMaterialSurfaceBase::DVI); }
 
+    /// Attach a batch of bodies to this system. The body list is grown only
+    /// once and the collision models of all bodies are passed to the collision
+    /// system with a single call.
+    virtual void AddBodies(const std::vector<std::shared_ptr<ChBody> >& newbodies) override;
+
     /// Attach a probe to this system.
     void AddProbe(std::shared_ptr<ChProbe>& newprobe);
     /// Attach a control to this system.
@@ -439,6 +447,13 @@ class ChApi ChSystem : public ChAssembly,
     ChEvents* Get_events() { return events; }
 
   protected:
+    /// Set this system as the owner of the given bodies, which also adds the
+    /// collision models of the colliding ones to the collision system. The
+    /// collision system is told the size of the batch beforehand, so that it
+    /// can allocate only once. The bodies must be already in the body list.
+    /// Used by AddBodies().
+    void AttachBodies(const std::vector<std::shared_ptr<ChBody> >& newbodies);
+
     //
     // LCP SOLVER
     //
@@ -763,6 +778,15 @@ public:
     /// client ChSystem object).
     collision::ChCollisionSystem* GetCollisionSystem() { return collision_system; };
 
+    /// Enable or disable the collision detection at each time step (default: enabled).
+    /// While disabled, the contacts found by the last collision detection are kept
+    /// and used again. This is a cheap approximation over a few steps, e.g. to
+    /// absorb a spike in the cost of a step in real-time simulations.
+    void SetCollisionDetection(bool val) { collision_detection = val; }
+
+    /// Tell if the collision detection is performed at each time step.
+    bool GetCollisionDetection() const { return collision_detection; }
+
     /// Turn on this feature to let the system put to sleep the bodies whose
     /// motion has almost come to a rest. This feature will allow faster simulation
     /// of large scenarios for real-time purposes, but it will affect the precision!
@@ -772,9 +796,17 @@ public:
     /// Tell if the system will put to sleep the bodies whose motion has almost come to a rest.
     bool GetUseSleeping() { return use_sleeping; }
 
+    /// Get the number of simulation islands found at the last step, i.e. groups of
+    /// bodies connected by links or contacts, that fall asleep and wake up together.
+    /// Only computed if sleeping is enabled with SetUseSleeping(true).
+    int GetNumIslands() { return islands.GetNumIslands(); }
+
   private:
 
     /// Put bodies to sleep if possible. Also awakens sleeping bodies, if needed.
+    /// Bodies are grouped in simulation islands (through links and contacts):
+    /// an island is put to sleep only if all its bodies are at rest, and it is
+    /// awaken as a whole if any of its bodies is moving.
     /// Returns true if some body changed from sleep to no sleep or viceversa, 
     /// returns false if nothing changed. In the former case, also performs Setup() 
     /// because the sleeping policy changed the totalDOFs and offsets.
@@ -959,9 +991,13 @@ public:
 
     int maxiter;       // max iterations for nonlinear convergence in DoAssembly()
 
+    bool collision_detection;  // if false, the contacts of the last collision detection are used again
+
     bool use_sleeping;   // if true, can put to sleep objects that come to rest, to speed up simulation (but decreasing
                          // the precision)
 
+    ChSimulationIslands islands;  // partition of bodies in islands, used by the sleeping policy
+
     eCh_integrationType integration_type;  // integration scheme
 
     ChLcpSystemDescriptor* LCP_descriptor;  // the LCP system descriptor
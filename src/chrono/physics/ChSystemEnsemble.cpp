@@ -0,0 +1,87 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#include <exception>
+#include <sstream>
+
+#include "physics/ChSystemEnsemble.h"
+#include "parallel/ChOpenMP.h"
+
+namespace chrono {
+
+// Task that advances a system by a number of fixed steps.
+class ChEnsembleStepTask : public ChSystemEnsemble::Task {
+  public:
+    ChEnsembleStepTask(double mstep, int mnum_steps) : step(mstep), num_steps(mnum_steps) {}
+    virtual void Run(ChSystem& system, int index) {
+        for (int i = 0; i < num_steps; i++)
+            system.DoStepDynamics(step);
+    }
+
+  private:
+    double step;
+    int num_steps;
+};
+
+// Task that advances a system up to a given time.
+class ChEnsembleFrameTask : public ChSystemEnsemble::Task {
+  public:
+    ChEnsembleFrameTask(double mend_time) : end_time(mend_time) {}
+    virtual void Run(ChSystem& system, int index) { system.DoFrameDynamics(end_time); }
+
+  private:
+    double end_time;
+};
+
+ChSystemEnsemble::ChSystemEnsemble() {
+    num_threads = CHOMPfunctions::GetNumProcs();
+}
+
+void ChSystemEnsemble::Run(Task& task) {
+    int nsystems = (int)systems.size();
+
+    // Exceptions cannot leave the parallel loop: keep the message of each failed system.
+    std::vector<std::string> errors(nsystems);
+    std::vector<char> failed(nsystems, 0);
+
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 1)
+    for (int i = 0; i < nsystems; i++) {
+        try {
+            task.Run(*systems[i], i);
+        } catch (std::exception& e) {
+            errors[i] = e.what();
+            failed[i] = 1;
+        } catch (...) {
+            errors[i] = "unknown exception";
+            failed[i] = 1;
+        }
+    }
+
+    for (int i = 0; i < nsystems; i++) {
+        if (failed[i]) {
+            std::ostringstream msg;
+            msg << "System " << i << " of the ensemble failed: " << errors[i];
+            throw ChException(msg.str());
+        }
+    }
+}
+
+void ChSystemEnsemble::DoStepDynamics(double step, int num_steps) {
+    ChEnsembleStepTask task(step, num_steps);
+    Run(task);
+}
+
+void ChSystemEnsemble::DoFrameDynamics(double end_time) {
+    ChEnsembleFrameTask task(end_time);
+    Run(task);
+}
+
+}  // END_OF_NAMESPACE____
@@ -0,0 +1,95 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#ifndef CHSYSTEMENSEMBLE_H
+#define CHSYSTEMENSEMBLE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "physics/ChSystem.h"
+
+namespace chrono {
+
+///
+/// Class for running many independent ChSystem objects concurrently, in the
+/// threads of one process (for example the cases of a parameter sweep or of
+/// a Monte Carlo analysis).
+///
+/// Systems are assigned to the threads dynamically, one at a time, so that
+/// threads that finish their systems early take the remaining ones. Each
+/// system is simulated by a single thread: the multithreaded parts of the
+/// systems (OpenMP loops, collision detection) run serially inside the
+/// ensemble, unless nested OpenMP parallelism is enabled.
+///
+/// Systems must not share bodies, links or other items. Data that is only
+/// read (meshes, curves, functions, materials) can be shared.
+///
+
+class ChApi ChSystemEnsemble {
+  public:
+    /// Base class for the work done on each system, see Run().
+    class ChApi Task {
+      public:
+        virtual ~Task() {}
+
+        /// Process the system with the given index in the ensemble. This is
+        /// called concurrently for different systems, so it must not modify
+        /// data shared between them.
+        virtual void Run(ChSystem& system, int index) = 0;
+    };
+
+    /// Create an empty ensemble, using as many threads as processors.
+    ChSystemEnsemble();
+
+    ~ChSystemEnsemble() {}
+
+    /// Add a system to the ensemble.
+    void AddSystem(std::shared_ptr<ChSystem> msystem) { systems.push_back(msystem); }
+
+    /// Remove all systems from the ensemble.
+    void RemoveAllSystems() { systems.clear(); }
+
+    /// Get the number of systems in the ensemble.
+    int GetNumSystems() const { return (int)systems.size(); }
+
+    /// Get the i-th system of the ensemble.
+    std::shared_ptr<ChSystem> GetSystem(int i) const { return systems[i]; }
+
+    /// Set the number of threads used to run the systems.
+    void SetNumThreads(int mthreads) { num_threads = (mthreads < 1) ? 1 : mthreads; }
+
+    /// Get the number of threads used to run the systems.
+    int GetNumThreads() const { return num_threads; }
+
+    /// Call task.Run() for all the systems of the ensemble, concurrently.
+    /// If the task throws an exception for some system, the other systems are
+    /// processed anyway, then a ChException is thrown with the message of the
+    /// exception of the first such system.
+    void Run(Task& task);
+
+    /// Advance all systems by the given number of steps, of size 'step',
+    /// with ChSystem::DoStepDynamics().
+    void DoStepDynamics(double step, int num_steps = 1);
+
+    /// Advance all systems up to the time 'end_time', with
+    /// ChSystem::DoFrameDynamics().
+    void DoFrameDynamics(double end_time);
+
+  private:
+    std::vector<std::shared_ptr<ChSystem> > systems;
+    int num_threads;
+};
+
+}  // END_OF_NAMESPACE____
+
+#endif
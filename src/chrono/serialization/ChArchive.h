@@ -392,6 +392,37 @@ public:
         } }; 
 
 
+
+///
+/// Trait for the types whose arrays can be serialized as contiguous blocks
+/// of numbers, see ChArchiveOut::out_array_bulk(). In specializations,
+/// 'scalar' is the type of the numbers, 'components' is the amount of numbers
+/// in each element, and 'version' is the version that ArchiveOUT() of the
+/// element writes before its numbers (0 if none).
+/// Plain numbers are enabled here; ChVector enables itself in ChVector.h.
+///
+
+template <class T>
+struct ChArchiveBulk {
+    static const bool value = false;
+};
+
+#define CH_ARCHIVE_BULK_NUMBER(__type) \
+    template <> \
+    struct ChArchiveBulk< __type > { \
+        static const bool value = true; \
+        typedef __type scalar; \
+        static const int components = 1; \
+        static const int version = 0; \
+    };
+
+CH_ARCHIVE_BULK_NUMBER(double)
+CH_ARCHIVE_BULK_NUMBER(float)
+CH_ARCHIVE_BULK_NUMBER(int)
+CH_ARCHIVE_BULK_NUMBER(unsigned int)
+
+
+
 ///
 /// This is a base class for archives with pointers to shared objects 
 ///
@@ -506,9 +537,40 @@ class  ChArchiveOut : public ChArchive {
       virtual void out_array_between (size_t msize, const char* classname) = 0;
       virtual void out_array_end (size_t msize,const char* classname) = 0;
 
+        // for contiguous arrays of numbers, between out_array_pre() and out_array_end():
+        // write 'msize' elements of 'ncomponents' numbers each, preceded each by the
+        // 'version' number if not 0. Return false if the archive does not support this,
+        // and the caller will write the elements one by one instead.
+      virtual bool out_array_bulk (const double* data, size_t msize, int ncomponents, int version) {return false;}
+      virtual bool out_array_bulk (const float* data, size_t msize, int ncomponents, int version) {return false;}
+      virtual bool out_array_bulk (const int* data, size_t msize, int ncomponents, int version) {return false;}
+      virtual bool out_array_bulk (const unsigned int* data, size_t msize, int ncomponents, int version) {return false;}
+
 
       //---------------------------------------------------
 
+        // write the elements of a contiguous array in a single block, if both the archive
+        // and the type T support this (see ChArchiveBulk); return false otherwise.
+      template<class T>
+      typename enable_if< ChArchiveBulk<T>::value, bool >::type
+      out_array_data (const T* data, size_t msize) {
+          return this->out_array_bulk((const typename ChArchiveBulk<T>::scalar*)data, msize,
+                                      ChArchiveBulk<T>::components,
+                                      use_versions ? ChArchiveBulk<T>::version : 0);
+      }
+      template<class T>
+      typename enable_if< !ChArchiveBulk<T>::value, bool >::type
+      out_array_data (const T* data, size_t msize) {
+          return false;
+      }
+      template<class T>
+      bool out_array_data (const std::vector<T>& mvect) {
+          return this->out_array_data(mvect.data(), mvect.size());
+      }
+      bool out_array_data (const std::vector<bool>& mvect) {
+          return false;
+      }
+
            // trick to wrap enum mappers:
       template<class T>
       void out     (ChNameValue< ChEnumMapper<T> > bVal) {
@@ -536,13 +598,15 @@ class  ChArchiveOut : public ChArchive {
       template<class T>
       void out     (ChNameValue< std::vector<T> > bVal) {
           this->out_array_pre(bVal.name(), bVal.value().size(), typeid(T).name());
-          for (size_t i = 0; i<bVal.value().size(); ++i)
-          {
-              char buffer[20];
-              sprintf(buffer, "el_%lu", (unsigned long)i);
-              ChNameValue< T > array_val(buffer, bVal.value()[i]);
-              this->out (array_val);
-              this->out_array_between(bVal.value().size(), typeid(bVal.value()).name());
+          if (!this->out_array_data(bVal.value())) {
+              for (size_t i = 0; i<bVal.value().size(); ++i)
+              {
+                  char buffer[20];
+                  sprintf(buffer, "el_%lu", (unsigned long)i);
+                  ChNameValue< T > array_val(buffer, bVal.value()[i]);
+                  this->out (array_val);
+                  this->out_array_between(bVal.value().size(), typeid(bVal.value()).name());
+              }
           }
           this->out_array_end(bVal.value().size(), typeid(bVal.value()).name());
       }
@@ -727,8 +791,38 @@ class  ChArchiveIn : public ChArchive {
       virtual void in_array_between (const char* name) = 0;
       virtual void in_array_end (const char* name) = 0;
 
+        // for contiguous arrays of numbers, between in_array_pre() and in_array_end():
+        // read what was written by ChArchiveOut::out_array_bulk(). Return false if the
+        // archive does not support this, and the caller will read the elements one by one.
+      virtual bool in_array_bulk (double* data, size_t msize, int ncomponents, int version) {return false;}
+      virtual bool in_array_bulk (float* data, size_t msize, int ncomponents, int version) {return false;}
+      virtual bool in_array_bulk (int* data, size_t msize, int ncomponents, int version) {return false;}
+      virtual bool in_array_bulk (unsigned int* data, size_t msize, int ncomponents, int version) {return false;}
+
       //---------------------------------------------------
 
+        // read the elements of a contiguous array in a single block, if both the archive
+        // and the type T support this (see ChArchiveBulk); return false otherwise.
+      template<class T>
+      typename enable_if< ChArchiveBulk<T>::value, bool >::type
+      in_array_data (T* data, size_t msize) {
+          return this->in_array_bulk((typename ChArchiveBulk<T>::scalar*)data, msize,
+                                     ChArchiveBulk<T>::components,
+                                     use_versions ? ChArchiveBulk<T>::version : 0);
+      }
+      template<class T>
+      typename enable_if< !ChArchiveBulk<T>::value, bool >::type
+      in_array_data (T* data, size_t msize) {
+          return false;
+      }
+      template<class T>
+      bool in_array_data (std::vector<T>& mvect) {
+          return this->in_array_data(mvect.data(), mvect.size());
+      }
+      bool in_array_data (std::vector<bool>& mvect) {
+          return false;
+      }
+
            // trick to wrap enum mappers:
       template<class T>
       void in     (ChNameValue< ChEnumMapper<T> > bVal) {
@@ -762,15 +856,17 @@ class  ChArchiveIn : public ChArchive {
           size_t arraysize;
           this->in_array_pre(bVal.name(), arraysize);
           bVal.value().resize(arraysize);
-          for (size_t i = 0; i<arraysize; ++i)
-          {
-              char idname[20];
-              sprintf(idname, "el_%lu", (unsigned long)i);
-              T element;
-              ChNameValue< T > array_val(idname, element);
-              this->in (array_val);
-              bVal.value()[i]=element;
-              this->in_array_between(bVal.name());
+          if (!this->in_array_data(bVal.value())) {
+              for (size_t i = 0; i<arraysize; ++i)
+              {
+                  char idname[20];
+                  sprintf(idname, "el_%lu", (unsigned long)i);
+                  T element;
+                  ChNameValue< T > array_val(idname, element);
+                  this->in (array_val);
+                  bVal.value()[i]=element;
+                  this->in_array_between(bVal.name());
+              }
           }
           this->in_array_end(bVal.name());
       }
@@ -14,6 +14,9 @@
 #define CHARCHIVEBINARY_H
 
 
+#include <algorithm>
+#include <cstring>
+
 #include "serialization/ChArchive.h"
 #include "core/ChLog.h"
 
@@ -75,6 +78,25 @@ class  ChArchiveOutBinary : public ChArchiveOut {
       virtual void out_array_between (size_t msize, const char* classname) {}
       virtual void out_array_end (size_t msize,const char* classname) {}
 
+        // contiguous arrays of numbers are written with one stream output, with
+        // the same bytes that element-by-element serialization would produce.
+      virtual bool out_array_bulk (const double* data, size_t msize, int ncomponents, int version) {
+            out_block(data, msize, ncomponents, version);
+            return true;
+      }
+      virtual bool out_array_bulk (const float* data, size_t msize, int ncomponents, int version) {
+            out_block(data, msize, ncomponents, version);
+            return true;
+      }
+      virtual bool out_array_bulk (const int* data, size_t msize, int ncomponents, int version) {
+            out_block(data, msize, ncomponents, version);
+            return true;
+      }
+      virtual bool out_array_bulk (const unsigned int* data, size_t msize, int ncomponents, int version) {
+            out_block(data, msize, ncomponents, version);
+            return true;
+      }
+
 
         // for custom c++ objects:
       virtual void out     (ChNameValue<ChFunctorArchiveOut> bVal, const char* classname, bool tracked, size_t position) {
@@ -113,6 +135,39 @@ class  ChArchiveOutBinary : public ChArchiveOut {
       }
 
   protected:
+
+      template <class T>
+      void out_block(const T* data, size_t msize, int ncomponents, int version) {
+          if (!version) {
+              ostream->BlockOutput(data, msize * ncomponents);
+              return;
+          }
+          // each element is preceded by its version number: interleave them
+          // in a buffer, written in chunks to bound the memory overhead.
+          const size_t chunk = 4096;
+          std::vector<char> buffer;
+          for (size_t start = 0; start < msize; start += chunk) {
+              size_t nelements = std::min(chunk, msize - start);
+              size_t n = 0;
+              buffer.resize(nelements * (sizeof(int) + ncomponents * sizeof(T)));
+              for (size_t i = start; i < start + nelements; ++i) {
+                  memcpy(&buffer[n], &version, sizeof(int));
+                  n += sizeof(int);
+                  memcpy(&buffer[n], &data[i * ncomponents], ncomponents * sizeof(T));
+                  n += ncomponents * sizeof(T);
+              }
+              if (ostream->IsBigEndianMachine()) {
+                  for (n = 0; n < buffer.size();) {
+                      StreamSwapBytes<int>((int*)&buffer[n]);
+                      n += sizeof(int);
+                      for (int j = 0; j < ncomponents; ++j, n += sizeof(T))
+                          StreamSwapBytes<T>((T*)&buffer[n]);
+                  }
+              }
+              ostream->BlockOutput(&buffer[0], buffer.size());
+          }
+      }
+
       ChStreamOutBinary* ostream;
 };
 
@@ -172,6 +227,24 @@ class  ChArchiveInBinary : public ChArchiveIn {
       virtual void in_array_between (const char* name) {}
       virtual void in_array_end (const char* name) {}
 
+        // contiguous arrays of numbers are read with one stream input
+      virtual bool in_array_bulk (double* data, size_t msize, int ncomponents, int version) {
+            in_block(data, msize, ncomponents, version);
+            return true;
+      }
+      virtual bool in_array_bulk (float* data, size_t msize, int ncomponents, int version) {
+            in_block(data, msize, ncomponents, version);
+            return true;
+      }
+      virtual bool in_array_bulk (int* data, size_t msize, int ncomponents, int version) {
+            in_block(data, msize, ncomponents, version);
+            return true;
+      }
+      virtual bool in_array_bulk (unsigned int* data, size_t msize, int ncomponents, int version) {
+            in_block(data, msize, ncomponents, version);
+            return true;
+      }
+
         //  for custom c++ objects:
       virtual void in     (ChNameValue<ChFunctorArchiveIn> bVal) {
           if (bVal.flags() & NVP_TRACK_OBJECT){
@@ -234,6 +307,35 @@ class  ChArchiveInBinary : public ChArchiveIn {
       }
 
   protected:
+
+      template <class T>
+      void in_block(T* data, size_t msize, int ncomponents, int version) {
+          if (!version) {
+              istream->BlockInput(data, msize * ncomponents);
+              return;
+          }
+          // skip the version number before each element (as ArchiveIN() of
+          // the elements would do)
+          const size_t chunk = 4096;
+          std::vector<char> buffer;
+          bool swap = istream->IsBigEndianMachine();
+          for (size_t start = 0; start < msize; start += chunk) {
+              size_t nelements = std::min(chunk, msize - start);
+              size_t n = 0;
+              buffer.resize(nelements * (sizeof(int) + ncomponents * sizeof(T)));
+              istream->BlockInput(&buffer[0], buffer.size());
+              for (size_t i = start; i < start + nelements; ++i) {
+                  n += sizeof(int);
+                  memcpy(&data[i * ncomponents], &buffer[n], ncomponents * sizeof(T));
+                  n += ncomponents * sizeof(T);
+                  if (swap) {
+                      for (int j = 0; j < ncomponents; ++j)
+                          StreamSwapBytes<T>(&data[i * ncomponents + j]);
+                  }
+              }
+          }
+      }
+
       ChStreamInBinary* istream;
 };
 
@@ -0,0 +1,240 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Asynchronous output of body states.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "core/ChException.h"
+#include "core/ChTimer.h"
+
+#include "utils/ChUtilsAsyncOutput.h"
+#include "utils/ChUtilsInputOutput.h"
+
+namespace chrono {
+namespace utils {
+
+static const char binary_magic[4] = {'C', 'H', 'B', 'S'};
+
+// Write body states (7 or 13 values per body) to a CSV file, as utils::WriteBodies.
+static bool WriteCSV(const std::string& filename,
+                     const double* data,
+                     size_t num_bodies,
+                     int num_values,
+                     const std::string& delim) {
+    CSV_writer csv(delim);
+    for (size_t i = 0; i < num_bodies; i++) {
+        const double* values = data + i * num_values;
+        for (int j = 0; j < num_values; j++)
+            csv << values[j];
+        csv << std::endl;
+    }
+
+    std::ofstream ofile(filename.c_str());
+    if (!ofile)
+        return false;
+    ofile << csv.stream().str();
+    return ofile.good();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChAsyncBodyWriter::ChAsyncBodyWriter(int num_buffers, Backpressure policy, Format format, const std::string& delim)
+    : m_format(format),
+      m_delim(delim),
+      m_policy(policy),
+      m_num_busy(0),
+      m_stop(false),
+      m_num_failed(0),
+      m_num_written(0),
+      m_num_dropped(0),
+      m_wait_time(0) {
+    m_buffers.resize(std::max(num_buffers, 1));
+    for (int i = 0; i < (int)m_buffers.size(); i++)
+        m_free.push_back(i);
+
+    m_thread = std::thread(&ChAsyncBodyWriter::Run, this);
+}
+
+ChAsyncBodyWriter::~ChAsyncBodyWriter() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cond_queue.notify_all();
+    m_thread.join();
+}
+
+// -----------------------------------------------------------------------------
+// Get a free buffer (applying the backpressure policy), then copy the body
+// states outside of the lock.
+// -----------------------------------------------------------------------------
+bool ChAsyncBodyWriter::WriteBodies(ChSystem* system,
+                                    const std::string& filename,
+                                    bool active_only,
+                                    bool dump_vel) {
+    int index;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_free.empty()) {
+            if (m_policy == DROP_NEWEST) {
+                m_num_dropped++;
+                return false;
+            }
+            if (m_policy == DROP_OLDEST && !m_queue.empty()) {
+                m_free.push_back(m_queue.front());
+                m_queue.pop_front();
+                m_num_dropped++;
+            } else {
+                ChTimer<double> timer;
+                timer.start();
+                m_cond_free.wait(lock, [this] { return !m_free.empty(); });
+                timer.stop();
+                m_wait_time += timer();
+            }
+        }
+        index = m_free.front();
+        m_free.pop_front();
+    }
+
+    Snapshot& snapshot = m_buffers[index];
+    snapshot.filename = filename;
+    snapshot.num_values = dump_vel ? 13 : 7;
+
+    // The buffer keeps its capacity from one snapshot to the next.
+    std::vector<std::shared_ptr<ChBody> >& bodies = *system->Get_bodylist();
+    snapshot.data.resize(bodies.size() * snapshot.num_values);
+
+    double* values = snapshot.data.data();
+    for (size_t i = 0; i < bodies.size(); i++) {
+        ChBody* body = bodies[i].get();
+        if (active_only && !body->IsActive())
+            continue;
+        const ChVector<>& pos = body->GetPos();
+        const ChQuaternion<>& rot = body->GetRot();
+        *values++ = pos.x;
+        *values++ = pos.y;
+        *values++ = pos.z;
+        *values++ = rot.e0;
+        *values++ = rot.e1;
+        *values++ = rot.e2;
+        *values++ = rot.e3;
+        if (dump_vel) {
+            const ChVector<>& vel = body->GetPos_dt();
+            ChVector<> wvel = body->GetWvel_loc();
+            *values++ = vel.x;
+            *values++ = vel.y;
+            *values++ = vel.z;
+            *values++ = wvel.x;
+            *values++ = wvel.y;
+            *values++ = wvel.z;
+        }
+    }
+    snapshot.data.resize(values - snapshot.data.data());
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(index);
+    }
+    m_cond_queue.notify_one();
+
+    return true;
+}
+
+void ChAsyncBodyWriter::Flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond_free.wait(lock, [this] { return m_queue.empty() && m_num_busy == 0; });
+
+    if (m_num_failed > 0) {
+        m_num_failed = 0;
+        throw(ChException("Can't save body data into file"));
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Background thread. On stop, the queued snapshots are written before exiting.
+// -----------------------------------------------------------------------------
+void ChAsyncBodyWriter::Run() {
+    while (true) {
+        int index;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond_queue.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty())
+                return;
+            index = m_queue.front();
+            m_queue.pop_front();
+            m_num_busy = 1;
+        }
+
+        bool ok = WriteSnapshot(m_buffers[index]);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_num_busy = 0;
+            m_free.push_back(index);
+            if (ok)
+                m_num_written++;
+            else
+                m_num_failed++;
+        }
+        m_cond_free.notify_all();
+    }
+}
+
+bool ChAsyncBodyWriter::WriteSnapshot(const Snapshot& snapshot) const {
+    int num_bodies = (int)(snapshot.data.size() / snapshot.num_values);
+
+    if (m_format == CSV)
+        return WriteCSV(snapshot.filename, snapshot.data.data(), num_bodies, snapshot.num_values, m_delim);
+
+    std::ofstream ofile(snapshot.filename.c_str(), std::ios::binary);
+    if (!ofile)
+        return false;
+    ofile.write(binary_magic, sizeof(binary_magic));
+    ofile.write((const char*)&num_bodies, sizeof(int));
+    ofile.write((const char*)&snapshot.num_values, sizeof(int));
+    ofile.write((const char*)snapshot.data.data(), snapshot.data.size() * sizeof(double));
+    return ofile.good();
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChAsyncBodyWriter::ConvertBinaryToCSV(const std::string& binary_filename,
+                                           const std::string& csv_filename,
+                                           const std::string& delim) {
+    std::ifstream ifile(binary_filename.c_str(), std::ios::binary);
+    char magic[4];
+    int num_bodies = 0;
+    int num_values = 0;
+    ifile.read(magic, sizeof(magic));
+    ifile.read((char*)&num_bodies, sizeof(int));
+    ifile.read((char*)&num_values, sizeof(int));
+    if (!ifile || std::memcmp(magic, binary_magic, sizeof(magic)) != 0 || num_bodies < 0 ||
+        (num_values != 7 && num_values != 13))
+        throw(ChException("Not a binary body data file: " + binary_filename));
+
+    std::vector<double> data((size_t)num_bodies * num_values);
+    ifile.read((char*)data.data(), data.size() * sizeof(double));
+    if (!ifile)
+        throw(ChException("Can't read body data from file " + binary_filename));
+
+    if (!WriteCSV(csv_filename, data.data(), num_bodies, num_values, delim))
+        throw(ChException("Can't save body data into file " + csv_filename));
+}
+
+}  // namespace utils
+}  // namespace chrono
@@ -0,0 +1,136 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Asynchronous output of body states.
+//
+// ChAsyncBodyWriter
+//  the simulation thread copies the body states into one of a ring of
+//  preallocated buffers; a background thread formats them (CSV, same output as
+//  utils::WriteBodies) or writes them as compact binary files.
+//
+// =============================================================================
+
+#ifndef CH_UTILS_ASYNC_OUTPUT_H
+#define CH_UTILS_ASYNC_OUTPUT_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/ChApiCE.h"
+#include "physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+// -----------------------------------------------------------------------------
+// ChAsyncBodyWriter
+//
+// Output pipeline for body states. WriteBodies() only copies the position,
+// rotation and (optionally) velocities of the bodies into a free buffer and
+// returns; the files are written by a background thread, in the order of the
+// calls. If all buffers are in use, the backpressure policy decides whether
+// WriteBodies() waits for a free buffer or drops a snapshot.
+// -----------------------------------------------------------------------------
+class ChApi ChAsyncBodyWriter {
+  public:
+    /// Output file format.
+    enum Format {
+        CSV,    ///< same as utils::WriteBodies
+        BINARY  ///< header and raw doubles (see ConvertBinaryToCSV)
+    };
+
+    /// What to do when all buffers are in use.
+    enum Backpressure {
+        BLOCK,        ///< wait for a free buffer (no snapshot is lost)
+        DROP_NEWEST,  ///< drop the new snapshot
+        DROP_OLDEST   ///< replace the oldest snapshot not yet being written
+    };
+
+    /// Create the writer and start its background thread.
+    ChAsyncBodyWriter(int num_buffers = 4,               ///< number of snapshot buffers
+                      Backpressure policy = BLOCK,       ///< backpressure policy
+                      Format format = CSV,               ///< output file format
+                      const std::string& delim = ","     ///< delimiter for CSV output
+                      );
+
+    /// Write the pending snapshots and stop the background thread.
+    ~ChAsyncBodyWriter();
+
+    /// Copy the states of the bodies of the system and queue them for writing to
+    /// the specified file. The file contents are those of utils::WriteBodies.
+    /// Return false if the snapshot was dropped (DROP_NEWEST policy).
+    bool WriteBodies(ChSystem* system,
+                     const std::string& filename,
+                     bool active_only = false,
+                     bool dump_vel = false);
+
+    /// Wait until all queued snapshots are written.
+    /// Throws a ChException if some file could not be written since the last call.
+    void Flush();
+
+    /// Get the number of files written.
+    int GetNumWritten() const { return m_num_written; }
+
+    /// Get the number of snapshots dropped because of the backpressure policy.
+    int GetNumDropped() const { return m_num_dropped; }
+
+    /// Get the total time (in seconds) that WriteBodies() waited for a free buffer.
+    double GetWaitTime() const { return m_wait_time; }
+
+    /// Write a CSV file (same as utils::WriteBodies) from a binary file written
+    /// with the BINARY format.
+    static void ConvertBinaryToCSV(const std::string& binary_filename,
+                                   const std::string& csv_filename,
+                                   const std::string& delim = ",");
+
+  private:
+    struct Snapshot {
+        std::string filename;
+        int num_values;             ///< values per body (7, or 13 with velocities)
+        std::vector<double> data;   ///< values of all bodies, body after body
+    };
+
+    /// Background thread: write the queued snapshots until stopped.
+    void Run();
+
+    /// Write the file of the given snapshot; return false on failure.
+    bool WriteSnapshot(const Snapshot& snapshot) const;
+
+    Format m_format;
+    std::string m_delim;
+    Backpressure m_policy;
+
+    std::vector<Snapshot> m_buffers;
+    std::deque<int> m_free;    ///< buffers available for new snapshots
+    std::deque<int> m_queue;   ///< buffers waiting to be written, oldest first
+    int m_num_busy;            ///< buffers being written (0 or 1)
+    bool m_stop;
+    int m_num_failed;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond_queue;  ///< signaled when a snapshot is queued (or on stop)
+    std::condition_variable m_cond_free;   ///< signaled when a buffer is released
+    std::thread m_thread;
+
+    int m_num_written;
+    int m_num_dropped;
+    double m_wait_time;
+};
+
+}  // namespace utils
+}  // namespace chrono
+
+#endif
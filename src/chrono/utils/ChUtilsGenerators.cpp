@@ -487,8 +487,58 @@ ChVector<> Generator::calcMinSeparation(const ChVector<>& sep) {
     return res;
 }
 
+// Add the collision and visualization geometry of an object of given type and
+// size to the specified body.
+static void AddIngredientGeometry(ChBody* body, MixtureType type, const ChVector<>& size) {
+    body->GetCollisionModel()->ClearModel();
+
+    switch (type) {
+        case SPHERE:
+            AddSphereGeometry(body, size.x);
+            break;
+        case ELLIPSOID:
+            AddEllipsoidGeometry(body, size);
+            break;
+        case BOX:
+            AddBoxGeometry(body, size);
+            break;
+        case CYLINDER:
+            AddCylinderGeometry(body, size.x, size.y);
+            break;
+        case CONE:
+            AddConeGeometry(body, size.x, size.y);
+            break;
+        case CAPSULE:
+            AddCapsuleGeometry(body, size.x, size.y);
+            break;
+        case ROUNDEDCYLINDER:
+            AddRoundedCylinderGeometry(body, size.x, size.y, size.z);
+            break;
+    }
+
+    body->GetCollisionModel()->BuildModel();
+}
+
 // Create objects at the specified locations using the current mixture settings.
+// The geometry of ingredients with constant size is built only once, in a
+// prototype body, and its collision shapes and visualization assets are shared
+// by all the bodies created from that ingredient. All bodies are added to the
+// system with a single call.
 void Generator::createObjects(const PointVector& points, const ChVector<>& vel) {
+    // Prototype bodies, for the ingredients without a size distribution.
+    std::vector<std::shared_ptr<ChBody>> prototypes(m_mixture.size());
+    for (int i = 0; i < m_mixture.size(); i++) {
+        if (m_mixture[i]->m_sizeDist)
+            continue;
+        prototypes[i] = std::shared_ptr<ChBody>(m_system->NewBody());
+        AddIngredientGeometry(prototypes[i].get(), m_mixture[i]->m_type, m_mixture[i]->m_defSize);
+    }
+
+    std::vector<std::shared_ptr<ChBody>> bodies(points.size());
+    std::vector<int> indices(points.size());
+
+    m_bodies.reserve(m_bodies.size() + points.size());
+
     for (int i = 0; i < points.size(); i++) {
         // Select the type of object to be created.
         int index = selectIngredient();
@@ -530,46 +580,30 @@ void Generator::createObjects(const PointVector& points, const ChVector<>& vel)
         m_totalMass += mass;
         m_totalVolume += volume;
 
-        // Add collision geometry
-        body->GetCollisionModel()->ClearModel();
-
-        switch (m_mixture[index]->m_type) {
-            case SPHERE:
-                AddSphereGeometry(body, size.x);
-                break;
-            case ELLIPSOID:
-                AddEllipsoidGeometry(body, size);
-                break;
-            case BOX:
-                AddBoxGeometry(body, size);
-                break;
-            case CYLINDER:
-                AddCylinderGeometry(body, size.x, size.y);
-                break;
-            case CONE:
-                AddConeGeometry(body, size.x, size.y);
-                break;
-            case CAPSULE:
-                AddCapsuleGeometry(body, size.x, size.y);
-                break;
-            case ROUNDEDCYLINDER:
-                AddRoundedCylinderGeometry(body, size.x, size.y, size.z);
-                break;
+        // Add collision geometry, shared with the prototype if possible
+        if (prototypes[index]) {
+            body->GetCollisionModel()->ClearModel();
+            body->GetCollisionModel()->AddCopyOfAnotherModel(prototypes[index]->GetCollisionModel());
+            body->GetCollisionModel()->BuildModel();
+            body->GetAssets() = prototypes[index]->GetAssets();
+        } else {
+            AddIngredientGeometry(body, m_mixture[index]->m_type, size);
         }
 
-        body->GetCollisionModel()->BuildModel();
+        bodies[i] = std::shared_ptr<ChBody>(body);
+        indices[i] = index;
 
-        // Attach the body to the system and append to list of generated bodies.
-        std::shared_ptr<ChBody> bodyPtr(body);
+        m_bodies.push_back(BodyInfo(m_mixture[index]->m_type, density, size, bodies[i]));
+    }
 
-        m_system->AddBody(bodyPtr);
+    // Attach all bodies to the system.
+    m_system->AddBodies(bodies);
 
-        // If the callback pointer is set, call the function with the body pointer
-        if (m_mixture[index]->callback_post_creation) {
-            m_mixture[index]->callback_post_creation->PostCreation(bodyPtr);
+    // If the callback pointer is set, call the function with the body pointer
+    for (int i = 0; i < points.size(); i++) {
+        if (m_mixture[indices[i]]->callback_post_creation) {
+            m_mixture[indices[i]]->callback_post_creation->PostCreation(bodies[i]);
         }
-
-        m_bodies.push_back(BodyInfo(m_mixture[index]->m_type, density, size, bodyPtr));
     }
 
     m_totalNumBodies += points.size();
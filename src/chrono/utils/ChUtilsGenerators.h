@@ -150,6 +150,9 @@ class ChApi MixtureIngredient {
 //
 // This class encapsulates functionality for generating sets of bodies with
 // positions drawn from a specified sampler and various mixture properties.
+// Bodies created from an ingredient of constant size share the collision
+// shapes and visualization assets of a prototype body, and all the bodies of a
+// createObjects*() call are added to the system in one batch.
 // -----------------------------------------------------------------------------
 class ChApi Generator {
   public:
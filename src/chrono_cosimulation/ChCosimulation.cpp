@@ -11,6 +11,7 @@ ChCosimulation::ChCosimulation(ChSocketFramework& mframework,
                                ) {
     this->myServer = 0;
     this->myClient = 0;
+    this->myChannel = 0;
     this->in_n = n_in_values;
     this->out_n = n_out_values;
     this->nport = 0;
@@ -23,6 +24,9 @@ ChCosimulation::~ChCosimulation() {
     if (this->myClient)
         delete this->myClient;
     this->myClient = 0;
+    if (this->myChannel)
+        delete this->myChannel;
+    this->myChannel = 0;
 }
 
 bool ChCosimulation::WaitConnection(int aport) {
@@ -47,24 +51,46 @@ bool ChCosimulation::WaitConnection(int aport) {
     return true;
 }
 
+bool ChCosimulation::WaitConnectionSharedMemory(const std::string& name, int capacity) {
+    // a shared memory channel is created, with the C::E outputs in the
+    // server->client direction
+    this->myChannel = new ChSharedMemoryChannel;
+    this->myChannel->Create(name, this->out_n, this->in_n, capacity);
+
+    // wait for a client to open it (this might put the program in
+    // a long waiting state...)
+    this->myChannel->WaitClient();
+
+    return true;
+}
+
+void ChCosimulation::CheckConnected(const char* function) {
+    if (!myClient && !myChannel)
+        throw ChExceptionSocket(0, std::string("Error. Attempted '") + function + "' with no connected client.");
+}
+
 bool ChCosimulation::SendData(double mtime, ChMatrix<double>* out_data) {
     if (out_data->GetColumns() != 1)
         throw ChExceptionSocket(0, "Error. Sent data must be a matrix with 1 column");
     if (out_data->GetRows() != this->out_n)
         throw ChExceptionSocket(0, "Error. Sent data must be a matrix with N rows and 1 column");
-    if (!myClient)
-        throw ChExceptionSocket(0, "Error. Attempted 'SendData' with no connected client.");
+    CheckConnected("SendData");
 
-    std::vector<char> mbuffer;                     // now zero length
-    ChStreamOutBinaryVector stream_out(&mbuffer);  // wrap the buffer, for easy formatting
+    // Shared memory: values are written directly in the channel.
+    if (myChannel) {
+        myChannel->Send(1, &mtime, out_data->GetAddress());
+        return true;
+    }
+
+    out_buffer.clear();                               // now zero length, but keeps its capacity
+    ChStreamOutBinaryVector stream_out(&out_buffer);  // wrap the buffer, for easy formatting
 
     // Serialize datas (little endian)...
 
     // time:
     stream_out << mtime;
     // variables:
-    for (int i = 0; i < out_data->GetRows(); i++)
-        stream_out << out_data->Element(i, 0);
+    stream_out.BlockOutput(out_data->GetAddress(), out_data->GetRows());
 
     // -----> SEND!!!
     this->myClient->SendBuffer(*stream_out.GetVector());
@@ -77,25 +103,83 @@ bool ChCosimulation::ReceiveData(double& mtime, ChMatrix<double>* in_data) {
         throw ChExceptionSocket(0, "Error. Received data must be a matrix with 1 column");
     if (in_data->GetRows() != this->in_n)
         throw ChExceptionSocket(0, "Error. Received data must be a matrix with N rows and 1 column");
-    if (!myClient)
-        throw ChExceptionSocket(0, "Error. Attempted 'ReceiveData' with no connected client.");
+    CheckConnected("ReceiveData");
+
+    // Shared memory: values are read directly from the channel.
+    if (myChannel) {
+        myChannel->Receive(1, &mtime, in_data->GetAddress());
+        return true;
+    }
 
     // Receive from the client
     int nbytes = sizeof(double) * (this->in_n + 1);
-    std::vector<char> rbuffer;
-    rbuffer.resize(nbytes);                      // reserve to number of expected bytes
-    ChStreamInBinaryVector stream_in(&rbuffer);  // wrap the buffer, for easy formatting
+    ChStreamInBinaryVector stream_in(&in_buffer);  // wrap the buffer, for easy formatting
 
-    // -----> RECEIVE!!!
-    int numBytes = this->myClient->ReceiveBuffer(*stream_in.GetVector(), nbytes);
+    // -----> RECEIVE!!! (throws if fewer than nbytes arrive)
+    this->myClient->ReceiveBuffer(*stream_in.GetVector(), nbytes);
 
     // Deserialize datas (little endian)...
 
     // time:
     stream_in >> mtime;
     // variables:
-    for (int i = 0; i < in_data->GetRows(); i++)
-        stream_in >> in_data->Element(i, 0);
+    stream_in.BlockInput(in_data->GetAddress(), in_data->GetRows());
+
+    return true;
+}
+
+bool ChCosimulation::SendDataBatch(ChMatrix<double>* out_times, ChMatrix<double>* out_data) {
+    if (out_times->GetColumns() != 1)
+        throw ChExceptionSocket(0, "Error. Sent times must be a matrix with 1 column");
+    if (out_data->GetColumns() != this->out_n || out_data->GetRows() != out_times->GetRows())
+        throw ChExceptionSocket(0, "Error. Sent data must be a matrix with a row for each time, and N columns");
+    CheckConnected("SendDataBatch");
+
+    int nsteps = out_times->GetRows();
+
+    if (myChannel) {
+        myChannel->Send(nsteps, out_times->GetAddress(), out_data->GetAddress());
+        return true;
+    }
+
+    out_buffer.clear();
+    ChStreamOutBinaryVector stream_out(&out_buffer);
+
+    // Same data of a SendData() for each step, in a single message.
+    for (int i = 0; i < nsteps; i++) {
+        stream_out << out_times->Element(i, 0);
+        stream_out.BlockOutput(out_data->GetAddress() + i * this->out_n, this->out_n);
+    }
+
+    this->myClient->SendBuffer(*stream_out.GetVector());
+
+    return true;
+}
+
+bool ChCosimulation::ReceiveDataBatch(ChMatrix<double>* in_times, ChMatrix<double>* in_data) {
+    if (in_times->GetColumns() != 1)
+        throw ChExceptionSocket(0, "Error. Received times must be a matrix with 1 column");
+    if (in_data->GetColumns() != this->in_n || in_data->GetRows() != in_times->GetRows())
+        throw ChExceptionSocket(0, "Error. Received data must be a matrix with a row for each time, and N columns");
+    CheckConnected("ReceiveDataBatch");
+
+    int nsteps = in_times->GetRows();
+
+    if (myChannel) {
+        myChannel->Receive(nsteps, in_times->GetAddress(), in_data->GetAddress());
+        return true;
+    }
+
+    int nbytes = sizeof(double) * (this->in_n + 1) * nsteps;
+    ChStreamInBinaryVector stream_in(&in_buffer);
+
+    // Throws if fewer than nbytes arrive.
+    this->myClient->ReceiveBuffer(*stream_in.GetVector(), nbytes);
+
+    for (int i = 0; i < nsteps; i++) {
+        stream_in >> in_times->Element(i, 0);
+        stream_in.BlockInput(in_data->GetAddress() + i * this->in_n, this->in_n);
+    }
 
     return true;
 }
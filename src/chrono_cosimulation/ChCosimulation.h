@@ -15,6 +15,7 @@
 
 #include "chrono_cosimulation/ChSocketFramework.h"
 #include "chrono_cosimulation/ChSocket.h"
+#include "chrono_cosimulation/ChSharedMemoryChannel.h"
 #include "core/ChMatrix.h"
 
 namespace chrono {
@@ -30,6 +31,9 @@ namespace cosimul {
 /// back and forth.
 /// In this case, C::E will work as a server, waiting for
 /// a client to talk with.
+/// If the other software runs on the same host, a shared memory
+/// channel (see ChSharedMemoryChannel) can be used instead of the
+/// socket, with the same functions for exchanging data.
 
 class ChApiCosimulation ChCosimulation {
   public:
@@ -58,11 +62,36 @@ class ChApiCosimulation ChCosimulation {
     /// External time is also received as first value.
     bool ReceiveData(double& mtime, ChMatrix<double>* mdata);
 
+    /// Create a shared memory channel with the given name (for example
+    /// "/chrono_cosim") and wait until a client on the same host opens it.
+    /// After this, data is exchanged through the shared memory instead
+    /// of a TCP socket. The client can buffer up to 'capacity' time steps
+    /// in each direction.
+    bool WaitConnectionSharedMemory(const std::string& name, int capacity = 64);
+
+    /// Send the data of several time steps at once. mtimes has one column
+    /// with the time of each step; mdata has a row for each step, with
+    /// the N values of that step. The client receives the same data as
+    /// with a call to SendData() for each step, but all steps are
+    /// sent with a single message.
+    bool SendDataBatch(ChMatrix<double>* mtimes, ChMatrix<double>* mdata);
+
+    /// Receive the data of several time steps at once, as sent by the client
+    /// at each step. The number of steps is the number of rows of mtimes
+    /// and mdata, as in SendDataBatch().
+    bool ReceiveDataBatch(ChMatrix<double>* mtimes, ChMatrix<double>* mdata);
+
   private:
+    void CheckConnected(const char* function);
+
     ChSocketTCP* myServer;
     ChSocketTCP* myClient;
+    ChSharedMemoryChannel* myChannel;
     int nport;
 
+    std::vector<char> out_buffer;  ///< reused between exchanges, to avoid allocations
+    std::vector<char> in_buffer;
+
     int in_n;
     int out_n;
 };
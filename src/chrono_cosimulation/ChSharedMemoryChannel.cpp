@@ -0,0 +1,359 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#include "chrono_cosimulation/ChSharedMemoryChannel.h"
+#include "chrono_cosimulation/ChExceptionSocket.h"
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+using namespace chrono;
+using namespace chrono::cosimul;
+
+namespace {
+
+const uint32_t SHM_MAGIC = 0x43484d43;
+const uint32_t SHM_VERSION = 1;
+
+enum { STATE_CREATED = 0, STATE_CONNECTED = 1, STATE_CLOSED = 2 };
+
+// The header and the rings are 64 bytes each, so that the two rings
+// (written by different processes) do not share a cache line.
+struct ShmHeader {
+    uint32_t magic;
+    uint32_t version;
+    std::atomic<uint32_t> state;
+    uint32_t pad[13];
+};
+
+struct ShmRing {
+    std::atomic<uint32_t> head;
+    std::atomic<uint32_t> tail;
+    uint32_t nvalues;
+    uint32_t capacity;
+    uint32_t offset;
+    std::atomic<uint32_t> head_waiters;
+    std::atomic<uint32_t> tail_waiters;
+    uint32_t pad[9];
+};
+
+static_assert(sizeof(ShmHeader) == 64 && sizeof(ShmRing) == 64, "unexpected layout of shared memory header");
+
+ShmHeader* Header(void* base) {
+    return (ShmHeader*)base;
+}
+
+ShmRing* Ring(void* base, int i) {
+    return (ShmRing*)((char*)base + sizeof(ShmHeader)) + i;
+}
+
+// Sleep until word != value, the timeout expires, or a wake-up is posted.
+void SleepOn(std::atomic<uint32_t>& word, uint32_t value) {
+#ifdef __linux__
+    // Short timeout, so that a peer that died without closing is detected.
+    struct timespec timeout = {0, 50000000};
+    syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAIT, value, &timeout, NULL, 0);
+#elif !defined(_WIN32)
+    sched_yield();
+#endif
+}
+
+void WakeAll(std::atomic<uint32_t>& word) {
+#ifdef __linux__
+    syscall(SYS_futex, (uint32_t*)&word, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#endif
+}
+
+// Wait until word != value. The waiters counter tells the other process
+// whether it must post a wake-up after changing word.
+uint32_t WaitChange(ShmHeader* header,
+                    std::atomic<uint32_t>& word,
+                    uint32_t value,
+                    std::atomic<uint32_t>& waiters,
+                    int spin) {
+    uint32_t current;
+    for (int i = 0; i < spin; i++) {
+        current = word.load(std::memory_order_acquire);
+        if (current != value)
+            return current;
+    }
+    waiters.fetch_add(1);
+    while ((current = word.load()) == value) {
+        if (header->state.load() == STATE_CLOSED) {
+            waiters.fetch_sub(1);
+            throw ChExceptionSocket(0, "Shared memory channel closed by the other process.");
+        }
+        SleepOn(word, value);
+    }
+    waiters.fetch_sub(1);
+    return current;
+}
+
+void Publish(std::atomic<uint32_t>& word, uint32_t value, std::atomic<uint32_t>& waiters) {
+    word.store(value);
+    if (waiters.load() > 0)
+        WakeAll(word);
+}
+
+}  // end anonymous namespace
+
+ChSharedMemoryChannel::ChSharedMemoryChannel()
+    : m_fd(-1),
+      m_base(0),
+      m_size(0),
+      m_server(false),
+      m_n_out(0),
+      m_n_in(0),
+      m_capacity(0),
+      m_spin(2000),
+      m_ring_out(0),
+      m_ring_in(0) {}
+
+ChSharedMemoryChannel::~ChSharedMemoryChannel() {
+    Close();
+}
+
+#ifdef _WIN32
+
+void ChSharedMemoryChannel::Create(const std::string& name, int n_out_values, int n_in_values, int capacity) {
+    throw ChExceptionSocket(0, "Shared memory channels are not supported on this platform.");
+}
+
+void ChSharedMemoryChannel::Open(const std::string& name) {
+    throw ChExceptionSocket(0, "Shared memory channels are not supported on this platform.");
+}
+
+void ChSharedMemoryChannel::Map(size_t size, bool create) {}
+
+void ChSharedMemoryChannel::Unmap() {}
+
+#else
+
+void ChSharedMemoryChannel::Map(size_t size, bool create) {
+    m_base = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_base == MAP_FAILED) {
+        m_base = 0;
+        close(m_fd);
+        m_fd = -1;
+        if (create)
+            shm_unlink(m_name.c_str());
+        throw ChExceptionSocket(errno, "Cannot map the shared memory channel " + m_name);
+    }
+    m_size = size;
+}
+
+void ChSharedMemoryChannel::Unmap() {
+    munmap(m_base, m_size);
+    close(m_fd);
+    m_base = 0;
+    m_fd = -1;
+    m_size = 0;
+}
+
+void ChSharedMemoryChannel::Create(const std::string& name, int n_out_values, int n_in_values, int capacity) {
+    if (IsOpen())
+        throw ChExceptionSocket(0, "Shared memory channel already open.");
+    if (n_out_values < 0 || n_in_values < 0 || capacity < 1)
+        throw ChExceptionSocket(0, "Invalid size for the shared memory channel.");
+
+    m_name = name;
+    m_server = true;
+    m_n_out = n_out_values;
+    m_n_in = n_in_values;
+    m_capacity = capacity;
+
+    size_t offset_out = sizeof(ShmHeader) + 2 * sizeof(ShmRing);
+    size_t offset_in = offset_out + sizeof(double) * capacity * (n_out_values + 1);
+    size_t size = offset_in + sizeof(double) * capacity * (n_in_values + 1);
+
+    shm_unlink(name.c_str());
+    m_fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (m_fd < 0)
+        throw ChExceptionSocket(errno, "Cannot create the shared memory channel " + name);
+    if (ftruncate(m_fd, size) != 0) {
+        close(m_fd);
+        m_fd = -1;
+        shm_unlink(name.c_str());
+        throw ChExceptionSocket(errno, "Cannot resize the shared memory channel " + name);
+    }
+    Map(size, true);
+
+    ShmHeader* header = new (m_base) ShmHeader;
+    header->version = SHM_VERSION;
+    header->state.store(STATE_CREATED);
+
+    size_t offsets[2] = {offset_out, offset_in};
+    int nvalues[2] = {n_out_values, n_in_values};
+    for (int i = 0; i < 2; i++) {
+        ShmRing* ring = new (Ring(m_base, i)) ShmRing;
+        ring->head.store(0);
+        ring->tail.store(0);
+        ring->nvalues = nvalues[i];
+        ring->capacity = capacity;
+        ring->offset = (uint32_t)offsets[i];
+        ring->head_waiters.store(0);
+        ring->tail_waiters.store(0);
+    }
+    m_ring_out = Ring(m_base, 0);
+    m_ring_in = Ring(m_base, 1);
+
+    // The magic number is written last: clients check it before attaching.
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = SHM_MAGIC;
+}
+
+void ChSharedMemoryChannel::Open(const std::string& name) {
+    if (IsOpen())
+        throw ChExceptionSocket(0, "Shared memory channel already open.");
+
+    m_name = name;
+    m_server = false;
+
+    m_fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (m_fd < 0)
+        throw ChExceptionSocket(errno, "Cannot open the shared memory channel " + name);
+    struct stat st;
+    if (fstat(m_fd, &st) != 0 || st.st_size < (off_t)(sizeof(ShmHeader) + 2 * sizeof(ShmRing))) {
+        close(m_fd);
+        m_fd = -1;
+        throw ChExceptionSocket(0, "Shared memory channel " + name + " not ready.");
+    }
+    Map((size_t)st.st_size, false);
+
+    ShmHeader* header = Header(m_base);
+    if (header->magic != SHM_MAGIC || header->version != SHM_VERSION) {
+        Unmap();
+        throw ChExceptionSocket(0, "Shared memory channel " + name + " not ready, or of a different version.");
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // The rings are seen from the other side.
+    m_ring_out = Ring(m_base, 1);
+    m_ring_in = Ring(m_base, 0);
+    m_n_out = ((ShmRing*)m_ring_out)->nvalues;
+    m_n_in = ((ShmRing*)m_ring_in)->nvalues;
+    m_capacity = ((ShmRing*)m_ring_out)->capacity;
+
+    header->state.store(STATE_CONNECTED);
+    WakeAll(header->state);
+}
+
+#endif
+
+void ChSharedMemoryChannel::WaitClient() {
+    if (!IsOpen() || !m_server)
+        throw ChExceptionSocket(0, "Only the creator of a shared memory channel can wait for a client.");
+
+    ShmHeader* header = Header(m_base);
+    while (header->state.load() == STATE_CREATED)
+        SleepOn(header->state, STATE_CREATED);
+}
+
+void ChSharedMemoryChannel::Close() {
+    if (!IsOpen())
+        return;
+
+    ShmHeader* header = Header(m_base);
+    header->state.store(STATE_CLOSED);
+    WakeAll(header->state);
+    for (int i = 0; i < 2; i++) {
+        WakeAll(Ring(m_base, i)->head);
+        WakeAll(Ring(m_base, i)->tail);
+    }
+
+#ifndef _WIN32
+    Unmap();
+    if (m_server)
+        shm_unlink(m_name.c_str());
+#endif
+    m_ring_out = 0;
+    m_ring_in = 0;
+}
+
+void ChSharedMemoryChannel::Send(int nsteps, const double* times, const double* values) {
+    if (!IsOpen())
+        throw ChExceptionSocket(0, "Error. Attempted 'Send' on a closed shared memory channel.");
+
+    ShmHeader* header = Header(m_base);
+    ShmRing* ring = (ShmRing*)m_ring_out;
+    double* data = (double*)((char*)m_base + ring->offset);
+    uint32_t capacity = ring->capacity;
+    uint32_t record = ring->nvalues + 1;
+
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    int done = 0;
+    while (done < nsteps) {
+        // Wait for free slots, then fill as many as possible before publishing.
+        uint32_t tail = ring->tail.load(std::memory_order_acquire);
+        while (head - tail == capacity)
+            tail = WaitChange(header, ring->tail, tail, ring->tail_waiters, m_spin);
+
+        uint32_t n = capacity - (head - tail);
+        if (n > (uint32_t)(nsteps - done))
+            n = (uint32_t)(nsteps - done);
+        for (uint32_t k = 0; k < n; k++, done++) {
+            double* slot = data + ((head + k) % capacity) * record;
+            slot[0] = times[done];
+            memcpy(slot + 1, values + (size_t)done * (record - 1), sizeof(double) * (record - 1));
+        }
+        head += n;
+        Publish(ring->head, head, ring->head_waiters);
+    }
+}
+
+void ChSharedMemoryChannel::Receive(int nsteps, double* times, double* values) {
+    if (!IsOpen())
+        throw ChExceptionSocket(0, "Error. Attempted 'Receive' on a closed shared memory channel.");
+
+    ShmHeader* header = Header(m_base);
+    ShmRing* ring = (ShmRing*)m_ring_in;
+    const double* data = (const double*)((char*)m_base + ring->offset);
+    uint32_t capacity = ring->capacity;
+    uint32_t record = ring->nvalues + 1;
+
+    uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+    int done = 0;
+    while (done < nsteps) {
+        // Wait for available records, then consume all of them before publishing.
+        uint32_t head = ring->head.load(std::memory_order_acquire);
+        while (head == tail)
+            head = WaitChange(header, ring->head, head, ring->head_waiters, m_spin);
+
+        uint32_t n = head - tail;
+        if (n > (uint32_t)(nsteps - done))
+            n = (uint32_t)(nsteps - done);
+        for (uint32_t k = 0; k < n; k++, done++) {
+            const double* slot = data + ((tail + k) % capacity) * record;
+            times[done] = slot[0];
+            memcpy(values + (size_t)done * (record - 1), slot + 1, sizeof(double) * (record - 1));
+        }
+        tail += n;
+        Publish(ring->tail, tail, ring->tail_waiters);
+    }
+}
@@ -0,0 +1,129 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+#ifndef CHSHAREDMEMORYCHANNEL_H
+#define CHSHAREDMEMORYCHANNEL_H
+
+//////////////////////////////////////////////////
+//
+//   ChSharedMemoryChannel.h
+//
+//   A channel to exchange vectors of values with
+//   another process on the same host, through
+//   POSIX shared memory
+//
+//   HEADER file for CHRONO,
+//	 Multibody dynamics engine
+//
+///////////////////////////////////////////////////
+
+#include <string>
+
+#include "chrono_cosimulation/ChApiCosimulation.h"
+
+namespace chrono {
+namespace cosimul {
+
+/// Channel for exchanging vectors of scalar values with another process
+/// running on the same host, as a faster alternative to TCP sockets.
+/// The channel is a POSIX shared memory object (shm_open) that contains
+/// two ring buffers, one for each direction. Each record of a ring is a time
+/// value followed by N values, all doubles in the native byte order.
+/// Records are written and read directly in the shared memory, and the
+/// other process is notified with a futex (on Linux) only if it is waiting,
+/// so that an exchange does not need any allocation nor, in most cases,
+/// any system call. Several records (time steps) can be written or read
+/// with a single call.
+///
+/// One process creates the channel with Create() and waits for the other
+/// one with WaitClient(); the other process attaches to it with Open().
+/// For the client, the 'out' values are the ones received by the server and
+/// vice versa.
+///
+/// Layout of the shared memory, for clients not written with Chrono
+/// (all fields are 32 bit unsigned integers):
+///   - header: magic 0x43484d43, version 1, state (0 created, 1 connected,
+///     2 closed), padding up to 64 bytes;
+///   - two rings of 64 bytes each (server->client, then client->server):
+///     head (records written), tail (records read), number of values N,
+///     capacity in records, byte offset of the data from the start of the
+///     shared memory, head and tail waiting counters; padded to 64 bytes;
+///   - the data of the two rings, capacity*(N+1) doubles each.
+/// Head and tail only increase (modulo 2^32); the record k is at position
+/// k % capacity.
+
+class ChApiCosimulation ChSharedMemoryChannel {
+  public:
+    ChSharedMemoryChannel();
+
+    /// Closing the channel also wakes up the other process.
+    ~ChSharedMemoryChannel();
+
+    /// Create a new channel with the given name (for example "/chrono_cosim")
+    /// and become its server. An old channel with the same name is removed.
+    void Create(const std::string& name,
+                int n_out_values,   ///< number of scalar values sent in each record
+                int n_in_values,    ///< number of scalar values received in each record
+                int capacity = 64   ///< max number of records buffered in each direction
+                );
+
+    /// Attach to a channel created by a server in another process.
+    void Open(const std::string& name);
+
+    /// Wait until a client attaches to the channel (server only).
+    void WaitClient();
+
+    /// Detach from the channel. The server also removes the shared memory object.
+    /// A process waiting on the other side is woken up, and gets an exception.
+    void Close();
+
+    /// Return true if the channel was created or opened.
+    bool IsOpen() const { return m_base != 0; }
+
+    int GetNumOutValues() const { return m_n_out; }
+    int GetNumInValues() const { return m_n_in; }
+    int GetCapacity() const { return m_capacity; }
+
+    /// Write nsteps records, each with a time value and GetNumOutValues() values.
+    /// times has nsteps elements; values has nsteps*GetNumOutValues() elements,
+    /// record after record. Waits if the ring is full.
+    void Send(int nsteps, const double* times, const double* values);
+
+    /// Read nsteps records, each with a time value and GetNumInValues() values,
+    /// with the same layout of Send(). Waits until all records are available.
+    void Receive(int nsteps, double* times, double* values);
+
+    /// Set the number of times the state of a ring is polled before
+    /// sleeping (default 2000). Polling reduces latency when the other
+    /// process replies quickly, at the cost of CPU time.
+    void SetSpinCount(int mcount) { m_spin = mcount; }
+
+  private:
+    void Map(size_t size, bool create);
+    void Unmap();
+
+    std::string m_name;
+    int m_fd;
+    void* m_base;
+    size_t m_size;
+    bool m_server;
+    int m_n_out;
+    int m_n_in;
+    int m_capacity;
+    int m_spin;
+    void* m_ring_out;
+    void* m_ring_in;
+};
+
+}  // END_OF_NAMESPACE____
+}  // END_OF_NAMESPACE____
+
+#endif  // END of header
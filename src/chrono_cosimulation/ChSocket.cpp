@@ -1230,22 +1230,29 @@ int ChSocketTCP::SendBuffer(std::vector<char>& source_buf) {
     if (nbytes)
         data = (char*)&(source_buf[0]);  // stl vectors are assured to be sequential
     else
-        data = "";  // stub, in case null length messages, stl vector has no [0] element address
+        data = (char*)"";  // stub, in case null length messages, stl vector has no [0] element address
 
+    // Sends the message to the connected host. send() may send only a part of
+    // the buffer, so loop until all bytes are gone.
     int sentBytes = 0;
-
-    // Sends the message to the connected host
-    if (sentBytes = send(socketId, data, nbytes, 0) == -1) {
+    while (sentBytes < nbytes) {
+        int numBytes = send(socketId, data + sentBytes, nbytes - sentBytes, 0);
+        if (numBytes == -1) {
 #ifdef WINDOWS_XP
-        int errorCode = 0;
-        string errorMsg = "error calling send():\n";
-        detectErrorRecv(&errorCode, errorMsg);
-        throw ChExceptionSocket(errorCode, errorMsg);
+            int errorCode = 0;
+            string errorMsg = "error calling send():\n";
+            detectErrorRecv(&errorCode, errorMsg);
+            throw ChExceptionSocket(errorCode, errorMsg);
 #endif
 
 #ifdef UNIX
-        throw ChExceptionSocket(0, "unix: error calling send()");
+            if (errno == EINTR)
+                continue;
+            throw ChExceptionSocket(0, "unix: error calling send()");
 #endif
+            throw ChExceptionSocket(0, "error calling send()");
+        }
+        sentBytes += numBytes;
     }
 
     return sentBytes;
@@ -1256,25 +1263,36 @@ int ChSocketTCP::ReceiveBuffer(std::vector<char>& dest_buf, int bsize) {
 
     dest_buf.resize(nbytes);
 
-    void* data;
+    char* data;
     if (nbytes)
         data = (char*)&(dest_buf[0]);  // stl vectors are assured to be sequential. // should not access directly
                                        // std::vector data, but this is efficient!
     else
         data = (char*)"";  // stub, in case null length messages, stl vector has no [0] element address
 
-    int receivedBytes = recv(socketId, (char*)data, nbytes, 0);
-    if (receivedBytes == -1) {
+    // recv() returns as soon as some bytes are available, so a large buffer can
+    // arrive in several pieces: loop until all bsize bytes are received.
+    int receivedBytes = 0;
+    while (receivedBytes < nbytes) {
+        int numBytes = recv(socketId, data + receivedBytes, nbytes - receivedBytes, 0);
+        if (numBytes == -1) {
 #ifdef WINDOWS_XP
-        int errorCode = 0;
-        string errorMsg = "error calling recv():\n";
-        detectErrorRecv(&errorCode, errorMsg);
-        throw ChExceptionSocket(errorCode, errorMsg);
+            int errorCode = 0;
+            string errorMsg = "error calling recv():\n";
+            detectErrorRecv(&errorCode, errorMsg);
+            throw ChExceptionSocket(errorCode, errorMsg);
 #endif
 
 #ifdef UNIX
-        throw ChExceptionSocket(0, "Error calling recv() in buffer receive:");
+            if (errno == EINTR)
+                continue;
+            throw ChExceptionSocket(0, "Error calling recv() in buffer receive:");
 #endif
+            throw ChExceptionSocket(0, "Error calling recv() in buffer receive");
+        }
+        if (numBytes == 0)
+            throw ChExceptionSocket(0, "Error in buffer receive: connection closed by the peer");
+        receivedBytes += numBytes;
     }
 
     return receivedBytes;
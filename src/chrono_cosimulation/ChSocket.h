@@ -28,7 +28,9 @@
 #include <sys/ioctl.h>
 #include <stdio.h>
 #include <string.h>
-#include <sys/filio.h>
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__sun)
+#include <sys/filio.h>  // FIONBIO (in sys/ioctl.h on Linux)
+#endif
 #else
 #include <winsock2.h>
 #endif
@@ -164,7 +166,8 @@ class ChApiCosimulation ChSocketTCP : public ChSocket {
     /// Receive a std::vector<char> (a buffer of bytes) from the connected host,
     /// without the header as in SendMessage (so one must know in advance
     /// the length of the buffer). If the receiving buffer size is not =bsize, it
-    /// will be resized before receiving.
+    /// will be resized before receiving. Waits until all bsize bytes are received,
+    /// and throws a ChExceptionSocket if the connection fails or is closed before.
     int ReceiveBuffer(std::vector<char>& dest_buf,  ///< destination buffer - will be resized
                       int bsize                     ///< size in bytes of expected received buffer.
                       );
@@ -95,6 +95,17 @@ class ChApiFea ChElementBase {
     ///   R += forces * c
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {}
 
+    /// Adds the internal forces Fi, as already computed by ComputeInternalForces(),
+    /// (pasted at global nodes offsets) into a global vector R, multiplied by a
+    /// scaling factor c. Fi may be scaled in place.
+    /// This is used by ChMesh to compute the forces of all elements in parallel and
+    /// assemble them afterwards. By default Fi is ignored and EleIntLoadResidual_F is
+    /// called, so that elements that only implement EleIntLoadResidual_F still work;
+    /// children classes can override this to paste Fi directly (see ChElementGeneric).
+    virtual void EleIntAssembleResidual_F(ChVectorDynamic<>& R, ChMatrixDynamic<>& Fi, const double c) {
+        EleIntLoadResidual_F(R, c);
+    }
+
     /// Adds the product of element mass M by a vector w (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += M * v * c
@@ -195,6 +195,13 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         ResidHE.Reset();
         int count = 0;
         int fail = 1;
+
+        // Enhanced Assumed Strain (EAS): T0 and detJ0C depend only on the initial
+        // configuration, so they are evaluated once, outside the EAS loop.
+        T0.Reset();
+        detJ0C = 0.0;
+        T0DetJElementCenterForEAS(m_d0, T0, detJ0C);
+
         /// Begin EAS loop
         while (fail == 1) {
             /// Update alpha EAS
@@ -206,10 +213,6 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             GDEPSP.Reset();
             KALPHA.Reset();
 
-            // Enhanced Assumed Strain (EAS)
-            T0.Reset();
-            detJ0C = 0.0;
-            T0DetJElementCenterForEAS(m_d0, T0, detJ0C);
             //== F_internal ==//
             // Choose constructors depending on m_isMooney
             MyForceNum myformula = !m_isMooney ? MyForceNum(&d, &m_d0, this, &T0, &detJ0C, &alpha_eas, &E, &v)
@@ -276,16 +279,17 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             ChMatrixNM<double, 9, 9> INV_KALPHA_Temp;
             ChMatrixNM<double, 24, 24> stock_jac_EAS_elem;
 
+            // Factorize KALPHA once, then solve for the columns of its inverse
+            INV_KALPHA_Temp = KALPHA;
+            ChMatrixNM<int, 9, 1> INDX;
+            bool pivoting;
+            if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
+                throw ChException("Singular matrix.");
+            }
             for (int ii = 0; ii < 9; ii++) {
-                INV_KALPHA_Temp = KALPHA;
-                ChMatrixNM<int, 9, 1> INDX;
                 ChMatrixNM<double, 9, 1> DAMMY_vec;
                 DAMMY_vec.Reset();
                 DAMMY_vec(ii) = 1.0;
-                bool pivoting;
-                if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
-                    throw ChException("Singular matrix.");
-                }
                 LU_solve(INV_KALPHA_Temp, INDX, DAMMY_vec);
                 INV_KALPHA.PasteClippedMatrix(&DAMMY_vec, 0, 0, 9, 1, 0, ii);  //
             }
@@ -316,6 +320,13 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         ResidHE.Reset();
         int count = 0;
         int fail = 1;
+
+        // Enhanced Assumed Strain (EAS): T0 and detJ0C depend only on the initial
+        // configuration, so they are evaluated once, outside the EAS loop.
+        T0.Reset();
+        detJ0C = 0.0;
+        T0DetJElementCenterForEAS(m_d0, T0, detJ0C);
+
         // Loop to obtain convergence in EAS internal parameters alpha
         // This loops call ChQuadrature::Integrate3D on MyAnalyticalForce,
         // which calculates the Jacobian at every iteration of each time step
@@ -330,10 +341,6 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             GDEPSP.Reset();     // Jacobian of EAS forces w.r.t. coordinates
             KALPHA.Reset();     // Jacobian of EAS forces w.r.t. EAS internal parameters
 
-            // Enhanced Assumed Strain (EAS)
-            T0.Reset();
-            detJ0C = 0.0;
-            T0DetJElementCenterForEAS(m_d0, T0, detJ0C);
 
             //== F_internal ==//
             MyForceAnalytical myformula = !m_isMooney
@@ -418,16 +425,17 @@ void ChElementBrick::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
             ChMatrixNM<double, 9, 9> INV_KALPHA_Temp;
             ChMatrixNM<double, 24, 24> stock_jac_EAS_elem;
 
+            // Factorize KALPHA once, then solve for the columns of its inverse
+            INV_KALPHA_Temp = KALPHA;
+            ChMatrixNM<int, 9, 1> INDX;
+            bool pivoting;
+            if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
+                throw ChException("Singular matrix.");
+            }
             for (int ii = 0; ii < 9; ii++) {
-                INV_KALPHA_Temp = KALPHA;
-                ChMatrixNM<int, 9, 1> INDX;
                 ChMatrixNM<double, 9, 1> DAMMY_vec;
                 DAMMY_vec.Reset();
                 DAMMY_vec(ii) = 1.0;
-                bool pivoting;
-                if (!LU_factor(INV_KALPHA_Temp, INDX, pivoting)) {
-                    throw ChException("Singular matrix.");
-                }
                 LU_solve(INV_KALPHA_Temp, INDX, DAMMY_vec);
                 INV_KALPHA.PasteClippedMatrix(&DAMMY_vec, 0, 0, 9, 1, 0, ii);  //
             }
@@ -18,6 +18,7 @@
 
 #include "chrono/physics/ChContinuumMaterial.h"
 #include "chrono_fea/ChApiFEA.h"
+#include "chrono_fea/ChElementGeneric.h"
 #include "chrono_fea/ChNodeFEAxyz.h"
 #include "core/ChQuadrature.h"
 
@@ -24,17 +24,22 @@ void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c
 	ChMatrixDynamic<> mFi(this->GetNdofs(), 1);
 	this->ComputeInternalForces(mFi);
 	//GetLog() << "EleIntLoadResidual_F , mFi=" << mFi << "  c=" << c << "\n";
-	mFi.MatrScale(c);
+	this->EleIntAssembleResidual_F(R, mFi, c);
+	//GetLog() << "EleIntLoadResidual_F , R=" << R << "\n";
+}
+
+void ChElementGeneric::EleIntAssembleResidual_F(ChVectorDynamic<>& R, ChMatrixDynamic<>& Fi, const double c)
+{
+	Fi.MatrScale(c);
 	int stride = 0;
 	for (int in=0; in < this->GetNnodes(); in++)
 	{
 		int nodedofs = GetNodeN(in)->Get_ndof_w();
 		//GetLog() << "  in=" << in << "  stride=" << stride << "  nodedofs=" << nodedofs << " offset=" <<  GetNodeN(in)->NodeGetOffset_w() << "\n";
 		if (!GetNodeN(in)->GetFixed())
-			R.PasteSumClippedMatrix(&mFi, stride, 0, nodedofs,1, GetNodeN(in)->NodeGetOffset_w(), 0);
+			R.PasteSumClippedMatrix(&Fi, stride, 0, nodedofs,1, GetNodeN(in)->NodeGetOffset_w(), 0);
 		stride += nodedofs;
 	}
-	//GetLog() << "EleIntLoadResidual_F , R=" << R << "\n";
 }
 
 void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c)
@@ -49,6 +49,9 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// implementing this EleIntLoadResidual_F function, unless you need faster code)
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) override;
 
+    /// Adds the already computed internal forces Fi, scaled by c, at the offsets of the nodes.
+    virtual void EleIntAssembleResidual_F(ChVectorDynamic<>& R, ChMatrixDynamic<>& Fi, const double c) override;
+
     /// (This is a default (VERY UNOPTIMAL) book keeping so that in children classes you can avoid
     /// implementing this EleIntLoadResidual_Mv function, unless you need faster code.)
     virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) override;
@@ -112,6 +112,9 @@ void ChElementShellANCF::SetupInitial(ChSystem* system) {
     // Compute mass matrix and gravitational forces (constant)
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
+
+    // Cache the reference configuration quantities at the Gauss points of all layers
+    SetupGaussPoints();
 }
 
 // State update.
@@ -273,6 +276,142 @@ void ChElementShellANCF::ComputeGravityForce(const ChVector<>& g_acc) {
     }
 }
 
+// -----------------------------------------------------------------------------
+// Reference configuration data at the Gauss points
+// -----------------------------------------------------------------------------
+
+// Evaluate, at the 2x2x2 Gauss points of each layer, all quantities of the internal
+// force and Jacobian integrands that depend only on the initial configuration.
+// Points are stored layer by layer, in the same order used by ChQuadrature::Integrate3D.
+void ChElementShellANCF::SetupGaussPoints() {
+    const std::vector<double>& roots = ChQuadrature::GetStaticTables()->Lroots[1];
+    const std::vector<double>& weights = ChQuadrature::GetStaticTables()->Weight[1];
+
+    m_gaussPoints.resize(m_numLayers * 8);
+
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        double Zc1 = (m_GaussZ[kl + 1] - m_GaussZ[kl]) / 2;
+        double Zc2 = (m_GaussZ[kl + 1] + m_GaussZ[kl]) / 2;
+
+        // Transformation matrix, function of fiber angle
+        const ChMatrixNM<double, 6, 6>& T0 = m_layers[kl].Get_T0();
+        // Determinant of the initial position vector gradient at the element center
+        double detJ0C = m_layers[kl].Get_detJ0C();
+        // Fiber angle
+        double theta = m_layers[kl].Get_theta();
+
+        int ip = 0;
+        for (int ix = 0; ix < 2; ix++) {
+            for (int iy = 0; iy < 2; iy++) {
+                for (int iz = 0; iz < 2; iz++) {
+                    GaussPoint& gp = m_gaussPoints[kl * 8 + ip++];
+                    double x = roots[ix];
+                    double y = roots[iy];
+                    double z = Zc1 * roots[iz] + Zc2;
+                    gp.weight = weights[ix] * weights[iy] * weights[iz];
+
+                    // Element shape function
+                    ShapeFunctions(gp.N, x, y, z);
+
+                    // Determinant of position vector gradient matrix: Initial configuration
+                    ChMatrixNM<double, 1, 3> Nx_d0;
+                    ChMatrixNM<double, 1, 3> Ny_d0;
+                    ChMatrixNM<double, 1, 3> Nz_d0;
+                    gp.detJ0 = Calc_detJ0(x, y, z, gp.Nx, gp.Ny, gp.Nz, Nx_d0, Ny_d0, Nz_d0);
+
+                    // ANS and EAS shape functions
+                    ChMatrixNM<double, 6, 5> M;
+                    ShapeFunctionANSbilinearShell(gp.S_ANS, x, y);
+                    Basis_M(M, x, y, z);
+
+                    // Transformation : Orthogonal transformation (A and J)
+                    ChVector<double> G1xG2;  // Cross product of first and second column of
+                    double G1dotG1;          // Dot product of first column of position vector gradient
+
+                    G1xG2.x = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
+                    G1xG2.y = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
+                    G1xG2.z = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
+                    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
+
+                    // Tangent Frame
+                    ChVector<double> A1;
+                    ChVector<double> A2;
+                    ChVector<double> A3;
+                    A1.x = Nx_d0[0][0];
+                    A1.y = Nx_d0[0][1];
+                    A1.z = Nx_d0[0][2];
+                    A1 = A1 / sqrt(G1dotG1);
+                    A3 = G1xG2.GetNormalized();
+                    A2.Cross(A3, A1);
+
+                    // Direction for orthotropic material
+                    ChVector<double> AA1;
+                    ChVector<double> AA2;
+                    ChVector<double> AA3;
+                    AA1 = A1 * cos(theta) + A2 * sin(theta);
+                    AA2 = -A1 * sin(theta) + A2 * cos(theta);
+                    AA3 = A3;
+
+                    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
+                    ChMatrixNM<double, 3, 3>& j0 = gp.j0;
+                    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
+                    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
+                    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
+                    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
+                    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
+                    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
+                    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
+                    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
+                    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
+                    j0.MatrDivScale(gp.detJ0);
+
+                    ChVector<double> j01(j0(0, 0), j0(0, 1), j0(0, 2));
+                    ChVector<double> j02(j0(1, 0), j0(1, 1), j0(1, 2));
+                    ChVector<double> j03(j0(2, 0), j0(2, 1), j0(2, 2));
+
+                    // Coefficients of contravariant transformation
+                    gp.beta(0, 0) = Vdot(AA1, j01);
+                    gp.beta(1, 0) = Vdot(AA2, j01);
+                    gp.beta(2, 0) = Vdot(AA3, j01);
+                    gp.beta(3, 0) = Vdot(AA1, j02);
+                    gp.beta(4, 0) = Vdot(AA2, j02);
+                    gp.beta(5, 0) = Vdot(AA3, j02);
+                    gp.beta(6, 0) = Vdot(AA1, j03);
+                    gp.beta(7, 0) = Vdot(AA2, j03);
+                    gp.beta(8, 0) = Vdot(AA3, j03);
+
+                    // Enhanced Assumed Strain
+                    gp.G = T0 * M * (detJ0C / gp.detJ0);
+
+                    // Strain terms of the initial configuration
+                    ChMatrixNM<double, 8, 1> d0d0Nx;
+                    ChMatrixNM<double, 8, 1> d0d0Ny;
+                    d0d0Nx.MatrMultiplyT(m_d0d0T, gp.Nx);
+                    d0d0Ny.MatrMultiplyT(m_d0d0T, gp.Ny);
+                    gp.strain0(0, 0) = (gp.Nx * d0d0Nx)(0, 0);
+                    gp.strain0(1, 0) = (gp.Ny * d0d0Ny)(0, 0);
+                    gp.strain0(2, 0) = (gp.Nx * d0d0Ny)(0, 0);
+                }
+            }
+        }
+    }
+}
+
+// Integrate the given integrand over the volume of layer kl, as a 2x2x2 Gauss quadrature
+// at the cached Gauss points (equivalent to ChQuadrature::Integrate3D with order 2).
+template <class T, class F>
+void ChElementShellANCF::IntegrateLayer(T& result, F& integrand, size_t kl) {
+    result.Reset();
+    T val;
+    for (int ip = 0; ip < 8; ip++) {
+        const GaussPoint& gp = m_gaussPoints[kl * 8 + ip];
+        integrand.Evaluate(val, gp);
+        val *= gp.weight;
+        result += val;
+    }
+    result *= (m_GaussZ[kl + 1] - m_GaussZ[kl]) / 2;
+}
+
 // -----------------------------------------------------------------------------
 // Elastic force calculation
 // -----------------------------------------------------------------------------
@@ -287,7 +426,9 @@ void ChElementShellANCF::ComputeGravityForce(const ChVector<>& g_acc) {
 // shear locking. This implementation also features a composite material implementation
 // that allows for selecting a number of layers over the element thickness; each of which
 // has an independent, user-selected fiber angle (direction for orthotropic constitutive behavior)
-class MyForce : public ChIntegrable3D<ChMatrixNM<double, 54, 1> > {
+// The integrand is evaluated at the Gauss points of the layer, using the reference
+// configuration quantities cached in ChElementShellANCF::SetupGaussPoints().
+class MyForce {
   public:
     MyForce(ChElementShellANCF* element,             // Containing element
             size_t kl,                               // Current layer index
@@ -298,131 +439,38 @@ class MyForce : public ChIntegrable3D<ChMatrixNM<double, 54, 1> > {
           m_alpha_eas(alpha_eas) {}
     ~MyForce() {}
 
+    /// Evaluate (strainD'*strain)  at the given Gauss point, include ANS and EAS.
+    void Evaluate(ChMatrixNM<double, 54, 1>& result, const ChElementShellANCF::GaussPoint& gp);
+
   private:
     ChElementShellANCF* m_element;
     size_t m_kl;
     ChMatrixNM<double, 5, 1>* m_alpha_eas;
-
-    /// Evaluate (strainD'*strain)  at point x, include ANS and EAS.
-    virtual void Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) override;
 };
 
-void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x = Nx_d0[0][0];
-    A1.y = Nx_d0[0][1];
-    A1.z = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01(0) = j0(0, 0);
-    j02(0) = j0(1, 0);
-    j03(0) = j0(2, 0);
-    j01(1) = j0(0, 1);
-    j02(1) = j0(1, 1);
-    j03(1) = j0(2, 1);
-    j01(2) = j0(0, 2);
-    j02(2) = j0(1, 2);
-    j03(2) = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
-
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
+void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const ChElementShellANCF::GaussPoint& gp) {
+    // Reference configuration quantities at this Gauss point
+    const ChMatrixNM<double, 1, 8>& N = gp.N;
+    const ChMatrixNM<double, 1, 8>& Nx = gp.Nx;
+    const ChMatrixNM<double, 1, 8>& Ny = gp.Ny;
+    const ChMatrixNM<double, 1, 4>& S_ANS = gp.S_ANS;
+    const ChMatrixNM<double, 9, 1>& beta = gp.beta;
+    const ChMatrixNM<double, 6, 5>& G = gp.G;
+    double detJ0 = gp.detJ0;
 
     // Enhanced Assumed Strain
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
     ChMatrixNM<double, 6, 1> strain_EAS = G * (*m_alpha_eas);
 
     ChMatrixNM<double, 8, 1> ddNx;
     ChMatrixNM<double, 8, 1> ddNy;
-    ChMatrixNM<double, 8, 1> ddNz;
     ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
     ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
 
     // Strain component
     ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
+    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - gp.strain0(0, 0));
+    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - gp.strain0(1, 0));
+    strain_til(2, 0) = (Nx * ddNy)(0, 0) - gp.strain0(2, 0);
     strain_til(3, 0) = N(0, 0) * m_element->m_strainANS(0, 0) + N(0, 2) * m_element->m_strainANS(1, 0) + N(0, 4) * m_element->m_strainANS(2, 0) +
                        N(0, 6) * m_element->m_strainANS(3, 0);
     strain_til(4, 0) = S_ANS(0, 2) * m_element->m_strainANS(6, 0) + S_ANS(0, 3) * m_element->m_strainANS(7, 0);
@@ -604,13 +652,7 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
         for (int count = 0; count < m_maxIterationsEAS; count++) {
             ChMatrixNM<double, 54, 1> result;
             MyForce formula(this, kl, &alphaEAS);
-            ChQuadrature::Integrate3D<ChMatrixNM<double, 54, 1> >(result,   // result of integration
-                                                                  formula,  // integrand formula
-                                                                  -1, 1,    // x limits
-                                                                  -1, 1,    // y limits
-                                                                  m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                                  2  // order of integration
-                                                                  );
+            IntegrateLayer(result, formula, kl);
 
             // Extract vectors and matrices from result of integration
             Finternal.PasteClippedMatrix(&result, 0, 0, 24, 1, 0, 0);
@@ -660,7 +702,8 @@ void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
 //      Kfactor * [K] + Rfactor * [R]
 // where K does not include the EAS contribution.
 // The last 120 entries represent the 5x24 cross-dependency matrix.
-class MyJacobian : public ChIntegrable3D<ChMatrixNM<double, 696, 1> > {
+// As for MyForce, the integrand is evaluated from the cached Gauss point data.
+class MyJacobian {
   public:
     MyJacobian(ChElementShellANCF* element,  // Containing element
                double Kfactor,               // Scaling coefficient for stiffness component
@@ -669,132 +712,41 @@ class MyJacobian : public ChIntegrable3D<ChMatrixNM<double, 696, 1> > {
                )
         : m_element(element), m_Kfactor(Kfactor), m_Rfactor(Rfactor), m_kl(kl) {}
 
+    // Evaluate integrand at the given Gauss point.
+    void Evaluate(ChMatrixNM<double, 696, 1>& result, const ChElementShellANCF::GaussPoint& gp);
+
   private:
     ChElementShellANCF* m_element;
     double m_Kfactor;
     double m_Rfactor;
     size_t m_kl;
-
-    // Evaluate integrand at the specified point.
-    virtual void Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, const double y, const double z) override;
 };
 
-void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, const double y, const double z) {
-    // Element shape function
-    ChMatrixNM<double, 1, 8> N;
-    m_element->ShapeFunctions(N, x, y, z);
-
-    // Determinant of position vector gradient matrix: Initial configuration
-    ChMatrixNM<double, 1, 8> Nx;
-    ChMatrixNM<double, 1, 8> Ny;
-    ChMatrixNM<double, 1, 8> Nz;
-    ChMatrixNM<double, 1, 3> Nx_d0;
-    ChMatrixNM<double, 1, 3> Ny_d0;
-    ChMatrixNM<double, 1, 3> Nz_d0;
-    double detJ0 = m_element->Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
-
-    // ANS shape function
-    ChMatrixNM<double, 1, 4> S_ANS;  // Shape function vector for Assumed Natural Strain
-    ChMatrixNM<double, 6, 5> M;      // Shape function vector for Enhanced Assumed Strain
-    m_element->ShapeFunctionANSbilinearShell(S_ANS, x, y);
-    m_element->Basis_M(M, x, y, z);
-
-    // Transformation : Orthogonal transformation (A and J)
-    ChVector<double> G1xG2;  // Cross product of first and second column of
-    double G1dotG1;          // Dot product of first column of position vector gradient
-
-    G1xG2.x = Nx_d0[0][1] * Ny_d0[0][2] - Nx_d0[0][2] * Ny_d0[0][1];
-    G1xG2.y = Nx_d0[0][2] * Ny_d0[0][0] - Nx_d0[0][0] * Ny_d0[0][2];
-    G1xG2.z = Nx_d0[0][0] * Ny_d0[0][1] - Nx_d0[0][1] * Ny_d0[0][0];
-    G1dotG1 = Nx_d0[0][0] * Nx_d0[0][0] + Nx_d0[0][1] * Nx_d0[0][1] + Nx_d0[0][2] * Nx_d0[0][2];
-
-    // Tangent Frame
-    ChVector<double> A1;
-    ChVector<double> A2;
-    ChVector<double> A3;
-    A1.x = Nx_d0[0][0];
-    A1.y = Nx_d0[0][1];
-    A1.z = Nx_d0[0][2];
-    A1 = A1 / sqrt(G1dotG1);
-    A3 = G1xG2.GetNormalized();
-    A2.Cross(A3, A1);
-
-    // Direction for orthotropic material
-    double theta = m_element->GetLayer(m_kl).Get_theta();  // Fiber angle
-    ChVector<double> AA1;
-    ChVector<double> AA2;
-    ChVector<double> AA3;
-    AA1 = A1 * cos(theta) + A2 * sin(theta);
-    AA2 = -A1 * sin(theta) + A2 * cos(theta);
-    AA3 = A3;
-
-    /// Beta
-    ChMatrixNM<double, 3, 3> j0;
-    ChVector<double> j01;
-    ChVector<double> j02;
-    ChVector<double> j03;
-    ChMatrixNM<double, 9, 1> beta;
-    // Calculates inverse of rd0 (j0) (position vector gradient: Initial Configuration)
-    j0(0, 0) = Ny_d0[0][1] * Nz_d0[0][2] - Nz_d0[0][1] * Ny_d0[0][2];
-    j0(0, 1) = Ny_d0[0][2] * Nz_d0[0][0] - Ny_d0[0][0] * Nz_d0[0][2];
-    j0(0, 2) = Ny_d0[0][0] * Nz_d0[0][1] - Nz_d0[0][0] * Ny_d0[0][1];
-    j0(1, 0) = Nz_d0[0][1] * Nx_d0[0][2] - Nx_d0[0][1] * Nz_d0[0][2];
-    j0(1, 1) = Nz_d0[0][2] * Nx_d0[0][0] - Nx_d0[0][2] * Nz_d0[0][0];
-    j0(1, 2) = Nz_d0[0][0] * Nx_d0[0][1] - Nz_d0[0][1] * Nx_d0[0][0];
-    j0(2, 0) = Nx_d0[0][1] * Ny_d0[0][2] - Ny_d0[0][1] * Nx_d0[0][2];
-    j0(2, 1) = Ny_d0[0][0] * Nx_d0[0][2] - Nx_d0[0][0] * Ny_d0[0][2];
-    j0(2, 2) = Nx_d0[0][0] * Ny_d0[0][1] - Ny_d0[0][0] * Nx_d0[0][1];
-    j0.MatrDivScale(detJ0);
-
-    j01(0) = j0(0, 0);
-    j02(0) = j0(1, 0);
-    j03(0) = j0(2, 0);
-    j01(1) = j0(0, 1);
-    j02(1) = j0(1, 1);
-    j03(1) = j0(2, 1);
-    j01(2) = j0(0, 2);
-    j02(2) = j0(1, 2);
-    j03(2) = j0(2, 2);
-
-    // Coefficients of contravariant transformation
-    beta(0, 0) = Vdot(AA1, j01);
-    beta(1, 0) = Vdot(AA2, j01);
-    beta(2, 0) = Vdot(AA3, j01);
-    beta(3, 0) = Vdot(AA1, j02);
-    beta(4, 0) = Vdot(AA2, j02);
-    beta(5, 0) = Vdot(AA3, j02);
-    beta(6, 0) = Vdot(AA1, j03);
-    beta(7, 0) = Vdot(AA2, j03);
-    beta(8, 0) = Vdot(AA3, j03);
-
-    // Transformation matrix, function of fiber angle
-    const ChMatrixNM<double, 6, 6>& T0 = m_element->GetLayer(m_kl).Get_T0();
-    // Determinant of the initial position vector gradient at the element center
-    double detJ0C = m_element->GetLayer(m_kl).Get_detJ0C();
+void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const ChElementShellANCF::GaussPoint& gp) {
+    // Reference configuration quantities at this Gauss point
+    const ChMatrixNM<double, 1, 8>& N = gp.N;
+    const ChMatrixNM<double, 1, 8>& Nx = gp.Nx;
+    const ChMatrixNM<double, 1, 8>& Ny = gp.Ny;
+    const ChMatrixNM<double, 1, 8>& Nz = gp.Nz;
+    const ChMatrixNM<double, 1, 4>& S_ANS = gp.S_ANS;
+    const ChMatrixNM<double, 3, 3>& j0 = gp.j0;
+    const ChMatrixNM<double, 9, 1>& beta = gp.beta;
+    const ChMatrixNM<double, 6, 5>& G = gp.G;
+    double detJ0 = gp.detJ0;
 
     // Enhanced Assumed Strain
-    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
     ChMatrixNM<double, 6, 1> strain_EAS = G * m_element->m_alphaEAS[m_kl];
 
     ChMatrixNM<double, 8, 1> ddNx;
     ChMatrixNM<double, 8, 1> ddNy;
-    ChMatrixNM<double, 8, 1> ddNz;
     ddNx.MatrMultiplyT(m_element->m_ddT, Nx);
     ddNy.MatrMultiplyT(m_element->m_ddT, Ny);
-    ddNz.MatrMultiplyT(m_element->m_ddT, Nz);
-
-    ChMatrixNM<double, 8, 1> d0d0Nx;
-    ChMatrixNM<double, 8, 1> d0d0Ny;
-    ChMatrixNM<double, 8, 1> d0d0Nz;
-    d0d0Nx.MatrMultiplyT(m_element->m_d0d0T, Nx);
-    d0d0Ny.MatrMultiplyT(m_element->m_d0d0T, Ny);
-    d0d0Nz.MatrMultiplyT(m_element->m_d0d0T, Nz);
 
     // Strain component
     ChMatrixNM<double, 6, 1> strain_til;
-    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - (Nx * d0d0Nx)(0, 0));
-    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - (Ny * d0d0Ny)(0, 0));
-    strain_til(2, 0) = (Nx * ddNy)(0, 0) - (Nx * d0d0Ny)(0, 0);
+    strain_til(0, 0) = 0.5 * ((Nx * ddNx)(0, 0) - gp.strain0(0, 0));
+    strain_til(1, 0) = 0.5 * ((Ny * ddNy)(0, 0) - gp.strain0(1, 0));
+    strain_til(2, 0) = (Nx * ddNy)(0, 0) - gp.strain0(2, 0);
     strain_til(3, 0) = N(0, 0) * m_element->m_strainANS(0, 0) + N(0, 2) * m_element->m_strainANS(1, 0) + N(0, 4) * m_element->m_strainANS(2, 0) +
         N(0, 6) * m_element->m_strainANS(3, 0);
     strain_til(4, 0) = S_ANS(0, 2) * m_element->m_strainANS(6, 0) + S_ANS(0, 3) * m_element->m_strainANS(7, 0);
@@ -1029,13 +981,7 @@ void ChElementShellANCF::ComputeInternalJacobians(double Kfactor, double Rfactor
     for (size_t kl = 0; kl < m_numLayers; kl++) {
         ChMatrixNM<double, 696, 1> result;
         MyJacobian formula(this, Kfactor, Rfactor, kl);
-        ChQuadrature::Integrate3D<ChMatrixNM<double, 696, 1> >(result,                          // result of integration
-                                                               formula,                         // integrand formula
-                                                               -1, 1,                           // x limits
-                                                               -1, 1,                           // y limits
-                                                               m_GaussZ[kl], m_GaussZ[kl + 1],  // z limits
-                                                               2                                // order of integration
-                                                               );
+        IntegrateLayer(result, formula, kl);
 
         // Extract matrices from result of integration
         ChMatrixNM<double, 24, 24> KTE;
@@ -198,6 +198,22 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     void ShapeFunctionsDerivativeZ(ChMatrix<>& Nz, double x, double y, double z);
 
   private:
+    /// Quantities of the internal force and Jacobian integrands at one Gauss point
+    /// which depend only on the initial configuration (cached in SetupInitial).
+    struct GaussPoint {
+        ChMatrixNM<double, 1, 8> N;        ///< shape functions
+        ChMatrixNM<double, 1, 8> Nx;       ///< shape function derivatives with respect to X
+        ChMatrixNM<double, 1, 8> Ny;       ///< shape function derivatives with respect to Y
+        ChMatrixNM<double, 1, 8> Nz;       ///< shape function derivatives with respect to Z
+        ChMatrixNM<double, 1, 4> S_ANS;    ///< ANS shape functions
+        ChMatrixNM<double, 3, 3> j0;       ///< inverse of the initial position vector gradient
+        ChMatrixNM<double, 9, 1> beta;     ///< coefficients of contravariant transformation
+        ChMatrixNM<double, 6, 5> G;        ///< EAS interpolation matrix
+        ChMatrixNM<double, 3, 1> strain0;  ///< in-plane strain terms of the initial configuration
+        double detJ0;                      ///< determinant of the initial position vector gradient
+        double weight;                     ///< Gauss quadrature weight
+    };
+
     std::vector<std::shared_ptr<ChNodeFEAxyzD> > m_nodes;  ///< element nodes
     std::vector<Layer> m_layers;                           ///< element layers
     size_t m_numLayers;                                    ///< number of layers for this element
@@ -220,6 +236,7 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     ChMatrixNM<double, 8, 24> m_strainANS_D;               ///< ANS strain derivatives
     std::vector<ChMatrixNM<double, 5, 1> > m_alphaEAS;     ///< EAS parameters (5 per layer)
     std::vector<ChMatrixNM<double, 5, 5> > m_KalphaEAS;    ///< EAS Jacobians (a 5x5 matrix per layer)
+    std::vector<GaussPoint> m_gaussPoints;                 ///< reference data at Gauss points (8 per layer)
 
     static const double m_toleranceEAS;   ///< tolerance for nonlinear EAS solver (on residual)
     static const int m_maxIterationsEAS;  ///< maximum number of nonlinear EAS iterations
@@ -288,6 +305,14 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     /// stiffness matrix H in the function ComputeKRMmatricesGlobal().
     void ComputeInternalJacobians(double Kfactor, double Rfactor);
 
+    /// Cache the initial configuration quantities at the Gauss points of all layers.
+    void SetupGaussPoints();
+
+    /// Integrate the internal force or Jacobian integrand over the specified layer,
+    /// using the cached Gauss point data.
+    template <class T, class F>
+    void IntegrateLayer(T& result, F& integrand, size_t kl);
+
     /// Compute the mass matrix of the element.
     /// Note: in this 'basic' implementation, constant section and
     /// constant material are assumed
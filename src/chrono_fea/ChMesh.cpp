@@ -265,28 +265,30 @@ void ChMesh::IntStateIncrement(
 }
 
 void ChMesh::IntLoadResidual_F(
-    const unsigned int off,		 ///< offset in R residual (not used here! use particle's offsets)
-    ChVectorDynamic<>& R,		 ///< result: the R residual, R += c*F
-    const double c				 ///< a scaling factor
-)
-{
-  // applied nodal forces
-  unsigned int local_off_v=0;
-  for (unsigned int j = 0; j < vnodes.size(); j++)
-  {
-    if (!vnodes[j]->GetFixed())
-    {
-      this->vnodes[j]->NodeIntLoadResidual_F(	off+local_off_v,
-          R,
-          c);
-      local_off_v += vnodes[j]->Get_ndof_w();
+    const unsigned int off,  ///< offset in R residual (not used here! use particle's offsets)
+    ChVectorDynamic<>& R,    ///< result: the R residual, R += c*F
+    const double c           ///< a scaling factor
+    ) {
+    // applied nodal forces
+    unsigned int local_off_v = 0;
+    for (unsigned int j = 0; j < vnodes.size(); j++) {
+        if (!vnodes[j]->GetFixed()) {
+            this->vnodes[j]->NodeIntLoadResidual_F(off + local_off_v, R, c);
+            local_off_v += vnodes[j]->Get_ndof_w();
+        }
     }
-  }
 
-  // internal forces
-#pragma omp parallel for
+    // internal forces: first computed for all elements in parallel, each in its own
+    // buffer, then assembled serially because elements sharing nodes write to the same
+    // entries of R.
+    element_forces.resize(this->velements.size());
+#pragma omp parallel for schedule(dynamic, 16)
     for (int ie = 0; ie < this->velements.size(); ie++) {
-        this->velements[ie]->EleIntLoadResidual_F(R, c);
+        element_forces[ie].Reset(this->velements[ie]->GetNdofs(), 1);
+        this->velements[ie]->ComputeInternalForces(element_forces[ie]);
+    }
+    for (unsigned int ie = 0; ie < this->velements.size(); ie++) {
+        this->velements[ie]->EleIntAssembleResidual_F(R, element_forces[ie], c);
     }
 
     // Apply gravity loads without the need of adding
@@ -308,7 +310,7 @@ void ChMesh::IntLoadResidual_F(
                 }
             }
         }
-  }
+    }
 }
 
 
@@ -62,6 +62,8 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
 	int num_points_gravity;
 
+    std::vector<ChMatrixDynamic<> > element_forces;  ///<  element-local buffers for internal forces
+
   public:
     ChMesh() {
         n_dofs = 0;
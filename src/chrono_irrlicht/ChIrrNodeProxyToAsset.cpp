@@ -59,7 +59,7 @@ void ChIrrNodeProxyToAsset::Update() {
     if (!visualization_asset)
         return;
 
-    if (auto trianglemesh = std::dynamic_pointer_cast<ChTriangleMeshShape>(visualization_asset)) {
+    if (auto trianglemesh = std::dynamic_pointer_cast<const ChTriangleMeshShape>(visualization_asset)) {
         // Fetch the 1st child, i.e. the mesh
         ISceneNode* mchildnode = *(getChildren().begin());
         if (!mchildnode)
@@ -73,7 +73,7 @@ void ChIrrNodeProxyToAsset::Update() {
         if (amesh->getMeshBufferCount() == 0)
             return;
 
-        geometry::ChTriangleMeshConnected* mmesh = &trianglemesh->GetMesh();
+        const geometry::ChTriangleMeshConnected* mmesh = &trianglemesh->GetMesh();
         unsigned int ntriangles = (unsigned int)mmesh->getIndicesVertexes().size();
         unsigned int nvertexes =
             ntriangles * 3;  // this is suboptimal because some vertexes might be shared, but easier now..
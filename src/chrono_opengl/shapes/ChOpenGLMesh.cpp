@@ -54,7 +54,7 @@ bool ChOpenGLMesh::Initialize(std::vector<glm::vec3>& vertices,
   return true;
 }
 
-bool ChOpenGLMesh::Initialize(chrono::ChTriangleMeshShape* tri_mesh, ChOpenGLMaterial mat) {
+bool ChOpenGLMesh::Initialize(const chrono::ChTriangleMeshShape* tri_mesh, ChOpenGLMaterial mat) {
   if (GLReturnedError("Mesh::Initialize - on entry")) {
     return false;
   }
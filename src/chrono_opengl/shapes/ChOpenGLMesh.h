@@ -38,7 +38,7 @@ class CH_OPENGL_API ChOpenGLMesh : public ChOpenGLObject {
                   std::vector<glm::vec2>& texcoords,
                   std::vector<GLuint>& indices,
                   ChOpenGLMaterial mat);
-  bool Initialize(chrono::ChTriangleMeshShape* tri_mesh, ChOpenGLMaterial mat);
+  bool Initialize(const chrono::ChTriangleMeshShape* tri_mesh, ChOpenGLMaterial mat);
   bool PostInitialize();
   void Update(std::vector<glm::mat4>& model);
   virtual void Draw(const glm::mat4& projection, const glm::mat4& view);
@@ -9,6 +9,8 @@ ChParallelDataManager::ChParallelDataManager()
       num_fluid_contacts(0),
       num_rigid_shapes(0),
       num_rigid_bodies(0),
+      num_particles(0),
+      num_new_bodies(0),
       num_fluid_bodies(0),
       num_unilaterals(0),
       num_bilaterals(0),
@@ -60,19 +60,41 @@ typedef blaze::DenseSubvector<const DynamicVector<real> > ConstSubVectorType;
 // The maximum number of shear history contacts per smaller body (DEM)
 #define max_shear 20
 
+// Compact a system-wide vector holding 'stride' entries per item (body or
+// shape), keeping only the entries of the listed items. The kept items are
+// given by their old index, in increasing order. Vectors that are not used by
+// the current system type are empty and are left untouched.
+template <typename T>
+void CompactHostVector(host_vector<T>& data, const std::vector<int>& kept, int stride = 1) {
+    if (data.size() == 0)
+        return;
+    host_vector<T> compacted(kept.size() * stride);
+#pragma omp parallel for
+    for (int i = 0; i < kept.size(); i++) {
+        for (int j = 0; j < stride; j++)
+            compacted[i * stride + j] = data[kept[i] * stride + j];
+    }
+    data.swap(compacted);
+}
+
 struct host_container {
     // Collision data
-    host_vector<real3> ObA_rigid;       // Position of shape
-    host_vector<real3> ObB_rigid;       // Size of shape (dims or convex data)
-    host_vector<real3> ObC_rigid;       // Rounded size
-    host_vector<real4> ObR_rigid;       // Shape rotation
+    // Shapes with the same local data share a shape prototype, so that the
+    // data of identical particles is stored once. The prototype data is
+    // indexed by the prototype of each shape (proto_rigid).
+    host_vector<real3> ObA_rigid;       // Position of shape prototype
+    host_vector<real3> ObB_rigid;       // Size of shape prototype (dims or convex data)
+    host_vector<real3> ObC_rigid;       // Shape prototype rounded size
+    host_vector<real4> ObR_rigid;       // Shape prototype rotation
+    host_vector<int> typ_rigid;         // Shape prototype type
+    host_vector<real> margin_rigid;     // Shape prototype inner collision margin
+    host_vector<real3> convex_data;     // list of convex points of the prototypes
+    // Per shape data
+    host_vector<int> proto_rigid;       // Prototype of each shape
     host_vector<short2> fam_rigid;      // Family information
-    host_vector<int> typ_rigid;         // Shape type
-    host_vector<real> margin_rigid;     // Inner collision margins
     host_vector<uint> id_rigid;         // Body identifier for each shape
     host_vector<real3> aabb_min_rigid;  // List of bounding boxes minimum point
     host_vector<real3> aabb_max_rigid;  // List of bounding boxes maximum point
-    host_vector<real3> convex_data;     // list of convex points
 
     // Contact data
     host_vector<real3> norm_rigid_rigid;
@@ -83,12 +105,20 @@ struct host_container {
     host_vector<int2> bids_rigid_rigid;
     host_vector<long long> pair_rigid_rigid;
 
+    // Contacts between rigid shapes and fluid nodes: x is the rigid body slot,
+    // y is the fluid node. The normal points from the rigid body to the node.
     host_vector<real3> norm_rigid_fluid;
     host_vector<real3> cpta_rigid_fluid;
     host_vector<real> dpth_rigid_fluid;
     host_vector<int2> bids_rigid_fluid;
 
+    // Pairs of fluid nodes closer than the kernel radius (x < y)
     host_vector<int2> bids_fluid_fluid;
+    // Neighbours of each fluid node, including the node itself, in increasing
+    // order: max_neighbors entries per node, of which only the first
+    // c_counts_fluid_fluid[i] are used.
+    host_vector<int> neighbor_fluid_fluid;
+    host_vector<int> c_counts_fluid_fluid;
 
     // Contact forces (DEM)
     // These vectors hold the total contact force and torque, respectively,
@@ -117,15 +147,27 @@ struct host_container {
     host_vector<real> coh_rigid_rigid;
 
     // Object data
+    // Rigid body slots: the bodies (in the order of the body list) followed by
+    // the particles of all particle clouds (ChParticleCloudParallel).
     host_vector<real3> pos_rigid;
     host_vector<real4> rot_rigid;
     host_vector<bool> active_rigid;
     host_vector<bool> collide_rigid;
     host_vector<real> mass_rigid;
 
+    // Particle state. These vectors are indexed by rigid body slot, like the
+    // ones above, but only the entries of particle slots are used: particles
+    // have no ChBody, so this is the only copy of their velocity and mass.
+    host_vector<real3> vel_particle;      // linear velocity (absolute frame)
+    host_vector<real3> omg_particle;      // angular velocity (local frame)
+    host_vector<real> inv_mass_particle;  // inverse of the mass
+    host_vector<real3> inv_inr_particle;  // inverse of the principal moments of inertia
+
+    // Fluid node data (3 dof per node). The mass and the radius of the nodes
+    // are in the fluid settings.
     host_vector<real3> pos_fluid;
     host_vector<real3> vel_fluid;
-    host_vector<real> den_fluid;
+    host_vector<real> den_fluid;  // density, computed at each step
 
     // Bilateral constraint type (all supported constraints)
     host_vector<int> bilateral_type;
@@ -157,16 +199,18 @@ struct host_container {
     //_t is tangential
     //_s is rolling and spinning
     //_b is bilateral
+    //_rf is rigid-fluid contact
+    //_ff is fluid density
     //_T is transpose
     //_inv is inverse
     // This matrix, if used will hold D^TxM^-1xD in sparse form
     CompressedMatrix<real> Nshur;
     // The D Matrix hold the Jacobian for the entire system
-    CompressedMatrix<real> D_n, D_t, D_s, D_b;
+    CompressedMatrix<real> D_n, D_t, D_s, D_b, D_rf, D_ff;
     // D_T is the transpose of the D matrix, note that D_T is actually computed
     // first and D is taken as the transpose. This is due to the way that blaze
     // handles sparse matrix allocation, it is easier to do it on a per row basis
-    CompressedMatrix<real> D_n_T, D_t_T, D_s_T, D_b_T;
+    CompressedMatrix<real> D_n_T, D_t_T, D_s_T, D_b_T, D_rf_T, D_ff_T;
     // M_inv is the inverse mass matrix, This matrix, if holding the full inertia
     // tensor is block diagonal
     CompressedMatrix<real> M_inv;
@@ -175,7 +219,7 @@ struct host_container {
     // performed in two steps, first R = Minv_D*x, and then D_T*R where R is just
     // a temporary variable used here for illustrative purposes. In reality the
     // entire operation happens inline without a temp variable.
-    CompressedMatrix<real> M_invD_n, M_invD_t, M_invD_s, M_invD_b;
+    CompressedMatrix<real> M_invD_n, M_invD_t, M_invD_s, M_invD_b, M_invD_rf, M_invD_ff;
 
     DynamicVector<real> R_full;  // The right hand side of the system
     DynamicVector<real> R;       // The rhs of the system, changes during solve
@@ -214,8 +258,10 @@ class CH_PARALLEL_API ChParallelDataManager {
     std::vector<std::shared_ptr<ChPhysicsItem> >* other_physics_list;  // List to other items
 
     // Indexing variables
-    uint num_rigid_bodies;          // The number of rigid bodies in a system
-    uint num_fluid_bodies;          // The number of fluid bodies in the system
+    uint num_rigid_bodies;          // The number of rigid body slots (bodies and particles) in a system
+    uint num_particles;             // The number of particles (slots after the bodies)
+    uint num_new_bodies;            // The number of bodies added after the particles, not yet moved before them
+    uint num_fluid_bodies;          // The number of fluid nodes in the system (after the shafts in the dof)
     uint num_shafts;                // The number of shafts in a system
     uint num_dof;                   // The number of degrees of freedom in the system
     uint num_rigid_shapes;          // The number of collision models in a system
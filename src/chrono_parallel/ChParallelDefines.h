@@ -20,6 +20,7 @@
 #undef _GLIBCXX_ATOMIC_BUILTINS
 #undef _GLIBCXX_USE_INT128
 
+#include <algorithm>
 #include <iostream>
 
 #ifndef _MSC_VER
@@ -109,6 +110,15 @@ static std::ostream null_stream(&null_buffer);
 #define Thrust_Unique(x) thrust::unique(x.begin(), x.end()) - x.begin();
 #define DBG(x) printf(x);
 
+// Make room for n elements before a batch of push_back. Unlike a plain
+// reserve(n), the capacity grows geometrically, so that repeated small batches
+// stay linear in the final size.
+template <typename T>
+inline void Reserve_Geometric(T& x, size_t n) {
+    if (n > x.capacity())
+        x.reserve(std::max(n, 2 * (size_t)x.capacity()));
+}
+
 enum SOLVERTYPE {
     STEEPEST_DESCENT,
     GRADIENT_DESCENT,
@@ -202,6 +202,42 @@ struct solver_settings {
   real tolerance_objective;
 };
 
+// fluid_settings contains the parameters of the fluid nodes and of the
+// constraints that act on them (DVI only). All fluid nodes share these values.
+struct fluid_settings {
+  fluid_settings() {
+    kernel_radius = .04;
+    collision_radius = .01;
+    mass = .008;
+    density = 1000;
+    epsilon = 1e-3;
+    tau = 0;
+    max_neighbors = 64;
+  }
+
+  // The radius of the SPH kernel used to compute the density of the fluid. It
+  // is also the size of the cells used to find the neighbours of each node.
+  // For a regular packing of the nodes, a kernel radius of about twice the
+  // distance between the nodes is a good choice.
+  real kernel_radius;
+  // The radius of the sphere used for the contacts between fluid nodes and
+  // rigid shapes.
+  real collision_radius;
+  // The mass of each fluid node
+  real mass;
+  // The rest density of the fluid, the density constraints keep the density
+  // of each node below this value.
+  real density;
+  // Compliance of the density constraints
+  real epsilon;
+  // Time constant used to correct the density error: the error is removed in
+  // (step size + tau) seconds.
+  real tau;
+  // The maximum number of neighbours (including itself) stored for each node,
+  // farther neighbours are ignored.
+  int max_neighbors;
+};
+
 struct settings_container {
   settings_container() {
     // The default minimum number of threads is 1, set this to your max threads
@@ -220,12 +256,15 @@ struct settings_container {
     perform_thread_tuning = ((min_threads == max_threads) ? false : true);
     system_type = SYSTEM_DVI;
     step_size = .01;
+    deterministic = false;
   }
 
   // The settings for the collision detection
   collision_settings collision;
   // The settings for the solver
   solver_settings solver;
+  // The settings for the fluid
+  fluid_settings fluid;
   // System level settings
   // If set to true chrono parallel will automatically check to see if increasing
   // the number of threads will improve performance. If performance is improved
@@ -238,6 +277,11 @@ struct settings_container {
   int min_threads;
   // This is the number of threads that the simulation will not exceed
   int max_threads;
+  // If set to true the results do not depend on the number of threads: the
+  // contacts are sorted by shape pair, the reductions in the solvers are done in
+  // a fixed order and the thread tuning is disabled. This costs some performance
+  // (measured by the benchmarkDeterministic demo), so it is off by default.
+  bool deterministic;
   // The timestep of the simulation. This value is copied from chrono currently,
   // setting it has no effect.
   real step_size;
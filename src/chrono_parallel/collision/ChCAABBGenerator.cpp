@@ -145,6 +145,7 @@ ChCAABBGenerator::ChCAABBGenerator() {
 void ChCAABBGenerator::GenerateAABB() {
   const host_vector<shape_type>& obj_data_T = data_manager->host_data.typ_rigid;
   const host_vector<uint>& obj_data_ID = data_manager->host_data.id_rigid;
+  const host_vector<int>& obj_data_P = data_manager->host_data.proto_rigid;
   const host_vector<real3>& obj_data_A = data_manager->host_data.ObA_rigid;
   const host_vector<real3>& obj_data_B = data_manager->host_data.ObB_rigid;
   const host_vector<real3>& obj_data_C = data_manager->host_data.ObC_rigid;
@@ -165,13 +166,14 @@ void ChCAABBGenerator::GenerateAABB() {
 
 #pragma omp parallel for
   for (int index = 0; index < num_rigid_shapes; index++) {
-    shape_type type = obj_data_T[index];
     uint id = obj_data_ID[index];
-    real3 A = obj_data_A[index];
-    real3 B = obj_data_B[index];
-    real3 C = obj_data_C[index];
+    int proto = obj_data_P[index];
+    shape_type type = obj_data_T[proto];
+    real3 A = obj_data_A[proto];
+    real3 B = obj_data_B[proto];
+    real3 C = obj_data_C[proto];
     real3 position = body_pos[id];
-    real4 rotation = (mult(body_rot[id], obj_data_R[index]));
+    real4 rotation = (mult(body_rot[id], obj_data_R[proto]));
     real3 temp_min;
     real3 temp_max;
 
@@ -184,12 +186,12 @@ void ChCAABBGenerator::GenerateAABB() {
       C = quatRotate(C, body_rot[id]) + position;
       ComputeAABBTriangle(A, B, C, temp_min, temp_max);
     } else if (type == ELLIPSOID || type == BOX || type == CYLINDER || type == CONE) {
-      ComputeAABBBox(B + collision_envelope, A, position, obj_data_R[index], body_rot[id], temp_min, temp_max);
+      ComputeAABBBox(B + collision_envelope, A, position, obj_data_R[proto], body_rot[id], temp_min, temp_max);
     } else if (type == ROUNDEDBOX || type == ROUNDEDCYL || type == ROUNDEDCONE) {
-      ComputeAABBBox(B + C.x + collision_envelope, A, position, obj_data_R[index], body_rot[id], temp_min, temp_max);
+      ComputeAABBBox(B + C.x + collision_envelope, A, position, obj_data_R[proto], body_rot[id], temp_min, temp_max);
     } else if (type == CAPSULE) {
       real3 B_ = R3(B.x, B.x + B.y, B.z) + collision_envelope;
-      ComputeAABBBox(B_, A, position, obj_data_R[index], body_rot[id], temp_min, temp_max);
+      ComputeAABBBox(B_, A, position, obj_data_R[proto], body_rot[id], temp_min, temp_max);
     } else if (type == CONVEX) {
       ComputeAABBConvex(convex_data.data(), B, A, position, rotation, temp_min, temp_max);
       temp_min -= collision_envelope;
@@ -302,6 +302,13 @@ void ChCBroadphase::DetectPossibleCollisions() {
 
   contact_pairs.resize(number_of_contacts_possible);
 
+  // The order of the shapes within a bin comes from a sort that is not
+  // guaranteed to be stable; sort the pairs by key so that the contacts are
+  // generated in the same order with any number of threads.
+  if (data_manager->settings.deterministic) {
+    Thrust_Sort(contact_pairs);
+  }
+
   LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
 
   return;
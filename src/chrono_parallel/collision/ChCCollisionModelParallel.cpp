@@ -439,9 +439,35 @@ bool ChCollisionModelParallel::AddTriangleMesh(const geometry::ChTriangleMesh& t
 }
 
 bool ChCollisionModelParallel::AddCopyOfAnotherModel(ChCollisionModel* another) {
-  // NOT SUPPORTED
-  return false;
+  // Shapes are stored by value in the system-wide vectors, so the shape data
+  // of the other model is simply copied (no need to recompute it).
+  ChCollisionModelParallel* pmodel = static_cast<ChCollisionModelParallel*>(another);
+
+  SetSafeMargin(pmodel->GetSafeMargin());
+  SetEnvelope(pmodel->GetEnvelope());
+
+  mData = pmodel->mData;
+  local_convex_data = pmodel->local_convex_data;
+  nObjects = pmodel->nObjects;
+  inertia = pmodel->inertia;
+  total_volume = pmodel->total_volume;
+
+  return true;
 }
+bool ChCollisionModelParallel::AddShape(const ConvexShape& shape, const real3* points) {
+  nObjects++;
+  ConvexShape tData = shape;
+  tData.convex = 0;
+  if (shape.type == CONVEX) {
+    int num_points = int(shape.B.x);
+    tData.B.y = local_convex_data.size();
+    local_convex_data.insert(local_convex_data.end(), points, points + num_points);
+  }
+  mData.push_back(tData);
+
+  return true;
+}
+
 void ChCollisionModelParallel::GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const {
 }
 
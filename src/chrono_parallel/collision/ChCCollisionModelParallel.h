@@ -159,13 +159,16 @@ class CH_PARALLEL_API ChCollisionModelParallel : public ChCollisionModel {
                          const ChVector<>& pos = ChVector<>(),
                          const ChMatrix33<>& rot = ChMatrix33<>(1));
 
-  /// Add all shapes already contained in another model.
-  /// Thank to the adoption of shared pointers, underlying shapes are
-  /// shared (not copied) among the models; this will save memory when you must
-  /// simulate thousands of objects with the same collision shape.
-  /// The 'another' model must be of ChModelBullet subclass.
+  /// Add all shapes already contained in another model, replacing the
+  /// current ones. The shape data is copied from the other model, without
+  /// recomputing it. The 'another' model must be of ChCollisionModelParallel class.
   virtual bool AddCopyOfAnotherModel(ChCollisionModel* another);
 
+  /// Add a shape given by its raw data, expressed in the centroidal frame of
+  /// the body (e.g. a shape of another model, received from another process).
+  /// For a convex hull, shape.B.x is the number of points, read from 'points'.
+  bool AddShape(const ConvexShape& shape, const real3* points = 0);
+
   /// Return the axis aligned bounding box for this collision model.
   virtual void GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const;
 
@@ -78,6 +78,8 @@ void ChCollisionSystemBulletParallel::Remove(ChCollisionModel* model) {
   ChModelBullet* bmodel = static_cast<ChModelBullet*>(model);
   if (bmodel->GetBulletModel()->getCollisionShape()) {
     bt_collision_world->removeCollisionObject(bmodel->GetBulletModel());
+    counter--;
+    data_manager->num_rigid_shapes--;
   }
 }
 
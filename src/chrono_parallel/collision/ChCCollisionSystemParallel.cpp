@@ -17,15 +17,18 @@ ChCollisionSystemParallel::ChCollisionSystemParallel(ChParallelDataManager* dm)
   broadphase = new ChCBroadphase;
   narrowphase = new ChCNarrowphaseDispatch;
   aabb_generator = new ChCAABBGenerator;
+  fluid_collision = new ChCFluidCollision;
   broadphase->data_manager = dm;
   narrowphase->data_manager = dm;
   aabb_generator->data_manager = dm;
+  fluid_collision->data_manager = dm;
 }
 
 ChCollisionSystemParallel::~ChCollisionSystemParallel() {
   delete narrowphase;
   delete broadphase;
   delete aabb_generator;
+  delete fluid_collision;
 }
 
 void ChCollisionSystemParallel::Add(ChCollisionModel* model) {
@@ -33,54 +36,193 @@ void ChCollisionSystemParallel::Add(ChCollisionModel* model) {
     ChCollisionModelParallel* pmodel = static_cast<ChCollisionModelParallel*>(model);
     int body_id = pmodel->GetBody()->GetId();
     short2 fam = S2(pmodel->GetFamilyGroup(), pmodel->GetFamilyMask());
-    // The offset for this shape will the current total number of points in
-    // the convex data list
-    int convex_data_offset = data_manager->host_data.convex_data.size();
-    // Insert the points into the global convex list
-    data_manager->host_data.convex_data.insert(data_manager->host_data.convex_data.end(),
-                                               pmodel->local_convex_data.begin(), pmodel->local_convex_data.end());
 
+    // Each shape only stores its body, its family and the index of its
+    // prototype, which holds the actual shape data.
     for (int j = 0; j < pmodel->GetNObjects(); j++) {
-      real3 obB = pmodel->mData[j].B;
-
-      // Compute the global offset of the convex data structure based on the number of points
-      // already present
-      if (pmodel->mData[j].type == CONVEX) {
-        obB.y += convex_data_offset;  // update to get the global offset
-      }
-
-      data_manager->host_data.ObA_rigid.push_back(pmodel->mData[j].A);
-      data_manager->host_data.ObB_rigid.push_back(obB);
-      data_manager->host_data.ObC_rigid.push_back(pmodel->mData[j].C);
-      data_manager->host_data.ObR_rigid.push_back(pmodel->mData[j].R);
+      data_manager->host_data.proto_rigid.push_back(FindShapePrototype(pmodel->mData[j], pmodel->local_convex_data));
       data_manager->host_data.fam_rigid.push_back(fam);
-      data_manager->host_data.margin_rigid.push_back(pmodel->mData[j].margin);
-      data_manager->host_data.typ_rigid.push_back(pmodel->mData[j].type);
       data_manager->host_data.id_rigid.push_back(body_id);
       data_manager->num_rigid_shapes++;
     }
   }
 }
 
+static void AppendKey(std::string& key, real value) {
+  key.append((const char*)&value, sizeof(real));
+}
+
+int ChCollisionSystemParallel::FindShapePrototype(const ConvexShape& shape, const std::vector<real3>& local_convex_data) {
+  host_container& host_data = data_manager->host_data;
+
+  // For convex hulls, B holds the number of points and their offset in the
+  // list of points of the model.
+  int num_points = 0;
+  int first_point = 0;
+  if (shape.type == CONVEX) {
+    num_points = int(shape.B.x);
+    first_point = int(shape.B.y);
+  }
+
+  // The key is made of the shape data (without the offset of convex points,
+  // but with the points themselves). Triangles of meshes are seldom shared
+  // and may be moved in place by the user, so they always get a new prototype.
+  std::string key;
+  if (shape.type != TRIANGLEMESH) {
+    key.reserve(sizeof(real) * (15 + 3 * num_points) + sizeof(shape_type));
+    key.append((const char*)&shape.type, sizeof(shape_type));
+    AppendKey(key, shape.A.x);
+    AppendKey(key, shape.A.y);
+    AppendKey(key, shape.A.z);
+    AppendKey(key, shape.B.x);
+    AppendKey(key, shape.type == CONVEX ? 0 : shape.B.y);
+    AppendKey(key, shape.B.z);
+    AppendKey(key, shape.C.x);
+    AppendKey(key, shape.C.y);
+    AppendKey(key, shape.C.z);
+    AppendKey(key, shape.R.w);
+    AppendKey(key, shape.R.x);
+    AppendKey(key, shape.R.y);
+    AppendKey(key, shape.R.z);
+    AppendKey(key, shape.margin);
+    for (int i = first_point; i < first_point + num_points; i++) {
+      AppendKey(key, local_convex_data[i].x);
+      AppendKey(key, local_convex_data[i].y);
+      AppendKey(key, local_convex_data[i].z);
+    }
+
+    std::unordered_map<std::string, int>::iterator it = shape_prototypes.find(key);
+    if (it != shape_prototypes.end())
+      return it->second;
+  }
+
+  // Add a new prototype. The offset of convex points becomes the one in the
+  // global list of points.
+  int index = host_data.typ_rigid.size();
+  real3 obB = shape.B;
+  if (shape.type == CONVEX) {
+    obB.y = host_data.convex_data.size();
+    host_data.convex_data.insert(host_data.convex_data.end(), local_convex_data.begin() + first_point,
+                                 local_convex_data.begin() + first_point + num_points);
+  }
+
+  host_data.ObA_rigid.push_back(shape.A);
+  host_data.ObB_rigid.push_back(obB);
+  host_data.ObC_rigid.push_back(shape.C);
+  host_data.ObR_rigid.push_back(shape.R);
+  host_data.margin_rigid.push_back(shape.margin);
+  host_data.typ_rigid.push_back(shape.type);
+
+  if (!key.empty())
+    shape_prototypes[key] = index;
+
+  return index;
+}
+
+void ChCollisionSystemParallel::CompactShapePrototypes() {
+  host_container& host_data = data_manager->host_data;
+  int num_prototypes = host_data.typ_rigid.size();
+
+  std::vector<int> proto_map(num_prototypes, -1);
+  for (int i = 0; i < host_data.proto_rigid.size(); i++)
+    proto_map[host_data.proto_rigid[i]] = 0;
+
+  std::vector<int> kept;
+  kept.reserve(num_prototypes);
+  for (int i = 0; i < num_prototypes; i++) {
+    if (proto_map[i] != -1) {
+      proto_map[i] = kept.size();
+      kept.push_back(i);
+    }
+  }
+
+  // The points of convex prototypes are stored in a global list, the
+  // prototype holding the number of points and the offset in that list.
+  custom_vector<real3> convex_data;
+  for (int i = 0; i < kept.size(); i++) {
+    real3& obB = host_data.ObB_rigid[kept[i]];
+    if (host_data.typ_rigid[kept[i]] == CONVEX) {
+      int offset = convex_data.size();
+      convex_data.insert(convex_data.end(), host_data.convex_data.begin() + int(obB.y),
+                         host_data.convex_data.begin() + int(obB.y) + int(obB.x));
+      obB.y = offset;
+    }
+  }
+  host_data.convex_data.swap(convex_data);
+
+  CompactHostVector(host_data.ObA_rigid, kept);
+  CompactHostVector(host_data.ObB_rigid, kept);
+  CompactHostVector(host_data.ObC_rigid, kept);
+  CompactHostVector(host_data.ObR_rigid, kept);
+  CompactHostVector(host_data.margin_rigid, kept);
+  CompactHostVector(host_data.typ_rigid, kept);
+
+#pragma omp parallel for
+  for (int i = 0; i < host_data.proto_rigid.size(); i++) {
+    host_data.proto_rigid[i] = proto_map[host_data.proto_rigid[i]];
+  }
+
+  // Renumber the map of prototypes, dropping the unused ones.
+  std::unordered_map<std::string, int>::iterator it = shape_prototypes.begin();
+  while (it != shape_prototypes.end()) {
+    if (proto_map[it->second] == -1) {
+      it = shape_prototypes.erase(it);
+    } else {
+      it->second = proto_map[it->second];
+      ++it;
+    }
+  }
+}
+
+void ChCollisionSystemParallel::ReserveModels(const std::vector<ChCollisionModel*>& models) {
+  // Count the shapes of the whole batch, so that the per-shape vectors are
+  // grown only once. Prototypes are few, and are added when needed.
+  size_t num_shapes = 0;
+  for (size_t i = 0; i < models.size(); i++) {
+    if (models[i]->GetPhysicsItem()->GetCollide() == true)
+      num_shapes += static_cast<ChCollisionModelParallel*>(models[i])->GetNObjects();
+  }
+
+  host_container& host_data = data_manager->host_data;
+  size_t total = host_data.id_rigid.size() + num_shapes;
+  Reserve_Geometric(host_data.proto_rigid, total);
+  Reserve_Geometric(host_data.fam_rigid, total);
+  Reserve_Geometric(host_data.id_rigid, total);
+}
+
+void ChCollisionSystemParallel::AddShapes(ChCollisionModelParallel* model, int first_slot, int num) {
+  int num_objects = model->GetNObjects();
+  short2 fam = S2(model->GetFamilyGroup(), model->GetFamilyMask());
+
+  // The prototypes are looked up once for all slots.
+  std::vector<int> protos(num_objects);
+  for (int j = 0; j < num_objects; j++) {
+    protos[j] = FindShapePrototype(model->mData[j], model->local_convex_data);
+  }
+
+  host_container& host_data = data_manager->host_data;
+  size_t first_shape = host_data.id_rigid.size();
+  size_t total = first_shape + (size_t)num * num_objects;
+  host_data.proto_rigid.resize(total);
+  host_data.fam_rigid.resize(total);
+  host_data.id_rigid.resize(total);
+
+#pragma omp parallel for
+  for (int i = 0; i < num; i++) {
+    for (int j = 0; j < num_objects; j++) {
+      size_t shape = first_shape + (size_t)i * num_objects + j;
+      host_data.proto_rigid[shape] = protos[j];
+      host_data.fam_rigid[shape] = fam;
+      host_data.id_rigid[shape] = first_slot + i;
+    }
+  }
+
+  data_manager->num_rigid_shapes += num * num_objects;
+}
+
 void ChCollisionSystemParallel::Remove(ChCollisionModel* model) {
-  //            ChCollisionModelGPU *body = (ChCollisionModelGPU *) model;
-  //            int body_id = ((ChBodyGPU *) body->GetBody())->id;
-  //
-  //            //for (int j = 0; j < body->GetNObjects(); j++) {
-  //            for (int i = 0; i < data_manager->host_typ_data.size(); i++) {
-  //                if (data_manager->host_typ_data[i].z == body_id) {
-  //                    data_manager->host_ObA_data.erase(data_manager->host_ObA_data.begin() + i);
-  //                    data_manager->host_ObB_data.erase(data_manager->host_ObB_data.begin() + i);
-  //                    data_manager->host_ObC_data.erase(data_manager->host_ObC_data.begin() + i);
-  //                    data_manager->host_ObR_data.erase(data_manager->host_ObR_data.begin() + i);
-  //                    data_manager->host_fam_data.erase(data_manager->host_fam_data.begin() + i);
-  //                    data_manager->host_typ_data.erase(data_manager->host_typ_data.begin() + i);
-  //                    data_manager->num_models--;
-  //                    return;
-  //                }
-  //            }
-  //
-  //            //}
+  // Shapes are stored in system-wide vectors indexed by body; they are removed
+  // in bulk, together with the body data, by ChSystemParallel::RemoveBodies().
 }
 
 void ChCollisionSystemParallel::Run() {
@@ -96,24 +238,29 @@ void ChCollisionSystemParallel::Run() {
     }
   }
 
-  if (data_manager->num_rigid_shapes <= 0) {
-    return;
-  }
+  if (data_manager->num_rigid_shapes > 0) {
+    data_manager->system_timer.start("collision_broad");
+    aabb_generator->GenerateAABB();
+    broadphase->DetectPossibleCollisions();
+    data_manager->system_timer.stop("collision_broad");
 
-  data_manager->system_timer.start("collision_broad");
-  aabb_generator->GenerateAABB();
-  broadphase->DetectPossibleCollisions();
-  data_manager->system_timer.stop("collision_broad");
+    data_manager->system_timer.start("collision_narrow");
+    narrowphase->Process();
+    data_manager->system_timer.stop("collision_narrow");
+  }
 
-  data_manager->system_timer.start("collision_narrow");
-  narrowphase->Process();
-  data_manager->system_timer.stop("collision_narrow");
+  // The fluid uses the AABBs of the rigid shapes computed above
+  if (data_manager->num_fluid_bodies > 0) {
+    data_manager->system_timer.start("collision_fluid");
+    fluid_collision->Process();
+    data_manager->system_timer.stop("collision_fluid");
+  }
 }
 
 void ChCollisionSystemParallel::GetOverlappingAABB(custom_vector<bool>& active_id, real3 Amin, real3 Amax) {
   aabb_generator->GenerateAABB();
 #pragma omp parallel for
-  for (int i = 0; i < data_manager->host_data.typ_rigid.size(); i++) {
+  for (int i = 0; i < data_manager->num_rigid_shapes; i++) {
     real3 Bmin = data_manager->host_data.aabb_min_rigid[i];
     real3 Bmax = data_manager->host_data.aabb_max_rigid[i];
 
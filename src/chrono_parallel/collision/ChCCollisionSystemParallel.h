@@ -1,5 +1,8 @@
 #pragma once
 
+#include <string>
+#include <unordered_map>
+
 #include "physics/ChProximityContainerBase.h"
 #include "physics/ChBody.h"
 
@@ -12,6 +15,7 @@
 #include "chrono_parallel/collision/ChCAABBGenerator.h"
 #include "chrono_parallel/collision/ChCNarrowphaseDispatch.h"
 #include "chrono_parallel/collision/ChCBroadphase.h"
+#include "chrono_parallel/collision/ChCFluidCollision.h"
 
 namespace chrono {
 
@@ -36,6 +40,15 @@ class CH_PARALLEL_API ChCollisionSystemParallel : public ChCollisionSystem {
   /// engine (custom data may be allocated).
   virtual void Add(ChCollisionModel* model);
 
+  /// Reserves space in the system-wide shape vectors for the
+  /// shapes of the given models, before they are added.
+  virtual void ReserveModels(const std::vector<ChCollisionModel*>& models);
+
+  /// Adds the shapes of the given model for each one of 'num' consecutive
+  /// rigid body slots, starting at 'first_slot' (used for the particles of a
+  /// particle cloud, which share the shape prototypes of a single model).
+  void AddShapes(ChCollisionModelParallel* model, int first_slot, int num);
+
   /// Removes a collision model from the collision
   /// engine (custom data may be deallocated).
   virtual void Remove(ChCollisionModel* model);
@@ -88,13 +101,26 @@ class CH_PARALLEL_API ChCollisionSystemParallel : public ChCollisionSystem {
   }
 
  private:
+  /// Return the index of the shape prototype with the same data as the given
+  /// shape (of a collision model with the given convex points), adding a new
+  /// prototype if there is none.
+  int FindShapePrototype(const ConvexShape& shape, const std::vector<real3>& local_convex_data);
+
+  /// Remove the prototypes that are not used by any shape, after shapes have
+  /// been removed, and renumber the prototype of each shape.
+  void CompactShapePrototypes();
+
   ChCBroadphase* broadphase;
   ChCNarrowphaseDispatch* narrowphase;
 
   ChCAABBGenerator* aabb_generator;
+  ChCFluidCollision* fluid_collision;
 
   ChParallelDataManager* data_manager;
 
+  // Map from the shape data to the index of the prototype
+  std::unordered_map<std::string, int> shape_prototypes;
+
   friend class chrono::ChSystemParallel;
 };
 
@@ -0,0 +1,292 @@
+#include <algorithm>
+
+#include "collision/ChCCollisionModel.h"
+#include "chrono_parallel/collision/ChCFluidCollision.h"
+#include "chrono_parallel/collision/ChCBroadphaseUtils.h"
+#include "chrono_parallel/collision/ChCNarrowphaseMPR.h"
+#include "chrono_parallel/collision/ChCNarrowphaseR.h"
+
+#include <thrust/transform_reduce.h>
+
+namespace chrono {
+namespace collision {
+
+void ChCFluidCollision::Process() {
+  LOG(INFO) << "ChCFluidCollision::Process()";
+  if (data_manager->num_fluid_bodies == 0) {
+    data_manager->num_fluid_contacts = 0;
+    data_manager->num_rigid_fluid_contacts = 0;
+    return;
+  }
+
+  SortNodes();
+  DetectFluidFluid();
+  DetectRigidFluid();
+}
+
+int3 ChCFluidCollision::GetCell(const real3& point) const {
+  return HashMin(point - grid_min, R3(inv_cell_size));
+}
+
+long long ChCFluidCollision::GetKey(const int3& cell) const {
+  return ((long long)cell.z * bins_per_axis.y + cell.y) * bins_per_axis.x + cell.x;
+}
+
+void ChCFluidCollision::GetCellRange(const int3& cell, int& start, int& end) const {
+  long long key = GetKey(cell);
+  start = std::lower_bound(node_key.begin(), node_key.end(), key) - node_key.begin();
+  end = std::upper_bound(node_key.begin() + start, node_key.end(), key) - node_key.begin();
+}
+
+// Sort the fluid nodes by cell. The grid covers the bounding box of the
+// nodes, so that its size only depends on the extent of the fluid.
+void ChCFluidCollision::SortNodes() {
+  const custom_vector<real3>& pos = data_manager->host_data.pos_fluid;
+  uint num_nodes = data_manager->num_fluid_bodies;
+  real cell_size = data_manager->settings.fluid.kernel_radius;
+
+  bbox res = bbox(pos[0], pos[0]);
+  bbox_transformation unary_op;
+  bbox_reduction binary_op;
+  res = thrust::transform_reduce(thrust_parallel, pos.begin(), pos.end(), unary_op, res, binary_op);
+
+  grid_min = res.first;
+  inv_cell_size = 1.0 / cell_size;
+  int3 last_cell = HashMin(res.second - res.first, R3(inv_cell_size));
+  bins_per_axis = I3(last_cell.x + 1, last_cell.y + 1, last_cell.z + 1);
+
+  node_key.resize(num_nodes);
+  sorted_node.resize(num_nodes);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_nodes; i++) {
+    node_key[i] = GetKey(GetCell(pos[i]));
+    sorted_node[i] = i;
+  }
+
+  Thrust_Sort_By_Key(node_key, sorted_node);
+}
+
+// Each node stores the nodes closer than the kernel radius, itself included,
+// in increasing order. If there are more than max_neighbors of them, the ones
+// found last are dropped.
+void ChCFluidCollision::DetectFluidFluid() {
+  const custom_vector<real3>& pos = data_manager->host_data.pos_fluid;
+  custom_vector<int>& neighbors = data_manager->host_data.neighbor_fluid_fluid;
+  custom_vector<int>& counts = data_manager->host_data.c_counts_fluid_fluid;
+  custom_vector<int2>& bids = data_manager->host_data.bids_fluid_fluid;
+  uint num_nodes = data_manager->num_fluid_bodies;
+  int max_neighbors = data_manager->settings.fluid.max_neighbors;
+  real h2 = data_manager->settings.fluid.kernel_radius * data_manager->settings.fluid.kernel_radius;
+
+  neighbors.resize(num_nodes * max_neighbors);
+  counts.resize(num_nodes);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_nodes; i++) {
+    real3 pos_i = pos[i];
+    int3 cell = GetCell(pos_i);
+    int* list = neighbors.data() + i * max_neighbors;
+    int count = 0;
+    list[count++] = i;
+
+    for (int k = cell.z - 1; k <= cell.z + 1; k++) {
+      for (int j = cell.y - 1; j <= cell.y + 1; j++) {
+        for (int l = cell.x - 1; l <= cell.x + 1; l++) {
+          if (l < 0 || j < 0 || k < 0 || l >= bins_per_axis.x || j >= bins_per_axis.y || k >= bins_per_axis.z) {
+            continue;
+          }
+          int start, end;
+          GetCellRange(I3(l, j, k), start, end);
+          for (int n = start; n < end && count < max_neighbors; n++) {
+            int node = sorted_node[n];
+            real3 d = pos[node] - pos_i;
+            if (node != i && dot(d, d) < h2) {
+              list[count++] = node;
+            }
+          }
+        }
+      }
+    }
+
+    std::sort(list, list + count);
+    counts[i] = count;
+  }
+
+  // List the pairs (i, j) with i < j: the first pair of node i is stored after
+  // the pairs of the nodes before it.
+  custom_vector<int> pair_start(num_nodes + 1);
+  pair_start[0] = 0;
+  for (int i = 0; i < num_nodes; i++) {
+    const int* list = neighbors.data() + i * max_neighbors;
+    pair_start[i + 1] = pair_start[i] + int(list + counts[i] - std::upper_bound(list, list + counts[i], i));
+  }
+
+  data_manager->num_fluid_contacts = pair_start[num_nodes];
+  bids.resize(data_manager->num_fluid_contacts);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_nodes; i++) {
+    const int* list = neighbors.data() + i * max_neighbors;
+    int index = pair_start[i];
+    for (const int* j = std::upper_bound(list, list + counts[i], i); j < list + counts[i]; j++) {
+      bids[index++] = I2(i, *j);
+    }
+  }
+}
+
+// Global data of a rigid collision shape, as in the narrowphase.
+static void GetGlobalShape(ChParallelDataManager* data_manager, int index, ConvexShape& shape) {
+  host_container& host = data_manager->host_data;
+  int P = host.proto_rigid[index];
+  uint ID = host.id_rigid[index];
+  real3 pos = host.pos_rigid[ID];
+  real4 rot = host.rot_rigid[ID];
+
+  shape.type = host.typ_rigid[P];
+  shape.A = TransformLocalToParent(pos, rot, host.ObA_rigid[P]);
+  if (shape.type == TRIANGLEMESH) {
+    shape.B = TransformLocalToParent(pos, rot, host.ObB_rigid[P]);
+    shape.C = TransformLocalToParent(pos, rot, host.ObC_rigid[P]);
+  } else {
+    shape.B = host.ObB_rigid[P];
+    shape.C = host.ObC_rigid[P];
+  }
+  shape.R = mult(rot, host.ObR_rigid[P]);
+  shape.convex = host.convex_data.data();
+  shape.margin = host.margin_rigid[P];
+}
+
+// The candidate pairs are the nodes in the cells overlapped by the AABB of each
+// rigid shape (grown by the node radius). They are counted, then listed, and
+// finally tested in parallel with the narrowphase used for the rigid contacts.
+// A node touching a shape gives one contact, the deepest one.
+void ChCFluidCollision::DetectRigidFluid() {
+  host_container& host = data_manager->host_data;
+  const custom_vector<real3>& pos = host.pos_fluid;
+  uint num_shapes = data_manager->num_rigid_shapes;
+  real radius = data_manager->settings.fluid.collision_radius;
+  real envelope = data_manager->settings.collision.collision_envelope;
+  // The AABBs are stored relative to the origin of the rigid broadphase grid
+  real3 origin = data_manager->measures.collision.global_origin;
+
+  data_manager->num_rigid_fluid_contacts = 0;
+  if (num_shapes == 0) {
+    return;
+  }
+
+  shape_count.resize(num_shapes + 1);
+
+  for (int pass = 0; pass < 2; pass++) {
+#pragma omp parallel for schedule(dynamic)
+    for (int s = 0; s < num_shapes; s++) {
+      int count = 0;
+      if (host.collide_rigid[host.id_rigid[s]]) {
+        real3 aabb_min = host.aabb_min_rigid[s] + origin - radius - envelope;
+        real3 aabb_max = host.aabb_max_rigid[s] + origin + radius + envelope;
+        int3 last_cell = I3(bins_per_axis.x - 1, bins_per_axis.y - 1, bins_per_axis.z - 1);
+        int3 cmin = clamp(GetCell(aabb_min), I3(0, 0, 0), last_cell);
+        int3 cmax = clamp(GetCell(aabb_max), I3(0, 0, 0), last_cell);
+
+        for (int k = cmin.z; k <= cmax.z; k++) {
+          for (int j = cmin.y; j <= cmax.y; j++) {
+            // The cells along x are consecutive in the sorted list
+            int start, end, temp;
+            GetCellRange(I3(cmin.x, j, k), start, temp);
+            GetCellRange(I3(cmax.x, j, k), temp, end);
+            for (int n = start; n < end; n++) {
+              int node = sorted_node[n];
+              real3 p = pos[node];
+              if (p.x < aabb_min.x || p.y < aabb_min.y || p.z < aabb_min.z || p.x > aabb_max.x ||
+                  p.y > aabb_max.y || p.z > aabb_max.z) {
+                continue;
+              }
+              if (pass == 1) {
+                candidates[shape_count[s] + count] = I2(s, node);
+              }
+              count++;
+            }
+          }
+        }
+      }
+      if (pass == 0) {
+        shape_count[s] = count;
+      }
+    }
+
+    if (pass == 0) {
+      shape_count[num_shapes] = 0;
+      Thrust_Exclusive_Scan(shape_count);
+      candidates.resize(shape_count[num_shapes]);
+    }
+  }
+
+  uint num_candidates = candidates.size();
+  custom_vector<real3>& norm = host.norm_rigid_fluid;
+  custom_vector<real3>& cpta = host.cpta_rigid_fluid;
+  custom_vector<real>& dpth = host.dpth_rigid_fluid;
+  custom_vector<int2>& bids = host.bids_rigid_fluid;
+
+  norm.resize(num_candidates);
+  cpta.resize(num_candidates);
+  dpth.resize(num_candidates);
+  bids.resize(num_candidates);
+  contact_active.resize(num_candidates);
+
+#pragma omp parallel for
+  for (int index = 0; index < num_candidates; index++) {
+    int2 pair = candidates[index];
+    ConvexShape shapeA, shapeB;
+    GetGlobalShape(data_manager, pair.x, shapeA);
+
+    shapeB.type = SPHERE;
+    shapeB.A = pos[pair.y];
+    shapeB.B = R3(radius, 0, 0);
+    shapeB.C = R3(0);
+    shapeB.R = R4(1, 0, 0, 0);
+    shapeB.convex = 0;
+    shapeB.margin = 0;
+
+    real3 ct_norm[4], ct_pta[4], ct_ptb[4];
+    real ct_depth[4], ct_erad[4];
+    int nC = 0;
+    contact_active[index] = false;
+
+    if (RCollision(shapeA, shapeB, 2 * envelope, ct_norm, ct_pta, ct_ptb, ct_depth, ct_erad, nC) && nC > 0) {
+      int deepest = 0;
+      for (int i = 1; i < nC; i++) {
+        if (ct_depth[i] < ct_depth[deepest]) {
+          deepest = i;
+        }
+      }
+      norm[index] = ct_norm[deepest];
+      cpta[index] = ct_pta[deepest];
+      dpth[index] = ct_depth[deepest];
+      contact_active[index] = true;
+    } else if (MPRCollision(shapeA, shapeB, envelope, norm[index], cpta[index], ct_ptb[0], dpth[index])) {
+      contact_active[index] = true;
+    }
+    bids[index] = I2(host.id_rigid[pair.x], pair.y);
+  }
+
+  // Keep the contacts that were found, in the order of the candidates
+  int num_contacts = 0;
+  for (int index = 0; index < num_candidates; index++) {
+    if (contact_active[index]) {
+      norm[num_contacts] = norm[index];
+      cpta[num_contacts] = cpta[index];
+      dpth[num_contacts] = dpth[index];
+      bids[num_contacts] = bids[index];
+      num_contacts++;
+    }
+  }
+
+  norm.resize(num_contacts);
+  cpta.resize(num_contacts);
+  dpth.resize(num_contacts);
+  bids.resize(num_contacts);
+  data_manager->num_rigid_fluid_contacts = num_contacts;
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,67 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: collision detection for the fluid nodes. The nodes are sorted
+// in a uniform grid of cells as large as the kernel radius; the neighbours of
+// each node are then searched in the 27 cells around it, and the nodes close
+// to each rigid shape in the cells overlapped by its AABB.
+// =============================================================================
+
+#pragma once
+
+#include "chrono_parallel/ChParallelDefines.h"
+#include "chrono_parallel/ChDataManager.h"
+#include "chrono_parallel/math/ChParallelMath.h"
+
+namespace chrono {
+namespace collision {
+
+class CH_PARALLEL_API ChCFluidCollision {
+ public:
+  ChCFluidCollision() : data_manager(0) {}
+  ~ChCFluidCollision() {}
+
+  // Find the neighbours of the fluid nodes and the contacts between the fluid
+  // nodes and the rigid shapes. The AABBs of the rigid shapes must be up to
+  // date (i.e. this is called after the rigid broadphase).
+  void Process();
+
+  ChParallelDataManager* data_manager;
+
+ private:
+  // Sort the fluid nodes by cell
+  void SortNodes();
+  // Fill the neighbour lists and the fluid-fluid pairs
+  void DetectFluidFluid();
+  // Fill the rigid-fluid contacts
+  void DetectRigidFluid();
+
+  // Cell containing a point, and key of a cell (grid_min is cell (0,0,0))
+  int3 GetCell(const real3& point) const;
+  long long GetKey(const int3& cell) const;
+  // Range of the sorted nodes in the given cell
+  void GetCellRange(const int3& cell, int& start, int& end) const;
+
+  real3 grid_min;
+  real inv_cell_size;
+  int3 bins_per_axis;
+
+  custom_vector<long long> node_key;  // key of the cell of each sorted node
+  custom_vector<int> sorted_node;     // node indices, sorted by cell
+
+  custom_vector<int> shape_count;     // candidate nodes for each rigid shape
+  custom_vector<int2> candidates;     // (shape, node) candidate pairs
+  custom_vector<bool> contact_active;
+};
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -112,8 +112,9 @@ void ChCNarrowphaseDispatch::PreprocessCount() {
   //   - an interaction involving a capsule can produce up to two contacts
   //   - a box-box interaction can produce up to 8 contacts
 
-  // shape type (per shape)
+  // shape type (per shape prototype)
   const shape_type* obj_data_T = data_manager->host_data.typ_rigid.data();
+  const int* obj_data_P = data_manager->host_data.proto_rigid.data();
   // encoded shape IDs (per collision pair)
   const long long* collision_pair = data_manager->host_data.pair_rigid_rigid.data();
 
@@ -121,8 +122,8 @@ void ChCNarrowphaseDispatch::PreprocessCount() {
   for (int index = 0; index < num_potentialCollisions; index++) {
     // Identify the two candidate shapes and get their types.
     int2 pair = I2(int(collision_pair[index] >> 32), int(collision_pair[index] & 0xffffffff));
-    shape_type type1 = obj_data_T[pair.x];
-    shape_type type2 = obj_data_T[pair.y];
+    shape_type type1 = obj_data_T[obj_data_P[pair.x]];
+    shape_type type2 = obj_data_T[obj_data_P[pair.y]];
 
     // Set the maximum number of possible contacts for this particular pair
     if (type1 == SPHERE || type2 == SPHERE) {
@@ -146,6 +147,7 @@ void ChCNarrowphaseDispatch::PreprocessLocalToParent() {
   const custom_vector<real3>& obj_data_C = data_manager->host_data.ObC_rigid;
   const custom_vector<real4>& obj_data_R = data_manager->host_data.ObR_rigid;
   const custom_vector<uint>& obj_data_ID = data_manager->host_data.id_rigid;
+  const custom_vector<int>& obj_data_P = data_manager->host_data.proto_rigid;
 
   const custom_vector<real3>& body_pos = data_manager->host_data.pos_rigid;
   const custom_vector<real4>& body_rot = data_manager->host_data.rot_rigid;
@@ -157,7 +159,9 @@ void ChCNarrowphaseDispatch::PreprocessLocalToParent() {
 
 #pragma omp parallel for
   for (int index = 0; index < num_shapes; index++) {
-    shape_type T = obj_data_T[index];
+    // Get the prototype of this collision shape, that holds its local data
+    int P = obj_data_P[index];
+    shape_type T = obj_data_T[P];
 
     // Get the identifier for the object associated with this collision shape
     uint ID = obj_data_ID[index];
@@ -165,15 +169,15 @@ void ChCNarrowphaseDispatch::PreprocessLocalToParent() {
     real3 pos = body_pos[ID];  // Get the global object position
     real4 rot = body_rot[ID];  // Get the global object rotation
 
-    obj_data_A_global[index] = TransformLocalToParent(pos, rot, obj_data_A[index]);
+    obj_data_A_global[index] = TransformLocalToParent(pos, rot, obj_data_A[P]);
     if (T == TRIANGLEMESH) {
-      obj_data_B_global[index] = TransformLocalToParent(pos, rot, obj_data_B[index]);
-      obj_data_C_global[index] = TransformLocalToParent(pos, rot, obj_data_C[index]);
+      obj_data_B_global[index] = TransformLocalToParent(pos, rot, obj_data_B[P]);
+      obj_data_C_global[index] = TransformLocalToParent(pos, rot, obj_data_C[P]);
     } else {
-      obj_data_B_global[index] = obj_data_B[index];
-      obj_data_C_global[index] = obj_data_C[index];
+      obj_data_B_global[index] = obj_data_B[P];
+      obj_data_C_global[index] = obj_data_C[P];
     }
-    obj_data_R_global[index] = mult(rot, obj_data_R[index]);
+    obj_data_R_global[index] = mult(rot, obj_data_R[P]);
   }
 }
 
@@ -187,6 +191,7 @@ void ChCNarrowphaseDispatch::Dispatch_Init(uint index,
   const custom_vector<uint>& obj_data_ID = data_manager->host_data.id_rigid;
   const custom_vector<long long>& contact_pair = data_manager->host_data.pair_rigid_rigid;
   const custom_vector<real>& collision_margins = data_manager->host_data.margin_rigid;
+  const custom_vector<int>& obj_data_P = data_manager->host_data.proto_rigid;
   real3* convex_data = data_manager->host_data.convex_data.data();
 
   long long p = contact_pair[index];
@@ -196,8 +201,11 @@ void ChCNarrowphaseDispatch::Dispatch_Init(uint index,
   ID_A = obj_data_ID[pair.x];
   ID_B = obj_data_ID[pair.y];  // Get the identifiers of the two associated objects (bodies)
 
-  shapeA.type = obj_data_T[pair.x];
-  shapeB.type = obj_data_T[pair.y];  // Load the type data for each object in the collision pair
+  int proto_A = obj_data_P[pair.x];
+  int proto_B = obj_data_P[pair.y];  // Get the prototypes holding the data of the two shapes
+
+  shapeA.type = obj_data_T[proto_A];
+  shapeB.type = obj_data_T[proto_B];  // Load the type data for each object in the collision pair
 
   shapeA.A = obj_data_A_global[pair.x];
   shapeB.A = obj_data_A_global[pair.y];
@@ -209,8 +217,8 @@ void ChCNarrowphaseDispatch::Dispatch_Init(uint index,
   shapeB.R = obj_data_R_global[pair.y];
   shapeA.convex = convex_data;
   shapeB.convex = convex_data;
-  shapeA.margin = collision_margins[pair.x];
-  shapeB.margin = collision_margins[pair.y];
+  shapeA.margin = collision_margins[proto_A];
+  shapeB.margin = collision_margins[proto_B];
 
   //// TODO: what is the best way to dispatch this?
   icoll = contact_index[index];
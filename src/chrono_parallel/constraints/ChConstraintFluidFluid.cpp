@@ -0,0 +1,148 @@
+#include <algorithm>
+
+#include "core/ChMathematics.h"
+#include "chrono_parallel/constraints/ChConstraintFluidFluid.h"
+
+using namespace chrono;
+
+// SPH kernels: poly6 for the density, and the gradient of the spiky kernel for
+// the jacobian (it does not vanish when two nodes get close).
+static inline real KernelPoly6(real dist2, real h) {
+  if (dist2 >= h * h) {
+    return 0;
+  }
+  real q = h * h - dist2;
+  return 315.0 / (64.0 * CH_C_PI * Pow(h, 9)) * q * q * q;
+}
+
+static inline real3 GradKernelSpiky(const real3& dist, real h) {
+  real r = length(dist);
+  if (r >= h || r == 0) {
+    return R3(0);
+  }
+  real q = h - r;
+  return -45.0 / (CH_C_PI * Pow(h, 6)) * q * q / r * dist;
+}
+
+void ChConstraintFluidFluid::Setup(ChParallelDataManager* data_container_, int start_row_) {
+  data_manager = data_container_;
+  start_row = start_row_;
+
+  const custom_vector<real3>& pos = data_manager->host_data.pos_fluid;
+  const custom_vector<int>& neighbors = data_manager->host_data.neighbor_fluid_fluid;
+  const custom_vector<int>& counts = data_manager->host_data.c_counts_fluid_fluid;
+  custom_vector<real>& density = data_manager->host_data.den_fluid;
+  int max_neighbors = data_manager->settings.fluid.max_neighbors;
+  real h = data_manager->settings.fluid.kernel_radius;
+  real mass = data_manager->settings.fluid.mass;
+
+  density.resize(data_manager->num_fluid_bodies);
+
+#pragma omp parallel for
+  for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
+    real rho = 0;
+    for (int n = 0; n < counts[i]; n++) {
+      real3 d = pos[i] - pos[neighbors[i * max_neighbors + n]];
+      rho += mass * KernelPoly6(dot(d, d), h);
+    }
+    density[i] = rho;
+  }
+}
+
+void ChConstraintFluidFluid::Project(real* gamma) {
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_fluid_bodies; index++) {
+    gamma[start_row + index] = Max(gamma[start_row + index], real(0));
+  }
+}
+
+// The constraint of node i is 1 - density_i / rest_density >= 0. The error is
+// corrected over (step size + tau) seconds.
+void ChConstraintFluidFluid::Build_b() {
+  if (data_manager->num_fluid_bodies <= 0) {
+    return;
+  }
+  real inv_rest_density = 1.0 / data_manager->settings.fluid.density;
+  real inv_htau = 1.0 / (data_manager->settings.step_size + data_manager->settings.fluid.tau);
+
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_fluid_bodies; index++) {
+    real phi = 1 - data_manager->host_data.den_fluid[index] * inv_rest_density;
+    data_manager->host_data.b[start_row + index] = phi * inv_htau;
+  }
+}
+
+void ChConstraintFluidFluid::Build_E() {
+  if (data_manager->num_fluid_bodies <= 0) {
+    return;
+  }
+  DynamicVector<real>& E = data_manager->host_data.E;
+  real epsilon = data_manager->settings.fluid.epsilon;
+
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_fluid_bodies; index++) {
+    E[start_row + index] = epsilon;
+  }
+}
+
+// Row i holds the gradient of the constraint of node i, phi_i = 1 - rho_i/rho0
+// with rho_i = sum_j m W(xi-xj): m/rho0 * gradW(xi-xj) for each neighbour j,
+// and the opposite of their sum for node i itself.
+void ChConstraintFluidFluid::Build_D() {
+  LOG(INFO) << "ChConstraintFluidFluid::Build_D";
+  const custom_vector<real3>& pos = data_manager->host_data.pos_fluid;
+  const custom_vector<int>& neighbors = data_manager->host_data.neighbor_fluid_fluid;
+  const custom_vector<int>& counts = data_manager->host_data.c_counts_fluid_fluid;
+  int max_neighbors = data_manager->settings.fluid.max_neighbors;
+  int fluid_offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
+  real h = data_manager->settings.fluid.kernel_radius;
+  real scale = data_manager->settings.fluid.mass / data_manager->settings.fluid.density;
+
+  CompressedMatrix<real>& D_ff_T = data_manager->host_data.D_ff_T;
+  CompressedMatrix<real>& D_ff = data_manager->host_data.D_ff;
+  CompressedMatrix<real>& M_invD_ff = data_manager->host_data.M_invD_ff;
+  const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
+
+#pragma omp parallel for
+  for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
+    real3 sum = R3(0);
+    for (int n = 0; n < counts[i]; n++) {
+      int j = neighbors[i * max_neighbors + n];
+      if (j == i) {
+        continue;
+      }
+      real3 grad = scale * GradKernelSpiky(pos[i] - pos[j], h);
+      D_ff_T.set(i, fluid_offset + j * 3 + 0, grad.x);
+      D_ff_T.set(i, fluid_offset + j * 3 + 1, grad.y);
+      D_ff_T.set(i, fluid_offset + j * 3 + 2, grad.z);
+      sum = sum + grad;
+    }
+    D_ff_T.set(i, fluid_offset + i * 3 + 0, -sum.x);
+    D_ff_T.set(i, fluid_offset + i * 3 + 1, -sum.y);
+    D_ff_T.set(i, fluid_offset + i * 3 + 2, -sum.z);
+  }
+
+  LOG(INFO) << "ChConstraintFluidFluid::Build_D - Compute Transpose";
+  D_ff = trans(D_ff_T);
+  M_invD_ff = M_inv * D_ff;
+}
+
+void ChConstraintFluidFluid::GenerateSparsity() {
+  LOG(INFO) << "ChConstraintFluidFluid::GenerateSparsity";
+  CompressedMatrix<real>& D_ff_T = data_manager->host_data.D_ff_T;
+  const custom_vector<int>& neighbors = data_manager->host_data.neighbor_fluid_fluid;
+  const custom_vector<int>& counts = data_manager->host_data.c_counts_fluid_fluid;
+  int max_neighbors = data_manager->settings.fluid.max_neighbors;
+  int fluid_offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
+
+  // The neighbour lists are sorted, so the columns are appended in order
+  for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
+    for (int n = 0; n < counts[i]; n++) {
+      int j = neighbors[i * max_neighbors + n];
+      D_ff_T.append(i, fluid_offset + j * 3 + 0, 1);
+      D_ff_T.append(i, fluid_offset + j * 3 + 1, 1);
+      D_ff_T.append(i, fluid_offset + j * 3 + 2, 1);
+    }
+    D_ff_T.finalize(i);
+  }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "chrono_parallel/ChDataManager.h"
+#include "chrono_parallel/math/ChParallelMath.h"
+
+namespace chrono {
+
+// Density constraints of the fluid nodes: one unilateral constraint per node,
+// that keeps the SPH density of the node below the rest density of the fluid.
+// The rows of the constraints follow the ones of the rigid-fluid contacts.
+class CH_PARALLEL_API ChConstraintFluidFluid {
+ public:
+  ChConstraintFluidFluid() {
+    data_manager = 0;
+    start_row = 0;
+  }
+  ~ChConstraintFluidFluid() {}
+
+  // Compute the density of the nodes (the neighbour lists must be up to date)
+  void Setup(ChParallelDataManager* data_container_, int start_row_);
+
+  // Keep the multipliers non negative
+  void Project(real* gamma);
+
+  // Compute the vector of corrections
+  void Build_b();
+  // Compute the diagonal compliance matrix
+  void Build_E();
+  // Compute the jacobian matrix, no allocation is performed here,
+  // GenerateSparsity should take care of that
+  void Build_D();
+
+  // Fill-in the non zero entries in the jacobian with ones.
+  // This operation is sequential.
+  void GenerateSparsity();
+
+  // Index of the first constraint in the vector of multipliers
+  int start_row;
+
+ protected:
+  // Pointer to the system's data manager
+  ChParallelDataManager* data_manager;
+};
+}
@@ -0,0 +1,115 @@
+#include <algorithm>
+
+#include "chrono_parallel/constraints/ChConstraintRigidFluid.h"
+#include "chrono_parallel/constraints/ChConstraintRigidRigid.h"
+
+using namespace chrono;
+
+void ChConstraintRigidFluid::Project(real* gamma) {
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_rigid_fluid_contacts; index++) {
+    gamma[start_row + index] = Max(gamma[start_row + index], real(0));
+  }
+}
+
+void ChConstraintRigidFluid::Build_b() {
+  if (data_manager->num_rigid_fluid_contacts <= 0) {
+    return;
+  }
+
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_rigid_fluid_contacts; index++) {
+    real bi = 0;
+    real depth = data_manager->host_data.dpth_rigid_fluid[index];
+
+    if (data_manager->settings.solver.alpha > 0) {
+      bi = inv_hpa * depth;
+    } else if (data_manager->settings.solver.contact_recovery_speed < 0) {
+      bi = inv_h * depth;
+    } else {
+      bi = Max(inv_h * depth, -data_manager->settings.solver.contact_recovery_speed);
+    }
+
+    data_manager->host_data.b[start_row + index] = bi;
+  }
+}
+
+// The compliance is the normal compliance of the material of the rigid body
+void ChConstraintRigidFluid::Build_E() {
+  if (data_manager->num_rigid_fluid_contacts <= 0) {
+    return;
+  }
+  DynamicVector<real>& E = data_manager->host_data.E;
+
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_rigid_fluid_contacts; index++) {
+    int body = data_manager->host_data.bids_rigid_fluid[index].x;
+    E[start_row + index] = data_manager->host_data.compliance_data[body].x;
+  }
+}
+
+void ChConstraintRigidFluid::Build_D() {
+  LOG(INFO) << "ChConstraintRigidFluid::Build_D";
+  real3* norm = data_manager->host_data.norm_rigid_fluid.data();
+  real3* ptA = data_manager->host_data.cpta_rigid_fluid.data();
+  real3* pos_data = data_manager->host_data.pos_rigid.data();
+  int2* ids = data_manager->host_data.bids_rigid_fluid.data();
+  real4* rot = data_manager->host_data.rot_rigid.data();
+  int fluid_offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
+
+  CompressedMatrix<real>& D_rf_T = data_manager->host_data.D_rf_T;
+  CompressedMatrix<real>& D_rf = data_manager->host_data.D_rf;
+  CompressedMatrix<real>& M_invD_rf = data_manager->host_data.M_invD_rf;
+  const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
+
+#pragma omp parallel for
+  for (int index = 0; index < data_manager->num_rigid_fluid_contacts; index++) {
+    real3 U = norm[index], V, W;
+    real3 T3, T4, T5;
+    Orthogonalize(U, V, W);
+    int2 body_id = ids[index];
+
+    Compute_Jacobian(rot[body_id.x], U, V, W, ptA[index] - pos_data[body_id.x], T3, T4, T5);
+
+    D_rf_T.set(index, body_id.x * 6 + 0, -U.x);
+    D_rf_T.set(index, body_id.x * 6 + 1, -U.y);
+    D_rf_T.set(index, body_id.x * 6 + 2, -U.z);
+
+    D_rf_T.set(index, body_id.x * 6 + 3, T3.x);
+    D_rf_T.set(index, body_id.x * 6 + 4, T3.y);
+    D_rf_T.set(index, body_id.x * 6 + 5, T3.z);
+
+    D_rf_T.set(index, fluid_offset + body_id.y * 3 + 0, U.x);
+    D_rf_T.set(index, fluid_offset + body_id.y * 3 + 1, U.y);
+    D_rf_T.set(index, fluid_offset + body_id.y * 3 + 2, U.z);
+  }
+
+  LOG(INFO) << "ChConstraintRigidFluid::Build_D - Compute Transpose";
+  D_rf = trans(D_rf_T);
+  M_invD_rf = M_inv * D_rf;
+}
+
+void ChConstraintRigidFluid::GenerateSparsity() {
+  LOG(INFO) << "ChConstraintRigidFluid::GenerateSparsity";
+  CompressedMatrix<real>& D_rf_T = data_manager->host_data.D_rf_T;
+  const int2* ids = data_manager->host_data.bids_rigid_fluid.data();
+  int fluid_offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
+
+  for (int index = 0; index < data_manager->num_rigid_fluid_contacts; index++) {
+    int2 body_id = ids[index];
+
+    D_rf_T.append(index, body_id.x * 6 + 0, 1);
+    D_rf_T.append(index, body_id.x * 6 + 1, 1);
+    D_rf_T.append(index, body_id.x * 6 + 2, 1);
+
+    D_rf_T.append(index, body_id.x * 6 + 3, 1);
+    D_rf_T.append(index, body_id.x * 6 + 4, 1);
+    D_rf_T.append(index, body_id.x * 6 + 5, 1);
+
+    D_rf_T.append(index, fluid_offset + body_id.y * 3 + 0, 1);
+    D_rf_T.append(index, fluid_offset + body_id.y * 3 + 1, 1);
+    D_rf_T.append(index, fluid_offset + body_id.y * 3 + 2, 1);
+
+    D_rf_T.finalize(index);
+  }
+}
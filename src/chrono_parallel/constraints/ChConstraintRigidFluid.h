@@ -0,0 +1,52 @@
+#pragma once
+
+#include "chrono_parallel/ChDataManager.h"
+#include "chrono_parallel/math/ChParallelMath.h"
+
+namespace chrono {
+
+// Frictionless contacts between rigid bodies and fluid nodes: one unilateral
+// constraint per contact. The rows of the constraints follow the ones of the
+// rigid contacts.
+class CH_PARALLEL_API ChConstraintRigidFluid {
+ public:
+  ChConstraintRigidFluid() {
+    data_manager = 0;
+    start_row = 0;
+    inv_h = inv_hpa = 0;
+  }
+  ~ChConstraintRigidFluid() {}
+
+  void Setup(ChParallelDataManager* data_container_, int start_row_) {
+    data_manager = data_container_;
+    start_row = start_row_;
+    inv_h = 1 / data_manager->settings.step_size;
+    inv_hpa = 1 / (data_manager->settings.step_size + data_manager->settings.solver.alpha);
+  }
+
+  // Keep the multipliers non negative
+  void Project(real* gamma);
+
+  // Compute the vector of corrections
+  void Build_b();
+  // Compute the diagonal compliance matrix
+  void Build_E();
+  // Compute the jacobian matrix, no allocation is performed here,
+  // GenerateSparsity should take care of that
+  void Build_D();
+
+  // Fill-in the non zero entries in the jacobian with ones.
+  // This operation is sequential.
+  void GenerateSparsity();
+
+  // Index of the first constraint in the vector of multipliers
+  int start_row;
+
+ protected:
+  real inv_h;
+  real inv_hpa;
+
+  // Pointer to the system's data manager
+  ChParallelDataManager* data_manager;
+};
+}
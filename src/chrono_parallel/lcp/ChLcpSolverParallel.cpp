@@ -19,6 +19,7 @@ void ChLcpSolverParallel::ComputeMassMatrix() {
   LOG(INFO) << "ChLcpSolverParallel::ComputeMassMatrix()";
   uint num_bodies = data_manager->num_rigid_bodies;
   uint num_shafts = data_manager->num_shafts;
+  uint num_fluid_bodies = data_manager->num_fluid_bodies;
   uint num_dof = data_manager->num_dof;
   bool use_full_inertia_tensor = data_manager->settings.solver.use_full_inertia_tensor;
   const custom_vector<real>& shaft_inr = data_manager->host_data.shaft_inr;
@@ -35,14 +36,14 @@ void ChLcpSolverParallel::ComputeMassMatrix() {
 
   clear(M_inv);
 
-  // Each rigid object has 3 mass entries and 9 inertia entries
-  // Each shaft has one inertia entry
-  M_inv.reserve(num_bodies * 12 + num_shafts * 1);
+  // Each rigid object has 3 mass entries and 9 inertia entries (3 for particles)
+  // Each shaft has one inertia entry, each fluid node 3 mass entries
+  M_inv.reserve(num_bodies * 12 + num_shafts * 1 + num_fluid_bodies * 3);
   // The mass matrix is square and each rigid body has 6 DOF
-  // Shafts have one DOF
+  // Shafts have one DOF, fluid nodes have 3
   M_inv.resize(num_dof, num_dof);
 
-  for (int i = 0; i < num_bodies; i++) {
+  for (int i = 0; i < body_list->size(); i++) {
     if (data_manager->host_data.active_rigid[i]) {
       real inv_mass = 1.0 / body_list->at(i)->GetMass();
       ChMatrix33<>& body_inv_inr = body_list->at(i)->VariablesBody().GetBodyInvInertia();
@@ -84,11 +85,47 @@ void ChLcpSolverParallel::ComputeMassMatrix() {
     }
   }
 
+  // Particles (the rigid body slots after the bodies) have no ChBody: their
+  // inverse mass and diagonal inverse inertia are in the system-wide vectors.
+  const custom_vector<real>& inv_mass_particle = data_manager->host_data.inv_mass_particle;
+  const custom_vector<real3>& inv_inr_particle = data_manager->host_data.inv_inr_particle;
+
+  for (int i = body_list->size(); i < num_bodies; i++) {
+    if (data_manager->host_data.active_rigid[i]) {
+      M_inv.append(i * 6 + 0, i * 6 + 0, inv_mass_particle[i]);
+      M_inv.finalize(i * 6 + 0);
+      M_inv.append(i * 6 + 1, i * 6 + 1, inv_mass_particle[i]);
+      M_inv.finalize(i * 6 + 1);
+      M_inv.append(i * 6 + 2, i * 6 + 2, inv_mass_particle[i]);
+      M_inv.finalize(i * 6 + 2);
+      M_inv.append(i * 6 + 3, i * 6 + 3, inv_inr_particle[i].x);
+      M_inv.finalize(i * 6 + 3);
+      M_inv.append(i * 6 + 4, i * 6 + 4, inv_inr_particle[i].y);
+      M_inv.finalize(i * 6 + 4);
+      M_inv.append(i * 6 + 5, i * 6 + 5, inv_inr_particle[i].z);
+      M_inv.finalize(i * 6 + 5);
+    } else {
+      M_inv.finalize(i * 6 + 0);
+      M_inv.finalize(i * 6 + 1);
+      M_inv.finalize(i * 6 + 2);
+      M_inv.finalize(i * 6 + 3);
+      M_inv.finalize(i * 6 + 4);
+      M_inv.finalize(i * 6 + 5);
+    }
+  }
+
   for (int i = 0; i < num_shafts; i++) {
     M_inv.append(num_bodies * 6 + i, num_bodies * 6 + i, shaft_inr[i]);
     M_inv.finalize(num_bodies * 6 + i);
   }
 
+  // All fluid nodes have the same mass
+  real inv_mass_fluid = 1.0 / data_manager->settings.fluid.mass;
+  for (int i = 0; i < num_fluid_bodies * 3; i++) {
+    M_inv.append(num_bodies * 6 + num_shafts + i, num_bodies * 6 + num_shafts + i, inv_mass_fluid);
+    M_inv.finalize(num_bodies * 6 + num_shafts + i);
+  }
+
   M_invk = v + M_inv * hf;
 }
 
@@ -370,7 +370,15 @@ void ChLcpSolverParallelDEM::host_CalcContactForces(custom_vector<int>& ext_body
                                                     custom_vector<real3>& ext_body_torque,
                                                     custom_vector<int2>& shape_pairs,
                                                     custom_vector<bool>& shear_touch) {
-#pragma omp parallel for
+    // With the multi-step tangential displacement model, the contacts of a body
+    // share its list of contact histories, whose free slots are taken in the
+    // order the contacts are processed. In deterministic mode the contacts are
+    // processed sequentially so that this order is the contact order.
+    bool sequential =
+        data_manager->settings.deterministic &&
+        data_manager->settings.solver.tangential_displ_mode == ChSystemDEM::TangentialDisplacementModel::MultiStep;
+
+#pragma omp parallel for if (!sequential)
     for (int index = 0; index < data_manager->num_rigid_contacts; index++) {
         function_CalcContactForces(
             index, data_manager->settings.solver.contact_force_model,
@@ -478,8 +486,17 @@ void ChLcpSolverParallelDEM::ProcessContacts() {
     //    involved in at least one contact, by reducing the contact forces and
     //    torques from all contacts these bodies are involved in. The number of
     //    bodies that experience at least one contact is 'ct_body_count'.
-    thrust::sort_by_key(thrust_parallel, ext_body_id.begin(), ext_body_id.end(),
-                        thrust::make_zip_iterator(thrust::make_tuple(ext_body_force.begin(), ext_body_torque.begin())));
+    //    In deterministic mode the sort is stable, so that the forces on each body
+    //    are added in the contact order.
+    if (data_manager->settings.deterministic) {
+        thrust::stable_sort_by_key(
+            thrust_parallel, ext_body_id.begin(), ext_body_id.end(),
+            thrust::make_zip_iterator(thrust::make_tuple(ext_body_force.begin(), ext_body_torque.begin())));
+    } else {
+        thrust::sort_by_key(
+            thrust_parallel, ext_body_id.begin(), ext_body_id.end(),
+            thrust::make_zip_iterator(thrust::make_tuple(ext_body_force.begin(), ext_body_torque.begin())));
+    }
 
     custom_vector<int> ct_body_id(data_manager->num_rigid_bodies);
     custom_vector<real3>& ct_body_force = data_manager->host_data.ct_body_force;
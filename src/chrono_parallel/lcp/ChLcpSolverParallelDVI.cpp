@@ -13,6 +13,8 @@
 #include "chrono_parallel/solver/ChSolverPGS.h"
 #include "chrono_parallel/solver/ChSolverJacobi.h"
 #include "chrono_parallel/solver/ChSolverPDIP.h"
+
+#include <thrust/reduce.h>
 using namespace chrono;
 
 #define CLEAR_RESERVE_RESIZE(M, nnz, rows, cols) \
@@ -33,6 +35,15 @@ void ChLcpSolverParallelDVI::RunTimeStep() {
     rigid_rigid.offset = 6;
     data_manager->num_unilaterals = 6 * data_manager->num_rigid_contacts;
   }
+  // The rigid-fluid contacts and the fluid density constraints follow the
+  // rigid contacts, in all solver modes
+  uint num_rigid_unilaterals = data_manager->num_unilaterals;
+  data_manager->num_unilaterals += data_manager->num_rigid_fluid_contacts + data_manager->num_fluid_bodies;
+  // The Gauss-Seidel solver does not handle the fluid rows
+  if (data_manager->settings.solver.solver_type == GAUSS_SEIDEL &&
+      data_manager->num_unilaterals > num_rigid_unilaterals) {
+    throw ChException("ChLcpSolverParallelDVI: the Gauss-Seidel solver does not support fluid.");
+  }
   // This is the total number of constraints
   data_manager->num_constraints = data_manager->num_unilaterals + data_manager->num_bilaterals;
 
@@ -44,6 +55,8 @@ void ChLcpSolverParallelDVI::RunTimeStep() {
 
   // Perform any setup tasks for all constraint types
   rigid_rigid.Setup(data_manager);
+  rigid_fluid.Setup(data_manager, num_rigid_unilaterals);
+  fluid_fluid.Setup(data_manager, num_rigid_unilaterals + data_manager->num_rigid_fluid_contacts);
   bilateral.Setup(data_manager);
   // Clear and reset solver history data and counters
   solver->current_iteration = 0;
@@ -52,6 +65,8 @@ void ChLcpSolverParallelDVI::RunTimeStep() {
   data_manager->measures.solver.maxdeltalambda_hist.clear();
   // Set pointers to constraint objects and perform setup actions for solver
   solver->rigid_rigid = &rigid_rigid;
+  solver->rigid_fluid = &rigid_fluid;
+  solver->fluid_fluid = &fluid_fluid;
   solver->bilateral = &bilateral;
   solver->Setup(data_manager);
 
@@ -140,20 +155,34 @@ void ChLcpSolverParallelDVI::ComputeD() {
   int num_tangential = 2 * data_manager->num_rigid_contacts;
   int num_spinning = 3 * data_manager->num_rigid_contacts;
 
+  // Each rigid-fluid contact has 6 entries for the body and 3 for the node,
+  // each density constraint 3 entries per neighbour (including the node)
+  uint num_rigid_fluid = data_manager->num_rigid_fluid_contacts;
+  uint num_fluid = data_manager->num_fluid_bodies;
+  int nnz_rigid_fluid = 9 * num_rigid_fluid;
+  int nnz_fluid = 3 * thrust::reduce(data_manager->host_data.c_counts_fluid_fluid.begin(),
+                                     data_manager->host_data.c_counts_fluid_fluid.begin() + num_fluid);
+
   CompressedMatrix<real>& D_n_T = data_manager->host_data.D_n_T;
   CompressedMatrix<real>& D_t_T = data_manager->host_data.D_t_T;
   CompressedMatrix<real>& D_s_T = data_manager->host_data.D_s_T;
   CompressedMatrix<real>& D_b_T = data_manager->host_data.D_b_T;
+  CompressedMatrix<real>& D_rf_T = data_manager->host_data.D_rf_T;
+  CompressedMatrix<real>& D_ff_T = data_manager->host_data.D_ff_T;
 
   CompressedMatrix<real>& D_n = data_manager->host_data.D_n;
   CompressedMatrix<real>& D_t = data_manager->host_data.D_t;
   CompressedMatrix<real>& D_s = data_manager->host_data.D_s;
   CompressedMatrix<real>& D_b = data_manager->host_data.D_b;
+  CompressedMatrix<real>& D_rf = data_manager->host_data.D_rf;
+  CompressedMatrix<real>& D_ff = data_manager->host_data.D_ff;
 
   CompressedMatrix<real>& M_invD_n = data_manager->host_data.M_invD_n;
   CompressedMatrix<real>& M_invD_t = data_manager->host_data.M_invD_t;
   CompressedMatrix<real>& M_invD_s = data_manager->host_data.M_invD_s;
   CompressedMatrix<real>& M_invD_b = data_manager->host_data.M_invD_b;
+  CompressedMatrix<real>& M_invD_rf = data_manager->host_data.M_invD_rf;
+  CompressedMatrix<real>& M_invD_ff = data_manager->host_data.M_invD_ff;
 
   const CompressedMatrix<real>& M_inv = data_manager->host_data.M_inv;
 
@@ -192,9 +221,21 @@ void ChLcpSolverParallelDVI::ComputeD() {
   }
   CLEAR_RESERVE_RESIZE(D_b_T, nnz_bilaterals, num_bilaterals, num_dof)
 
+  CLEAR_RESERVE_RESIZE(D_rf_T, nnz_rigid_fluid, num_rigid_fluid, num_dof)
+  CLEAR_RESERVE_RESIZE(D_rf, nnz_rigid_fluid, num_dof, num_rigid_fluid)
+  CLEAR_RESERVE_RESIZE(M_invD_rf, nnz_rigid_fluid, num_dof, num_rigid_fluid)
+
+  CLEAR_RESERVE_RESIZE(D_ff_T, nnz_fluid, num_fluid, num_dof)
+  CLEAR_RESERVE_RESIZE(D_ff, nnz_fluid, num_dof, num_fluid)
+  CLEAR_RESERVE_RESIZE(M_invD_ff, nnz_fluid, num_dof, num_fluid)
+
   rigid_rigid.GenerateSparsity();
+  rigid_fluid.GenerateSparsity();
+  fluid_fluid.GenerateSparsity();
   bilateral.GenerateSparsity();
   rigid_rigid.Build_D();
+  rigid_fluid.Build_D();
+  fluid_fluid.Build_D();
   bilateral.Build_D();
 
   data_manager->system_timer.stop("ChLcpSolverParallel_D");
@@ -211,6 +252,8 @@ void ChLcpSolverParallelDVI::ComputeE() {
   reset(data_manager->host_data.E);
 
   rigid_rigid.Build_E();
+  rigid_fluid.Build_E();
+  fluid_fluid.Build_E();
   bilateral.Build_E();
   data_manager->system_timer.stop("ChLcpSolverParallel_E");
 }
@@ -226,6 +269,8 @@ void ChLcpSolverParallelDVI::ComputeR() {
   const CompressedMatrix<real>& D_t_T = data_manager->host_data.D_t_T;
   const CompressedMatrix<real>& D_s_T = data_manager->host_data.D_s_T;
   const CompressedMatrix<real>& D_b_T = data_manager->host_data.D_b_T;
+  const CompressedMatrix<real>& D_rf_T = data_manager->host_data.D_rf_T;
+  const CompressedMatrix<real>& D_ff_T = data_manager->host_data.D_ff_T;
 
   const DynamicVector<real>& M_invk = data_manager->host_data.M_invk;
 
@@ -243,6 +288,8 @@ void ChLcpSolverParallelDVI::ComputeR() {
   reset(R);
 
   rigid_rigid.Build_b();
+  rigid_fluid.Build_b();
+  fluid_fluid.Build_b();
   bilateral.Build_b();
 
   SubVectorType b_n = blaze::subvector(b, 0, num_contacts);
@@ -277,6 +324,19 @@ void ChLcpSolverParallelDVI::ComputeR() {
       R_s = -D_s_T * M_invk;
     } break;
   }
+
+  uint num_rigid_fluid = data_manager->num_rigid_fluid_contacts;
+  uint num_fluid = data_manager->num_fluid_bodies;
+  if (num_rigid_fluid > 0) {
+    SubVectorType b_rf = blaze::subvector(b, rigid_fluid.start_row, num_rigid_fluid);
+    SubVectorType R_rf = blaze::subvector(R, rigid_fluid.start_row, num_rigid_fluid);
+    R_rf = -b_rf - D_rf_T * M_invk;
+  }
+  if (num_fluid > 0) {
+    SubVectorType b_ff = blaze::subvector(b, fluid_fluid.start_row, num_fluid);
+    SubVectorType R_ff = blaze::subvector(R, fluid_fluid.start_row, num_fluid);
+    R_ff = -b_ff - D_ff_T * M_invk;
+  }
   data_manager->system_timer.stop("ChLcpSolverParallel_R");
 }
 
@@ -329,6 +389,13 @@ void ChLcpSolverParallelDVI::SetR() {
           blaze::subvector(R_full, num_contacts * 3, num_contacts * 3);
     } break;
   }
+
+  // The fluid constraints are solved together with the rigid contacts
+  uint num_fluid_rows = data_manager->num_rigid_fluid_contacts + data_manager->num_fluid_bodies;
+  if (data_manager->settings.solver.local_solver_mode != BILATERAL && num_fluid_rows > 0) {
+    blaze::subvector(R, rigid_fluid.start_row, num_fluid_rows) =
+        blaze::subvector(R_full, rigid_fluid.start_row, num_fluid_rows);
+  }
 }
 
 void ChLcpSolverParallelDVI::ComputeImpulses() {
@@ -376,6 +443,15 @@ void ChLcpSolverParallelDVI::ComputeImpulses() {
 
       } break;
     }
+
+    uint num_rigid_fluid = data_manager->num_rigid_fluid_contacts;
+    uint num_fluid = data_manager->num_fluid_bodies;
+    if (num_rigid_fluid > 0) {
+      v += data_manager->host_data.M_invD_rf * blaze::subvector(gamma, rigid_fluid.start_row, num_rigid_fluid);
+    }
+    if (num_fluid > 0) {
+      v += data_manager->host_data.M_invD_ff * blaze::subvector(gamma, fluid_fluid.start_row, num_fluid);
+    }
   } else {
     // When there are no constraints we need to still apply gravity and other
     // body forces!
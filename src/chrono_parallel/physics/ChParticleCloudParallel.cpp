@@ -0,0 +1,124 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: a cloud of rigid particles for a parallel system.
+// =============================================================================
+
+#include "chrono_parallel/physics/ChParticleCloudParallel.h"
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/collision/ChCCollisionModelParallel.h"
+
+namespace chrono {
+
+ChParticleCloudParallel::ChParticleCloudParallel(ChMaterialSurfaceBase::ContactMethod contact_method)
+    : m_collide(true), m_first(0), m_num(0), m_data_manager(0) {
+  m_prototype = std::make_shared<ChBody>(new collision::ChCollisionModelParallel, contact_method);
+}
+
+int ChParticleCloudParallel::GetFirstSlot() const {
+  // The slots of bodies added after the particles may not be moved yet.
+  return m_data_manager->num_rigid_bodies - m_data_manager->num_new_bodies - m_data_manager->num_particles + m_first;
+}
+
+int ChParticleCloudParallel::AddParticle(const ChCoordsys<>& csys, const ChVector<>& vel) {
+  int index = AddParticles(std::vector<ChVector<> >(1, csys.pos));
+  SetRot(index, csys.rot);
+  SetPos_dt(index, vel);
+  return index;
+}
+
+int ChParticleCloudParallel::AddParticles(const std::vector<ChVector<> >& positions) {
+  if (!m_data_manager)
+    throw ChException("ChParticleCloudParallel: particles can be added only after the cloud is added to a system.");
+
+  ChParallelDataManager* data_manager = m_data_manager;
+  int index = m_num;
+
+  // Reserve the slots (this updates m_num), then set the initial state.
+  static_cast<ChSystemParallel*>(GetSystem())->AddParticleSlots(this, (int)positions.size());
+
+  int first_slot = GetFirstSlot() + index;
+  real inv_mass = 1.0 / m_prototype->GetMass();
+  const ChVector<>& inertia = m_prototype->GetInertiaXX();
+  real3 inv_inertia = R3(1.0 / inertia.x, 1.0 / inertia.y, 1.0 / inertia.z);
+
+#pragma omp parallel for
+  for (int i = 0; i < positions.size(); i++) {
+    int slot = first_slot + i;
+    data_manager->host_data.pos_rigid[slot] = R3(positions[i].x, positions[i].y, positions[i].z);
+    data_manager->host_data.rot_rigid[slot] = R4(1, 0, 0, 0);
+    data_manager->host_data.active_rigid[slot] = true;
+    data_manager->host_data.collide_rigid[slot] = m_collide;
+    data_manager->host_data.vel_particle[slot] = R3(0);
+    data_manager->host_data.omg_particle[slot] = R3(0);
+    data_manager->host_data.inv_mass_particle[slot] = inv_mass;
+    data_manager->host_data.inv_inr_particle[slot] = inv_inertia;
+  }
+
+  return index;
+}
+
+ChVector<> ChParticleCloudParallel::GetPos(int i) const {
+  real3 pos = m_data_manager->host_data.pos_rigid[GetFirstSlot() + i];
+  return ChVector<>(pos.x, pos.y, pos.z);
+}
+
+void ChParticleCloudParallel::SetPos(int i, const ChVector<>& pos) {
+  m_data_manager->host_data.pos_rigid[GetFirstSlot() + i] = R3(pos.x, pos.y, pos.z);
+}
+
+ChQuaternion<> ChParticleCloudParallel::GetRot(int i) const {
+  real4 rot = m_data_manager->host_data.rot_rigid[GetFirstSlot() + i];
+  return ChQuaternion<>(rot.w, rot.x, rot.y, rot.z);
+}
+
+void ChParticleCloudParallel::SetRot(int i, const ChQuaternion<>& rot) {
+  m_data_manager->host_data.rot_rigid[GetFirstSlot() + i] = R4(rot.e0, rot.e1, rot.e2, rot.e3);
+}
+
+ChVector<> ChParticleCloudParallel::GetPos_dt(int i) const {
+  real3 vel = m_data_manager->host_data.vel_particle[GetFirstSlot() + i];
+  return ChVector<>(vel.x, vel.y, vel.z);
+}
+
+void ChParticleCloudParallel::SetPos_dt(int i, const ChVector<>& vel) {
+  m_data_manager->host_data.vel_particle[GetFirstSlot() + i] = R3(vel.x, vel.y, vel.z);
+}
+
+ChVector<> ChParticleCloudParallel::GetWvel_loc(int i) const {
+  real3 omg = m_data_manager->host_data.omg_particle[GetFirstSlot() + i];
+  return ChVector<>(omg.x, omg.y, omg.z);
+}
+
+void ChParticleCloudParallel::SetWvel_loc(int i, const ChVector<>& omg) {
+  m_data_manager->host_data.omg_particle[GetFirstSlot() + i] = R3(omg.x, omg.y, omg.z);
+}
+
+double ChParticleCloudParallel::GetMass(int i) const {
+  return 1.0 / m_data_manager->host_data.inv_mass_particle[GetFirstSlot() + i];
+}
+
+void ChParticleCloudParallel::SetMass(int i, double mass) {
+  m_data_manager->host_data.inv_mass_particle[GetFirstSlot() + i] = 1.0 / mass;
+}
+
+ChVector<> ChParticleCloudParallel::GetInertiaXX(int i) const {
+  real3 inv_inertia = m_data_manager->host_data.inv_inr_particle[GetFirstSlot() + i];
+  return ChVector<>(1.0 / inv_inertia.x, 1.0 / inv_inertia.y, 1.0 / inv_inertia.z);
+}
+
+void ChParticleCloudParallel::SetInertiaXX(int i, const ChVector<>& inertia) {
+  m_data_manager->host_data.inv_inr_particle[GetFirstSlot() + i] =
+      R3(1.0 / inertia.x, 1.0 / inertia.y, 1.0 / inertia.z);
+}
+
+}  // end namespace chrono
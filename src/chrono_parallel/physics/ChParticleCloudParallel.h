@@ -0,0 +1,113 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: a cloud of rigid particles for a parallel system. The particles
+// have no ChBody: their state is stored only in the system-wide vectors of the
+// data manager, in rigid body slots that follow the ones of the bodies, so they
+// take part in collision detection and in the solve like bodies do.
+// =============================================================================
+
+#pragma once
+
+#include "physics/ChBody.h"
+#include "chrono_parallel/ChParallelDefines.h"
+#include "chrono_parallel/ChDataManager.h"
+
+namespace chrono {
+
+class ChSystemParallel;
+
+/// Cloud of rigid particles with the same collision shape and material, for
+/// granular simulations with a ChSystemParallel. Unlike ChBody objects, the
+/// particles are not objects: position, rotation, velocity and mass of each
+/// particle live only in the system-wide vectors of the data manager, and
+/// all particles of a cloud share the shape prototypes of the collision
+/// system. The particles are accessed through their index in the cloud.
+///
+/// The shape, the mass and the material are set on a prototype body, which
+/// is not added to the system:
+///   auto cloud = std::make_shared<ChParticleCloudParallel>(ChMaterialSurfaceBase::DVI);
+///   cloud->GetPrototype()->SetMass(mass);
+///   cloud->GetPrototype()->GetCollisionModel()->ClearModel();
+///   utils::AddSphereGeometry(cloud->GetPrototype().get(), radius);
+///   cloud->GetPrototype()->GetCollisionModel()->BuildModel();
+///   system->AddOtherPhysicsItem(cloud);
+///   cloud->AddParticles(positions);
+/// Particles added later get the mass and inertia of the prototype at that
+/// time. Particles are only subject to gravity and contacts; they cannot be
+/// connected with links, nor removed, and they never sleep.
+/// Particle clouds require the parallel collision system (COLLSYS_PARALLEL).
+class CH_PARALLEL_API ChParticleCloudParallel : public ChPhysicsItem {
+  CH_RTTI(ChParticleCloudParallel, ChPhysicsItem);
+
+ public:
+  ChParticleCloudParallel(ChMaterialSurfaceBase::ContactMethod contact_method = ChMaterialSurfaceBase::DVI);
+  ~ChParticleCloudParallel() {}
+
+  /// Return the body that defines the collision shape, the material and the
+  /// mass properties of the particles added afterwards.
+  std::shared_ptr<ChBody> GetPrototype() const { return m_prototype; }
+
+  virtual bool GetCollide() { return m_collide; }
+  /// Enable or disable the collisions of the particles added afterwards.
+  void SetCollide(bool state) { m_collide = state; }
+
+  /// Add a particle, with the given position, rotation and linear velocity.
+  /// The cloud must be in a system. Return the index of the particle.
+  int AddParticle(const ChCoordsys<>& csys, const ChVector<>& vel = VNULL);
+
+  /// Add a batch of particles at the given positions, with no rotation and no
+  /// velocity. The system-wide vectors are grown only once.
+  /// Return the index of the first new particle.
+  int AddParticles(const std::vector<ChVector<> >& positions);
+
+  /// Get the number of particles.
+  int GetNparticles() const { return m_num; }
+
+  /// Get the rigid body slot of the first particle, i.e. the index of its
+  /// data in the system-wide vectors. Particles occupy consecutive slots.
+  int GetFirstSlot() const;
+
+  ChVector<> GetPos(int i) const;
+  void SetPos(int i, const ChVector<>& pos);
+
+  ChQuaternion<> GetRot(int i) const;
+  void SetRot(int i, const ChQuaternion<>& rot);
+
+  /// Linear velocity, in the absolute frame.
+  ChVector<> GetPos_dt(int i) const;
+  void SetPos_dt(int i, const ChVector<>& vel);
+
+  /// Angular velocity, in the local frame of the particle.
+  ChVector<> GetWvel_loc(int i) const;
+  void SetWvel_loc(int i, const ChVector<>& omg);
+
+  double GetMass(int i) const;
+  void SetMass(int i, double mass);
+
+  /// Principal moments of inertia (the inertia tensor is diagonal).
+  ChVector<> GetInertiaXX(int i) const;
+  void SetInertiaXX(int i, const ChVector<>& inertia);
+
+ private:
+  std::shared_ptr<ChBody> m_prototype;
+  bool m_collide;
+
+  int m_first;  ///< index of the first particle among all the particles of the system
+  int m_num;    ///< number of particles
+
+  ChParallelDataManager* m_data_manager;  ///< set when the cloud is added to a system
+
+  friend class ChSystemParallel;
+};
+
+}  // end namespace chrono
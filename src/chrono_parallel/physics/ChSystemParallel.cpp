@@ -6,6 +6,9 @@
 
 #include "chrono_parallel/physics/ChSystemParallel.h"
 #include <numeric>
+#include <fstream>
+#include <cstring>
+#include <stdint.h>
 
 using namespace chrono;
 using namespace chrono::collision;
@@ -37,6 +40,7 @@ ChSystemParallel::ChSystemParallel(unsigned int max_objects) : ChSystem(1000, 10
   data_manager->system_timer.AddTimer("collision");
   data_manager->system_timer.AddTimer("collision_broad");
   data_manager->system_timer.AddTimer("collision_narrow");
+  data_manager->system_timer.AddTimer("collision_fluid");
   data_manager->system_timer.AddTimer("lcp");
 
   data_manager->system_timer.AddTimer("ChLcpSolverParallel_Solve");
@@ -55,6 +59,8 @@ ChSystemParallel::~ChSystemParallel() {
 
 int ChSystemParallel::Integrate_Y() {
   LOG(INFO) << "ChSystemParallel::Integrate_Y()";
+  FlushNewBodySlots();
+
   // Get the pointer for the system descriptor and store it into the data manager
   data_manager->lcp_system_descriptor = this->LCP_descriptor;
   data_manager->body_list = &this->bodylist;
@@ -120,6 +126,32 @@ int ChSystemParallel::Integrate_Y() {
     }
   }
 
+  // Particles have no ChBody: they are integrated directly in the system-wide
+  // vectors, as in ChBody::VariablesQbIncrementPosition().
+  custom_vector<real3>& vel_particle = data_manager->host_data.vel_particle;
+  custom_vector<real3>& omg_particle = data_manager->host_data.omg_particle;
+  int num_slots = data_manager->num_rigid_bodies;
+  real step_size = GetStep();
+
+#pragma omp parallel for
+  for (int i = num_slots - data_manager->num_particles; i < num_slots; i++) {
+    if (data_manager->host_data.active_rigid[i] == true) {
+      real3 vel = R3(velocities[i * 6 + 0], velocities[i * 6 + 1], velocities[i * 6 + 2]);
+      real3 omg = R3(velocities[i * 6 + 3], velocities[i * 6 + 4], velocities[i * 6 + 5]);
+      vel_particle[i] = vel;
+      omg_particle[i] = omg;
+
+      pos_pointer[i] = pos_pointer[i] + vel * step_size;
+
+      // The angular velocity is in the local frame: rotate by the local increment.
+      real omg_length = length(omg);
+      if (omg_length > 0) {
+        quaternion delta = Q_from_AngAxis(omg_length * step_size, omg / omg_length);
+        rot_pointer[i] = normalize(mult(rot_pointer[i], delta));
+      }
+    }
+  }
+
   ////#pragma omp parallel for
   for (int i = 0; i < data_manager->num_shafts; i++) {
     if (!data_manager->host_data.shaft_active[i])
@@ -131,16 +163,30 @@ int ChSystemParallel::Integrate_Y() {
     shaftlist[i]->Update(ChTime);
   }
 
+  // Fluid nodes are integrated directly in the system-wide vectors.
+  custom_vector<real3>& pos_fluid = data_manager->host_data.pos_fluid;
+  custom_vector<real3>& vel_fluid = data_manager->host_data.vel_fluid;
+  int fluid_offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
+
+#pragma omp parallel for
+  for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
+    int dof = fluid_offset + i * 3;
+    vel_fluid[i] = R3(velocities[dof + 0], velocities[dof + 1], velocities[dof + 2]);
+    pos_fluid[i] = pos_fluid[i] + vel_fluid[i] * step_size;
+  }
+
   for (int i = 0; i < otherphysicslist.size(); i++) {
     otherphysicslist[i]->Update(ChTime);
   }
 
   data_manager->system_timer.stop("update");
 
+  UpdateSleepingBodies();
+
   //=============================================================================================
   ChTime += GetStep();
   data_manager->system_timer.stop("step");
-  if (data_manager->settings.perform_thread_tuning) {
+  if (data_manager->settings.perform_thread_tuning && !data_manager->settings.deterministic) {
     RecomputeThreads();
   }
 
@@ -154,6 +200,8 @@ int ChSystemParallel::Integrate_Y() {
 // body.
 //
 void ChSystemParallel::AddBody(std::shared_ptr<ChBody> newbody) {
+  assert(newbody->GetContactMethod() == GetContactMethod());
+
   // This is only need because bilaterals need to know what bodies to
   // refer to. Not used by contacts
   newbody->SetId(data_manager->num_rigid_bodies);
@@ -171,9 +219,243 @@ void ChSystemParallel::AddBody(std::shared_ptr<ChBody> newbody) {
   data_manager->host_data.rot_rigid.push_back(R4());
   data_manager->host_data.active_rigid.push_back(true);
   data_manager->host_data.collide_rigid.push_back(true);
+  data_manager->host_data.vel_particle.push_back(R3());
+  data_manager->host_data.omg_particle.push_back(R3());
+  data_manager->host_data.inv_mass_particle.push_back(0);
+  data_manager->host_data.inv_inr_particle.push_back(R3());
 
   // Let derived classes reserve space for specific material surface data
-  AddMaterialSurfaceData(newbody);
+  AddMaterialSurfaceData(1);
+
+  // The body slots must precede the particle slots. The slots of the bodies
+  // added after the particles are moved all together, when needed.
+  if (data_manager->num_particles > 0)
+    data_manager->num_new_bodies++;
+}
+
+//
+// Add a batch of bodies to the system.
+//
+void ChSystemParallel::AddBodies(const std::vector<std::shared_ptr<ChBody> >& bodies) {
+  size_t num_bodies = bodylist.size() + bodies.size();
+  size_t num_slots = data_manager->num_rigid_bodies + bodies.size();
+
+  Reserve_Geometric(bodylist, num_bodies);
+  Reserve_Geometric(data_manager->host_data.pos_rigid, num_slots);
+  Reserve_Geometric(data_manager->host_data.rot_rigid, num_slots);
+  Reserve_Geometric(data_manager->host_data.active_rigid, num_slots);
+  Reserve_Geometric(data_manager->host_data.collide_rigid, num_slots);
+
+  // Same as AddBody(), except that the bodies are attached to the system (and
+  // their shapes added to the collision system) all together at the end.
+  for (int i = 0; i < bodies.size(); i++) {
+    assert(bodies[i]->GetContactMethod() == GetContactMethod());
+    bodies[i]->SetId(data_manager->num_rigid_bodies);
+    bodylist.push_back(bodies[i]);
+    data_manager->num_rigid_bodies++;
+
+    data_manager->host_data.pos_rigid.push_back(R3());
+    data_manager->host_data.rot_rigid.push_back(R4());
+    data_manager->host_data.active_rigid.push_back(true);
+    data_manager->host_data.collide_rigid.push_back(true);
+  }
+
+  data_manager->host_data.vel_particle.resize(num_slots, R3());
+  data_manager->host_data.omg_particle.resize(num_slots, R3());
+  data_manager->host_data.inv_mass_particle.resize(num_slots, 0);
+  data_manager->host_data.inv_inr_particle.resize(num_slots, R3());
+
+  AddMaterialSurfaceData(bodies.size());
+
+  AttachBodies(bodies);
+
+  if (data_manager->num_particles > 0)
+    data_manager->num_new_bodies += bodies.size();
+}
+
+void ChSystemParallel::RemoveBody(std::shared_ptr<ChBody> body) {
+  RemoveBodies(std::vector<std::shared_ptr<ChBody> >(1, body));
+}
+
+//
+// Remove a batch of bodies from the system. The body identifiers are their
+// indices in the system-wide vectors, so all vectors indexed by body or by
+// collision shape are compacted at once and the references to bodies and
+// shapes (shape owners, shear history) are renumbered.
+// Contact data refer to the old indices and is discarded; it is recomputed
+// at the next step.
+//
+void ChSystemParallel::RemoveBodies(const std::vector<std::shared_ptr<ChBody> >& bodies) {
+  if (bodies.size() == 0)
+    return;
+
+  FlushNewBodySlots();
+
+  int num_bodies = bodylist.size();
+  int num_slots = data_manager->num_rigid_bodies;
+
+  // Mark the removed bodies.
+  std::vector<char> removed(num_bodies, 0);
+  for (int i = 0; i < bodies.size(); i++) {
+    int id = bodies[i]->GetId();
+    assert(id < num_bodies && bodylist[id] == bodies[i]);
+    removed[id] = 1;
+  }
+
+  // Keep the other bodies, and all particles.
+  std::vector<int> kept_slots;
+  kept_slots.reserve(num_slots);
+  for (int i = 0; i < num_bodies; i++) {
+    if (removed[i]) {
+      // Also removes the collision models, if in a Bullet collision system.
+      bodylist[i]->SetSystem(0);
+    } else {
+      kept_slots.push_back(i);
+    }
+  }
+  int num_kept_bodies = kept_slots.size();
+  for (int i = num_bodies; i < num_slots; i++) {
+    kept_slots.push_back(i);
+  }
+
+  ReorderRigidSlots(kept_slots);
+
+  std::vector<std::shared_ptr<ChBody> > bodies_compacted(num_kept_bodies);
+#pragma omp parallel for
+  for (int i = 0; i < num_kept_bodies; i++) {
+    bodies_compacted[i] = bodylist[kept_slots[i]];
+    bodies_compacted[i]->SetId(i);
+  }
+  bodylist.swap(bodies_compacted);
+
+  if (collision_system_type == COLLSYS_BULLET_PARALLEL) {
+    for (int i = 0; i < bodylist.size(); i++) {
+      if (bodylist[i]->GetCollide()) {
+        ChModelBullet* model = static_cast<ChModelBullet*>(bodylist[i]->GetCollisionModel());
+        model->GetBulletModel()->setCompanionId(i);
+      }
+    }
+  }
+}
+
+//
+// Move the slots of the bodies added after the particles right after the
+// slots of the other bodies. Doing this once for all the bodies added since
+// the last call keeps AddBody() cheap when there are many particles.
+//
+void ChSystemParallel::FlushNewBodySlots() {
+  int num = data_manager->num_new_bodies;
+  if (num == 0)
+    return;
+
+  data_manager->num_new_bodies = 0;
+  MoveNewBodySlots(num);
+}
+
+//
+// Move the last 'num' rigid body slots, which belong to bodies just added
+// after the particles, right after the slots of the other bodies.
+//
+void ChSystemParallel::MoveNewBodySlots(int num) {
+  int num_slots = data_manager->num_rigid_bodies;
+  int num_particles = data_manager->num_particles;
+  int num_old_bodies = num_slots - num_particles - num;
+
+  std::vector<int> kept_slots(num_slots);
+  for (int i = 0; i < num_old_bodies; i++)
+    kept_slots[i] = i;
+  for (int i = 0; i < num; i++)
+    kept_slots[num_old_bodies + i] = num_slots - num + i;
+  for (int i = 0; i < num_particles; i++)
+    kept_slots[num_old_bodies + num + i] = num_old_bodies + i;
+
+  ReorderRigidSlots(kept_slots);
+
+  for (int i = num_old_bodies; i < num_old_bodies + num; i++)
+    bodylist[i]->SetId(i);
+}
+
+void ChSystemParallel::ReorderRigidSlots(const std::vector<int>& kept_slots) {
+  int num_slots = data_manager->num_rigid_bodies;
+
+  // Map each slot to its new index (-1 if dropped).
+  std::vector<int> slot_map(num_slots, -1);
+  for (int i = 0; i < kept_slots.size(); i++) {
+    slot_map[kept_slots[i]] = i;
+  }
+
+  // Collision shapes are kept if their slot is kept.
+  if (collision_system_type == COLLSYS_PARALLEL) {
+    host_container& host = data_manager->host_data;
+    int num_shapes = data_manager->num_rigid_shapes;
+
+    std::vector<int> shape_map(num_shapes, -1);
+    std::vector<int> kept_shapes;
+    kept_shapes.reserve(num_shapes);
+    for (int i = 0; i < num_shapes; i++) {
+      if (slot_map[host.id_rigid[i]] != -1) {
+        shape_map[i] = kept_shapes.size();
+        kept_shapes.push_back(i);
+      }
+    }
+
+    if (kept_shapes.size() < num_shapes) {
+      CompactHostVector(host.proto_rigid, kept_shapes);
+      CompactHostVector(host.fam_rigid, kept_shapes);
+      CompactHostVector(host.id_rigid, kept_shapes);
+
+      // Drop the shape prototypes that are no longer used.
+      ((collision::ChCollisionSystemParallel*)collision_system)->CompactShapePrototypes();
+    }
+
+#pragma omp parallel for
+    for (int i = 0; i < kept_shapes.size(); i++) {
+      host.id_rigid[i] = slot_map[host.id_rigid[i]];
+    }
+
+    // Shear history (DEM): max_shear neighbors per slot, each one given by the
+    // neighbor slot and the two shapes in contact.
+    if (host.shear_neigh.size() > 0) {
+      CompactHostVector(host.shear_neigh, kept_slots, max_shear);
+      CompactHostVector(host.shear_disp, kept_slots, max_shear);
+
+#pragma omp parallel for
+      for (int i = 0; i < host.shear_neigh.size(); i++) {
+        int3& neigh = host.shear_neigh[i];
+        if (neigh.x == -1)
+          continue;
+        int body = slot_map[neigh.x];
+        int shape1 = shape_map[neigh.y];
+        int shape2 = shape_map[neigh.z];
+        if (body == -1 || shape1 == -1 || shape2 == -1)
+          neigh = I3(-1, -1, -1);
+        else
+          neigh = I3(body, shape1, shape2);
+      }
+    }
+
+    data_manager->num_rigid_shapes = kept_shapes.size();
+  }
+
+  CompactHostVector(data_manager->host_data.pos_rigid, kept_slots);
+  CompactHostVector(data_manager->host_data.rot_rigid, kept_slots);
+  CompactHostVector(data_manager->host_data.active_rigid, kept_slots);
+  CompactHostVector(data_manager->host_data.collide_rigid, kept_slots);
+  CompactHostVector(data_manager->host_data.vel_particle, kept_slots);
+  CompactHostVector(data_manager->host_data.omg_particle, kept_slots);
+  CompactHostVector(data_manager->host_data.inv_mass_particle, kept_slots);
+  CompactHostVector(data_manager->host_data.inv_inr_particle, kept_slots);
+
+  // Let derived classes compact the specific material surface data
+  CompactMaterialSurfaceData(kept_slots);
+
+  data_manager->num_rigid_bodies = kept_slots.size();
+  data_manager->num_rigid_contacts = 0;
+  if (data_manager->host_data.ct_body_map.size() > 0) {
+    data_manager->host_data.ct_body_map.resize(kept_slots.size());
+    Thrust_Fill(data_manager->host_data.ct_body_map, -1);
+  }
+  data_manager->Fc_current = false;
 }
 
 //
@@ -191,6 +473,8 @@ void ChSystemParallel::AddBody(std::shared_ptr<ChBody> newbody) {
 void ChSystemParallel::AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> newitem) {
     if (auto shaft = std::dynamic_pointer_cast<ChShaft>(newitem)) {
         AddShaft(shaft);
+    } else if (auto cloud = std::dynamic_pointer_cast<ChParticleCloudParallel>(newitem)) {
+        AddParticleCloud(cloud);
     } else {
         newitem->SetSystem(this);
         otherphysicslist.push_back(newitem);
@@ -224,12 +508,132 @@ void ChSystemParallel::AddShaft(std::shared_ptr<ChShaft> shaft) {
   data_manager->host_data.shaft_inr.push_back(0);
   data_manager->host_data.shaft_active.push_back(true);
 }
+//
+// Add the specified particle cloud to the system. The cloud has no particles
+// yet: they are added with ChParticleCloudParallel::AddParticles(), which
+// reserves their slots with AddParticleSlots().
+//
+void ChSystemParallel::AddParticleCloud(std::shared_ptr<ChParticleCloudParallel> cloud) {
+  if (collision_system_type != COLLSYS_PARALLEL)
+    throw ChException("ChSystemParallel: particle clouds require the parallel collision system.");
+  assert(cloud->GetPrototype()->GetContactMethod() == GetContactMethod());
+
+  cloud->m_first = data_manager->num_particles;
+  cloud->m_num = 0;
+  cloud->m_data_manager = data_manager;
+  cloud->SetSystem(this);
+
+  cloudlist.push_back(cloud);
+}
+
+//
+// Reserve the rigid body slots for new particles of the specified cloud. The
+// slots are appended to the system-wide vectors, together with the collision
+// shapes of the particles (which share the shape prototypes of the cloud).
+// The particles of each cloud are kept contiguous, so if the cloud is not the
+// last one the new slots are moved after its other particles.
+// Note that the actual data is set by the cloud.
+//
+void ChSystemParallel::AddParticleSlots(ChParticleCloudParallel* cloud, int num) {
+  FlushNewBodySlots();
+
+  host_container& host = data_manager->host_data;
+  int num_slots = data_manager->num_rigid_bodies;
+  int first_particle_slot = num_slots - data_manager->num_particles;
+
+  host.pos_rigid.resize(num_slots + num, R3());
+  host.rot_rigid.resize(num_slots + num, R4(1, 0, 0, 0));
+  host.active_rigid.resize(num_slots + num, true);
+  host.collide_rigid.resize(num_slots + num, cloud->GetCollide());
+  host.vel_particle.resize(num_slots + num, R3());
+  host.omg_particle.resize(num_slots + num, R3());
+  host.inv_mass_particle.resize(num_slots + num, 0);
+  host.inv_inr_particle.resize(num_slots + num, R3());
+
+  // Let derived classes reserve space for specific material surface data
+  AddMaterialSurfaceData(num);
+
+  if (cloud->GetCollide()) {
+    collision::ChCollisionModelParallel* model =
+        static_cast<collision::ChCollisionModelParallel*>(cloud->GetPrototype()->GetCollisionModel());
+    ((collision::ChCollisionSystemParallel*)collision_system)->AddShapes(model, num_slots, num);
+  }
+
+  data_manager->num_rigid_bodies += num;
+  data_manager->num_particles += num;
+
+  int cloud_end = cloud->m_first + cloud->m_num;
+  if (first_particle_slot + cloud_end < num_slots) {
+    std::vector<int> kept_slots(num_slots + num);
+    int insert_slot = first_particle_slot + cloud_end;
+    for (int i = 0; i < insert_slot; i++)
+      kept_slots[i] = i;
+    for (int i = 0; i < num; i++)
+      kept_slots[insert_slot + i] = num_slots + i;
+    for (int i = insert_slot; i < num_slots; i++)
+      kept_slots[num + i] = i;
+
+    ReorderRigidSlots(kept_slots);
+
+    for (int i = 0; i < cloudlist.size(); i++) {
+      if (cloudlist[i].get() != cloud && cloudlist[i]->m_first >= cloud_end)
+        cloudlist[i]->m_first += num;
+    }
+  }
+
+  cloud->m_num += num;
+}
+
+//
+// Add fluid nodes to the system. They are stored only in the system-wide
+// vectors, after the shafts in the degrees of freedom.
+//
+int ChSystemParallel::AddFluid(const std::vector<ChVector<> >& positions, const std::vector<ChVector<> >& velocities) {
+  if (GetContactMethod() != ChMaterialSurfaceBase::DVI)
+    throw ChException("ChSystemParallel: fluid requires the DVI contact method.");
+  if (collision_system_type != COLLSYS_PARALLEL)
+    throw ChException("ChSystemParallel: fluid requires the parallel collision system.");
+  assert(velocities.empty() || velocities.size() == positions.size());
+
+  host_container& host = data_manager->host_data;
+  int index = data_manager->num_fluid_bodies;
+  int num = (int)positions.size();
+
+  host.pos_fluid.resize(index + num);
+  host.vel_fluid.resize(index + num);
+  host.den_fluid.resize(index + num, data_manager->settings.fluid.density);
+
+#pragma omp parallel for
+  for (int i = 0; i < num; i++) {
+    host.pos_fluid[index + i] = R3(positions[i].x, positions[i].y, positions[i].z);
+    host.vel_fluid[index + i] =
+        velocities.empty() ? R3(0) : R3(velocities[i].x, velocities[i].y, velocities[i].z);
+  }
+
+  data_manager->num_fluid_bodies += num;
+  return index;
+}
+
+ChVector<> ChSystemParallel::GetFluidPos(int i) const {
+  real3 pos = data_manager->host_data.pos_fluid[i];
+  return ChVector<>(pos.x, pos.y, pos.z);
+}
+
+ChVector<> ChSystemParallel::GetFluidVel(int i) const {
+  real3 vel = data_manager->host_data.vel_fluid[i];
+  return ChVector<>(vel.x, vel.y, vel.z);
+}
+
+double ChSystemParallel::GetFluidDensity(int i) const {
+  return data_manager->host_data.den_fluid[i];
+}
+
 //
 // Reset forces for all lcp variables
 //
 void ChSystemParallel::ClearForceVariables() {
 #pragma omp parallel for
-  for (int i = 0; i < data_manager->num_rigid_bodies; i++) {
+  for (int i = 0; i < bodylist.size(); i++) {
     bodylist[i]->VariablesFbReset();
   }
 
@@ -245,11 +649,14 @@ void ChSystemParallel::ClearForceVariables() {
 // 2. Compute link constraint forces
 // 3. Update other physics items (other than shafts)
 // 4. Update bodies (these introduce state variables)
-// 5. Update shafts (these introduce state variables)
-// 6. Process bilateral constraints
+// 5. Update particles (these introduce state variables)
+// 6. Update shafts (these introduce state variables)
+// 7. Process bilateral constraints
 //
 void ChSystemParallel::Update() {
   LOG(INFO) << "ChSystemParallel::Update()";
+  FlushNewBodySlots();
+
   // Clear the forces for all lcp variables
   ClearForceVariables();
 
@@ -265,6 +672,7 @@ void ChSystemParallel::Update() {
   UpdateLinks();
   UpdateOtherPhysics();
   UpdateRigidBodies();
+  UpdateParticles();
   UpdateShafts();
   UpdateFluidBodies();
   LCP_descriptor->EndInsertion();
@@ -285,6 +693,10 @@ void ChSystemParallel::UpdateRigidBodies() {
 
 #pragma omp parallel for
   for (int i = 0; i < bodylist.size(); i++) {
+    // Wake up a sleeping body that was moved from outside (its island is waken
+    // at the end of the step, see UpdateSleepingBodies).
+    bodylist[i]->SyncCollisionModels();
+
     bodylist[i]->Update(ChTime, false);
     bodylist[i]->VariablesFbLoadForces(GetStep());
     bodylist[i]->VariablesQbLoadSpeed();
@@ -314,13 +726,61 @@ void ChSystemParallel::UpdateRigidBodies() {
     active[i] = bodylist[i]->IsActive();
     collide[i] = bodylist[i]->GetCollide();
 
-    // Let derived classes set the specific material surface data.
-    UpdateMaterialSurfaceData(i, bodylist[i].get());
+    // Let derived classes set the specific material surface data. Since this
+    // is a parallel for loop, the material is accessed by reference (we cannot
+    // use ChBody::GetMaterialSurface since that returns a copy of the reference
+    // counted shared pointer).
+    UpdateMaterialSurfaceData(i, bodylist[i]->GetMaterialSurfaceBase().get(), bodylist[i]->GetMass());
 
     bodylist[i]->GetCollisionModel()->SyncPosition();
   }
 }
 
+//
+// Populate the system-wide velocity and force vectors for all particles. The
+// particle state is already in the system-wide vectors; the only forces are
+// gravity and the gyroscopic torque. Particles never sleep, but may have been
+// deactivated by the collision system (see SetAABB).
+//
+void ChSystemParallel::UpdateParticles() {
+  host_container& host = data_manager->host_data;
+  real step_size = GetStep();
+  real3 gravity = R3(G_acc.x, G_acc.y, G_acc.z);
+
+  for (int c = 0; c < cloudlist.size(); c++) {
+    ChMaterialSurfaceBase* mat = cloudlist[c]->GetPrototype()->GetMaterialSurfaceBase().get();
+    int first_slot = cloudlist[c]->GetFirstSlot();
+    int last_slot = first_slot + cloudlist[c]->GetNparticles();
+
+#pragma omp parallel for
+    for (int i = first_slot; i < last_slot; i++) {
+      real3 vel = host.vel_particle[i];
+      real3 omg = host.omg_particle[i];
+      real mass = 1.0 / host.inv_mass_particle[i];
+      real3 inv_inr = host.inv_inr_particle[i];
+      real3 gyro = cross(omg, R3(omg.x / inv_inr.x, omg.y / inv_inr.y, omg.z / inv_inr.z));
+
+      host.v[i * 6 + 0] = vel.x;
+      host.v[i * 6 + 1] = vel.y;
+      host.v[i * 6 + 2] = vel.z;
+      host.v[i * 6 + 3] = omg.x;
+      host.v[i * 6 + 4] = omg.y;
+      host.v[i * 6 + 5] = omg.z;
+
+      host.hf[i * 6 + 0] = step_size * mass * gravity.x;
+      host.hf[i * 6 + 1] = step_size * mass * gravity.y;
+      host.hf[i * 6 + 2] = step_size * mass * gravity.z;
+      host.hf[i * 6 + 3] = -step_size * gyro.x;
+      host.hf[i * 6 + 4] = -step_size * gyro.y;
+      host.hf[i * 6 + 5] = -step_size * gyro.z;
+
+      host.active_rigid[i] = true;
+
+      UpdateMaterialSurfaceData(i, mat, mass);
+    }
+  }
+}
+
 //
 // Update all shaft elements in the system and populate system-wide state and
 // force vectors. Note that visualization assets are not updated.
@@ -348,9 +808,25 @@ void ChSystemParallel::UpdateShafts() {
 }
 
 //
-// Update all fluid nodes
-// currently a stub
+// Populate the system-wide state and force vectors for the fluid nodes. The
+// only external force is gravity.
+//
 void ChSystemParallel::UpdateFluidBodies() {
+  custom_vector<real3>& vel_fluid = data_manager->host_data.vel_fluid;
+  int fluid_offset = data_manager->num_rigid_bodies * 6 + data_manager->num_shafts;
+  real3 gravity = R3(G_acc.x, G_acc.y, G_acc.z) * data_manager->settings.fluid.mass * GetStep();
+
+#pragma omp parallel for
+  for (int i = 0; i < data_manager->num_fluid_bodies; i++) {
+    int dof = fluid_offset + i * 3;
+    data_manager->host_data.v[dof + 0] = vel_fluid[i].x;
+    data_manager->host_data.v[dof + 1] = vel_fluid[i].y;
+    data_manager->host_data.v[dof + 2] = vel_fluid[i].z;
+
+    data_manager->host_data.hf[dof + 0] = gravity.x;
+    data_manager->host_data.hf[dof + 1] = gravity.y;
+    data_manager->host_data.hf[dof + 2] = gravity.z;
+  }
 }
 
 //
@@ -370,13 +846,74 @@ void ChSystemParallel::UpdateLinks() {
     linklist[i]->ConstraintsFbLoadForces(GetStep());
     linklist[i]->ConstraintsLoadJacobians();
 
+    // Only count the constraints that were actually injected: disabled or
+    // sleeping links do not insert any.
+    size_t num_injected = LCP_descriptor->GetConstraintsList().size();
     linklist[i]->InjectConstraints(*LCP_descriptor);
+    num_injected = LCP_descriptor->GetConstraintsList().size() - num_injected;
 
-    for (int j = 0; j < linklist[i]->GetDOC_c(); j++)
+    for (int j = 0; j < num_injected; j++)
       data_manager->host_data.bilateral_type.push_back(BODY_BODY);
   }
 }
 
+//
+// Put to sleep the rigid bodies that came to rest and wake up the sleeping
+// bodies touched by active ones. As in ChSystem, bodies are grouped into
+// simulation islands through links and contacts, and each island falls asleep
+// or wakes up as a whole. Sleeping bodies are inactive, so they are excluded
+// from the solve and pairs of sleeping bodies are skipped by the broadphase;
+// the contacts found between an active and a sleeping body wake up the island
+// of the latter at the end of the step.
+//
+void ChSystemParallel::UpdateSleepingBodies() {
+  if (!GetUseSleeping())
+    return;
+
+  int num_bodies = bodylist.size();
+  int num_slots = data_manager->num_rigid_bodies;
+  int num_contacts = data_manager->num_rigid_contacts;
+  const custom_vector<int2>& bids = data_manager->host_data.bids_rigid_rigid;
+
+  // Mark the bodies at rest as sleep candidates (velocity thresholds).
+#pragma omp parallel for
+  for (int i = 0; i < num_bodies; i++) {
+    bodylist[i]->TrySleeping();
+  }
+
+  // Partition the bodies in islands. Bodies are indexed by their identifier,
+  // which is their position in bodylist. Fixed bodies do not connect islands.
+  // Particles (the slots after the bodies) are included, as they connect the
+  // bodies they touch.
+  islands.Reset(num_slots);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_contacts; i++) {
+    int2 b = bids[i];
+    bool fixed_x = b.x < num_bodies && bodylist[b.x]->GetBodyFixed();
+    bool fixed_y = b.y < num_bodies && bodylist[b.y]->GetBodyFixed();
+    if (!fixed_x && !fixed_y)
+      islands.Union(b.x, b.y);
+  }
+
+  islands.UnionLinks(bodylist, linklist);
+
+  // Pairs of sleeping bodies are not in the contact list: keep the bodies that
+  // fell asleep together in the same island through their group tag.
+  islands.UnionSleepingGroups(bodylist);
+
+  // Put to sleep or wake up whole islands; particles never sleep, so their
+  // islands are always awake.
+  islands.UpdateSleeping(bodylist);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_bodies; i++) {
+    data_manager->host_data.active_rigid[i] = bodylist[i]->IsActive();
+  }
+
+  ChSimulationIslands::UpdateSleepingLinks(linklist);
+}
+
 //
 // This utility function returns the type of constraints associated with the
 // specified physics item. Return UNKNOWN if the item has no associated
@@ -493,7 +1030,7 @@ void ChSystemParallel::Setup() {
       data_manager->num_rigid_bodies * 6 + data_manager->num_shafts + data_manager->num_fluid_bodies * 3;
 
   // Set variables that are stored in the ChSystem class
-  nbodies = data_manager->num_rigid_bodies;
+  nbodies = bodylist.size();
   nlinks = 0;
   nphysicsitems = 0;
   ncoords = 0;
@@ -513,6 +1050,12 @@ void ChSystemParallel::Setup() {
 
 void ChSystemParallel::RecomputeThreads() {
 #ifdef CHRONO_OMP_FOUND
+  // Inside a parallel region (ex. a ChSystemEnsemble) the number of threads is
+  // decided by the caller, and omp_set_num_threads would change it for the
+  // other systems run by this thread.
+  if (omp_in_parallel())
+    return;
+
   timer_accumulator.insert(timer_accumulator.begin(), data_manager->system_timer.GetTime("step"));
   timer_accumulator.pop_back();
 
@@ -557,7 +1100,7 @@ void ChSystemParallel::RecomputeThreads() {
 }
 
 void ChSystemParallel::ChangeCollisionSystem(COLLISIONSYSTEMTYPE type) {
-  assert(GetNbodies() == 0);
+  assert(data_manager->num_rigid_bodies == 0);
 
   delete collision_system;
 
@@ -617,3 +1160,453 @@ double ChSystemParallel::CalculateConstraintViolation(std::vector<double>& cvec)
 
   return max_c;
 }
+
+// -----------------------------------------------------------------------------
+// Binary checkpoint
+//
+// Layout of the file:
+//   CheckpointHeader
+//   CheckpointSection[num_sections]
+//   section data (each array starting at a 16-byte aligned offset)
+// Sections with an unknown id are skipped when reading, so that new sections
+// can be added without changing the version number.
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const char checkpoint_magic[8] = {'C', 'H', 'P', 'C', 'K', 'P', 'T', '\0'};
+const uint32_t checkpoint_version = 1;
+
+struct CheckpointHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t real_size;       // size of the floating point type (float or double)
+  uint32_t contact_method;  // DVI or DEM
+  uint32_t num_sections;
+  double time;
+  uint64_t num_bodies;
+  uint64_t num_shafts;
+};
+
+struct CheckpointSection {
+  uint32_t id;
+  uint32_t elem_size;
+  uint64_t count;
+  uint64_t offset;
+};
+
+enum CheckpointSectionId {
+  CHECKPOINT_BODY_POS,       // real3 per body
+  CHECKPOINT_BODY_ROT,       // real4 per body
+  CHECKPOINT_BODY_VEL,       // 6 reals per body (linear velocity, local angular velocity)
+  CHECKPOINT_BODY_SLEEPING,  // char per body
+  CHECKPOINT_SHAFT_STATE,    // 2 reals per shaft (rotation, angular velocity)
+  CHECKPOINT_SHEAR_NEIGH,    // max_shear int3 per body and particle (DEM)
+  CHECKPOINT_SHEAR_DISP,     // max_shear real3 per body and particle (DEM)
+  CHECKPOINT_PARTICLE_POS,   // real3 per particle
+  CHECKPOINT_PARTICLE_ROT,   // real4 per particle
+  CHECKPOINT_PARTICLE_VEL,   // 6 reals per particle (linear velocity, local angular velocity)
+  CHECKPOINT_CONTACT_BIDS,   // int2 per rigid contact (body slots)
+  CHECKPOINT_CONTACT_NORM,   // real3 per rigid contact
+  CHECKPOINT_CONTACT_CPTA,   // real3 per rigid contact
+  CHECKPOINT_CONTACT_CPTB,   // real3 per rigid contact
+  CHECKPOINT_CONTACT_DPTH,   // real per rigid contact
+  CHECKPOINT_CONTACT_ERAD,   // real per rigid contact (DEM only, may be empty)
+  CHECKPOINT_CONTACT_FORCE,  // real3 per body and particle (total contact force)
+  CHECKPOINT_CONTACT_TORQUE, // real3 per body and particle (total contact torque)
+  CHECKPOINT_FLUID_POS,      // real3 per fluid node
+  CHECKPOINT_FLUID_VEL,      // real3 per fluid node
+  CHECKPOINT_NUM_SECTIONS
+};
+
+uint64_t AlignCheckpointOffset(uint64_t offset) {
+  return (offset + 15) & ~uint64_t(15);
+}
+
+template <typename T>
+void SetCheckpointSection(CheckpointSection& section, CheckpointSectionId id, const custom_vector<T>& data) {
+  section.id = id;
+  section.elem_size = sizeof(T);
+  section.count = data.size();
+}
+
+// Copy of the first 'count' entries of a contact array (contact arrays can be
+// larger than the number of contacts).
+template <typename T>
+custom_vector<T> CheckpointContactData(const custom_vector<T>& data, uint count) {
+  if (data.size() < count)
+    return custom_vector<T>();
+  return custom_vector<T>(data.begin(), data.begin() + count);
+}
+
+template <typename T>
+bool ReadCheckpointSection(std::ifstream& file, const CheckpointSection& section, custom_vector<T>& data) {
+  if (section.elem_size != sizeof(T))
+    return false;
+  data.resize(section.count);
+  file.seekg(section.offset);
+  file.read((char*)data.data(), section.count * sizeof(T));
+  return file.good();
+}
+
+}  // end anonymous namespace
+
+bool ChSystemParallel::WriteBinaryCheckpoint(const std::string& filename) {
+  FlushNewBodySlots();
+
+  int num_bodies = (int)bodylist.size();
+  int num_shafts = (int)shaftlist.size();
+
+  // Gather the body and shaft states in contiguous arrays.
+  custom_vector<real3> pos(num_bodies);
+  custom_vector<real4> rot(num_bodies);
+  custom_vector<real> vel(6 * num_bodies);
+  custom_vector<char> sleeping(num_bodies);
+  custom_vector<real> shaft_state(2 * num_shafts);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_bodies; i++) {
+    const ChVector<>& body_pos = bodylist[i]->GetPos();
+    const ChQuaternion<>& body_rot = bodylist[i]->GetRot();
+    const ChVector<>& body_vel = bodylist[i]->GetPos_dt();
+    const ChVector<>& body_omg = bodylist[i]->GetWvel_loc();
+    pos[i] = R3(body_pos.x, body_pos.y, body_pos.z);
+    rot[i] = R4(body_rot.e0, body_rot.e1, body_rot.e2, body_rot.e3);
+    vel[6 * i + 0] = body_vel.x;
+    vel[6 * i + 1] = body_vel.y;
+    vel[6 * i + 2] = body_vel.z;
+    vel[6 * i + 3] = body_omg.x;
+    vel[6 * i + 4] = body_omg.y;
+    vel[6 * i + 5] = body_omg.z;
+    sleeping[i] = bodylist[i]->GetSleeping();
+  }
+
+  for (int i = 0; i < num_shafts; i++) {
+    shaft_state[2 * i + 0] = shaftlist[i]->GetPos();
+    shaft_state[2 * i + 1] = shaftlist[i]->GetPos_dt();
+  }
+
+  // The particle state is already in the system-wide vectors, after the bodies.
+  int num_particles = data_manager->num_particles;
+  const host_container& host = data_manager->host_data;
+  custom_vector<real3> particle_pos(host.pos_rigid.begin() + num_bodies, host.pos_rigid.end());
+  custom_vector<real4> particle_rot(host.rot_rigid.begin() + num_bodies, host.rot_rigid.end());
+  custom_vector<real> particle_vel(6 * num_particles);
+
+#pragma omp parallel for
+  for (int i = 0; i < num_particles; i++) {
+    const real3& vel = host.vel_particle[num_bodies + i];
+    const real3& omg = host.omg_particle[num_bodies + i];
+    particle_vel[6 * i + 0] = vel.x;
+    particle_vel[6 * i + 1] = vel.y;
+    particle_vel[6 * i + 2] = vel.z;
+    particle_vel[6 * i + 3] = omg.x;
+    particle_vel[6 * i + 4] = omg.y;
+    particle_vel[6 * i + 5] = omg.z;
+  }
+
+  const custom_vector<int3>& shear_neigh = data_manager->host_data.shear_neigh;
+  const custom_vector<real3>& shear_disp = data_manager->host_data.shear_disp;
+
+  // The rigid contacts found at the last step and the resulting contact forces,
+  // so that contact queries give the same answers right after a restart. The
+  // contacts are found again by the next collision detection.
+  uint num_contacts = data_manager->num_rigid_contacts;
+  custom_vector<int2> contact_bids = CheckpointContactData(host.bids_rigid_rigid, num_contacts);
+  custom_vector<real3> contact_norm = CheckpointContactData(host.norm_rigid_rigid, num_contacts);
+  custom_vector<real3> contact_cpta = CheckpointContactData(host.cpta_rigid_rigid, num_contacts);
+  custom_vector<real3> contact_cptb = CheckpointContactData(host.cptb_rigid_rigid, num_contacts);
+  custom_vector<real> contact_dpth = CheckpointContactData(host.dpth_rigid_rigid, num_contacts);
+  custom_vector<real> contact_erad = CheckpointContactData(host.erad_rigid_rigid, num_contacts);
+
+  int num_slots = data_manager->num_rigid_bodies;
+  custom_vector<real3> contact_force;
+  custom_vector<real3> contact_torque;
+  if (GetContactMethod() == ChMaterialSurfaceBase::DVI && !data_manager->Fc_current)
+    static_cast<ChSystemParallelDVI*>(this)->CalculateContactForces();
+  if (GetContactMethod() == ChMaterialSurfaceBase::DVI || host.ct_body_map.size() == num_slots) {
+    contact_force.resize(num_slots);
+    contact_torque.resize(num_slots);
+#pragma omp parallel for
+    for (int i = 0; i < num_slots; i++) {
+      contact_force[i] = GetBodyContactForce(i);
+      contact_torque[i] = GetBodyContactTorque(i);
+    }
+  }
+
+  // The fluid state is already in contiguous arrays; the density is computed
+  // at each step.
+  const custom_vector<real3>& fluid_pos = host.pos_fluid;
+  const custom_vector<real3>& fluid_vel = host.vel_fluid;
+
+  // Fill in the header and the table of sections.
+  CheckpointHeader header;
+  std::memcpy(header.magic, checkpoint_magic, sizeof(header.magic));
+  header.version = checkpoint_version;
+  header.real_size = sizeof(real);
+  header.contact_method = GetContactMethod();
+  header.num_sections = CHECKPOINT_NUM_SECTIONS;
+  header.time = ChTime;
+  header.num_bodies = num_bodies;
+  header.num_shafts = num_shafts;
+
+  CheckpointSection sections[CHECKPOINT_NUM_SECTIONS];
+  const void* section_data[CHECKPOINT_NUM_SECTIONS] = {
+      pos.data(),          rot.data(),          vel.data(),           sleeping.data(),      shaft_state.data(),
+      shear_neigh.data(),  shear_disp.data(),   particle_pos.data(),  particle_rot.data(),  particle_vel.data(),
+      contact_bids.data(), contact_norm.data(), contact_cpta.data(),  contact_cptb.data(),  contact_dpth.data(),
+      contact_erad.data(), contact_force.data(), contact_torque.data(), fluid_pos.data(),   fluid_vel.data()};
+  SetCheckpointSection(sections[CHECKPOINT_BODY_POS], CHECKPOINT_BODY_POS, pos);
+  SetCheckpointSection(sections[CHECKPOINT_BODY_ROT], CHECKPOINT_BODY_ROT, rot);
+  SetCheckpointSection(sections[CHECKPOINT_BODY_VEL], CHECKPOINT_BODY_VEL, vel);
+  SetCheckpointSection(sections[CHECKPOINT_BODY_SLEEPING], CHECKPOINT_BODY_SLEEPING, sleeping);
+  SetCheckpointSection(sections[CHECKPOINT_SHAFT_STATE], CHECKPOINT_SHAFT_STATE, shaft_state);
+  SetCheckpointSection(sections[CHECKPOINT_SHEAR_NEIGH], CHECKPOINT_SHEAR_NEIGH, shear_neigh);
+  SetCheckpointSection(sections[CHECKPOINT_SHEAR_DISP], CHECKPOINT_SHEAR_DISP, shear_disp);
+  SetCheckpointSection(sections[CHECKPOINT_PARTICLE_POS], CHECKPOINT_PARTICLE_POS, particle_pos);
+  SetCheckpointSection(sections[CHECKPOINT_PARTICLE_ROT], CHECKPOINT_PARTICLE_ROT, particle_rot);
+  SetCheckpointSection(sections[CHECKPOINT_PARTICLE_VEL], CHECKPOINT_PARTICLE_VEL, particle_vel);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_BIDS], CHECKPOINT_CONTACT_BIDS, contact_bids);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_NORM], CHECKPOINT_CONTACT_NORM, contact_norm);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_CPTA], CHECKPOINT_CONTACT_CPTA, contact_cpta);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_CPTB], CHECKPOINT_CONTACT_CPTB, contact_cptb);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_DPTH], CHECKPOINT_CONTACT_DPTH, contact_dpth);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_ERAD], CHECKPOINT_CONTACT_ERAD, contact_erad);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_FORCE], CHECKPOINT_CONTACT_FORCE, contact_force);
+  SetCheckpointSection(sections[CHECKPOINT_CONTACT_TORQUE], CHECKPOINT_CONTACT_TORQUE, contact_torque);
+  SetCheckpointSection(sections[CHECKPOINT_FLUID_POS], CHECKPOINT_FLUID_POS, fluid_pos);
+  SetCheckpointSection(sections[CHECKPOINT_FLUID_VEL], CHECKPOINT_FLUID_VEL, fluid_vel);
+
+  uint64_t offset = AlignCheckpointOffset(sizeof(header) + sizeof(sections));
+  for (int j = 0; j < CHECKPOINT_NUM_SECTIONS; j++) {
+    sections[j].offset = offset;
+    offset = AlignCheckpointOffset(offset + sections[j].elem_size * sections[j].count);
+  }
+
+  // Write everything in bulk.
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+    return false;
+
+  file.write((const char*)&header, sizeof(header));
+  file.write((const char*)sections, sizeof(sections));
+
+  const char padding[16] = {0};
+  uint64_t written = sizeof(header) + sizeof(sections);
+  for (int j = 0; j < CHECKPOINT_NUM_SECTIONS; j++) {
+    file.write(padding, sections[j].offset - written);
+    uint64_t size = sections[j].elem_size * sections[j].count;
+    file.write((const char*)section_data[j], size);
+    written = sections[j].offset + size;
+  }
+
+  return file.good();
+}
+
+bool ChSystemParallel::ReadBinaryCheckpoint(const std::string& filename) {
+  FlushNewBodySlots();
+
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open())
+    return false;
+
+  // Check that the checkpoint was written by a compatible system.
+  CheckpointHeader header;
+  file.read((char*)&header, sizeof(header));
+  if (!file.good() || std::memcmp(header.magic, checkpoint_magic, sizeof(header.magic)) != 0)
+    return false;
+  if (header.version != checkpoint_version || header.real_size != sizeof(real))
+    return false;
+  if (header.contact_method != GetContactMethod() || header.num_bodies != bodylist.size() ||
+      header.num_shafts != shaftlist.size())
+    return false;
+
+  std::vector<CheckpointSection> sections(header.num_sections);
+  file.read((char*)sections.data(), header.num_sections * sizeof(CheckpointSection));
+  if (!file.good())
+    return false;
+
+  int num_bodies = (int)bodylist.size();
+  int num_shafts = (int)shaftlist.size();
+
+  custom_vector<real3> pos;
+  custom_vector<real4> rot;
+  custom_vector<real> vel;
+  custom_vector<char> sleeping;
+  custom_vector<real> shaft_state;
+  custom_vector<int3> shear_neigh;
+  custom_vector<real3> shear_disp;
+  custom_vector<real3> particle_pos;
+  custom_vector<real4> particle_rot;
+  custom_vector<real> particle_vel;
+  custom_vector<int2> contact_bids;
+  custom_vector<real3> contact_norm;
+  custom_vector<real3> contact_cpta;
+  custom_vector<real3> contact_cptb;
+  custom_vector<real> contact_dpth;
+  custom_vector<real> contact_erad;
+  custom_vector<real3> contact_force;
+  custom_vector<real3> contact_torque;
+  custom_vector<real3> fluid_pos;
+  custom_vector<real3> fluid_vel;
+
+  bool ok = true;
+  for (int j = 0; j < sections.size() && ok; j++) {
+    switch (sections[j].id) {
+      case CHECKPOINT_BODY_POS:
+        ok = ReadCheckpointSection(file, sections[j], pos) && pos.size() == num_bodies;
+        break;
+      case CHECKPOINT_BODY_ROT:
+        ok = ReadCheckpointSection(file, sections[j], rot) && rot.size() == num_bodies;
+        break;
+      case CHECKPOINT_BODY_VEL:
+        ok = ReadCheckpointSection(file, sections[j], vel) && vel.size() == 6 * num_bodies;
+        break;
+      case CHECKPOINT_BODY_SLEEPING:
+        ok = ReadCheckpointSection(file, sections[j], sleeping) && sleeping.size() == num_bodies;
+        break;
+      case CHECKPOINT_SHAFT_STATE:
+        ok = ReadCheckpointSection(file, sections[j], shaft_state) && shaft_state.size() == 2 * num_shafts;
+        break;
+      case CHECKPOINT_SHEAR_NEIGH:
+        ok = ReadCheckpointSection(file, sections[j], shear_neigh);
+        break;
+      case CHECKPOINT_SHEAR_DISP:
+        ok = ReadCheckpointSection(file, sections[j], shear_disp);
+        break;
+      case CHECKPOINT_PARTICLE_POS:
+        ok = ReadCheckpointSection(file, sections[j], particle_pos);
+        break;
+      case CHECKPOINT_PARTICLE_ROT:
+        ok = ReadCheckpointSection(file, sections[j], particle_rot);
+        break;
+      case CHECKPOINT_PARTICLE_VEL:
+        ok = ReadCheckpointSection(file, sections[j], particle_vel);
+        break;
+      case CHECKPOINT_CONTACT_BIDS:
+        ok = ReadCheckpointSection(file, sections[j], contact_bids);
+        break;
+      case CHECKPOINT_CONTACT_NORM:
+        ok = ReadCheckpointSection(file, sections[j], contact_norm);
+        break;
+      case CHECKPOINT_CONTACT_CPTA:
+        ok = ReadCheckpointSection(file, sections[j], contact_cpta);
+        break;
+      case CHECKPOINT_CONTACT_CPTB:
+        ok = ReadCheckpointSection(file, sections[j], contact_cptb);
+        break;
+      case CHECKPOINT_CONTACT_DPTH:
+        ok = ReadCheckpointSection(file, sections[j], contact_dpth);
+        break;
+      case CHECKPOINT_CONTACT_ERAD:
+        ok = ReadCheckpointSection(file, sections[j], contact_erad);
+        break;
+      case CHECKPOINT_CONTACT_FORCE:
+        ok = ReadCheckpointSection(file, sections[j], contact_force);
+        break;
+      case CHECKPOINT_CONTACT_TORQUE:
+        ok = ReadCheckpointSection(file, sections[j], contact_torque);
+        break;
+      case CHECKPOINT_FLUID_POS:
+        ok = ReadCheckpointSection(file, sections[j], fluid_pos);
+        break;
+      case CHECKPOINT_FLUID_VEL:
+        ok = ReadCheckpointSection(file, sections[j], fluid_vel);
+        break;
+      default:
+        break;
+    }
+  }
+  if (!ok || pos.size() != num_bodies || rot.size() != num_bodies || vel.size() != 6 * num_bodies)
+    return false;
+
+  // The particles must match too (checkpoints without particles have none).
+  int num_particles = data_manager->num_particles;
+  if (particle_pos.size() != num_particles || particle_rot.size() != num_particles ||
+      particle_vel.size() != 6 * num_particles)
+    return false;
+
+  // And so must the fluid nodes.
+  int num_fluid = data_manager->num_fluid_bodies;
+  if (fluid_pos.size() != num_fluid || fluid_vel.size() != num_fluid)
+    return false;
+
+  // Scatter the states to the bodies and shafts.
+#pragma omp parallel for
+  for (int i = 0; i < num_bodies; i++) {
+    bodylist[i]->SetPos(ChVector<>(pos[i].x, pos[i].y, pos[i].z));
+    bodylist[i]->SetRot(ChQuaternion<>(rot[i].w, rot[i].x, rot[i].y, rot[i].z));
+    bodylist[i]->SetPos_dt(ChVector<>(vel[6 * i + 0], vel[6 * i + 1], vel[6 * i + 2]));
+    bodylist[i]->SetWvel_loc(ChVector<>(vel[6 * i + 3], vel[6 * i + 4], vel[6 * i + 5]));
+    if (sleeping.size() == num_bodies)
+      bodylist[i]->SetSleeping(sleeping[i] != 0);
+  }
+
+  if (shaft_state.size() == 2 * num_shafts) {
+    for (int i = 0; i < num_shafts; i++) {
+      shaftlist[i]->SetPos(shaft_state[2 * i + 0]);
+      shaftlist[i]->SetPos_dt(shaft_state[2 * i + 1]);
+    }
+  }
+
+  host_container& host = data_manager->host_data;
+#pragma omp parallel for
+  for (int i = 0; i < num_particles; i++) {
+    host.pos_rigid[num_bodies + i] = particle_pos[i];
+    host.rot_rigid[num_bodies + i] = particle_rot[i];
+    host.vel_particle[num_bodies + i] = R3(particle_vel[6 * i + 0], particle_vel[6 * i + 1], particle_vel[6 * i + 2]);
+    host.omg_particle[num_bodies + i] = R3(particle_vel[6 * i + 3], particle_vel[6 * i + 4], particle_vel[6 * i + 5]);
+  }
+
+  // Restore the contact shear history, so that tangential DEM forces are
+  // continuous across the restart.
+  int num_slots = data_manager->num_rigid_bodies;
+  if (shear_neigh.size() == max_shear * num_slots && shear_disp.size() == max_shear * num_slots) {
+    data_manager->host_data.shear_neigh.swap(shear_neigh);
+    data_manager->host_data.shear_disp.swap(shear_disp);
+  }
+
+  host.pos_fluid.swap(fluid_pos);
+  host.vel_fluid.swap(fluid_vel);
+
+  // Restore the contacts of the last step and the contact forces. Without them
+  // (older checkpoints), the contact forces are recomputed at the next step.
+  uint num_contacts = contact_bids.size();
+  if (contact_norm.size() == num_contacts && contact_cpta.size() == num_contacts &&
+      contact_cptb.size() == num_contacts && contact_dpth.size() == num_contacts) {
+    host.bids_rigid_rigid.swap(contact_bids);
+    host.norm_rigid_rigid.swap(contact_norm);
+    host.cpta_rigid_rigid.swap(contact_cpta);
+    host.cptb_rigid_rigid.swap(contact_cptb);
+    host.dpth_rigid_rigid.swap(contact_dpth);
+    if (contact_erad.size() == num_contacts)
+      host.erad_rigid_rigid.swap(contact_erad);
+    data_manager->num_rigid_contacts = num_contacts;
+  }
+
+  data_manager->Fc_current = false;
+  if (contact_force.size() == num_slots && contact_torque.size() == num_slots) {
+    if (GetContactMethod() == ChMaterialSurfaceBase::DVI) {
+      host.Fc.resize(6 * num_slots);
+#pragma omp parallel for
+      for (int i = 0; i < num_slots; i++) {
+        host.Fc[6 * i + 0] = contact_force[i].x;
+        host.Fc[6 * i + 1] = contact_force[i].y;
+        host.Fc[6 * i + 2] = contact_force[i].z;
+        host.Fc[6 * i + 3] = contact_torque[i].x;
+        host.Fc[6 * i + 4] = contact_torque[i].y;
+        host.Fc[6 * i + 5] = contact_torque[i].z;
+      }
+      data_manager->Fc_current = true;
+    } else {
+      host.ct_body_force.swap(contact_force);
+      host.ct_body_torque.swap(contact_torque);
+      host.ct_body_map.resize(num_slots);
+      Thrust_Sequence(host.ct_body_map);
+    }
+  }
+
+  SetChTime(header.time);
+
+  return true;
+}
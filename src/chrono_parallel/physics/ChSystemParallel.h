@@ -40,6 +40,7 @@
 #include "chrono_parallel/collision/ChCNarrowphaseR.h"
 #include "chrono_parallel/math/ChParallelMath.h"
 #include "chrono_parallel/physics/ChNodeFluid.h"
+#include "chrono_parallel/physics/ChParticleCloudParallel.h"
 namespace chrono {
 
 class CH_PARALLEL_API ChSystemParallel : public ChSystem {
@@ -52,6 +53,17 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
   virtual int Integrate_Y();
   virtual void AddBody(std::shared_ptr<ChBody> newbody) override;
   virtual void AddOtherPhysicsItem(std::shared_ptr<ChPhysicsItem> newitem) override;
+  virtual void RemoveBody(std::shared_ptr<ChBody> body) override;
+
+  /// Add a batch of bodies to the system, reserving space in the system-wide
+  /// vectors only once and adding all collision shapes with a single call.
+  virtual void AddBodies(const std::vector<std::shared_ptr<ChBody> >& bodies) override;
+  /// Remove a batch of bodies from the system. All system-wide vectors (body
+  /// and shape data, material data, contact shear history) are compacted in a
+  /// single pass; the remaining bodies keep their relative order but their Id
+  /// is renumbered, so GetIdentifier() should be used as a stable handle.
+  /// Links to the removed bodies must be removed by the caller.
+  void RemoveBodies(const std::vector<std::shared_ptr<ChBody> >& bodies);
 
   void ClearForceVariables();
   void Update();
@@ -60,11 +72,17 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
   void UpdateOtherPhysics();
   void UpdateRigidBodies();
   void UpdateShafts();
+  void UpdateParticles();
   void UpdateFluidBodies();
+  void UpdateSleepingBodies();
   void RecomputeThreads();
 
-  virtual void AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) = 0;
-  virtual void UpdateMaterialSurfaceData(int index, ChBody* body) = 0;
+  /// Reserve space for the material data of the given number of new rigid body slots.
+  virtual void AddMaterialSurfaceData(int num_slots) = 0;
+  /// Set the material data of a rigid body slot (body or particle) with the given mass.
+  virtual void UpdateMaterialSurfaceData(int index, ChMaterialSurfaceBase* mat, real mass) = 0;
+  /// Keep only the material data of the listed slots (old indices, in their new order).
+  virtual void CompactMaterialSurfaceData(const std::vector<int>& kept_bodies) = 0;
   virtual void Setup();
   virtual void ChangeCollisionSystem(COLLISIONSYSTEMTYPE type);
 
@@ -72,8 +90,27 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
 
   int GetNumBodies() { return data_manager->num_rigid_bodies + data_manager->num_fluid_bodies; }
 
+  /// Get the total number of particles, in all particle clouds.
+  int GetNumParticles() { return data_manager->num_particles; }
+
   int GetNumShafts() { return data_manager->num_shafts; }
 
+  /// Add fluid nodes at the given positions, with the given initial velocities
+  /// (zero if not given). The fluid properties are in GetSettings()->fluid and
+  /// are shared by all nodes. Fluid requires the DVI contact method and the
+  /// parallel collision system. Return the index of the first new node.
+  int AddFluid(const std::vector<ChVector<> >& positions,
+               const std::vector<ChVector<> >& velocities = std::vector<ChVector<> >());
+
+  /// Get the number of fluid nodes.
+  int GetNumFluidBodies() { return data_manager->num_fluid_bodies; }
+  /// Get the position of the specified fluid node.
+  ChVector<> GetFluidPos(int i) const;
+  /// Get the velocity of the specified fluid node.
+  ChVector<> GetFluidVel(int i) const;
+  /// Get the density of the specified fluid node, as computed at the last step.
+  double GetFluidDensity(int i) const;
+
   int GetNumContacts() {
     return data_manager->num_rigid_contacts + data_manager->num_rigid_fluid_contacts + data_manager->num_fluid_contacts;
   }
@@ -107,6 +144,20 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
   /// Return the maximum constraint violation.
   double CalculateConstraintViolation(std::vector<double>& cvec);
 
+  /// Write a binary checkpoint of the current state of the system: simulation
+  /// time, state of bodies, particles, shafts and fluid nodes, the DEM contact
+  /// shear history, and the rigid contacts and contact forces of the last step.
+  /// The file starts with a versioned header and a table of sections, each one
+  /// a contiguous array aligned on 16 bytes, so that it can be read in bulk or
+  /// memory-mapped. Return false if the file could not be written.
+  bool WriteBinaryCheckpoint(const std::string& filename);
+
+  /// Restore the state saved with WriteBinaryCheckpoint(). The system must
+  /// contain the same bodies, particles and shafts, in the same order, as the one that
+  /// wrote the checkpoint (e.g. created by the same setup code). Return false
+  /// if the file could not be read or does not match this system.
+  bool ReadBinaryCheckpoint(const std::string& filename);
+
   ChParallelDataManager* data_manager;
 
  protected:
@@ -123,9 +174,34 @@ class CH_PARALLEL_API ChSystemParallel : public ChSystem {
 
  private:
   void AddShaft(std::shared_ptr<ChShaft> shaft);
+  void AddParticleCloud(std::shared_ptr<ChParticleCloudParallel> cloud);
+
+  /// Append rigid body slots for new particles of the given cloud; the slots
+  /// are moved after the other particles of that cloud. Called by
+  /// ChParticleCloudParallel::AddParticles().
+  void AddParticleSlots(ChParticleCloudParallel* cloud, int num);
+
+  /// Move the slots of all the bodies added after the particles (counted in
+  /// num_new_bodies) before the particle slots. Called before the slots are
+  /// used by position: at each step, and when slots are added or removed.
+  void FlushNewBodySlots();
+
+  /// Move the bodies added at the end of the rigid body slots (after the
+  /// particles) to the end of the body slots.
+  void MoveNewBodySlots(int num);
+
+  /// Rearrange the rigid body slots: the new slot i takes the data of the old
+  /// slot kept[i], and the old slots that are not listed are dropped together
+  /// with their collision shapes. All vectors indexed by slot or by shape are
+  /// updated, and so are the references to slots and shapes. The body list
+  /// and the body identifiers are left to the caller.
+  void ReorderRigidSlots(const std::vector<int>& kept);
 
   std::vector<ChShaft*> shaftlist;
+  std::vector<std::shared_ptr<ChParticleCloudParallel> > cloudlist;
   std::shared_ptr<ChNodeFluid> fluid_container;
+
+  friend class ChParticleCloudParallel;
 };
 
 class CH_PARALLEL_API ChSystemParallelDVI : public ChSystemParallel {
@@ -138,8 +214,9 @@ class CH_PARALLEL_API ChSystemParallelDVI : public ChSystemParallel {
 
   virtual ChMaterialSurfaceBase::ContactMethod GetContactMethod() const { return ChMaterialSurfaceBase::DVI; }
   virtual ChBody* NewBody();
-  virtual void AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) override;
-  virtual void UpdateMaterialSurfaceData(int index, ChBody* body) override;
+  virtual void AddMaterialSurfaceData(int num_slots) override;
+  virtual void UpdateMaterialSurfaceData(int index, ChMaterialSurfaceBase* mat, real mass) override;
+  virtual void CompactMaterialSurfaceData(const std::vector<int>& kept_bodies) override;
 
   void CalculateContactForces();
 
@@ -158,8 +235,9 @@ class CH_PARALLEL_API ChSystemParallelDEM : public ChSystemParallel {
 
   virtual ChMaterialSurface::ContactMethod GetContactMethod() const { return ChMaterialSurfaceBase::DEM; }
   virtual ChBody* NewBody();
-  virtual void AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) override;
-  virtual void UpdateMaterialSurfaceData(int index, ChBody* body) override;
+  virtual void AddMaterialSurfaceData(int num_slots) override;
+  virtual void UpdateMaterialSurfaceData(int index, ChMaterialSurfaceBase* mat, real mass) override;
+  virtual void CompactMaterialSurfaceData(const std::vector<int>& kept_bodies) override;
 
   virtual void Setup();
   virtual void ChangeCollisionSystem(COLLISIONSYSTEMTYPE type);
@@ -21,33 +21,40 @@ ChBody* ChSystemParallelDEM::NewBody() {
   return new ChBody(ChMaterialSurfaceBase::DEM);
 }
 
-void ChSystemParallelDEM::AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) {
-  assert(newbody->GetContactMethod() == ChMaterialSurfaceBase::DEM);
+void ChSystemParallelDEM::AddMaterialSurfaceData(int num_slots) {
+  // Reserve space for material properties for the new slots. Note that the
+  // actual data is set in UpdateMaterialSurfaceData().
+  size_t size = data_manager->host_data.mu.size() + num_slots;
+  data_manager->host_data.mu.resize(size, 0);
+  data_manager->host_data.cohesion_data.resize(size, 0);
+  data_manager->host_data.adhesionMultDMT_data.resize(size, 0);
 
-  // Reserve space for material properties for the specified body. Not that the
-  // actual data is set in UpdateMaterialProperties().
-  data_manager->host_data.mu.push_back(0);
-  data_manager->host_data.cohesion_data.push_back(0);
-  data_manager->host_data.adhesionMultDMT_data.push_back(0);
-
-  data_manager->host_data.mass_rigid.push_back(0);
+  data_manager->host_data.mass_rigid.resize(size, 0);
 
   if (data_manager->settings.solver.use_material_properties) {
-    data_manager->host_data.elastic_moduli.push_back(R2(0, 0));
-    data_manager->host_data.cr.push_back(0);
+    data_manager->host_data.elastic_moduli.resize(size, R2(0, 0));
+    data_manager->host_data.cr.resize(size, 0);
   } else {
-    data_manager->host_data.dem_coeffs.push_back(R4(0, 0, 0, 0));
+    data_manager->host_data.dem_coeffs.resize(size, R4(0, 0, 0, 0));
   }
 
   if (data_manager->settings.solver.tangential_displ_mode == ChSystemDEM::TangentialDisplacementModel::MultiStep) {
-    for (int i = 0; i < max_shear; i++) {
-      data_manager->host_data.shear_neigh.push_back(I3(-1, -1, -1));
-      data_manager->host_data.shear_disp.push_back(R3(0, 0, 0));
-    }
+    data_manager->host_data.shear_neigh.resize(size * max_shear, I3(-1, -1, -1));
+    data_manager->host_data.shear_disp.resize(size * max_shear, R3(0, 0, 0));
   }
 }
 
-void ChSystemParallelDEM::UpdateMaterialSurfaceData(int index, ChBody* body) {
+void ChSystemParallelDEM::CompactMaterialSurfaceData(const std::vector<int>& kept_bodies) {
+  CompactHostVector(data_manager->host_data.mu, kept_bodies);
+  CompactHostVector(data_manager->host_data.cohesion_data, kept_bodies);
+  CompactHostVector(data_manager->host_data.adhesionMultDMT_data, kept_bodies);
+  CompactHostVector(data_manager->host_data.mass_rigid, kept_bodies);
+  CompactHostVector(data_manager->host_data.elastic_moduli, kept_bodies);
+  CompactHostVector(data_manager->host_data.cr, kept_bodies);
+  CompactHostVector(data_manager->host_data.dem_coeffs, kept_bodies);
+}
+
+void ChSystemParallelDEM::UpdateMaterialSurfaceData(int index, ChMaterialSurfaceBase* mat, real body_mass) {
   custom_vector<real>& mass = data_manager->host_data.mass_rigid;
   custom_vector<real2>& elastic_moduli = data_manager->host_data.elastic_moduli;
   custom_vector<real>& adhesion = data_manager->host_data.cohesion_data;
@@ -56,14 +63,9 @@ void ChSystemParallelDEM::UpdateMaterialSurfaceData(int index, ChBody* body) {
   custom_vector<real>& cr = data_manager->host_data.cr;
   custom_vector<real4>& dem_coeffs = data_manager->host_data.dem_coeffs;
 
-  // Since this function is called in a parallel for loop, we must access the
-  // material properties in a thread-safe manner (we cannot use the function
-  // ChBody::GetMaterialSurfaceDEM since that returns a copy of the reference
-  // counted shared pointer).
-  std::shared_ptr<ChMaterialSurfaceBase>& mat = body->GetMaterialSurfaceBase();
-  ChMaterialSurfaceDEM* mat_ptr = static_cast<ChMaterialSurfaceDEM*>(mat.get());
+  ChMaterialSurfaceDEM* mat_ptr = static_cast<ChMaterialSurfaceDEM*>(mat);
 
-  mass[index] = body->GetMass();
+  mass[index] = body_mass;
   mu[index] = mat_ptr->GetSfriction();
   adhesion[index] = mat_ptr->GetAdhesion();
   adhesionMult[index] = mat_ptr->GetAdhesionMultDMT();
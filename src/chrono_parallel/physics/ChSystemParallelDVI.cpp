@@ -32,27 +32,21 @@ ChBody* ChSystemParallelDVI::NewBody() {
   return new ChBody(ChMaterialSurfaceBase::DVI);
 }
 
-void ChSystemParallelDVI::AddMaterialSurfaceData(std::shared_ptr<ChBody> newbody) {
-  assert(newbody->GetContactMethod() == ChMaterialSurfaceBase::DVI);
-
-  // Reserve space for material properties for the specified body. Not that the
-  // actual data is set in UpdateMaterialProperties().
-  data_manager->host_data.fric_data.push_back(R3(0));
-  data_manager->host_data.cohesion_data.push_back(0);
-  data_manager->host_data.compliance_data.push_back(R4(0));
+void ChSystemParallelDVI::AddMaterialSurfaceData(int num_slots) {
+  // Reserve space for material properties for the new slots. Note that the
+  // actual data is set in UpdateMaterialSurfaceData().
+  size_t size = data_manager->host_data.fric_data.size() + num_slots;
+  data_manager->host_data.fric_data.resize(size, R3(0));
+  data_manager->host_data.cohesion_data.resize(size, 0);
+  data_manager->host_data.compliance_data.resize(size, R4(0));
 }
 
-void ChSystemParallelDVI::UpdateMaterialSurfaceData(int index, ChBody* body) {
+void ChSystemParallelDVI::UpdateMaterialSurfaceData(int index, ChMaterialSurfaceBase* mat, real mass) {
   custom_vector<real>& cohesion = data_manager->host_data.cohesion_data;
   custom_vector<real3>& friction = data_manager->host_data.fric_data;
   custom_vector<real4>& compliance = data_manager->host_data.compliance_data;
 
-  // Since this function is called in a parallel for loop, we must access the
-  // material properties in a thread-safe manner (we cannot use the function
-  // ChBody::GetMaterialSurface since that returns a copy of the reference
-  // counted shared pointer).
-  std::shared_ptr<ChMaterialSurfaceBase>& mat = body->GetMaterialSurfaceBase();
-  ChMaterialSurface* mat_ptr = static_cast<ChMaterialSurface*>(mat.get());
+  ChMaterialSurface* mat_ptr = static_cast<ChMaterialSurface*>(mat);
 
   friction[index] = R3(mat_ptr->GetKfriction(), mat_ptr->GetRollingFriction(), mat_ptr->GetSpinningFriction());
   cohesion[index] = mat_ptr->GetCohesion();
@@ -60,6 +54,12 @@ void ChSystemParallelDVI::UpdateMaterialSurfaceData(int index, ChBody* body) {
                          mat_ptr->GetComplianceSpinning());
 }
 
+void ChSystemParallelDVI::CompactMaterialSurfaceData(const std::vector<int>& kept_bodies) {
+  CompactHostVector(data_manager->host_data.fric_data, kept_bodies);
+  CompactHostVector(data_manager->host_data.cohesion_data, kept_bodies);
+  CompactHostVector(data_manager->host_data.compliance_data, kept_bodies);
+}
+
 void ChSystemParallelDVI::CalculateContactForces() {
   uint num_contacts = data_manager->num_rigid_contacts;
   DynamicVector<real>& Fc = data_manager->host_data.Fc;
@@ -151,6 +151,10 @@ void ChSystemParallelDVI::AssembleSystem() {
   chrono::collision::ChCollisionInfo icontact;
   for (int i = 0; i < data_manager->num_rigid_contacts; i++) {
     int2 cd_pair = data_manager->host_data.bids_rigid_rigid[i];
+    // Particles have no collision model of their own: their contacts are
+    // not reported.
+    if (cd_pair.x >= bodylist.size() || cd_pair.y >= bodylist.size())
+      continue;
     icontact.modelA = bodylist[cd_pair.x]->GetCollisionModel();
     icontact.modelB = bodylist[cd_pair.y]->GetCollisionModel();
     icontact.vN = ToChVector(data_manager->host_data.norm_rigid_rigid[i]);
@@ -0,0 +1,456 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: a parallel DEM system distributed over MPI processes, by
+// decomposition of the simulation domain in subdomains.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+#include "chrono_parallel/physics/ChSystemParallelDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Size of the body state in a record: position, rotation, linear velocity and
+// local angular velocity.
+static const int state_size = 13;
+
+ChSystemParallelDistributed::ChSystemParallelDistributed(MPI_Comm comm, unsigned int max_objects)
+    : ChSystemParallelDEM(max_objects),
+      comm(comm),
+      ghost_layer(0),
+      num_added(0),
+      num_owned(0),
+      exchanged(false),
+      num_sent(0) {
+  MPI_Comm_rank(comm, &rank);
+  MPI_Comm_size(comm, &num_ranks);
+  grid[0] = grid[1] = grid[2] = 0;
+}
+
+ChSystemParallelDistributed::~ChSystemParallelDistributed() {}
+
+void ChSystemParallelDistributed::SetDomain(const ChVector<>& lo,
+                                            const ChVector<>& hi,
+                                            int num_x,
+                                            int num_y,
+                                            int num_z,
+                                            double ghost) {
+  if (num_x * num_y * num_z != num_ranks)
+    throw ChException("ChSystemParallelDistributed: the number of subdomains must be the number of processes.");
+
+  domain_lo = lo;
+  domain_hi = hi;
+  grid[0] = num_x;
+  grid[1] = num_y;
+  grid[2] = num_z;
+  cell_size = ChVector<>((hi.x - lo.x) / num_x, (hi.y - lo.y) / num_y, (hi.z - lo.z) / num_z);
+  ghost_layer = ghost;
+
+  if (ghost_layer > std::min(cell_size.x, std::min(cell_size.y, cell_size.z)))
+    throw ChException("ChSystemParallelDistributed: the ghost layer is larger than the subdomains.");
+
+  // The neighbors are the (up to 26) subdomains that touch this one.
+  int i = rank % num_x;
+  int j = (rank / num_x) % num_y;
+  int k = rank / (num_x * num_y);
+
+  neighbors.clear();
+  for (int dk = -1; dk <= 1; dk++) {
+    for (int dj = -1; dj <= 1; dj++) {
+      for (int di = -1; di <= 1; di++) {
+        int ni = i + di, nj = j + dj, nk = k + dk;
+        if ((di == 0 && dj == 0 && dk == 0) || ni < 0 || nj < 0 || nk < 0 || ni >= num_x || nj >= num_y ||
+            nk >= num_z)
+          continue;
+        neighbors.push_back(ni + num_x * (nj + num_y * nk));
+      }
+    }
+  }
+  sent.assign(neighbors.size(), std::set<long long>());
+}
+
+void ChSystemParallelDistributed::GetSubdomain(ChVector<>& sub_lo, ChVector<>& sub_hi) const {
+  int i = rank % grid[0];
+  int j = (rank / grid[0]) % grid[1];
+  int k = rank / (grid[0] * grid[1]);
+  sub_lo = ChVector<>(domain_lo.x + i * cell_size.x, domain_lo.y + j * cell_size.y, domain_lo.z + k * cell_size.z);
+  sub_hi = sub_lo + cell_size;
+}
+
+void ChSystemParallelDistributed::ChangeCollisionSystem(COLLISIONSYSTEMTYPE type) {
+  if (type != COLLSYS_PARALLEL)
+    throw ChException("ChSystemParallelDistributed: only the parallel collision system is supported.");
+  ChSystemParallelDEM::ChangeCollisionSystem(type);
+}
+
+// -----------------------------------------------------------------------------
+// Ownership: bodies outside of the domain box belong to the nearest subdomain.
+// -----------------------------------------------------------------------------
+
+void ChSystemParallelDistributed::CellOf(const ChVector<>& pos, int cell[3]) const {
+  double p[3] = {pos.x - domain_lo.x, pos.y - domain_lo.y, pos.z - domain_lo.z};
+  double size[3] = {cell_size.x, cell_size.y, cell_size.z};
+  for (int a = 0; a < 3; a++) {
+    cell[a] = (int)std::floor(p[a] / size[a]);
+    cell[a] = std::max(0, std::min(grid[a] - 1, cell[a]));
+  }
+}
+
+int ChSystemParallelDistributed::OwnerOf(const ChVector<>& pos) const {
+  int cell[3];
+  CellOf(pos, cell);
+  return cell[0] + grid[0] * (cell[1] + grid[1] * cell[2]);
+}
+
+bool ChSystemParallelDistributed::InGhostRegion(int r, const ChVector<>& pos) const {
+  int cell[3] = {r % grid[0], (r / grid[0]) % grid[1], r / (grid[0] * grid[1])};
+  double p[3] = {pos.x - domain_lo.x, pos.y - domain_lo.y, pos.z - domain_lo.z};
+  double size[3] = {cell_size.x, cell_size.y, cell_size.z};
+  for (int a = 0; a < 3; a++) {
+    // The boundary subdomains extend beyond the domain box.
+    if (cell[a] > 0 && p[a] < cell[a] * size[a] - ghost_layer)
+      return false;
+    if (cell[a] < grid[a] - 1 && p[a] > (cell[a] + 1) * size[a] + ghost_layer)
+      return false;
+  }
+  return true;
+}
+
+bool ChSystemParallelDistributed::IsOwned(const std::shared_ptr<ChBody>& body) const {
+  std::unordered_map<const ChBody*, long long>::const_iterator id = global_ids.find(body.get());
+  return id != global_ids.end() && distributed.find(id->second)->second.owned;
+}
+
+int ChSystemParallelDistributed::GetNumBodiesGlobal() const {
+  int num_local = num_owned;
+  int num_global = 0;
+  MPI_Allreduce(&num_local, &num_global, 1, MPI_INT, MPI_SUM, comm);
+  return num_global;
+}
+
+// -----------------------------------------------------------------------------
+// Adding bodies: fixed bodies everywhere, the others only on their owner. The
+// global ids are unique without communication: each process numbers its own
+// bodies and interleaves them with the other processes.
+// -----------------------------------------------------------------------------
+
+void ChSystemParallelDistributed::AddBody(std::shared_ptr<ChBody> newbody) {
+  AddBodies(std::vector<std::shared_ptr<ChBody> >(1, newbody));
+}
+
+void ChSystemParallelDistributed::AddBodies(const std::vector<std::shared_ptr<ChBody> >& bodies) {
+  if (grid[0] == 0)
+    throw ChException("ChSystemParallelDistributed: SetDomain must be called before adding bodies.");
+
+  std::vector<std::shared_ptr<ChBody> > kept;
+  kept.reserve(bodies.size());
+  for (int i = 0; i < bodies.size(); i++) {
+    if (bodies[i]->GetBodyFixed()) {
+      kept.push_back(bodies[i]);
+    } else if (OwnerOf(bodies[i]->GetPos()) == rank) {
+      long long gid = num_added * num_ranks + rank;
+      if (!global_ids.insert(std::make_pair(bodies[i].get(), gid)).second)
+        throw ChException("ChSystemParallelDistributed: body added twice.");
+      Entry entry = {bodies[i], true};
+      distributed[gid] = entry;
+      num_added++;
+      kept.push_back(bodies[i]);
+      num_owned++;
+    }
+  }
+
+  if (!kept.empty())
+    ChSystemParallelDEM::AddBodies(kept);
+}
+
+// -----------------------------------------------------------------------------
+// The ghosts must be present before the first collision detection; then the
+// exchange follows each step.
+// -----------------------------------------------------------------------------
+
+int ChSystemParallelDistributed::Integrate_Y() {
+  timer_exchange.reset();
+
+  if (!exchanged) {
+    Exchange();
+    exchanged = true;
+  }
+
+  ChSystemParallelDEM::Integrate_Y();
+
+  Exchange();
+
+  return 1;
+}
+
+// -----------------------------------------------------------------------------
+// Body records, as arrays of doubles:
+//   size, global id, identifier, full flag, state (13 values)
+// and, for a full record (first time the body is sent to a neighbor):
+//   collide flag, mass, inertia (6), family group and mask, material (11),
+//   number of shapes, and for each shape:
+//     type, A (3), B (3), C (3), R (4), margin [, points of a convex hull]
+// -----------------------------------------------------------------------------
+
+void ChSystemParallelDistributed::PackBody(long long gid, ChBody* body, bool full, std::vector<double>& buffer) const {
+  size_t start = buffer.size();
+  buffer.push_back(0);
+  buffer.push_back((double)gid);
+  buffer.push_back(body->GetIdentifier());
+  buffer.push_back(full ? 1 : 0);
+
+  const ChVector<>& pos = body->GetPos();
+  const ChQuaternion<>& rot = body->GetRot();
+  const ChVector<>& vel = body->GetPos_dt();
+  ChVector<> omg = body->GetWvel_loc();
+  double state[state_size] = {pos.x, pos.y, pos.z, rot.e0, rot.e1, rot.e2, rot.e3,
+                              vel.x, vel.y, vel.z, omg.x, omg.y, omg.z};
+  buffer.insert(buffer.end(), state, state + state_size);
+
+  if (full) {
+    ChCollisionModelParallel* model = static_cast<ChCollisionModelParallel*>(body->GetCollisionModel());
+    ChMaterialSurfaceDEM* mat = body->GetMaterialSurfaceDEM().get();
+    ChVector<> inertia_xx = body->GetInertiaXX();
+    ChVector<> inertia_xy = body->GetInertiaXY();
+
+    double props[] = {body->GetCollide() ? 1.0 : 0.0,
+                      body->GetMass(),
+                      inertia_xx.x,
+                      inertia_xx.y,
+                      inertia_xx.z,
+                      inertia_xy.x,
+                      inertia_xy.y,
+                      inertia_xy.z,
+                      (double)model->GetFamilyGroup(),
+                      (double)model->GetFamilyMask(),
+                      mat->GetYoungModulus(),
+                      mat->GetPoissonRatio(),
+                      mat->GetSfriction(),
+                      mat->GetKfriction(),
+                      mat->GetRestitution(),
+                      mat->GetAdhesion(),
+                      mat->GetAdhesionMultDMT(),
+                      mat->GetKn(),
+                      mat->GetKt(),
+                      mat->GetGn(),
+                      mat->GetGt(),
+                      (double)model->GetNObjects()};
+    buffer.insert(buffer.end(), props, props + sizeof(props) / sizeof(double));
+
+    for (int i = 0; i < model->GetNObjects(); i++) {
+      const ConvexShape& shape = model->mData[i];
+      double data[] = {(double)shape.type, shape.A.x, shape.A.y, shape.A.z, shape.B.x, shape.B.y, shape.B.z, shape.C.x,
+                       shape.C.y,          shape.C.z, shape.R.w, shape.R.x, shape.R.y, shape.R.z, shape.margin};
+      buffer.insert(buffer.end(), data, data + sizeof(data) / sizeof(double));
+      if (shape.type == CONVEX) {
+        int first = int(shape.B.y);
+        for (int j = first; j < first + int(shape.B.x); j++) {
+          buffer.push_back(model->local_convex_data[j].x);
+          buffer.push_back(model->local_convex_data[j].y);
+          buffer.push_back(model->local_convex_data[j].z);
+        }
+      }
+    }
+  }
+
+  buffer[start] = (double)(buffer.size() - start);
+}
+
+std::shared_ptr<ChBody> ChSystemParallelDistributed::UnpackBody(const double*& data, long long& gid, bool& fresh) {
+  const double* record = data;
+  data += (size_t)record[0];
+
+  gid = (long long)record[1];
+  int identifier = (int)record[2];
+  bool full = record[3] != 0;
+  const double* state = record + 4;
+
+  std::shared_ptr<ChBody> body;
+  std::unordered_map<long long, Entry>::iterator it = distributed.find(gid);
+  fresh = (it == distributed.end());
+
+  if (fresh) {
+    if (!full)
+      throw ChException("ChSystemParallelDistributed: state received for an unknown body.");
+
+    const double* props = state + state_size;
+    body = std::shared_ptr<ChBody>(NewBody());
+    body->SetIdentifier(identifier);
+    body->SetMass(props[1]);
+
+    ChCollisionModelParallel* model = static_cast<ChCollisionModelParallel*>(body->GetCollisionModel());
+    model->ClearModel();
+    const double* shapes = props + 22;
+    for (int i = 0; i < (int)props[21]; i++) {
+      ConvexShape shape;
+      shape.type = (shape_type)(int)shapes[0];
+      shape.A = R3(shapes[1], shapes[2], shapes[3]);
+      shape.B = R3(shapes[4], shapes[5], shapes[6]);
+      shape.C = R3(shapes[7], shapes[8], shapes[9]);
+      shape.R = R4(shapes[10], shapes[11], shapes[12], shapes[13]);
+      shape.margin = shapes[14];
+      shapes += 15;
+
+      std::vector<real3> points;
+      if (shape.type == CONVEX) {
+        points.resize((int)shape.B.x);
+        for (int j = 0; j < points.size(); j++, shapes += 3)
+          points[j] = R3(shapes[0], shapes[1], shapes[2]);
+      }
+      model->AddShape(shape, points.empty() ? 0 : points.data());
+    }
+    model->BuildModel();
+    model->SetFamilyGroup((short int)props[8]);
+    model->SetFamilyMask((short int)props[9]);
+
+    // BuildModel() sets the inertia computed from the shapes; use the owner's.
+    body->SetInertiaXX(ChVector<>(props[2], props[3], props[4]));
+    body->SetInertiaXY(ChVector<>(props[5], props[6], props[7]));
+    body->SetCollide(props[0] != 0);
+
+    ChMaterialSurfaceDEM* mat = body->GetMaterialSurfaceDEM().get();
+    mat->SetYoungModulus((float)props[10]);
+    mat->SetPoissonRatio((float)props[11]);
+    mat->SetSfriction((float)props[12]);
+    mat->SetKfriction((float)props[13]);
+    mat->SetRestitution((float)props[14]);
+    mat->SetAdhesion((float)props[15]);
+    mat->SetAdhesionMultDMT((float)props[16]);
+    mat->SetKn((float)props[17]);
+    mat->SetKt((float)props[18]);
+    mat->SetGn((float)props[19]);
+    mat->SetGt((float)props[20]);
+  } else {
+    body = it->second.body;
+  }
+
+  body->SetPos(ChVector<>(state[0], state[1], state[2]));
+  body->SetRot(ChQuaternion<>(state[3], state[4], state[5], state[6]));
+  body->SetPos_dt(ChVector<>(state[7], state[8], state[9]));
+  body->SetWvel_loc(ChVector<>(state[10], state[11], state[12]));
+
+  return body;
+}
+
+// -----------------------------------------------------------------------------
+// Exchange with the neighbors. Only the owner of a body sends it. Ownership is
+// a function of the position, so when a body leaves a subdomain, the sender
+// gives it up and the receiver (which finds it in its own subdomain) takes it
+// over, in the same exchange. A body that was already a ghost on the receiver
+// keeps its slot, so that its contact history is preserved.
+// -----------------------------------------------------------------------------
+
+void ChSystemParallelDistributed::Exchange() {
+  timer_exchange.start();
+
+  int num_neighbors = neighbors.size();
+  std::vector<std::vector<double> > send_buffers(num_neighbors);
+  std::vector<std::set<long long> > sent_now(num_neighbors);
+
+  // Ghosts kept after this exchange: received ones and bodies just given up
+  // that are still in the ghost region.
+  std::unordered_set<long long> refreshed;
+
+  num_sent = 0;
+  for (std::unordered_map<long long, Entry>::iterator it = distributed.begin(); it != distributed.end(); ++it) {
+    Entry& entry = it->second;
+    if (!entry.owned)
+      continue;
+
+    const ChVector<>& pos = entry.body->GetPos();
+    for (int n = 0; n < num_neighbors; n++) {
+      if (InGhostRegion(neighbors[n], pos)) {
+        PackBody(it->first, entry.body.get(), sent[n].count(it->first) == 0, send_buffers[n]);
+        sent_now[n].insert(it->first);
+        num_sent++;
+      }
+    }
+
+    int owner = OwnerOf(pos);
+    if (owner != rank) {
+      if (std::find(neighbors.begin(), neighbors.end(), owner) == neighbors.end())
+        throw ChException("ChSystemParallelDistributed: a body crossed more than one subdomain in one step.");
+      entry.owned = false;
+      num_owned--;
+      if (InGhostRegion(rank, pos))
+        refreshed.insert(it->first);
+    }
+  }
+
+  // Sizes first, then the records.
+  std::vector<int> send_sizes(num_neighbors);
+  std::vector<int> recv_sizes(num_neighbors);
+  std::vector<MPI_Request> requests(2 * num_neighbors);
+  for (int n = 0; n < num_neighbors; n++) {
+    send_sizes[n] = send_buffers[n].size();
+    MPI_Irecv(&recv_sizes[n], 1, MPI_INT, neighbors[n], 0, comm, &requests[2 * n]);
+    MPI_Isend(&send_sizes[n], 1, MPI_INT, neighbors[n], 0, comm, &requests[2 * n + 1]);
+  }
+  MPI_Waitall(2 * num_neighbors, requests.data(), MPI_STATUSES_IGNORE);
+
+  std::vector<std::vector<double> > recv_buffers(num_neighbors);
+  for (int n = 0; n < num_neighbors; n++) {
+    recv_buffers[n].resize(recv_sizes[n]);
+    MPI_Irecv(recv_buffers[n].data(), recv_sizes[n], MPI_DOUBLE, neighbors[n], 1, comm, &requests[2 * n]);
+    MPI_Isend(send_buffers[n].data(), send_sizes[n], MPI_DOUBLE, neighbors[n], 1, comm, &requests[2 * n + 1]);
+  }
+  MPI_Waitall(2 * num_neighbors, requests.data(), MPI_STATUSES_IGNORE);
+
+  // Update the ghosts and take over the bodies that entered the subdomain.
+  std::vector<std::shared_ptr<ChBody> > added;
+  for (int n = 0; n < num_neighbors; n++) {
+    const double* data = recv_buffers[n].data();
+    const double* end = data + recv_buffers[n].size();
+    while (data < end) {
+      long long gid;
+      bool fresh;
+      std::shared_ptr<ChBody> body = UnpackBody(data, gid, fresh);
+      bool owned = (OwnerOf(body->GetPos()) == rank);
+
+      if (fresh) {
+        Entry entry = {body, owned};
+        distributed[gid] = entry;
+        global_ids[body.get()] = gid;
+        added.push_back(body);
+      } else {
+        distributed[gid].owned = owned;
+      }
+      if (owned)
+        num_owned++;
+      refreshed.insert(gid);
+    }
+  }
+
+  // Drop the ghosts that were not refreshed.
+  std::vector<std::shared_ptr<ChBody> > removed;
+  for (std::unordered_map<long long, Entry>::iterator it = distributed.begin(); it != distributed.end();) {
+    if (!it->second.owned && refreshed.count(it->first) == 0) {
+      removed.push_back(it->second.body);
+      global_ids.erase(it->second.body.get());
+      it = distributed.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  RemoveBodies(removed);
+  if (!added.empty())
+    ChSystemParallelDEM::AddBodies(added);
+
+  sent.swap(sent_now);
+
+  timer_exchange.stop();
+}
@@ -0,0 +1,149 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Description: a parallel DEM system distributed over MPI processes, by
+// decomposition of the simulation domain in subdomains.
+// =============================================================================
+
+#pragma once
+
+#include <mpi.h>
+
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "core/ChTimer.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+namespace chrono {
+
+/// Parallel DEM system distributed over MPI processes.
+/// The domain box is split in a grid of subdomains, one per process. Each
+/// process owns the bodies whose center is in its subdomain and also holds
+/// copies (ghosts) of the bodies owned by its neighbors whose center is within
+/// the ghost layer around its subdomain. Every process runs the usual
+/// collision detection and DEM solver on its owned and ghost bodies; after each
+/// step, the owners send the new states of their bodies to the neighbors that
+/// hold them as ghosts, and the bodies that left a subdomain change owner.
+///
+/// Requirements:
+///  - the ghost layer must be at least the largest distance between the center
+///    of a body and a point of a body it can touch, and at most the size of the
+///    subdomains; a body must not cross more than one subdomain in one step;
+///  - fixed bodies (e.g. containers) are added by every process and are not
+///    distributed; the other bodies are tracked across processes by a global id
+///    assigned when they are added (their identifier is only carried over to
+///    the ghosts, it need not be unique);
+///  - the parallel collision system; links and shafts are not supported.
+/// Bodies outside the domain box belong to the nearest subdomain.
+class CH_PARALLEL_API ChSystemParallelDistributed : public ChSystemParallelDEM {
+  CH_RTTI(ChSystemParallelDistributed, ChSystemParallelDEM);
+
+ public:
+  ChSystemParallelDistributed(MPI_Comm comm, unsigned int max_objects = 1000);
+  ~ChSystemParallelDistributed();
+
+  /// Split the box [lo, hi] in a grid of num_x * num_y * num_z subdomains, one
+  /// for each process of the communicator, and set the width of the ghost layer.
+  /// Must be called before adding bodies.
+  void SetDomain(const ChVector<>& lo,
+                 const ChVector<>& hi,
+                 int num_x,
+                 int num_y,
+                 int num_z,
+                 double ghost_layer);
+
+  /// Add a body. A fixed body is added on every process. Any other body is
+  /// added only by the process that owns its position, and ignored by the others.
+  virtual void AddBody(std::shared_ptr<ChBody> newbody) override;
+
+  /// Add a batch of bodies, keeping those that are fixed or owned (see AddBody).
+  virtual void AddBodies(const std::vector<std::shared_ptr<ChBody> >& bodies) override;
+
+  /// Advance the owned and ghost bodies by one step, then exchange the states
+  /// of the bodies with the neighbor processes.
+  virtual int Integrate_Y() override;
+
+  virtual void ChangeCollisionSystem(COLLISIONSYSTEMTYPE type) override;
+
+  /// Return true if the body is owned by this process (always false for fixed bodies).
+  bool IsOwned(const std::shared_ptr<ChBody>& body) const;
+
+  int GetRank() const { return rank; }
+  int GetNumRanks() const { return num_ranks; }
+  MPI_Comm GetCommunicator() const { return comm; }
+
+  /// Get the corners of the subdomain of this process.
+  void GetSubdomain(ChVector<>& sub_lo, ChVector<>& sub_hi) const;
+
+  /// Get the number of bodies owned by this process.
+  int GetNumOwnedBodies() const { return num_owned; }
+  /// Get the number of ghost bodies held by this process.
+  int GetNumGhostBodies() const { return (int)distributed.size() - num_owned; }
+  /// Get the number of distributed bodies owned by all processes (collective call).
+  int GetNumBodiesGlobal() const;
+
+  /// Get the time (in seconds) spent in the exchange with the neighbors, at the last step.
+  double GetTimerExchange() const { return timer_exchange(); }
+  /// Get the number of body records sent to the neighbors, at the last step.
+  int GetNumSentRecords() const { return num_sent; }
+
+ private:
+  struct Entry {
+    std::shared_ptr<ChBody> body;
+    bool owned;
+  };
+
+  /// Index of the subdomain (along each axis) that contains the given point.
+  void CellOf(const ChVector<>& pos, int cell[3]) const;
+  /// Rank of the process that owns the given point.
+  int OwnerOf(const ChVector<>& pos) const;
+  /// Test if the point is within the subdomain of the given rank, grown by the ghost layer.
+  bool InGhostRegion(int r, const ChVector<>& pos) const;
+
+  /// Send the owned bodies to the neighbors, update or create the received
+  /// ghosts, drop the stale ones and transfer the ownership of the bodies
+  /// that changed subdomain.
+  void Exchange();
+
+  void PackBody(long long gid, ChBody* body, bool full, std::vector<double>& buffer) const;
+  /// Read a record; return the new body if it is not held yet, otherwise update it.
+  std::shared_ptr<ChBody> UnpackBody(const double*& data, long long& gid, bool& fresh);
+
+  MPI_Comm comm;
+  int rank;
+  int num_ranks;
+
+  ChVector<> domain_lo;
+  ChVector<> domain_hi;
+  int grid[3];
+  ChVector<> cell_size;
+  double ghost_layer;
+  std::vector<int> neighbors;  ///< ranks of the neighbor subdomains
+
+  std::unordered_map<long long, Entry> distributed;       ///< owned and ghost bodies, by global id
+  std::unordered_map<const ChBody*, long long> global_ids;  ///< global id of the owned and ghost bodies
+  long long num_added;  ///< number of bodies added by this process (global id = num_added * num_ranks + rank)
+  int num_owned;
+  bool exchanged;
+
+  /// Global ids sent to each neighbor at the last exchange; for these, only
+  /// the state is sent.
+  std::vector<std::set<long long> > sent;
+
+  ChTimer<double> timer_exchange;
+  int num_sent;
+};
+
+}  // end namespace chrono
@@ -1,7 +1,44 @@
+#include <algorithm>
+
 #include "chrono_parallel/solver/ChSolverAPGD.h"
 #include <blaze/math/CompressedVector.h>
 using namespace chrono;
 
+// Number of entries per block of the reductions in deterministic mode.
+#define APGD_DETERMINISTIC_BLOCK 1024
+
+// Call body(i, sums) for i in [0, size), where body adds its terms to the N
+// entries of sums. The range is split in blocks of fixed size whose partial
+// sums are computed in parallel and then added in block order, so that the
+// totals do not depend on the number of threads. This is only used in
+// deterministic mode; otherwise the loops use OpenMP reductions.
+template <int N, typename Body>
+static void BlockSum(uint size, std::vector<real>& partial, real* sums, Body body) {
+  const int num_blocks = (size + APGD_DETERMINISTIC_BLOCK - 1) / APGD_DETERMINISTIC_BLOCK;
+  partial.assign(N * num_blocks, 0);
+
+#pragma omp parallel for
+  for (int k = 0; k < num_blocks; k++) {
+    real local[N] = {};
+    const int end = std::min((int)size, (k + 1) * APGD_DETERMINISTIC_BLOCK);
+    for (int i = k * APGD_DETERMINISTIC_BLOCK; i < end; i++) {
+      body(i, local);
+    }
+    for (int j = 0; j < N; j++) {
+      partial[N * k + j] = local[j];
+    }
+  }
+
+  for (int j = 0; j < N; j++) {
+    sums[j] = 0;
+  }
+  for (int k = 0; k < num_blocks; k++) {
+    for (int j = 0; j < N; j++) {
+      sums[j] += partial[N * k + j];
+    }
+  }
+}
+
 ChSolverAPGD::ChSolverAPGD()
     : ChSolverParallel(),
       mg_tmp_norm(0),
@@ -39,6 +76,39 @@ void ChSolverAPGD::UpdateR() {
   R_n = -b_n - D_n_T * M_invk - s_n;
 }
 
+void ChSolverAPGD::UpdateObjective(const DynamicVector<real>& r) {
+  // obj1 = 0.5*gamma_new'*N*gamma_new - gamma_new'*r, and the terms of the
+  // backtracking condition that depend on gamma_new - y
+  const uint size = (uint)gamma_new.size();
+  if (data_manager->settings.deterministic) {
+    real sums[3];
+    BlockSum<3>(size, partial_sums, sums, [&](int i, real* sum) {
+      real diff = gamma_new[i] - y[i];
+      sum[0] += gamma_new[i] * (0.5 * N_gamma_new[i] - r[i]);
+      sum[1] += g[i] * diff;
+      sum[2] += diff * diff;
+    });
+    obj1 = sums[0];
+    dot_g_temp = sums[1];
+    norm_ms = sums[2];
+    return;
+  }
+
+  real obj = 0;
+  real dot_g = 0;
+  real norm = 0;
+#pragma omp parallel for reduction(+ : obj, dot_g, norm)
+  for (int i = 0; i < (signed)size; i++) {
+    real diff = gamma_new[i] - y[i];
+    obj += gamma_new[i] * (0.5 * N_gamma_new[i] - r[i]);
+    dot_g += g[i] * diff;
+    norm += diff * diff;
+  }
+  obj1 = obj;
+  dot_g_temp = dot_g;
+  norm_ms = norm;
+}
+
 uint ChSolverAPGD::SolveAPGD(const uint max_iter,
                              const uint size,
                              const DynamicVector<real>& r,
@@ -46,6 +116,8 @@ uint ChSolverAPGD::SolveAPGD(const uint max_iter,
   real& residual = data_manager->measures.solver.residual;
   real& objective_value = data_manager->measures.solver.objective_value;
 
+  const bool deterministic = data_manager->settings.deterministic;
+
   DynamicVector<real> one(size, 1.0);
   data_manager->system_timer.start("ChSolverParallel_Solve");
   gamma_hat.resize(size);
@@ -54,6 +126,8 @@ uint ChSolverAPGD::SolveAPGD(const uint max_iter,
   g.resize(size);
   gamma_new.resize(size);
   y.resize(size);
+  N_y.resize(size);
+  N_gamma.resize(size);
 
   residual = 10e30;
   g_diff = 1.0 / pow(size, 2.0);
@@ -102,51 +176,103 @@ uint ChSolverAPGD::SolveAPGD(const uint max_iter,
   // overwritten with a vector of zero size
   gamma_hat = gamma;
 
+  // N*gamma and N*y are kept up to date instead of being recomputed: N*y is a
+  // linear combination of the products of the last two iterates, so only
+  // N*gamma_new is computed at each iteration (plus one product for each
+  // backtracking step). The iterates differ from the ones of the three products
+  // version only by round-off; note that the residual divides by g_diff, so it
+  // magnifies this round-off once it gets close to its floor.
+  ShurProduct(gamma, N_gamma);
+  N_y = N_gamma;
+
   for (current_iteration = 0; current_iteration < max_iter; current_iteration++) {
-    ShurProduct(y, g);
-    g = g - r;
-    gamma_new = y - t * g;
+    // g = N*y - r, gamma_new = y - t*g, obj2 = 0.5*y'*N*y - y'*r
+    if (deterministic) {
+      BlockSum<1>(size, partial_sums, &obj2, [&](int i, real* sum) {
+        g[i] = N_y[i] - r[i];
+        gamma_new[i] = y[i] - t * g[i];
+        sum[0] += y[i] * (0.5 * N_y[i] - r[i]);
+      });
+    } else {
+      real obj_y = 0;
+#pragma omp parallel for reduction(+ : obj_y)
+      for (int i = 0; i < (signed)size; i++) {
+        g[i] = N_y[i] - r[i];
+        gamma_new[i] = y[i] - t * g[i];
+        obj_y += y[i] * (0.5 * N_y[i] - r[i]);
+      }
+      obj2 = obj_y;
+    }
 
     Project(gamma_new.data());
-
     ShurProduct(gamma_new, N_gamma_new);
-    obj1 = 0.5 * (gamma_new, N_gamma_new) - (gamma_new, r);
-
-    ShurProduct(y, temp);
-    obj2 = 0.5 * (y, temp) - (y, r);
+    UpdateObjective(r);
 
-    temp = gamma_new - y;
-    dot_g_temp = (g, temp);
-    norm_ms = (temp, temp);
     while (obj1 > obj2 + dot_g_temp + 0.5 * L * norm_ms) {
       L = 2.0 * L;
       t = 1.0 / L;
       gamma_new = y - t * g;
       Project(gamma_new.data());
       ShurProduct(gamma_new, N_gamma_new);
-      obj1 = 0.5 * (gamma_new, N_gamma_new) - (gamma_new, r);
-      temp = gamma_new - y;
-      dot_g_temp = (g, temp);
-      norm_ms = (temp, temp);
+      UpdateObjective(r);
     }
     theta_new = (-pow(theta, 2.0) + theta * Sqrt(pow(theta, 2.0) + 4.0)) / 2.0;
     beta_new = theta * (1.0 - theta) / (pow(theta, 2.0) + theta_new);
 
-    temp = gamma_new - gamma;
-    y = beta_new * temp + gamma_new;
-    dot_g_temp = (g, temp);
+    // In a single pass:
+    //   y = gamma_new + beta_new * (gamma_new - gamma)
+    //   N*y = (1 + beta_new) * N*gamma_new - beta_new * N*gamma
+    //   dot_g_temp = g'*(gamma_new - gamma)
+    //   the argument of the projection for the residual
+    //   objective_value = gamma_new'*(0.5*N*gamma_new - r)
+    if (deterministic) {
+      real sums[2];
+      BlockSum<2>(size, partial_sums, sums, [&](int i, real* sum) {
+        real step = gamma_new[i] - gamma[i];
+        y[i] = gamma_new[i] + beta_new * step;
+        N_y[i] = (1.0 + beta_new) * N_gamma_new[i] - beta_new * N_gamma[i];
+        sum[0] += g[i] * step;
+        temp[i] = gamma_new[i] - g_diff * (N_gamma_new[i] - r[i]);
+        sum[1] += gamma_new[i] * (0.5 * N_gamma_new[i] - r[i]);
+      });
+      dot_g_temp = sums[0];
+      objective_value = sums[1];
+    } else {
+      real dot_g = 0;
+      real objective = 0;
+#pragma omp parallel for reduction(+ : dot_g, objective)
+      for (int i = 0; i < (signed)size; i++) {
+        real step = gamma_new[i] - gamma[i];
+        y[i] = gamma_new[i] + beta_new * step;
+        N_y[i] = (1.0 + beta_new) * N_gamma_new[i] - beta_new * N_gamma[i];
+        dot_g += g[i] * step;
+        temp[i] = gamma_new[i] - g_diff * (N_gamma_new[i] - r[i]);
+        objective += gamma_new[i] * (0.5 * N_gamma_new[i] - r[i]);
+      }
+      dot_g_temp = dot_g;
+      objective_value = objective;
+    }
 
     // Compute the residual
-    temp = gamma_new - g_diff * (N_gamma_new - r);
-    real temp_dota = (real)(temp, temp);
     // ಠ_ಠ THIS PROJECTION IS IMPORTANT! (╯°□°)╯︵ ┻━┻
     // If turned off the residual will be very incorrect! Turning it off can cause the solver to effectively use the
     // solution found in the first step because the residual never get's smaller. (You can convince yourself of this by
     // looking at the objective function value and watch it decrease while the residual and the current solution remain
     // the same.)
     Project(temp.data());
-    temp = (1.0 / g_diff) * (gamma_new - temp);
-    real temp_dotb = (real)(temp, temp);
+    real temp_dotb = 0;
+    if (deterministic) {
+      BlockSum<1>(size, partial_sums, &temp_dotb, [&](int i, real* sum) {
+        real diff = (gamma_new[i] - temp[i]) / g_diff;
+        sum[0] += diff * diff;
+      });
+    } else {
+#pragma omp parallel for reduction(+ : temp_dotb)
+      for (int i = 0; i < (signed)size; i++) {
+        real diff = (gamma_new[i] - temp[i]) / g_diff;
+        temp_dotb += diff * diff;
+      }
+    }
     real res = Sqrt(temp_dotb);
 
     if (res < residual) {
@@ -154,10 +280,6 @@ uint ChSolverAPGD::SolveAPGD(const uint max_iter,
       gamma_hat = gamma_new;
     }
 
-    // Compute the objective value
-    temp = 0.5 * N_gamma_new - r;
-    objective_value = (gamma_new, temp);
-
     AtIterationEnd(residual, objective_value);
 
     if (data_manager->settings.solver.test_objective) {
@@ -172,6 +294,7 @@ uint ChSolverAPGD::SolveAPGD(const uint max_iter,
 
     if (dot_g_temp > 0) {
       y = gamma_new;
+      N_y = N_gamma_new;
       theta_new = 1.0;
     }
 
@@ -179,6 +302,8 @@ uint ChSolverAPGD::SolveAPGD(const uint max_iter,
     t = 1.0 / L;
     theta = theta_new;
     gamma = gamma_new;
+    // N_gamma_new is overwritten at the next iteration
+    swap(N_gamma, N_gamma_new);
 
     if (data_manager->settings.solver.update_rhs) {
       UpdateR();
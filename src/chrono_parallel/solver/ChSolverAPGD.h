@@ -13,10 +13,14 @@
 // =============================================================================
 //
 // This file contains an implementation of APGD that is more optimized.
+// Only one product with N is computed per iteration, unless the step size has
+// to be reduced.
 // =============================================================================
 
 #pragma once
 
+#include <vector>
+
 #include "chrono_parallel/ChConfigParallel.h"
 #include "chrono_parallel/solver/ChSolverParallel.h"
 
@@ -44,13 +48,20 @@ class CH_PARALLEL_API ChSolverAPGD : public ChSolverParallel {
 
   void UpdateR();
 
+  // Compute obj1, dot_g_temp and norm_ms for the current gamma_new and N_gamma_new
+  void UpdateObjective(const DynamicVector<real>& r);
+
   // APGD specific vectors
   DynamicVector<real> obj2_temp, obj1_temp, temp, g, gamma_new, y, gamma_hat, N_gamma_new;
+  // Products of N with y and with the current iterate, updated without new products
+  DynamicVector<real> N_y, N_gamma;
   real L, t;
   real g_diff;
   real theta, theta_new, beta_new;
   real mb_tmp_norm, mg_tmp_norm;
   real obj1, obj2;
   real dot_g_temp, norm_ms;
+  // Partial sums of the blocks of the reductions (deterministic mode)
+  std::vector<real> partial_sums;
 };
 }
@@ -11,43 +11,110 @@ uint ChSolverJacobi::SolveJacobi(const uint max_iter,
   real& objective_value = data_manager->measures.solver.objective_value;
 
   uint num_contacts = data_manager->num_rigid_contacts;
+  // The tangential rows exist only if the constraints were built for them
+  bool tangential = data_manager->settings.solver.solver_mode != NORMAL;
+  // The rigid-fluid contacts and the fluid density constraints are the last
+  // unilaterals
+  uint num_rigid_fluid = data_manager->num_rigid_fluid_contacts;
+  uint num_fluid_rows = num_rigid_fluid + data_manager->num_fluid_bodies;
+  uint start_fluid = data_manager->num_unilaterals - num_fluid_rows;
+
   diagonal.resize(size, false);
   ml_old = ml;
   CompressedMatrix<real> Nshur_n = data_manager->host_data.D_n_T * data_manager->host_data.M_invD_n;
-  CompressedMatrix<real> Nshur_t = data_manager->host_data.D_t_T * data_manager->host_data.M_invD_t;
+  CompressedMatrix<real> Nshur_t;
+  if (tangential)
+    Nshur_t = data_manager->host_data.D_t_T * data_manager->host_data.M_invD_t;
 
   for (size_t i = 0; i < num_contacts; ++i) {
     diagonal[i * 1 + 0] = Nshur_n(i, i);
-    diagonal[num_contacts + i * 2 + 0] = Nshur_t(i * 2 + 0, i * 2 + 0);
-    diagonal[num_contacts + i * 2 + 1] = Nshur_t(i * 2 + 1, i * 2 + 1);
+    if (tangential) {
+      diagonal[num_contacts + i * 2 + 0] = Nshur_t(i * 2 + 0, i * 2 + 0);
+      diagonal[num_contacts + i * 2 + 1] = Nshur_t(i * 2 + 1, i * 2 + 1);
+    }
+  }
+
+  // The fluid rows are strongly coupled (each node has many neighbours), and a
+  // step of 1/N(k,k) makes the iterations diverge. Their step is instead bounded
+  // by the sum of the magnitudes of their row of N, so that diag - N is positive
+  // semi-definite and the iterations contract. The sums are bounded by
+  // |D^T| |M^-1| |D| 1, which costs a few sparse products.
+  if (num_fluid_rows > 0) {
+    const host_container& host = data_manager->host_data;
+    DynamicVector<real> w = abs(host.D_n) * DynamicVector<real>(num_contacts, 1.0) +
+                            abs(host.D_rf) * DynamicVector<real>(num_rigid_fluid, 1.0) +
+                            abs(host.D_ff) * DynamicVector<real>(data_manager->num_fluid_bodies, 1.0);
+    if (tangential)
+      w += abs(host.D_t) * DynamicVector<real>(2 * num_contacts, 1.0);
+    DynamicVector<real> M_inv_w = abs(host.M_inv) * w;
+    DynamicVector<real> sum_rf = abs(host.D_rf_T) * M_inv_w;
+    DynamicVector<real> sum_ff = abs(host.D_ff_T) * M_inv_w;
+    for (size_t i = 0; i < num_rigid_fluid; ++i) {
+      diagonal[start_fluid + i] = sum_rf[i] + host.E[start_fluid + i];
+    }
+    for (size_t i = 0; i < data_manager->num_fluid_bodies; ++i) {
+      diagonal[start_fluid + num_rigid_fluid + i] = sum_ff[i] + host.E[start_fluid + num_rigid_fluid + i];
+    }
+    N_ml.resize(size);
   }
 
   Project(ml.data());
   //
   for (current_iteration = 0; current_iteration < max_iter; current_iteration++) {
     real omega = 1.0;
+
+    // Impulses of the rigid-fluid contacts seen by the rigid contacts
+    DynamicVector<real> fluid_n, fluid_t;
+    if (num_fluid_rows > 0) {
+      ShurProduct(ml_old, N_ml);
+    }
+    if (num_rigid_fluid > 0) {
+      DynamicVector<real> v_rf =
+          data_manager->host_data.M_invD_rf * blaze::subvector(ml_old, start_fluid, num_rigid_fluid);
+      fluid_n = data_manager->host_data.D_n_T * v_rf;
+      if (tangential)
+        fluid_t = data_manager->host_data.D_t_T * v_rf;
+    }
+
 #pragma omp parallel for
     for (int i = 0; i < num_contacts; ++i) {
       int a = i * 1 + 0;
+      real E1 = data_manager->host_data.E[a];
+      real c1 = (num_rigid_fluid > 0) ? fluid_n[i] : 0;
+      if (!tangential) {
+        ml[a] = ml[a] -
+                omega / diagonal[a] *
+                    ((row(Nshur_n, i * 1 + 0), blaze::subvector(ml_old, 0, 1 * num_contacts)) + c1 + E1 * ml_old[a] -
+                     mb[a]);
+        continue;
+      }
       int b = num_contacts + i * 2 + 0;
       int c = num_contacts + i * 2 + 1;
 
       real Dinv = 3.0 / (diagonal[a] + diagonal[b] + diagonal[c]);
-      real E1 = data_manager->host_data.E[a];
       real E2 = data_manager->host_data.E[b];
       real E3 = data_manager->host_data.E[c];
+      real c2 = (num_rigid_fluid > 0) ? fluid_t[i * 2 + 0] : 0;
+      real c3 = (num_rigid_fluid > 0) ? fluid_t[i * 2 + 1] : 0;
       ml[a] = ml[a] -
               omega * Dinv *
-                  ((row(Nshur_n, i * 1 + 0), blaze::subvector(ml_old, 0, 1 * num_contacts)) + E1 * ml_old[a] - mb[a]);
+                  ((row(Nshur_n, i * 1 + 0), blaze::subvector(ml_old, 0, 1 * num_contacts)) + c1 + E1 * ml_old[a] -
+                   mb[a]);
       ml[b] = ml[b] -
               omega * Dinv * ((row(Nshur_t, i * 2 + 0), blaze::subvector(ml_old, num_contacts, 2 * num_contacts)) +
-                              E2 * ml_old[b] - mb[b]);
+                              c2 + E2 * ml_old[b] - mb[b]);
       ml[c] = ml[c] -
               omega * Dinv * ((row(Nshur_t, i * 2 + 1), blaze::subvector(ml_old, num_contacts, 2 * num_contacts)) +
-                              E3 * ml_old[c] - mb[c]);
+                              c3 + E3 * ml_old[c] - mb[c]);
 
       // Project_Single(i, ml.data());
     }
+
+#pragma omp parallel for
+    for (int k = start_fluid; k < (int)(start_fluid + num_fluid_rows); ++k) {
+      ml[k] = ml[k] - omega / diagonal[k] * (N_ml[k] - mb[k]);
+    }
+
     Project(ml.data());
     ml_old = ml;
     residual = 0;  // Res4Blaze(ml, mb);
@@ -45,7 +45,7 @@ class CH_PARALLEL_API ChSolverJacobi : public ChSolverParallel {
                    );
 
   custom_vector<real> r, p, Ap;
-  DynamicVector<real> diagonal, ml_old;
+  DynamicVector<real> diagonal, ml_old, N_ml;
 };
 }
 
@@ -6,12 +6,18 @@ ChSolverParallel::ChSolverParallel() {
   max_iteration = 100;
   current_iteration = 0;
   rigid_rigid = NULL;
+  rigid_fluid = NULL;
+  fluid_fluid = NULL;
   bilateral = NULL;
 }
 
 void ChSolverParallel::Project(real* gamma) {
   data_manager->system_timer.start("ChSolverParallel_Project");
   rigid_rigid->Project(gamma);
+  if (data_manager->settings.solver.local_solver_mode != BILATERAL) {
+    rigid_fluid->Project(gamma);
+    fluid_fluid->Project(gamma);
+  }
   data_manager->system_timer.stop("ChSolverParallel_Project");
 }
 
@@ -39,17 +45,28 @@ void ChSolverParallel::ShurProduct(const DynamicVector<real>& x, DynamicVector<r
   const CompressedMatrix<real>& D_t_T = data_manager->host_data.D_t_T;
   const CompressedMatrix<real>& D_s_T = data_manager->host_data.D_s_T;
   const CompressedMatrix<real>& D_b_T = data_manager->host_data.D_b_T;
+  const CompressedMatrix<real>& D_rf_T = data_manager->host_data.D_rf_T;
+  const CompressedMatrix<real>& D_ff_T = data_manager->host_data.D_ff_T;
 
   const CompressedMatrix<real>& M_invD_n = data_manager->host_data.M_invD_n;
   const CompressedMatrix<real>& M_invD_t = data_manager->host_data.M_invD_t;
   const CompressedMatrix<real>& M_invD_s = data_manager->host_data.M_invD_s;
   const CompressedMatrix<real>& M_invD_b = data_manager->host_data.M_invD_b;
+  const CompressedMatrix<real>& M_invD_rf = data_manager->host_data.M_invD_rf;
+  const CompressedMatrix<real>& M_invD_ff = data_manager->host_data.M_invD_ff;
 
   const DynamicVector<real>& E = data_manager->host_data.E;
 
+  SOLVERMODE solver_mode = data_manager->settings.solver.local_solver_mode;
   uint num_contacts = data_manager->num_rigid_contacts;
+  uint num_rigid_fluid = data_manager->num_rigid_fluid_contacts;
+  uint num_fluid = data_manager->num_fluid_bodies;
   uint num_unilaterals = data_manager->num_unilaterals;
   uint num_bilaterals = data_manager->num_bilaterals;
+  // The fluid constraints are the last unilaterals
+  uint start_rf = num_unilaterals - num_rigid_fluid - num_fluid;
+  uint start_ff = num_unilaterals - num_fluid;
+
   output.reset();
   SubVectorType o_b = blaze::subvector(output, num_unilaterals, num_bilaterals);
   ConstSubVectorType x_b = blaze::subvector(x, num_unilaterals, num_bilaterals);
@@ -59,47 +76,47 @@ void ChSolverParallel::ShurProduct(const DynamicVector<real>& x, DynamicVector<r
   ConstSubVectorType x_n = blaze::subvector(x, 0, num_contacts);
   ConstSubVectorType E_n = blaze::subvector(E, 0, num_contacts);
 
-  switch (data_manager->settings.solver.local_solver_mode) {
-    case BILATERAL: {
-      o_b = D_b_T * (M_invD_b * x_b) + E_b * x_b;
-
-    } break;
-
-    case NORMAL: {
-      DynamicVector<real> tmp = M_invD_b * x_b + M_invD_n * x_n;
-      o_b = D_b_T * tmp + E_b * x_b;
-      o_n = D_n_T * tmp + E_n * x_n;
-
-    } break;
-
-    case SLIDING: {
-      SubVectorType o_t = blaze::subvector(output, num_contacts, num_contacts * 2);
-      ConstSubVectorType x_t = blaze::subvector(x, num_contacts, num_contacts * 2);
-      ConstSubVectorType E_t = blaze::subvector(E, num_contacts, num_contacts * 2);
-
-      DynamicVector<real> tmp = M_invD_b * x_b + M_invD_n * x_n + M_invD_t * x_t;
-      o_b = D_b_T * tmp + E_b * x_b;
-      o_n = D_n_T * tmp + E_n * x_n;
-      o_t = D_t_T * tmp + E_t * x_t;
-
-    } break;
-
-    case SPINNING: {
-      SubVectorType o_t = blaze::subvector(output, num_contacts, num_contacts * 2);
-      ConstSubVectorType x_t = blaze::subvector(x, num_contacts, num_contacts * 2);
-      ConstSubVectorType E_t = blaze::subvector(E, num_contacts, num_contacts * 2);
-
-      SubVectorType o_s = blaze::subvector(output, num_contacts * 3, num_contacts * 3);
-      ConstSubVectorType x_s = blaze::subvector(x, num_contacts * 3, num_contacts * 3);
-      ConstSubVectorType E_s = blaze::subvector(E, num_contacts * 3, num_contacts * 3);
+  if (solver_mode == BILATERAL) {
+    o_b = D_b_T * (M_invD_b * x_b) + E_b * x_b;
+    data_manager->system_timer.stop("ShurProduct");
+    return;
+  }
 
-      DynamicVector<real> tmp = M_invD_b * x_b + M_invD_n * x_n + M_invD_t * x_t + M_invD_s * x_s;
-      o_b = D_b_T * tmp + E_b * x_b;
-      o_n = D_n_T * tmp + E_n * x_n;
-      o_t = D_t_T * tmp + E_t * x_t;
-      o_s = D_s_T * tmp + E_s * x_s;
+  DynamicVector<real> tmp = M_invD_b * x_b + M_invD_n * x_n;
+  if (solver_mode == SLIDING || solver_mode == SPINNING) {
+    tmp += M_invD_t * blaze::subvector(x, num_contacts, num_contacts * 2);
+  }
+  if (solver_mode == SPINNING) {
+    tmp += M_invD_s * blaze::subvector(x, num_contacts * 3, num_contacts * 3);
+  }
+  if (num_rigid_fluid > 0) {
+    tmp += M_invD_rf * blaze::subvector(x, start_rf, num_rigid_fluid);
+  }
+  if (num_fluid > 0) {
+    tmp += M_invD_ff * blaze::subvector(x, start_ff, num_fluid);
+  }
 
-    } break;
+  o_b = D_b_T * tmp + E_b * x_b;
+  o_n = D_n_T * tmp + E_n * x_n;
+  if (solver_mode == SLIDING || solver_mode == SPINNING) {
+    SubVectorType o_t = blaze::subvector(output, num_contacts, num_contacts * 2);
+    ConstSubVectorType x_t = blaze::subvector(x, num_contacts, num_contacts * 2);
+    ConstSubVectorType E_t = blaze::subvector(E, num_contacts, num_contacts * 2);
+    o_t = D_t_T * tmp + E_t * x_t;
+  }
+  if (solver_mode == SPINNING) {
+    SubVectorType o_s = blaze::subvector(output, num_contacts * 3, num_contacts * 3);
+    ConstSubVectorType x_s = blaze::subvector(x, num_contacts * 3, num_contacts * 3);
+    ConstSubVectorType E_s = blaze::subvector(E, num_contacts * 3, num_contacts * 3);
+    o_s = D_s_T * tmp + E_s * x_s;
+  }
+  if (num_rigid_fluid > 0) {
+    blaze::subvector(output, start_rf, num_rigid_fluid) =
+        D_rf_T * tmp + blaze::subvector(E, start_rf, num_rigid_fluid) * blaze::subvector(x, start_rf, num_rigid_fluid);
+  }
+  if (num_fluid > 0) {
+    blaze::subvector(output, start_ff, num_fluid) =
+        D_ff_T * tmp + blaze::subvector(E, start_ff, num_fluid) * blaze::subvector(x, start_ff, num_fluid);
   }
 
   data_manager->system_timer.stop("ShurProduct");
@@ -112,6 +112,8 @@ class CH_PARALLEL_API ChSolverParallel {
   int current_iteration;  // The current iteration number of the solver
 
   ChConstraintRigidRigid* rigid_rigid;
+  ChConstraintRigidFluid* rigid_fluid;
+  ChConstraintFluidFluid* fluid_fluid;
   ChConstraintBilateral* bilateral;
 
   // Pointer to the system's data manager
@@ -34,11 +34,88 @@
 #include "chrono_postprocess/ChPovRayAssetCustom.h"
 #include "physics/ChParticlesClones.h"
 #include "physics/ChLinkMate.h"
+#include "parallel/ChThreads.h"
 
 using namespace chrono;
 using namespace postprocess;
 using namespace geometry;
 
+// Write the rotation and position at the end of the POV union of an object.
+static void WritePovTransform(ChStreamOutAscii& mfilepov, const ChCoordsys<>& csys) {
+    if (!(csys == CSYSNORM)) {
+        mfilepov << " quatRotation(<" << csys.rot.e0;
+        mfilepov << "," << csys.rot.e1;
+        mfilepov << "," << csys.rot.e2;
+        mfilepov << "," << csys.rot.e3 << ">) \n";
+        mfilepov << " translate  <" << csys.pos.x;
+        mfilepov << "," << csys.pos.y;
+        mfilepov << "," << csys.pos.z << "> \n";
+    }
+}
+
+// Write the POV code of a camera, also used by ConvertBinaryData().
+static void WritePovCamera(ChStreamOutAscii& mfilepov,
+                           const ChVector<>& camera_location,
+                           const ChVector<>& camera_aim,
+                           const ChVector<>& camera_up,
+                           double camera_angle,
+                           bool camera_orthographic) {
+    mfilepov << "camera { \n";
+    if (camera_orthographic) {
+        mfilepov << " orthographic \n";
+        mfilepov << " right x * " << (camera_location - camera_aim).Length() << " * tan ((( " << camera_angle
+                 << " *0.5)/180)*3.14) \n";
+        mfilepov << " up y * image_height/image_width * " << (camera_location - camera_aim).Length()
+                 << " * tan (((" << camera_angle << "*0.5)/180)*3.14) \n";
+        ChVector<> mdir = (camera_aim - camera_location) * 0.00001;
+        mfilepov << " direction <" << mdir.x << "," << mdir.y << "," << mdir.z << "> \n";
+    } else {
+        mfilepov << " right -x*image_width/image_height \n";
+        mfilepov << " angle " << camera_angle << " \n";
+    }
+    mfilepov << " location <" << camera_location.x << "," << camera_location.y << "," << camera_location.z << "> \n"
+             << " look_at <" << camera_aim.x << "," << camera_aim.y << "," << camera_aim.z << "> \n"
+             << " sky <" << camera_up.x << "," << camera_up.y << "," << camera_up.z << "> \n";
+    mfilepov << "}\n\n\n";
+}
+
+// Write the POV macro call that shows a coordinate system (sh_csysCOG, sh_csysFRM).
+static void WritePovCsys(ChStreamOutAscii& mfilepov, const char* macro, const ChCoordsys<>& csys, double size) {
+    mfilepov << macro << "(";
+    mfilepov << csys.pos.x << "," << csys.pos.y << "," << csys.pos.z << ",";
+    mfilepov << csys.rot.e0 << "," << csys.rot.e1 << "," << csys.rot.e2 << "," << csys.rot.e3 << ",";
+    mfilepov << size << ")\n";
+}
+
+// Write a line of the .dat file with the coordinate system of a particle.
+static void WriteDatCsys(ChStreamOutAscii& mfiledat, const ChCoordsys<>& csys) {
+    mfiledat << csys.pos.x << ", ";
+    mfiledat << csys.pos.y << ", ";
+    mfiledat << csys.pos.z << ", ";
+    mfiledat << csys.rot.e0 << ", ";
+    mfiledat << csys.rot.e1 << ", ";
+    mfiledat << csys.rot.e2 << ", ";
+    mfiledat << csys.rot.e3 << ", \n";
+}
+
+// Write the POV loop that reads the particles of a ChParticlesClones from the .dat
+// file: the POV code of the particle shape goes between the two functions.
+static void WritePovClonesBegin(ChStreamOutAscii& mfilepov, unsigned int nparticles) {
+    mfilepov << " \n";
+    mfilepov << "#declare Index = 0; \n";
+    mfilepov << "#while(Index < " << nparticles << ") \n";
+    mfilepov << "  #read (MyDatFile, apx, apy, apz, aq0, aq1, aq2, aq3) \n";
+    mfilepov << "  union{\n";
+}
+
+static void WritePovClonesEnd(ChStreamOutAscii& mfilepov) {
+    mfilepov << "  quatRotation(<aq0,aq1,aq2,aq3>)\n";
+    mfilepov << "  translate(<apx,apy,apz>)\n";
+    mfilepov << "  }\n";
+    mfilepov << "  #declare Index = Index + 1; \n";
+    mfilepov << "#end \n";
+}
+
 ChPovRay::ChPovRay(ChSystem* system) : ChPostProcessBase(system) {
     this->pic_filename = "pic";
     this->template_filename = GetChronoDataFile("_template_POV.pov");
@@ -75,6 +152,18 @@ ChPovRay::ChPovRay(ChSystem* system) : ChPostProcessBase(system) {
     this->contacts_colormap_startscale = 0;
     this->contacts_colormap_endscale = 10;
     this->contacts_do_colormap = true;
+    this->binary_output = false;
+    this->binary_single_precision = false;
+    this->writer_thread = 0;
+    this->current_buffer = 0;
+    this->last_sent_buffer = -1;
+}
+
+ChPovRay::~ChPovRay() {
+    try {
+        SetAsyncOutput(false);
+    } catch (ChException) {
+    }
 }
 
 void ChPovRay::Add(std::shared_ptr<ChPhysicsItem> mitem) {
@@ -448,7 +537,7 @@ void ChPovRay::_recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& asse
             auto mytrimeshshapeasset = std::dynamic_pointer_cast<ChTriangleMeshShape>(k_asset);
 
             if (myobjshapeasset || mytrimeshshapeasset) {
-                ChTriangleMeshConnected* mytrimesh = 0;
+                const ChTriangleMeshConnected* mytrimesh = 0;
                 ChTriangleMeshConnected* temp_allocated_loadtrimesh = 0;
 
                 if (myobjshapeasset) {
@@ -472,7 +561,8 @@ void ChPovRay::_recurseExportAssets(std::vector<std::shared_ptr<ChAsset> >& asse
                 }
 
                 if (mytrimeshshapeasset) {
-                    mytrimesh = &mytrimeshshapeasset->GetMesh();
+                    const ChTriangleMeshShape& mytrimeshshape = *mytrimeshshapeasset;
+                    mytrimesh = &mytrimeshshape.GetMesh();
                 }
 
                 // POV macro to build the asset - begin
@@ -694,9 +784,20 @@ void ChPovRay::ExportAssets() {
 
 void ChPovRay::_recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& assetlist,
                                      ChFrame<> parentframe,
-                                     ChStreamOutAsciiFile& mfilepov) {
+                                     ChStreamOutAscii& mfilepov) {
     mfilepov << "union{\n";  // begin union
 
+    _recurseExportObjAssets(assetlist, parentframe, mfilepov);
+
+    // write the rotation and position
+    WritePovTransform(mfilepov, parentframe.GetCoord());
+
+    mfilepov << "}\n";  // end union
+}
+
+void ChPovRay::_recurseExportObjAssets(std::vector<std::shared_ptr<ChAsset> >& assetlist,
+                                       ChFrame<> parentframe,
+                                       ChStreamOutAscii& mfilepov) {
     // Scan assets in object and write the macro to set their position
     for (unsigned int k = 0; k < assetlist.size(); k++) {
         std::shared_ptr<ChAsset> k_asset = assetlist[k];
@@ -744,23 +845,34 @@ void ChPovRay::_recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& ass
             mfilepov << "cm_" << (size_t)k_asset.get() << "()\n";
         }
     }
+}
 
+void ChPovRay::_recurseFindCamera(std::vector<std::shared_ptr<ChAsset> >& assetlist, ChFrame<> parentframe) {
+    // Same camera search of _recurseExportObjAssets(), without writing POV code
+    for (unsigned int k = 0; k < assetlist.size(); k++) {
+        if (auto mycamera = std::dynamic_pointer_cast<ChCamera>(assetlist[k])) {
+            this->camera_found_in_assets = true;
 
-    // write the rotation and position
-    if (!(parentframe.GetCoord() == CSYSNORM)) {
-        mfilepov << " quatRotation(<" << parentframe.GetRot().e0;
-        mfilepov << "," << parentframe.GetRot().e1;
-        mfilepov << "," << parentframe.GetRot().e2;
-        mfilepov << "," << parentframe.GetRot().e3 << ">) \n";
-        mfilepov << " translate  <" << parentframe.GetPos().x;
-        mfilepov << "," << parentframe.GetPos().y;
-        mfilepov << "," << parentframe.GetPos().z << "> \n";
+            this->camera_location = mycamera->GetPosition() >> parentframe;
+            this->camera_aim = mycamera->GetAimPoint() >> parentframe;
+            this->camera_up = mycamera->GetUpVector() >> parentframe;
+            this->camera_angle = mycamera->GetAngle();
+            this->camera_orthographic = mycamera->GetOrthographic();
+        }
+        if (auto mylevel = std::dynamic_pointer_cast<ChAssetLevel>(assetlist[k]))
+            _recurseFindCamera(mylevel->GetAssets(), mylevel->GetFrame());
     }
-
-    mfilepov << "}\n";  // end union
 }
 
 void ChPovRay::ExportData(const std::string& filename) {
+    if (this->binary_output) {
+        FrameBuffer& buffer = this->writer_thread ? this->buffers[this->current_buffer] : this->buffers[0];
+        ExportBinaryData(filename, buffer);
+        WriteBuffer(buffer);
+        this->framenumber++;
+        return;
+    }
+
     // Regenerate the list of objects that need POV rendering, by
     // scanning all ChPhysicsItems in the ChSystem that have a ChPovRayAsse attached.
     // Note that SetupLists() happens at each ExportData (i.e. at each timestep)
@@ -777,7 +889,467 @@ void ChPovRay::ExportData(const std::string& filename) {
 
     // Generate the nnnn.dat and nnnn.pov files:
 
+    char pathdat[200];
+    sprintf(pathdat, "%s.dat", filename.c_str());
+    char pathpov[200];
+    sprintf(pathpov, "%s.pov", filename.c_str());
+
+    if (this->writer_thread) {
+        // Format the files in memory, the background thread will write them.
+        FrameBuffer& buffer = this->buffers[this->current_buffer];
+        buffer.nfiles = 2;
+        buffer.files[0] = pathpov;
+        buffer.files[1] = pathdat;
+        buffer.contents[0].clear();
+        buffer.contents[1].clear();
+        ChStreamOutAsciiVector mfilepov(&buffer.contents[0]);
+        ChStreamOutAsciiVector mfiledat(&buffer.contents[1]);
+        ExportTextData(filename, mfilepov, mfiledat);
+        WriteBuffer(buffer);
+    } else {
+        try {
+            ChStreamOutAsciiFile mfiledat(pathdat);
+            ChStreamOutAsciiFile mfilepov(pathpov);
+            ExportTextData(filename, mfilepov, mfiledat);
+        } catch (ChException) {
+            char error[400];
+            sprintf(error, "Can't save data into file %s.pov (or .dat)", filename.c_str());
+            throw(ChException(error));
+        }
+    }
+
+    // Increment the number of the frame.
+    this->framenumber++;
+}
+
+void ChPovRay::ExportTextData(const std::string& filename, ChStreamOutAscii& mfilepov, ChStreamOutAscii& mfiledat) {
+    char pathdat[200];
+    sprintf(pathdat, "%s.dat", filename.c_str());
+
+    this->camera_found_in_assets = false;
+
+    // Write custom data commands, if provided by the user
+    if (this->custom_data.size() > 0) {
+        mfilepov << "// Custom user-added script: \n\n";
+        mfilepov << this->custom_data;
+        mfilepov << "\n\n";
+    }
+
+    // Tell POV to open the .dat file, that could be used by
+    // ChParticleClones for efficiency (xyz raw data with center of particles will
+    // be saved in dat and load using a #while POV loop, helping to reduce size of .pov file)
+    mfilepov << "#declare dat_file = \"" << pathdat << "\"\n";
+    mfilepov << "#fopen MyDatFile dat_file read \n\n";
+
+    // Save time-dependent data for the geometry of objects in ...nnnn.POV
+    // and in ...nnnn.DAT file
+
+    for (unsigned int i = 0; i < this->mdata.size(); i++) {
+        // #) saving a body ?
+        if (auto mybody = std::dynamic_pointer_cast<ChBody>(mdata[i])) {
+            // Get the current coordinate frame of the i-th object
+            ChCoordsys<> assetcsys = CSYSNORM;
+            const ChFrame<>& bodyframe = mybody->GetFrame_REF_to_abs();
+            assetcsys = bodyframe.GetCoord();
+
+            // Dump the POV macro that generates the contained asset(s) tree!!!
+            _recurseExportObjData(mdata[i]->GetAssets(), bodyframe, mfilepov);
+
+            // Show body COG?
+            if (this->COGs_show)
+                WritePovCsys(mfilepov, "sh_csysCOG", mybody->GetFrame_COG_to_abs().GetCoord(), this->COGs_size);
+            // Show body frame ref?
+            if (this->frames_show)
+                WritePovCsys(mfilepov, "sh_csysFRM", assetcsys, this->frames_size);
+        }
+
+        // #) saving a cluster of particles ?  (NEW method that uses a POV '#while' loop and a .dat file)
+        if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
+            WritePovClonesBegin(mfilepov, myclones->GetNparticles());
+            ChFrame<> nullframe(CSYSNORM);
+            _recurseExportObjData(mdata[i]->GetAssets(), nullframe, mfilepov);
+            WritePovClonesEnd(mfilepov);
+
+            // Loop on all particle clones
+            for (unsigned int m = 0; m < myclones->GetNparticles(); ++m) {
+                // Get the current coordinate frame of the i-th particle
+                WriteDatCsys(mfiledat, myclones->GetParticle(m).GetCoord());
+            }  // end loop on particles
+        }
+
+        // #) saving a ChLinkMateGeneric constraint ?
+        if (auto mylinkmate = std::dynamic_pointer_cast<ChLinkMateGeneric>(mdata[i])) {
+            if (mylinkmate->GetBody1() && mylinkmate->GetBody2() && this->links_show) {
+                ChFrame<> frAabs = mylinkmate->GetFrame1() >> *mylinkmate->GetBody1();
+                ChFrame<> frBabs = mylinkmate->GetFrame2() >> *mylinkmate->GetBody2();
+                WritePovCsys(mfilepov, "sh_csysFRM", frAabs.GetCoord(), this->links_size * 0.7);  // smaller, as 'slave' csys.
+                WritePovCsys(mfilepov, "sh_csysFRM", frBabs.GetCoord(), this->links_size);
+            }
+        }
+
+    }  // end loop on objects
+
+    // #) saving contacts ?
+    if (this->contacts_show) {
+      /*
+        char pathcontacts[200];
+        sprintf(pathcontacts, "%s.contacts", filename.c_str());
+        ChStreamOutAsciiFile data_contacts(pathcontacts);
+
+        class _reporter_class : public chrono::ChReportContactCallback {
+          public:
+            virtual bool ReportContactCallback(const ChVector<>& pA,
+                                               const ChVector<>& pB,
+                                               const ChMatrix33<>& plane_coord,
+                                               const double& distance,
+                                               const float& mfriction,
+                                               const ChVector<>& react_forces,
+                                               const ChVector<>& react_torques,
+                                               collision::ChCollisionModel* modA,
+                                               collision::ChCollisionModel* modB) {
+                if (fabs(react_forces.x) > 1e-8 || fabs(react_forces.y) > 1e-8 || fabs(react_forces.z) > 1e-8) {
+                    ChMatrix33<> localmatr(plane_coord);
+                    ChVector<> n1 = localmatr.Get_A_Xaxis();
+                    ChVector<> absreac = localmatr * react_forces;
+                    (*mfile) << pA.x << ", ";
+                    (*mfile) << pA.y << ", ";
+                    (*mfile) << pA.z << ", ";
+                    (*mfile) << n1.x << ", ";
+                    (*mfile) << n1.y << ", ";
+                    (*mfile) << n1.z << ", ";
+                    (*mfile) << absreac.x << ", ";
+                    (*mfile) << absreac.y << ", ";
+                    (*mfile) << absreac.z << ", \n";
+                }
+                return true;  // to continue scanning contacts
+            }
+            // Data
+            ChStreamOutAsciiFile* mfile;
+        };
+
+        _reporter_class my_contact_reporter;
+        my_contact_reporter.mfile = &data_contacts;
+
+        // scan all contacts
+        this->mSystem->GetContactContainer()->ReportAllContacts(&my_contact_reporter);
+        */
+    }
+
+    // If a camera have been found in assets, create it and override the default one
+    if (this->camera_found_in_assets)
+        WritePovCamera(mfilepov, camera_location, camera_aim, camera_up, camera_angle, camera_orthographic);
+
+    // At the end of the .pov file, remember to close the .dat
+    mfilepov << "\n\n#fclose MyDatFile \n";
+}
+
+// -----------------------------------------------------------------------------
+// Binary and asynchronous output
+// -----------------------------------------------------------------------------
+
+namespace {
+
+const int POV_FRAME_MAGIC = 0x46504843;   // "CHPF"
+const int POV_LAYOUT_MAGIC = 0x4C504843;  // "CHPL"
+
+enum { BINARY_ITEM_OTHER = 0, BINARY_ITEM_BODY = 1, BINARY_ITEM_CLONES = 2, BINARY_ITEM_LINK = 3 };
+
+void* PovWriterMemoryFunc() {
+    return 0;
+}
+
+void PushCsys(std::vector<double>* data, const ChCoordsys<>& csys) {
+    data[0].push_back(csys.pos.x);
+    data[1].push_back(csys.pos.y);
+    data[2].push_back(csys.pos.z);
+    data[3].push_back(csys.rot.e0);
+    data[4].push_back(csys.rot.e1);
+    data[5].push_back(csys.rot.e2);
+    data[6].push_back(csys.rot.e3);
+}
+
+ChCoordsys<> GetCsys(std::vector<double>* data, size_t k) {
+    return ChCoordsys<>(ChVector<>(data[0][k], data[1][k], data[2][k]),
+                        ChQuaternion<>(data[3][k], data[4][k], data[5][k], data[6][k]));
+}
+
+}  // end anonymous namespace
+
+void ChPovRay::SetAsyncOutput(bool async) {
+    if (async && !this->writer_thread) {
+        static char writer_name[] = "povray_writer";
+        ChThreadConstructionInfo create_args(writer_name, WriteFrameBuffer, PovWriterMemoryFunc, 1);
+        this->writer_thread = new ChThreads(create_args);
+        this->current_buffer = 0;
+        this->last_sent_buffer = -1;
+    } else if (!async && this->writer_thread) {
+        ChThreads* mthread = this->writer_thread;
+        try {
+            Flush();
+        } catch (ChException) {
+            this->writer_thread = 0;
+            delete mthread;
+            throw;
+        }
+        this->writer_thread = 0;
+        delete mthread;
+    }
+}
+
+void ChPovRay::Flush() {
+    if (!this->writer_thread || this->last_sent_buffer < 0)
+        return;
+
+    this->writer_thread->flush();
+
+    FrameBuffer& buffer = this->buffers[this->last_sent_buffer];
+    this->last_sent_buffer = -1;
+    if (buffer.failed)
+        throw(ChException("Can't save data into file " + buffer.files[0]));
+}
+
+void ChPovRay::WriteFrameBuffer(void* userPtr, void* lsMemory) {
+    FrameBuffer* buffer = (FrameBuffer*)userPtr;
+    buffer->failed = false;
+    try {
+        for (int i = 0; i < buffer->nfiles; i++) {
+            ChStreamOutBinaryFile mfile(buffer->files[i].c_str());
+            if (buffer->contents[i].size())
+                mfile.BlockOutput(&buffer->contents[i][0], buffer->contents[i].size());
+        }
+    } catch (std::exception) {
+        buffer->failed = true;
+    }
+}
+
+void ChPovRay::WriteBuffer(FrameBuffer& buffer) {
+    if (this->writer_thread) {
+        // Wait for the previous frame, then pass this one to the background thread;
+        // the next frame will be prepared in the other buffer.
+        Flush();
+        this->last_sent_buffer = this->current_buffer;
+        this->writer_thread->sendRequest(1, &buffer, 0);
+        this->current_buffer = 1 - this->current_buffer;
+    } else {
+        WriteFrameBuffer(&buffer, 0);
+        if (buffer.failed)
+            throw(ChException("Can't save data into file " + buffer.files[0]));
+    }
+}
+
+void ChPovRay::BuildLayout(std::vector<char>& bytes) {
+    layout_items.resize(mdata.size());
+    layout_nassets.resize(mdata.size());
+    layout_camera.resize(mdata.size());
+
+    bytes.clear();
+    ChStreamOutBinaryVector mlayout(&bytes);
+    mlayout << POV_LAYOUT_MAGIC;
+    mlayout.VersionWrite(1);
+    mlayout << (int)mdata.size();
+
+    // The POV code of each item, without the position: it is written
+    // again only if the list of items changes.
+    std::vector<char> text;
+    for (unsigned int i = 0; i < this->mdata.size(); i++) {
+        layout_items[i] = mdata[i].get();
+        layout_nassets[i] = mdata[i]->GetAssets().size();
+
+        text.clear();
+        ChStreamOutAsciiVector mtext(&text);
+        this->camera_found_in_assets = false;
+
+        int type = BINARY_ITEM_OTHER;
+        if (std::dynamic_pointer_cast<ChBody>(mdata[i])) {
+            type = BINARY_ITEM_BODY;
+            _recurseExportObjAssets(mdata[i]->GetAssets(), ChFrame<>(CSYSNORM), mtext);
+        } else if (std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
+            type = BINARY_ITEM_CLONES;
+            _recurseExportObjData(mdata[i]->GetAssets(), ChFrame<>(CSYSNORM), mtext);
+        } else if (std::dynamic_pointer_cast<ChLinkMateGeneric>(mdata[i])) {
+            type = BINARY_ITEM_LINK;
+        }
+        layout_camera[i] = this->camera_found_in_assets;
+
+        std::string mstring(text.begin(), text.end());
+        mlayout << type << mstring;
+    }
+
+    this->camera_found_in_assets = false;
+}
+
+void ChPovRay::ExportBinaryData(const std::string& filename, FrameBuffer& buffer) {
+    // Regenerate the list of objects (see ExportData()). The assets and the
+    // layout file are exported only if the list or the number of assets of an
+    // item changed since the last layout, or after InvalidateLayout().
+    this->SetupLists();
+
+    bool changed = (mdata.size() != layout_items.size()) || layout_file.empty();
+    for (unsigned int i = 0; i < mdata.size() && !changed; i++)
+        changed = (mdata[i].get() != layout_items[i]) || (mdata[i]->GetAssets().size() != layout_nassets[i]);
+
+    buffer.nfiles = 1;
+    buffer.files[0] = filename + ".chf";
+    if (changed) {
+        this->ExportAssets();
+        layout_file = filename + ".chl";
+        buffer.nfiles = 2;
+        buffer.files[1] = layout_file;
+        BuildLayout(buffer.contents[1]);
+    }
+
+    // Gather the coordinate systems of all items
+    for (int c = 0; c < 7; c++)
+        csys_data[c].clear();
+    csys_counts.resize(mdata.size());
+    this->camera_found_in_assets = false;
+
+    size_t ncsys = 0;
+    for (unsigned int i = 0; i < this->mdata.size(); i++) {
+        if (auto mybody = std::dynamic_pointer_cast<ChBody>(mdata[i])) {
+            PushCsys(csys_data, mybody->GetFrame_REF_to_abs().GetCoord());
+            if (this->COGs_show)
+                PushCsys(csys_data, mybody->GetFrame_COG_to_abs().GetCoord());
+            if (layout_camera[i])
+                _recurseFindCamera(mdata[i]->GetAssets(), mybody->GetFrame_REF_to_abs());
+        } else if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
+            size_t nparticles = myclones->GetNparticles();
+            for (int c = 0; c < 7; c++)
+                csys_data[c].resize(ncsys + nparticles);
+            for (size_t m = 0; m < nparticles; ++m) {
+                const ChCoordsys<>& csys = myclones->GetParticle((unsigned int)m).GetCoord();
+                csys_data[0][ncsys + m] = csys.pos.x;
+                csys_data[1][ncsys + m] = csys.pos.y;
+                csys_data[2][ncsys + m] = csys.pos.z;
+                csys_data[3][ncsys + m] = csys.rot.e0;
+                csys_data[4][ncsys + m] = csys.rot.e1;
+                csys_data[5][ncsys + m] = csys.rot.e2;
+                csys_data[6][ncsys + m] = csys.rot.e3;
+            }
+            if (layout_camera[i])
+                _recurseFindCamera(mdata[i]->GetAssets(), ChFrame<>(CSYSNORM));
+        } else if (auto mylinkmate = std::dynamic_pointer_cast<ChLinkMateGeneric>(mdata[i])) {
+            if (mylinkmate->GetBody1() && mylinkmate->GetBody2() && this->links_show) {
+                ChFrame<> frAabs = mylinkmate->GetFrame1() >> *mylinkmate->GetBody1();
+                ChFrame<> frBabs = mylinkmate->GetFrame2() >> *mylinkmate->GetBody2();
+                PushCsys(csys_data, frAabs.GetCoord());
+                PushCsys(csys_data, frBabs.GetCoord());
+            }
+        }
+        csys_counts[i] = (int)(csys_data[0].size() - ncsys);
+        ncsys = csys_data[0].size();
+    }
+
+    // Write the frame
+    buffer.contents[0].clear();
+    ChStreamOutBinaryVector mframe(&buffer.contents[0]);
+    mframe << POV_FRAME_MAGIC;
+    mframe.VersionWrite(1);
+    mframe << this->binary_single_precision;
+    mframe << mSystem->GetChTime();
+    mframe << layout_file;
+    mframe << custom_data;
+    mframe << this->COGs_show << this->COGs_size << this->frames_show << this->frames_size << this->links_size;
+
+    mframe << this->camera_found_in_assets;
+    if (this->camera_found_in_assets) {
+        mframe << camera_location.x << camera_location.y << camera_location.z;
+        mframe << camera_aim.x << camera_aim.y << camera_aim.z;
+        mframe << camera_up.x << camera_up.y << camera_up.z;
+        mframe << camera_angle << camera_orthographic;
+    }
+
+    mframe << (int)csys_counts.size();
+    if (csys_counts.size())
+        mframe.BlockOutput(&csys_counts[0], csys_counts.size());
+
+    mframe << (int)ncsys;
+    if (ncsys) {
+        for (int c = 0; c < 7; c++) {
+            if (this->binary_single_precision) {
+                csys_data_f.resize(ncsys);
+                for (size_t k = 0; k < ncsys; k++)
+                    csys_data_f[k] = (float)csys_data[c][k];
+                mframe.BlockOutput(&csys_data_f[0], ncsys);
+            } else {
+                mframe.BlockOutput(&csys_data[c][0], ncsys);
+            }
+        }
+    }
+}
+
+void ChPovRay::ConvertBinaryData(const std::string& filename) {
+    std::string pathframe = filename + ".chf";
+
     try {
+        // Load the frame
+        ChStreamInBinaryFile mframe(pathframe.c_str());
+        int magic;
+        mframe >> magic;
+        if (magic != POV_FRAME_MAGIC)
+            throw(ChException("Not a binary POV-Ray frame: " + pathframe));
+        mframe.VersionRead();
+
+        bool single_precision;
+        double mtime;
+        std::string mlayout_file;
+        std::string mcustom_data;
+        bool cogs_show, frames_show;
+        double cogs_size, frames_size, links_size;
+        mframe >> single_precision >> mtime >> mlayout_file >> mcustom_data;
+        mframe >> cogs_show >> cogs_size >> frames_show >> frames_size >> links_size;
+
+        bool camera_found;
+        ChVector<> camera_location, camera_aim, camera_up;
+        double camera_angle = 0;
+        bool camera_orthographic = false;
+        mframe >> camera_found;
+        if (camera_found) {
+            mframe >> camera_location.x >> camera_location.y >> camera_location.z;
+            mframe >> camera_aim.x >> camera_aim.y >> camera_aim.z;
+            mframe >> camera_up.x >> camera_up.y >> camera_up.z;
+            mframe >> camera_angle >> camera_orthographic;
+        }
+
+        int nitems;
+        mframe >> nitems;
+        std::vector<int> counts(nitems);
+        if (nitems)
+            mframe.BlockInput(&counts[0], nitems);
+
+        int ncsys;
+        mframe >> ncsys;
+        std::vector<double> data[7];
+        std::vector<float> data_f(single_precision ? ncsys : 0);
+        for (int c = 0; c < 7; c++) {
+            data[c].resize(ncsys);
+            if (ncsys == 0)
+                continue;
+            if (single_precision) {
+                mframe.BlockInput(&data_f[0], ncsys);
+                for (int k = 0; k < ncsys; k++)
+                    data[c][k] = data_f[k];
+            } else {
+                mframe.BlockInput(&data[c][0], ncsys);
+            }
+        }
+
+        // Load the layout
+        ChStreamInBinaryFile mlayout(mlayout_file.c_str());
+        mlayout >> magic;
+        if (magic != POV_LAYOUT_MAGIC)
+            throw(ChException("Not a binary POV-Ray layout: " + mlayout_file));
+        mlayout.VersionRead();
+        int nlayout;
+        mlayout >> nlayout;
+        if (nlayout != nitems)
+            throw(ChException("Binary POV-Ray frame " + pathframe + " does not match its layout " + mlayout_file));
+        std::vector<int> types(nitems);
+        std::vector<std::string> texts(nitems);
+        for (int i = 0; i < nitems; i++)
+            mlayout >> types[i] >> texts[i];
+
+        // Write the same .pov and .dat files of ExportTextData()
         char pathdat[200];
         sprintf(pathdat, "%s.dat", filename.c_str());
         ChStreamOutAsciiFile mfiledat(pathdat);
@@ -786,183 +1358,57 @@ void ChPovRay::ExportData(const std::string& filename) {
         sprintf(pathpov, "%s.pov", filename.c_str());
         ChStreamOutAsciiFile mfilepov(pathpov);
 
-        this->camera_found_in_assets = false;
-
-        // Write custom data commands, if provided by the user
-        if (this->custom_data.size() > 0) {
+        if (mcustom_data.size() > 0) {
             mfilepov << "// Custom user-added script: \n\n";
-            mfilepov << this->custom_data;
+            mfilepov << mcustom_data;
             mfilepov << "\n\n";
         }
 
-        // Tell POV to open the .dat file, that could be used by
-        // ChParticleClones for efficiency (xyz raw data with center of particles will
-        // be saved in dat and load using a #while POV loop, helping to reduce size of .pov file)
         mfilepov << "#declare dat_file = \"" << pathdat << "\"\n";
         mfilepov << "#fopen MyDatFile dat_file read \n\n";
 
-        // Save time-dependent data for the geometry of objects in ...nnnn.POV
-        // and in ...nnnn.DAT file
-
-        for (unsigned int i = 0; i < this->mdata.size(); i++) {
-            // #) saving a body ?
-            if (auto mybody = std::dynamic_pointer_cast<ChBody>(mdata[i])) {
-                // Get the current coordinate frame of the i-th object
-                ChCoordsys<> assetcsys = CSYSNORM;
-                const ChFrame<>& bodyframe = mybody->GetFrame_REF_to_abs();
-                assetcsys = bodyframe.GetCoord();
-
-                // Dump the POV macro that generates the contained asset(s) tree!!!
-                _recurseExportObjData(mdata[i]->GetAssets(), bodyframe, mfilepov);
-
-                // Show body COG?
-                if (this->COGs_show) {
-                    const ChCoordsys<>& cogcsys = mybody->GetFrame_COG_to_abs().GetCoord();
-                    mfilepov << "sh_csysCOG(";
-                    mfilepov << cogcsys.pos.x << "," << cogcsys.pos.y << "," << cogcsys.pos.z << ",";
-                    mfilepov << cogcsys.rot.e0 << "," << cogcsys.rot.e1 << "," << cogcsys.rot.e2 << ","
-                             << cogcsys.rot.e3 << ",";
-                    mfilepov << this->COGs_size << ")\n";
-                }
-                // Show body frame ref?
-                if (this->frames_show) {
-                    mfilepov << "sh_csysFRM(";
-                    mfilepov << assetcsys.pos.x << "," << assetcsys.pos.y << "," << assetcsys.pos.z << ",";
-                    mfilepov << assetcsys.rot.e0 << "," << assetcsys.rot.e1 << "," << assetcsys.rot.e2 << ","
-                             << assetcsys.rot.e3 << ",";
-                    mfilepov << this->frames_size << ")\n";
+        size_t k = 0;
+        for (int i = 0; i < nitems; i++) {
+            switch (types[i]) {
+                case BINARY_ITEM_BODY: {
+                    ChCoordsys<> bodycsys = GetCsys(data, k);
+                    mfilepov << "union{\n";
+                    mfilepov << texts[i];
+                    WritePovTransform(mfilepov, bodycsys);
+                    mfilepov << "}\n";
+                    if (cogs_show)
+                        WritePovCsys(mfilepov, "sh_csysCOG", GetCsys(data, k + 1), cogs_size);
+                    if (frames_show)
+                        WritePovCsys(mfilepov, "sh_csysFRM", bodycsys, frames_size);
+                    break;
                 }
-            }
-
-            // #) saving a cluster of particles ?  (NEW method that uses a POV '#while' loop and a .dat file)
-            if (auto myclones = std::dynamic_pointer_cast<ChParticlesClones>(mdata[i])) {
-                mfilepov << " \n";
-                // mfilepov << "union{\n";
-                mfilepov << "#declare Index = 0; \n";
-                mfilepov << "#while(Index < " << myclones->GetNparticles() << ") \n";
-                mfilepov << "  #read (MyDatFile, apx, apy, apz, aq0, aq1, aq2, aq3) \n";
-                mfilepov << "  union{\n";
-                ChFrame<> nullframe(CSYSNORM);
-                _recurseExportObjData(mdata[i]->GetAssets(), nullframe, mfilepov);
-                mfilepov << "  quatRotation(<aq0,aq1,aq2,aq3>)\n";
-                mfilepov << "  translate(<apx,apy,apz>)\n";
-                mfilepov << "  }\n";
-                mfilepov << "  #declare Index = Index + 1; \n";
-                mfilepov << "#end \n";
-                // mfilepov << "} \n";
-
-                // Loop on all particle clones
-                for (unsigned int m = 0; m < myclones->GetNparticles(); ++m) {
-                    // Get the current coordinate frame of the i-th particle
-                    ChCoordsys<> assetcsys = CSYSNORM;
-                    assetcsys = myclones->GetParticle(m).GetCoord();
-
-                    mfiledat << assetcsys.pos.x << ", ";
-                    mfiledat << assetcsys.pos.y << ", ";
-                    mfiledat << assetcsys.pos.z << ", ";
-                    mfiledat << assetcsys.rot.e0 << ", ";
-                    mfiledat << assetcsys.rot.e1 << ", ";
-                    mfiledat << assetcsys.rot.e2 << ", ";
-                    mfiledat << assetcsys.rot.e3 << ", \n";
-                }  // end loop on particles
-            }
-
-            // #) saving a ChLinkMateGeneric constraint ?
-            if (auto mylinkmate = std::dynamic_pointer_cast<ChLinkMateGeneric>(mdata[i])) {
-                if (mylinkmate->GetBody1() && mylinkmate->GetBody2() && this->links_show) {
-                    ChFrame<> frAabs = mylinkmate->GetFrame1() >> *mylinkmate->GetBody1();
-                    ChFrame<> frBabs = mylinkmate->GetFrame2() >> *mylinkmate->GetBody2();
-                    mfilepov << "sh_csysFRM(";
-                    mfilepov << frAabs.GetPos().x << "," << frAabs.GetPos().y << "," << frAabs.GetPos().z << ",";
-                    mfilepov << frAabs.GetRot().e0 << "," << frAabs.GetRot().e1 << "," << frAabs.GetRot().e2 << ","
-                             << frAabs.GetRot().e3 << ",";
-                    mfilepov << this->links_size * 0.7 << ")\n";  // smaller, as 'slave' csys.
-                    mfilepov << "sh_csysFRM(";
-                    mfilepov << frBabs.GetPos().x << "," << frBabs.GetPos().y << "," << frBabs.GetPos().z << ",";
-                    mfilepov << frBabs.GetRot().e0 << "," << frBabs.GetRot().e1 << "," << frBabs.GetRot().e2 << ","
-                             << frBabs.GetRot().e3 << ",";
-                    mfilepov << this->links_size << ")\n";
+                case BINARY_ITEM_CLONES: {
+                    WritePovClonesBegin(mfilepov, counts[i]);
+                    mfilepov << texts[i];
+                    WritePovClonesEnd(mfilepov);
+                    for (int m = 0; m < counts[i]; m++)
+                        WriteDatCsys(mfiledat, GetCsys(data, k + m));
+                    break;
                 }
-            }
-
-        }  // end loop on objects
-
-        // #) saving contacts ?
-        if (this->contacts_show) {
-          /*
-            char pathcontacts[200];
-            sprintf(pathcontacts, "%s.contacts", filename.c_str());
-            ChStreamOutAsciiFile data_contacts(pathcontacts);
-
-            class _reporter_class : public chrono::ChReportContactCallback {
-              public:
-                virtual bool ReportContactCallback(const ChVector<>& pA,
-                                                   const ChVector<>& pB,
-                                                   const ChMatrix33<>& plane_coord,
-                                                   const double& distance,
-                                                   const float& mfriction,
-                                                   const ChVector<>& react_forces,
-                                                   const ChVector<>& react_torques,
-                                                   collision::ChCollisionModel* modA,
-                                                   collision::ChCollisionModel* modB) {
-                    if (fabs(react_forces.x) > 1e-8 || fabs(react_forces.y) > 1e-8 || fabs(react_forces.z) > 1e-8) {
-                        ChMatrix33<> localmatr(plane_coord);
-                        ChVector<> n1 = localmatr.Get_A_Xaxis();
-                        ChVector<> absreac = localmatr * react_forces;
-                        (*mfile) << pA.x << ", ";
-                        (*mfile) << pA.y << ", ";
-                        (*mfile) << pA.z << ", ";
-                        (*mfile) << n1.x << ", ";
-                        (*mfile) << n1.y << ", ";
-                        (*mfile) << n1.z << ", ";
-                        (*mfile) << absreac.x << ", ";
-                        (*mfile) << absreac.y << ", ";
-                        (*mfile) << absreac.z << ", \n";
+                case BINARY_ITEM_LINK: {
+                    if (counts[i] == 2) {
+                        WritePovCsys(mfilepov, "sh_csysFRM", GetCsys(data, k), links_size * 0.7);
+                        WritePovCsys(mfilepov, "sh_csysFRM", GetCsys(data, k + 1), links_size);
                     }
-                    return true;  // to continue scanning contacts
+                    break;
                 }
-                // Data
-                ChStreamOutAsciiFile* mfile;
-            };
-
-            _reporter_class my_contact_reporter;
-            my_contact_reporter.mfile = &data_contacts;
-
-            // scan all contacts
-            this->mSystem->GetContactContainer()->ReportAllContacts(&my_contact_reporter);
-            */
-        }
-
-        // If a camera have been found in assets, create it and override the default one
-        if (this->camera_found_in_assets) {
-            mfilepov << "camera { \n";
-            if (camera_orthographic) {
-                mfilepov << " orthographic \n";
-                mfilepov << " right x * " << (camera_location - camera_aim).Length() << " * tan ((( " << camera_angle
-                         << " *0.5)/180)*3.14) \n";
-                mfilepov << " up y * image_height/image_width * " << (camera_location - camera_aim).Length()
-                         << " * tan (((" << camera_angle << "*0.5)/180)*3.14) \n";
-                ChVector<> mdir = (camera_aim - camera_location) * 0.00001;
-                mfilepov << " direction <" << mdir.x << "," << mdir.y << "," << mdir.z << "> \n";
-            } else {
-                mfilepov << " right -x*image_width/image_height \n";
-                mfilepov << " angle " << camera_angle << " \n";
+                default:
+                    break;
             }
-            mfilepov << " location <" << camera_location.x << "," << camera_location.y << "," << camera_location.z
-                     << "> \n"
-                     << " look_at <" << camera_aim.x << "," << camera_aim.y << "," << camera_aim.z << "> \n"
-                     << " sky <" << camera_up.x << "," << camera_up.y << "," << camera_up.z << "> \n";
-            mfilepov << "}\n\n\n";
+            k += counts[i];
         }
 
-        // At the end of the .pov file, remember to close the .dat
+        if (camera_found)
+            WritePovCamera(mfilepov, camera_location, camera_aim, camera_up, camera_angle, camera_orthographic);
+
         mfilepov << "\n\n#fclose MyDatFile \n";
-    } catch (ChException) {
-        char error[400];
-        sprintf(error, "Can't save data into file %s.pov (or .dat)", filename.c_str());
-        throw(ChException(error));
-    }
 
-    // Increment the number of the frame.
-    this->framenumber++;
+    } catch (ChException mex) {
+        throw(ChException("Can't convert binary POV-Ray data " + filename + ": " + mex.what()));
+    }
 }
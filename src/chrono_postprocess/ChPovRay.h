@@ -36,6 +36,8 @@
 
 namespace chrono {
 
+class ChThreads;
+
 /// Namespace with classes for the postprocess unit.
 namespace postprocess {
 
@@ -50,7 +52,7 @@ namespace postprocess {
 class ChApiPostProcess ChPovRay : public ChPostProcessBase {
   public:
     ChPovRay(ChSystem* system);
-    virtual ~ChPovRay() {}
+    virtual ~ChPovRay();
 
     enum eChContactSymbol {  // used for displaying contacts
         SYMBOL_VECTOR_SCALELENGTH = 0,
@@ -207,6 +209,41 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
     /// As ExportScript(), but overrides the automatically computed filename.
     virtual void ExportData(const std::string& filename);
 
+    /// If enabled, ExportData() writes a compact binary frame file (.chf)
+    /// instead of the .pov and .dat files. The frame contains only the
+    /// positions and rotations of the exported items (as arrays of x, y, z,
+    /// e0, e1, e2, e3 values), while the POV code of the items is written in
+    /// a layout file (.chl) only when the list of exported items, or the number
+    /// of assets of an item, changes (see also InvalidateLayout()).
+    /// The .pov and .dat files can be generated later with ConvertBinaryData().
+    /// Optionally, positions and rotations are saved in single precision.
+    virtual void SetBinaryOutput(bool binary, bool single_precision = false) {
+        binary_output = binary;
+        binary_single_precision = single_precision;
+    }
+
+    /// With binary output, force the export of the assets and of a new layout
+    /// file at the next ExportData(). Call this after modifying the assets of
+    /// exported items (for example their shape or color): such changes are not
+    /// detected automatically.
+    void InvalidateLayout() { layout_file.clear(); }
+
+    /// If enabled, the files of ExportData() are written by a background
+    /// thread, while the simulation continues. The state of the items is
+    /// copied before ExportData() returns; if the previous frame is still
+    /// being written, ExportData() waits for it first (double buffering).
+    virtual void SetAsyncOutput(bool async);
+
+    /// Wait until the files of the last ExportData() are written, if the
+    /// output is asynchronous. Throws a ChException if writing failed.
+    virtual void Flush();
+
+    /// Generate the .pov and .dat files from a binary frame saved with
+    /// ExportData() and SetBinaryOutput(true). The filename is the same
+    /// passed to ExportData(filename), without extension. The result is
+    /// the same of an ExportData() without binary output.
+    static void ConvertBinaryData(const std::string& filename);
+
   protected:
     virtual void SetupLists();
     virtual void ExportAssets();
@@ -214,7 +251,40 @@ class ChApiPostProcess ChPovRay : public ChPostProcessBase {
 
     void _recurseExportObjData(std::vector<std::shared_ptr<ChAsset> >& assetlist,
                                ChFrame<> parentframe,
-                               ChStreamOutAsciiFile& mfilepov);
+                               ChStreamOutAscii& mfilepov);
+    void _recurseExportObjAssets(std::vector<std::shared_ptr<ChAsset> >& assetlist,
+                                 ChFrame<> parentframe,
+                                 ChStreamOutAscii& mfilepov);
+    void _recurseFindCamera(std::vector<std::shared_ptr<ChAsset> >& assetlist, ChFrame<> parentframe);
+
+    /// Files of a frame to be written (possibly by the background thread).
+    struct FrameBuffer {
+        int nfiles;
+        std::string files[2];
+        std::vector<char> contents[2];
+        bool failed;
+    };
+
+    void ExportTextData(const std::string& filename, ChStreamOutAscii& mfilepov, ChStreamOutAscii& mfiledat);
+    void ExportBinaryData(const std::string& filename, FrameBuffer& buffer);
+    void BuildLayout(std::vector<char>& bytes);
+    void WriteBuffer(FrameBuffer& buffer);
+    static void WriteFrameBuffer(void* userPtr, void* lsMemory);
+
+    bool binary_output;
+    bool binary_single_precision;
+    std::vector<ChPhysicsItem*> layout_items;  ///< items in the last layout file
+    std::vector<size_t> layout_nassets;        ///< number of assets of these items
+    std::string layout_file;
+    std::vector<bool> layout_camera;  ///< items with a ChCamera asset
+    std::vector<double> csys_data[7];  ///< work arrays for the state of the items: x, y, z, e0, e1, e2, e3
+    std::vector<float> csys_data_f;    ///< work array for single precision output
+    std::vector<int> csys_counts;      ///< work array, number of coordinate systems of each item
+
+    ChThreads* writer_thread;
+    FrameBuffer buffers[2];
+    int current_buffer;
+    int last_sent_buffer;
 
     std::vector<std::shared_ptr<ChPhysicsItem> > mdata;
     ChHashTable<size_t, std::shared_ptr<ChAsset> > pov_assets;
@@ -20,5 +20,18 @@
 
 namespace chrono {
 namespace vehicle {
+
+void ChTerrain::GetHeightNormal(int num_points,
+                                const double* x,
+                                const double* y,
+                                double* height,
+                                ChVector<>* normal) const {
+    for (int i = 0; i < num_points; i++) {
+        height[i] = GetHeight(x[i], y[i]);
+        if (normal)
+            normal[i] = GetNormal(x[i], y[i]);
+    }
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -53,6 +53,17 @@ class CH_VEHICLE_API ChTerrain {
 
     /// Get the terrain normal at the specified (x,y) location.
     virtual ChVector<> GetNormal(double x, double y) const = 0;
+
+    /// Get the terrain height and normal at a set of (x,y) locations.
+    /// The normals are not calculated if 'normal' is NULL. The default
+    /// implementation calls GetHeight() and GetNormal() for each location;
+    /// derived classes can override it to process all locations at once.
+    virtual void GetHeightNormal(int num_points,      ///< [in] number of locations
+                                 const double* x,     ///< [in] x coordinates of the locations
+                                 const double* y,     ///< [in] y coordinates of the locations
+                                 double* height,      ///< [out] terrain heights
+                                 ChVector<>* normal   ///< [out] terrain normals (may be NULL)
+                                 ) const;
 };
 
 /// @} vehicle_terrain
@@ -0,0 +1,163 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Process-wide cache of parsed Chrono::Vehicle model files (JSON specification
+// files and Wavefront meshes).
+//
+// =============================================================================
+
+#include <cstdio>
+#include <map>
+#include <mutex>
+
+#include "chrono/core/ChException.h"
+
+#include "chrono_vehicle/ChVehicleModelCache.h"
+
+#include "thirdparty/rapidjson/filereadstream.h"
+
+using namespace rapidjson;
+
+namespace chrono {
+namespace vehicle {
+
+// Each cached file has its own lock, held while the file is loaded, so that
+// concurrent requests for the same file load it only once while different
+// files are loaded concurrently.
+template <typename T>
+struct CacheEntry {
+    std::mutex mutex;
+    std::shared_ptr<const T> object;
+};
+
+typedef std::map<std::string, std::shared_ptr<CacheEntry<Document> > > JSONCache;
+typedef std::map<std::string, std::shared_ptr<CacheEntry<geometry::ChTriangleMeshConnected> > > MeshCache;
+
+// The cache is allocated on first use and never deleted, so that it can still
+// be used from static destructors. Its lock only protects the maps.
+struct ModelCache {
+    ModelCache() : enabled(true) {}
+    std::mutex mutex;
+    bool enabled;
+    JSONCache documents;
+    MeshCache meshes;
+};
+
+static ModelCache& GetModelCache() {
+    static ModelCache* cache = new ModelCache;
+    return *cache;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+static std::shared_ptr<const Document> ReadJSON(const std::string& filename) {
+    auto d = std::make_shared<Document>();
+
+    FILE* fp = fopen(filename.c_str(), "r");
+    if (!fp)
+        throw ChException("Cannot open JSON file " + filename);
+
+    char readBuffer[65536];
+    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    d->ParseStream(is);
+
+    fclose(fp);
+
+    if (d->HasParseError() || !d->IsObject())
+        throw ChException("Cannot parse JSON file " + filename);
+
+    return d;
+}
+
+static std::shared_ptr<const geometry::ChTriangleMeshConnected> ReadMesh(const std::string& filename,
+                                                                         bool load_normals,
+                                                                         bool load_uv) {
+    auto trimesh = std::make_shared<geometry::ChTriangleMeshConnected>();
+    trimesh->LoadWavefrontMesh(filename, load_normals, load_uv);
+    return trimesh;
+}
+
+// -----------------------------------------------------------------------------
+// Find or add the entry of the specified file (with the cache lock held).
+// -----------------------------------------------------------------------------
+template <typename T>
+static std::shared_ptr<CacheEntry<T> > GetEntry(std::map<std::string, std::shared_ptr<CacheEntry<T> > >& entries,
+                                                const std::string& key) {
+    std::shared_ptr<CacheEntry<T> >& entry = entries[key];
+    if (!entry)
+        entry = std::make_shared<CacheEntry<T> >();
+    return entry;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+std::shared_ptr<const Document> GetCachedJSON(const std::string& filename) {
+    ModelCache& cache = GetModelCache();
+    std::shared_ptr<CacheEntry<Document> > entry;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (cache.enabled)
+            entry = GetEntry(cache.documents, filename);
+    }
+    if (!entry)
+        return ReadJSON(filename);
+
+    // If the file cannot be read, the entry stays empty and the next request
+    // tries again.
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    if (!entry->object)
+        entry->object = ReadJSON(filename);
+
+    return entry->object;
+}
+
+std::shared_ptr<const geometry::ChTriangleMeshConnected> GetCachedMesh(const std::string& filename,
+                                                                       bool load_normals,
+                                                                       bool load_uv) {
+    ModelCache& cache = GetModelCache();
+    std::shared_ptr<CacheEntry<geometry::ChTriangleMeshConnected> > entry;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (cache.enabled) {
+            std::string key = filename + (load_normals ? "|n" : "|-") + (load_uv ? "t" : "-");
+            entry = GetEntry(cache.meshes, key);
+        }
+    }
+    if (!entry)
+        return ReadMesh(filename, load_normals, load_uv);
+
+    std::lock_guard<std::mutex> lock(entry->mutex);
+    if (!entry->object)
+        entry->object = ReadMesh(filename, load_normals, load_uv);
+
+    return entry->object;
+}
+
+void SetModelCacheEnabled(bool val) {
+    ModelCache& cache = GetModelCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.enabled = val;
+    if (!val) {
+        cache.documents.clear();
+        cache.meshes.clear();
+    }
+}
+
+void ClearModelCache() {
+    ModelCache& cache = GetModelCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.documents.clear();
+    cache.meshes.clear();
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,68 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Process-wide cache of parsed Chrono::Vehicle model files (JSON specification
+// files and Wavefront meshes).
+//
+// =============================================================================
+
+#ifndef CH_VEHICLE_MODELCACHE_H
+#define CH_VEHICLE_MODELCACHE_H
+
+#include <memory>
+#include <string>
+
+#include "chrono/geometry/ChCTriangleMeshConnected.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+#include "thirdparty/rapidjson/document.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle
+/// @{
+
+/// Get the parsed JSON document for the specified file.
+/// The file is read and parsed the first time it is requested; later requests
+/// (from any thread) return the same document. Cached documents are never
+/// modified, so vehicles and subsystems created from them are identical to
+/// those created from the file. Different files are loaded concurrently.
+/// Throws a ChException if the file cannot be opened or parsed (nothing is
+/// cached then).
+CH_VEHICLE_API std::shared_ptr<const rapidjson::Document> GetCachedJSON(const std::string& filename);
+
+/// Get the triangle mesh loaded from the specified Wavefront OBJ file.
+/// As for JSON files, the mesh is loaded only the first time it is requested
+/// (separately for each combination of the loading options). The mesh should
+/// be shared rather than copied (see ChTriangleMeshShape::SetMesh).
+CH_VEHICLE_API std::shared_ptr<const geometry::ChTriangleMeshConnected> GetCachedMesh(const std::string& filename,
+                                                                                   bool load_normals = true,
+                                                                                   bool load_uv = false);
+
+/// Enable or disable the model cache (default: enabled).
+/// If disabled, the files are read and parsed at each request and nothing is
+/// stored in the cache.
+CH_VEHICLE_API void SetModelCacheEnabled(bool val);
+
+/// Remove all documents and meshes from the model cache.
+/// This must be called if a model file is modified while the program runs.
+/// Objects that still hold cached documents or meshes keep them alive.
+CH_VEHICLE_API void ClearModelCache();
+
+/// @} vehicle
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -16,6 +16,8 @@
 //
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono_vehicle/terrain/FlatTerrain.h"
 
 namespace chrono {
@@ -24,5 +26,15 @@ namespace vehicle {
 FlatTerrain::FlatTerrain(const int height) : m_height(height) {
 }
 
+void FlatTerrain::GetHeightNormal(int num_points,
+                                  const double* x,
+                                  const double* y,
+                                  double* height,
+                                  ChVector<>* normal) const {
+    std::fill(height, height + num_points, m_height);
+    if (normal)
+        std::fill(normal, normal + num_points, ChVector<>(0, 0, 1));
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
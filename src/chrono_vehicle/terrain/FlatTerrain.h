@@ -48,6 +48,13 @@ class CH_VEHICLE_API FlatTerrain : public ChTerrain {
     /// Returns a constant unit vector along the Z axis.
     virtual ChVector<> GetNormal(double x, double y) const { return ChVector<>(0, 0, 1); }
 
+    /// Get the terrain height and normal at a set of (x,y) locations.
+    virtual void GetHeightNormal(int num_points,
+                                 const double* x,
+                                 const double* y,
+                                 double* height,
+                                 ChVector<>* normal) const override;
+
   private:
     double m_height;
 };
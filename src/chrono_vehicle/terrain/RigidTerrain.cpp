@@ -16,6 +16,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cstdio>
 #include <cmath>
 
@@ -413,5 +414,23 @@ ChVector<> RigidTerrain::GetNormal(double x, double y) const {
     }
 }
 
+// -----------------------------------------------------------------------------
+// Return the terrain height and normal at a set of locations
+// -----------------------------------------------------------------------------
+void RigidTerrain::GetHeightNormal(int num_points,
+                                   const double* x,
+                                   const double* y,
+                                   double* height,
+                                   ChVector<>* normal) const {
+    if (m_type != FLAT) {
+        ChTerrain::GetHeightNormal(num_points, x, y, height, normal);
+        return;
+    }
+
+    std::fill(height, height + num_points, m_height);
+    if (normal)
+        std::fill(normal, normal + num_points, ChVector<>(0, 0, 1));
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
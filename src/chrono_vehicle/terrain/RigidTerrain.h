@@ -112,6 +112,13 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// Get the terrain normal at the specified (x,y) location.
     virtual chrono::ChVector<> GetNormal(double x, double y) const override;
 
+    /// Get the terrain height and normal at a set of (x,y) locations.
+    virtual void GetHeightNormal(int num_points,
+                                 const double* x,
+                                 const double* y,
+                                 double* height,
+                                 chrono::ChVector<>* normal) const override;
+
   private:
     Type m_type;
     std::shared_ptr<ChBody> m_ground;
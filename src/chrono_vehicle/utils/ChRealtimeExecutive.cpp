@@ -0,0 +1,237 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Real-time executive for a Chrono::Vehicle simulation: advances the vehicle
+// system within a wall-clock budget and paces the simulation to real time.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "chrono/lcp/ChLcpIterativeSolver.h"
+
+#include "chrono_vehicle/utils/ChRealtimeExecutive.h"
+
+namespace chrono {
+namespace vehicle {
+
+// Latency histogram: bin 0 holds latencies below 1 us, the following bins grow
+// by 1% up to 100 s.
+static const double hist_min = 1e-6;
+static const double hist_ratio = 1.01;
+static const int hist_bins = 1853;
+
+// Update a cost estimate with a new measurement: increases are followed
+// immediately, decreases slowly.
+static void UpdateEstimate(double& estimate, double value) {
+    if (value > estimate)
+        estimate = value;
+    else
+        estimate += 0.05 * (value - estimate);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+ChRealtimeExecutive::ChRealtimeExecutive(ChVehicle& vehicle)
+    : m_vehicle(&vehicle),
+      m_system(vehicle.GetSystem()),
+      m_factor(1),
+      m_margin(0.1),
+      m_skip_allowed(true),
+      m_max_skipped(2),
+      m_pacing(true),
+      m_cost_fixed(0),
+      m_cost_iter(0),
+      m_cost_collision(0),
+      m_cost_other(0) {
+    m_max_iters = m_system->GetIterLCPmaxItersSpeed();
+    m_min_iters = std::min(5, m_max_iters);
+    Reset();
+}
+
+void ChRealtimeExecutive::SetIterationLimits(int min_iters, int max_iters) {
+    m_min_iters = std::max(1, min_iters);
+    m_max_iters = std::max(m_min_iters, max_iters);
+}
+
+void ChRealtimeExecutive::SetCollisionSkipping(bool val, int max_consecutive) {
+    m_skip_allowed = val;
+    m_max_skipped = max_consecutive;
+}
+
+void ChRealtimeExecutive::Reset() {
+    m_clock.reset();
+    m_clock.start();
+    m_sim_time = 0;
+    m_frame_end = 0;
+    m_consecutive_skipped = 0;
+
+    m_num_frames = 0;
+    m_num_overruns = 0;
+    m_num_skipped = 0;
+    m_num_resyncs = 0;
+    m_num_steps = 0;
+    m_total_iters = 0;
+    m_total_latency = 0;
+    m_max_latency = 0;
+    m_histogram.assign(hist_bins, 0);
+}
+
+// -----------------------------------------------------------------------------
+// Advance the vehicle system by one frame. The integration steps are those of
+// ChVehicle::Advance(); before each of them, the solver iterations are chosen
+// so that the remaining steps fit in the remaining budget of the frame. The
+// iteration limit and the collision detection are restored at the end, so that
+// the system can also be advanced without the executive.
+// -----------------------------------------------------------------------------
+void ChRealtimeExecutive::Advance(double step) {
+    if (m_num_frames == 0)
+        Reset();
+
+    double frame_start = m_clock.GetTimeSecondsIntermediate();
+    double other = (m_num_frames > 0) ? frame_start - m_frame_end : 0;
+    UpdateEstimate(m_cost_other, other);
+
+    double frame = m_factor * step;
+    double budget = (1 - m_margin) * frame - m_cost_other;
+    double stepsize = m_vehicle->GetStepsize();
+
+    double t = 0;
+    while (t < step) {
+        double h = std::min<>(stepsize, step - t);
+        int remaining = std::max(1, (int)std::ceil((step - t) / stepsize - 1e-6));
+        double available = (budget - (m_clock.GetTimeSecondsIntermediate() - frame_start)) / remaining;
+
+        // Skip the collision detection if the step does not fit, even with the
+        // minimum number of iterations.
+        bool collision = true;
+        if (m_skip_allowed && m_consecutive_skipped < m_max_skipped &&
+            m_cost_fixed + m_min_iters * m_cost_iter + m_cost_collision > available)
+            collision = false;
+
+        // Number of iterations that fit in the available time.
+        int iters = m_max_iters;
+        if (m_cost_iter > 0) {
+            double fit = (available - m_cost_fixed - (collision ? m_cost_collision : 0)) / m_cost_iter;
+            iters = (int)std::max<double>(m_min_iters, std::min<double>(m_max_iters, std::floor(fit)));
+        }
+
+        m_system->SetIterLCPmaxItersSpeed(iters);
+        m_system->SetCollisionDetection(collision);
+        m_system->DoStepDynamics(h);
+        UpdateEstimates(iters, collision);
+
+        if (collision) {
+            m_consecutive_skipped = 0;
+        } else {
+            m_consecutive_skipped++;
+            m_num_skipped++;
+        }
+
+        t += h;
+    }
+
+    m_system->SetIterLCPmaxItersSpeed(m_max_iters);
+    m_system->SetCollisionDetection(true);
+
+    // Frame statistics.
+    double work_end = m_clock.GetTimeSecondsIntermediate();
+    double latency = work_end - frame_start;
+    m_num_frames++;
+    m_total_latency += latency;
+    m_max_latency = std::max(m_max_latency, latency);
+    m_histogram[LatencyBin(latency)]++;
+    if (latency + other > frame)
+        m_num_overruns++;
+
+    // Wait for the real time to catch up with the simulated time. If the
+    // simulation is behind by more than one frame, move the simulated time
+    // forward rather than running the next frames without pause.
+    m_sim_time += frame;
+    if (m_pacing) {
+        double lag = work_end - m_sim_time;
+        if (lag > frame) {
+            m_sim_time = work_end;
+            m_num_resyncs++;
+        } else if (lag < 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double>(-lag));
+        }
+    }
+
+    m_frame_end = m_clock.GetTimeSecondsIntermediate();
+}
+
+// -----------------------------------------------------------------------------
+// The cost of the solver is attributed to its iterations, which overestimates
+// the cost of one iteration when few iterations are done.
+// -----------------------------------------------------------------------------
+void ChRealtimeExecutive::UpdateEstimates(int iters, bool collision) {
+    double t_step = m_system->GetTimerStep();
+    double t_lcp = m_system->GetTimerLcp();
+    double t_collision = m_system->GetTimerCollisionBroad() + m_system->GetTimerCollisionNarrow();
+
+    if (ChLcpIterativeSolver* solver = dynamic_cast<ChLcpIterativeSolver*>(m_system->GetLcpSolverSpeed())) {
+        int done = (int)solver->GetTotalIterations();
+        if (done > 0)
+            iters = done;
+        UpdateEstimate(m_cost_iter, t_lcp / std::max(iters, 1));
+        m_total_iters += iters;
+    }
+
+    UpdateEstimate(m_cost_fixed, std::max(0.0, t_step - t_lcp - t_collision));
+    if (collision)
+        UpdateEstimate(m_cost_collision, t_collision);
+
+    m_num_steps++;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+double ChRealtimeExecutive::GetAverageIterations() const {
+    return m_num_steps > 0 ? m_total_iters / m_num_steps : 0;
+}
+
+double ChRealtimeExecutive::GetAverageLatency() const {
+    return m_num_frames > 0 ? m_total_latency / m_num_frames : 0;
+}
+
+double ChRealtimeExecutive::GetLatencyPercentile(double percentile) const {
+    if (m_num_frames == 0)
+        return 0;
+
+    double target = std::ceil(percentile / 100 * m_num_frames);
+    int count = 0;
+    for (int bin = 0; bin < hist_bins; bin++) {
+        count += m_histogram[bin];
+        if (count >= target)
+            return std::min(LatencyBinBound(bin), m_max_latency);
+    }
+
+    return m_max_latency;
+}
+
+int ChRealtimeExecutive::LatencyBin(double time) {
+    if (time < hist_min)
+        return 0;
+    int bin = 1 + (int)(std::log(time / hist_min) / std::log(hist_ratio));
+    return std::min(bin, hist_bins - 1);
+}
+
+double ChRealtimeExecutive::LatencyBinBound(int bin) {
+    return hist_min * std::pow(hist_ratio, bin);
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,165 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Real-time executive for a Chrono::Vehicle simulation: advances the vehicle
+// system within a wall-clock budget and paces the simulation to real time.
+//
+// =============================================================================
+
+#ifndef CH_REALTIME_EXECUTIVE_H
+#define CH_REALTIME_EXECUTIVE_H
+
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_utils
+/// @{
+
+/// Real-time executive for a vehicle simulation.
+/// Call Advance() instead of ChVehicle::Advance(), once per frame of the
+/// simulation loop (after the other systems, e.g. driver, tires, powertrain,
+/// have been advanced). The executive:
+///  - measures the cost of each integration step with the system timers;
+///  - before each step, sets the maximum number of solver iterations
+///    (ChSystem::SetIterLCPmaxItersSpeed) so that the remaining steps of the
+///    frame fit in the remaining budget;
+///  - if even the minimum number of iterations does not fit, skips the
+///    collision detection for that step and keeps the previous contacts
+///    (ChSystem::SetCollisionDetection), at most a few steps in a row;
+///  - at the end of the frame, sets the maximum number of iterations back to
+///    the upper limit and enables the collision detection again;
+///  - sleeps at the end of the frame until the wall-clock time catches up with
+///    the simulated time;
+///  - records the latency of each frame and the budget overruns.
+/// The budget of a frame is the frame step (scaled by the real-time factor),
+/// minus the time spent in the rest of the simulation loop (measured between
+/// frames) and a safety margin.
+class CH_VEHICLE_API ChRealtimeExecutive {
+  public:
+    /// Construct an executive for the given vehicle.
+    /// The current maximum number of solver iterations of the vehicle system is
+    /// used as the upper limit of the iterations.
+    ChRealtimeExecutive(ChVehicle& vehicle);
+
+    ~ChRealtimeExecutive() {}
+
+    /// Set the range for the number of solver iterations.
+    void SetIterationLimits(int min_iters, int max_iters);
+
+    /// Set the ratio of wall-clock time to simulated time (default: 1, real time).
+    /// Larger values give the simulation more time, e.g. on a slow machine.
+    void SetRealtimeFactor(double factor) { m_factor = factor; }
+
+    /// Set the safety margin, as a fraction of the frame budget (default: 0.1).
+    void SetMargin(double margin) { m_margin = margin; }
+
+    /// Enable or disable skipping the collision detection when a step does not fit
+    /// in the budget (default: enabled), and set the maximum number of consecutive
+    /// steps without collision detection (default: 2).
+    void SetCollisionSkipping(bool val, int max_consecutive = 2);
+
+    /// Enable or disable pacing to real time (default: enabled).
+    /// If disabled, Advance() returns as soon as the frame is computed; the
+    /// budgets are still enforced.
+    void SetPacing(bool val) { m_pacing = val; }
+
+    /// Restart the real-time clock and clear the statistics.
+    /// Advance() does this on its first call.
+    void Reset();
+
+    /// Advance the vehicle system by the specified step (one frame).
+    void Advance(double step);
+
+    /// Get the number of frames since the last reset.
+    int GetNumFrames() const { return m_num_frames; }
+
+    /// Get the number of frames that exceeded their budget.
+    int GetNumOverruns() const { return m_num_overruns; }
+
+    /// Get the number of integration steps done without collision detection.
+    int GetNumSkippedCollisions() const { return m_num_skipped; }
+
+    /// Get the number of times the simulation fell behind real time by more than
+    /// one frame; the real-time clock is then moved forward instead of catching up.
+    int GetNumResyncs() const { return m_num_resyncs; }
+
+    /// Get the average number of solver iterations per step.
+    double GetAverageIterations() const;
+
+    /// Get the maximum frame latency (wall-clock time spent in Advance, without sleeping).
+    double GetMaxLatency() const { return m_max_latency; }
+
+    /// Get the average frame latency.
+    double GetAverageLatency() const;
+
+    /// Get the specified percentile (in [0, 100]) of the frame latency.
+    /// The latencies are binned with a relative resolution of 1%.
+    double GetLatencyPercentile(double percentile) const;
+
+  private:
+    /// Index of the latency histogram bin for the given time.
+    static int LatencyBin(double time);
+
+    /// Upper bound of the given latency histogram bin.
+    static double LatencyBinBound(int bin);
+
+    /// Update the step cost estimates from the system timers.
+    void UpdateEstimates(int iters, bool collision);
+
+    ChVehicle* m_vehicle;
+    ChSystem* m_system;
+
+    int m_min_iters;      ///< lower limit for the solver iterations
+    int m_max_iters;      ///< upper limit for the solver iterations
+    double m_factor;      ///< ratio of wall-clock time to simulated time
+    double m_margin;      ///< safety margin, as a fraction of the frame budget
+    bool m_skip_allowed;  ///< skip the collision detection if a step does not fit
+    int m_max_skipped;    ///< maximum number of consecutive steps without collision detection
+    bool m_pacing;        ///< sleep to keep the pace of real time
+
+    // Cost estimates (wall-clock seconds). They follow increases immediately
+    // and decrease slowly.
+    double m_cost_fixed;      ///< cost of a step, excluding the solver and the collision detection
+    double m_cost_iter;       ///< cost of one solver iteration
+    double m_cost_collision;  ///< cost of the collision detection
+    double m_cost_other;      ///< cost of the rest of the simulation loop, per frame
+
+    ChTimer<double> m_clock;  ///< real-time clock, started at the first frame
+    double m_sim_time;        ///< scaled simulated time since the clock was started
+    double m_frame_end;       ///< clock time at the end of the previous frame
+    int m_consecutive_skipped;
+
+    // Statistics
+    int m_num_frames;
+    int m_num_overruns;
+    int m_num_skipped;
+    int m_num_resyncs;
+    int m_num_steps;
+    double m_total_iters;
+    double m_total_latency;
+    double m_max_latency;
+    std::vector<int> m_histogram;  ///< frame latency histogram
+};
+
+/// @} vehicle_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -51,25 +51,59 @@ bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
 
     // Find the lowest point on the disc. There is no contact if the disc is
     // (almost) horizontal.
+    ChVector<> ptD;
+    if (!disc_lowest_point(disc_center, disc_normal, disc_radius, ptD))
+        return false;
+
+    // Find terrain height at lowest point. No contact if lowest point is above
+    // the terrain.
+    double hp = terrain.GetHeight(ptD.x, ptD.y);
+
+    if (ptD.z > hp)
+        return false;
+
+    ChVector<> normal = terrain.GetNormal(ptD.x, ptD.y);
+
+    return disc_terrain_contact(disc_center, disc_normal, disc_radius, ptD, hc, hp, normal, contact, depth);
+}
+
+bool ChTire::disc_lowest_point(const ChVector<>& disc_center,
+                               const ChVector<>& disc_normal,
+                               double disc_radius,
+                               ChVector<>& point) {
     ChVector<> dir1 = Vcross(disc_normal, ChVector<>(0, 0, 1));
     double sinTilt2 = dir1.Length2();
 
     if (sinTilt2 < 1e-3)
         return false;
 
-    // Contact point (lowest point on disc).
-    ChVector<> ptD = disc_center + disc_radius * Vcross(disc_normal, dir1 / sqrt(sinTilt2));
+    point = disc_center + disc_radius * Vcross(disc_normal, dir1 / sqrt(sinTilt2));
+    return true;
+}
+
+bool ChTire::disc_terrain_contact(const ChVector<>& disc_center,
+                                  const ChVector<>& disc_normal,
+                                  double disc_radius,
+                                  const ChVector<>& lowest_point,
+                                  double height_center,
+                                  double height_point,
+                                  const ChVector<>& terrain_normal,
+                                  ChCoordsys<>& contact,
+                                  double& depth) {
+    if (disc_center.z <= height_center || disc_center.z >= height_center + disc_radius)
+        return false;
 
-    // Find terrain height at lowest point. No contact if lowest point is above
-    // the terrain.
-    double hp = terrain.GetHeight(ptD.x, ptD.y);
+    // Contact point (lowest point on disc). No contact if lowest point is
+    // above the terrain.
+    const ChVector<>& ptD = lowest_point;
+    double hp = height_point;
 
     if (ptD.z > hp)
         return false;
 
     // Approximate the terrain with a plane. Define the projection of the lowest
     // point onto this plane as the contact point on the terrain.
-    ChVector<> normal = terrain.GetNormal(ptD.x, ptD.y);
+    const ChVector<>& normal = terrain_normal;
     ChVector<> longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
@@ -85,5 +119,23 @@ bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
     return true;
 }
 
+// -----------------------------------------------------------------------------
+// Update a tire that uses contact discs, one disc at a time. ChTireBatch does
+// the same for many tires, with the terrain queries of all discs grouped.
+// -----------------------------------------------------------------------------
+void ChTire::UpdateDiscs(double time,
+                         const WheelState& wheel_state,
+                         const ChTerrain& terrain,
+                         ContactDisc* discs,
+                         DiscContact* contacts) {
+    CalculateContactDiscs(wheel_state, discs);
+    for (int id = 0; id < GetNumContactDiscs(); id++) {
+        contacts[id].in_contact = disc_terrain_contact(terrain, discs[id].center, discs[id].normal, discs[id].radius,
+                                                       contacts[id].frame, contacts[id].depth);
+    }
+
+    UpdateContacts(time, wheel_state, contacts);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
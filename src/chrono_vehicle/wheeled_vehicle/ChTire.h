@@ -40,6 +40,8 @@
 namespace chrono {
 namespace vehicle {
 
+class ChTireBatch;
+
 /// @addtogroup vehicle_wheeled_tire
 /// @{
 
@@ -77,7 +79,45 @@ class CH_VEHICLE_API ChTire {
     /// force one the wheel body.
     virtual TireForce GetTireForce() const = 0;
 
+    /// Get the number of discs used by this tire for contact with the terrain.
+    /// Tires that use discs (e.g. ChLugreTire, ChFialaTire) can be evaluated
+    /// in batches with ChTireBatch. The default is 0: the tire does its own
+    /// contact detection in Update().
+    virtual int GetNumContactDiscs() const { return 0; }
+
   protected:
+    /// Geometry of a disc used for contact with the terrain.
+    struct ContactDisc {
+        ChVector<> center;  ///< global location of the disc center
+        ChVector<> normal;  ///< disc normal, expressed in the global frame
+        double radius;      ///< disc radius
+    };
+
+    /// Result of the contact between a disc and the terrain.
+    struct DiscContact {
+        bool in_contact;     ///< true if the disc contacts the terrain
+        ChCoordsys<> frame;  ///< contact frame (x: long, y: lat, z: normal)
+        double depth;        ///< penetration depth (positive if in contact)
+    };
+
+    /// Calculate the contact discs of this tire for the given wheel state.
+    /// The array 'discs' has GetNumContactDiscs() elements.
+    virtual void CalculateContactDiscs(const WheelState& wheel_state, ContactDisc* discs) const {}
+
+    /// Update the state of this tire from the contacts of its discs with the
+    /// terrain, given in the order of CalculateContactDiscs().
+    virtual void UpdateContacts(double time, const WheelState& wheel_state, const DiscContact* contacts) {}
+
+    /// Update a tire that uses contact discs: calculate the discs, check each
+    /// of them for contact with the terrain, and call UpdateContacts(). The
+    /// arrays 'discs' and 'contacts' (GetNumContactDiscs() elements) are
+    /// provided by the caller.
+    void UpdateDiscs(double time,
+                     const WheelState& wheel_state,
+                     const ChTerrain& terrain,
+                     ContactDisc* discs,
+                     DiscContact* contacts);
+
     /// Perform disc-terrain collision detection.
     /// This utility function checks for contact between a disc of specified
     /// radius with given position and orientation (specified as the location of
@@ -96,7 +136,33 @@ class CH_VEHICLE_API ChTire {
         double& depth                   ///< [out] penetration depth (positive if contact occurred)
         );
 
+    /// Find the lowest point on a disc (its contact point with a horizontal
+    /// plane). Return false if the disc is (almost) horizontal.
+    static bool disc_lowest_point(const ChVector<>& disc_center,  ///< [in] global location of the disc center
+                                  const ChVector<>& disc_normal,  ///< [in] disc normal, in the global frame
+                                  double disc_radius,             ///< [in] disc radius
+                                  ChVector<>& point               ///< [out] lowest point on the disc
+                                  );
+
+    /// Disc-terrain collision detection with the terrain data already known:
+    /// the terrain height below the disc center, and the terrain height and
+    /// normal below the lowest point on the disc.
+    /// This gives the same result as the version that queries the terrain.
+    static bool disc_terrain_contact(
+        const ChVector<>& disc_center,     ///< [in] global location of the disc center
+        const ChVector<>& disc_normal,     ///< [in] disc normal, expressed in the global frame
+        double disc_radius,                ///< [in] disc radius
+        const ChVector<>& lowest_point,    ///< [in] lowest point on the disc (see disc_lowest_point())
+        double height_center,              ///< [in] terrain height below the disc center
+        double height_point,               ///< [in] terrain height below the lowest point
+        const ChVector<>& terrain_normal,  ///< [in] terrain normal below the lowest point
+        ChCoordsys<>& contact,             ///< [out] contact coordinate system (relative to the global frame)
+        double& depth                      ///< [out] penetration depth (positive if contact occurred)
+        );
+
     std::string m_name;  ///< name of this tire subsystem
+
+    friend class ChTireBatch;
 };
 
 /// @} vehicle_wheeled_tire
@@ -65,7 +65,23 @@ void ChFialaTire::Initialize() {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void ChFialaTire::Update(double time, const WheelState& wheel_state, const ChTerrain& terrain) {
-    ChCoordsys<> contact_frame;
+    UpdateDiscs(time, wheel_state, terrain, &m_disc, &m_contact);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChFialaTire::CalculateContactDiscs(const WheelState& wheel_state, ContactDisc* discs) const {
+    // Assuming the tire is a disc at the wheel center, with the wheel normal
+    // (expressed in global frame)
+    ChMatrix33<> A(wheel_state.rot);
+    discs[0].center = wheel_state.pos;
+    discs[0].normal = A.Get_A_Yaxis();
+    discs[0].radius = m_unloaded_radius;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChFialaTire::UpdateContacts(double time, const WheelState& wheel_state, const DiscContact* contacts) {
     // Clear the force accumulators and set the application point to the wheel
     // center.
     m_tireforce.force = ChVector<>(0, 0, 0);
@@ -76,10 +92,11 @@ void ChFialaTire::Update(double time, const WheelState& wheel_state, const ChTer
     ChMatrix33<> A(wheel_state.rot);
     ChVector<> disc_normal = A.Get_A_Yaxis();
 
-    // Assuuming the tire is a disc, check contact with terrain
-    m_data.in_contact =
-        disc_terrain_contact(terrain, wheel_state.pos, disc_normal, m_unloaded_radius, m_data.frame, m_data.depth);
+    m_data.in_contact = contacts[0].in_contact;
     if (m_data.in_contact) {
+        m_data.frame = contacts[0].frame;
+        m_data.depth = contacts[0].depth;
+
         // Wheel velocity in the ISO-C Frame
         ChVector<> vel = wheel_state.lin_vel;
         m_data.vel = m_data.frame.TransformDirectionParentToLocal(vel);
@@ -64,6 +64,9 @@ class CH_VEHICLE_API ChFialaTire : public ChTire {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) override;
 
+    /// Get the number of discs used for contact with the terrain (one).
+    virtual int GetNumContactDiscs() const override { return 1; }
+
     /// Set the value of the integration step size for the underlying dynamics.
     void SetStepsize(double val) { m_stepsize = val; }
 
@@ -89,6 +92,12 @@ class CH_VEHICLE_API ChFialaTire : public ChTire {
     /// Set the parameters in the Fiala model.
     virtual void SetFialaParams() = 0;
 
+    /// Calculate the disc of this tire for the given wheel state.
+    virtual void CalculateContactDiscs(const WheelState& wheel_state, ContactDisc* discs) const override;
+
+    /// Update the tire from the contact of its disc with the terrain.
+    virtual void UpdateContacts(double time, const WheelState& wheel_state, const DiscContact* contacts) override;
+
     /// Fiala tire model parameters
     double m_unloaded_radius;
     double m_width;
@@ -124,6 +133,9 @@ class CH_VEHICLE_API ChFialaTire : public ChTire {
     ContactData m_data;
     TireStates m_states;
 
+    ContactDisc m_disc;      // disc geometry (used by Update)
+    DiscContact m_contact;  // disc-terrain contact (used by Update)
+
     TireForce m_tireforce;
 };
 
@@ -46,6 +46,8 @@ ChLugreTire::ChLugreTire(const std::string& name) : ChTire(name), m_stepsize(1e-
 void ChLugreTire::Initialize() {
     m_data.resize(getNumDiscs());
     m_state.resize(getNumDiscs());
+    m_discs.resize(getNumDiscs());
+    m_contacts.resize(getNumDiscs());
 
     SetLugreParams();
 
@@ -81,33 +83,46 @@ void ChLugreTire::Initialize(std::shared_ptr<ChBody> wheel) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void ChLugreTire::Update(double time, const WheelState& wheel_state, const ChTerrain& terrain) {
+    UpdateDiscs(time, wheel_state, terrain, m_discs.data(), m_contacts.data());
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChLugreTire::CalculateContactDiscs(const WheelState& wheel_state, ContactDisc* discs) const {
     double disc_radius = getRadius();
     const double* disc_locs = getDiscLocations();
 
+    // Extract the wheel normal (expressed in global frame)
+    ChMatrix33<> A(wheel_state.rot);
+    ChVector<> disc_normal = A.Get_A_Yaxis();
+
+    for (int id = 0; id < getNumDiscs(); id++) {
+        // Calculate center of disk (expressed in global frame)
+        discs[id].center = wheel_state.pos + disc_locs[id] * disc_normal;
+        discs[id].normal = disc_normal;
+        discs[id].radius = disc_radius;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+void ChLugreTire::UpdateContacts(double time, const WheelState& wheel_state, const DiscContact* contacts) {
     // Clear the force accumulators and set the application point to the wheel
     // center.
     m_tireForce.force = ChVector<>(0, 0, 0);
     m_tireForce.moment = ChVector<>(0, 0, 0);
     m_tireForce.point = wheel_state.pos;
 
-    // Extract the wheel normal (expressed in global frame)
-    ChMatrix33<> A(wheel_state.rot);
-    ChVector<> disc_normal = A.Get_A_Yaxis();
-
-    // Loop over all discs, check contact with terrain, accumulate normal tire
+    // Loop over all discs in contact with the terrain, accumulate normal tire
     // forces, and cache data that only depends on wheel state.
-    double depth;
-
     for (int id = 0; id < getNumDiscs(); id++) {
-        // Calculate center of disk (expressed in global frame)
-        ChVector<> disc_center = wheel_state.pos + disc_locs[id] * disc_normal;
-
-        // Check contact with terrain and calculate contact points.
-        m_data[id].in_contact =
-            disc_terrain_contact(terrain, disc_center, disc_normal, disc_radius, m_data[id].frame, depth);
+        m_data[id].in_contact = contacts[id].in_contact;
         if (!m_data[id].in_contact)
             continue;
 
+        m_data[id].frame = contacts[id].frame;
+        double depth = contacts[id].depth;
+
         // Relative velocity at contact point (expressed in the global frame and in
         // the contact frame)
         ChVector<> vel = wheel_state.lin_vel + Vcross(wheel_state.ang_vel, m_data[id].frame.pos - wheel_state.pos);
@@ -64,6 +64,9 @@ class CH_VEHICLE_API ChLugreTire : public ChTire {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) override;
 
+    /// Get the number of discs used for contact with the terrain.
+    virtual int GetNumContactDiscs() const override { return getNumDiscs(); }
+
     /// Set the value of the integration step size for the underlying dynamics.
     void SetStepsize(double val) { m_stepsize = val; }
 
@@ -89,6 +92,12 @@ class CH_VEHICLE_API ChLugreTire : public ChTire {
     /// Set the parameters in the LuGre friction model.
     virtual void SetLugreParams() = 0;
 
+    /// Calculate the discs of this tire for the given wheel state.
+    virtual void CalculateContactDiscs(const WheelState& wheel_state, ContactDisc* discs) const override;
+
+    /// Update the tire from the contacts of its discs with the terrain.
+    virtual void UpdateContacts(double time, const WheelState& wheel_state, const DiscContact* contacts) override;
+
     /// Lugre friction model parameters (longitudinal/lateral)
     double m_sigma0[2];  ///<
     double m_sigma1[2];  ///<
@@ -117,6 +126,9 @@ class CH_VEHICLE_API ChLugreTire : public ChTire {
     TireForce m_tireForce;
     std::vector<DiscContactData> m_data;
     std::vector<DiscState> m_state;
+
+    std::vector<ContactDisc> m_discs;     // disc geometry (used by Update)
+    std::vector<DiscContact> m_contacts;  // disc-terrain contacts (used by Update)
 };
 
 /// @} vehicle_wheeled_tire
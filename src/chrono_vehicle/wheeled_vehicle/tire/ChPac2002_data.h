@@ -2,6 +2,7 @@
 #define CHPAC2002_DATA_H
 
 #include <string>
+#include <vector>
 
 namespace chrono {
 namespace vehicle {
@@ -365,6 +366,22 @@ struct bessel {
     double v_sigma;
 };
 
+// -----------
+// lookup tables of the Magic Formula reactions, over (kappaP, alphaP, gammaP, Fz)
+// the slip axes are uniform in s, with slip = c_slip * sinh(s), so that the
+// nodes are dense around zero slip, where the reactions vary the most
+
+struct PacTables {
+    int n[4];       // number of nodes along each axis (kappaP, alphaP, gammaP, Fz)
+    double x0[4];   // first node along each axis (s for the slip axes)
+    double x1[4];   // last node along each axis
+    double dx[4];   // node spacing along each axis
+    double c_slip;  // scale of the slip axes
+
+    std::vector<float> values;  // reactions at the nodes, kappaP varies fastest, then alphaP, gammaP, Fz
+    double error;               // max. interpolation error (at the cell centers), relative to the peak values
+};
+
 }  // end namespace vehicle
 }  // end namespace chrono
 
@@ -16,6 +16,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
@@ -49,6 +50,27 @@ static double gammaP_thresh = 0.05;
 static double phiP_thresh = 99;
 static double phiT_thresh = 99;
 
+// Lookup tables: reactions stored at each node. The aligning moments are
+// evaluated with cosPrime_alpha = 1 and V_cx > 0, and scaled when interpolated.
+enum TableValue {
+    TBL_FX_PURE,     // Fx, pure slip
+    TBL_FY_PURE,     // Fy, pure slip (for the side of the parameter file)
+    TBL_MZ_PURE,     // Mz, pure slip
+    TBL_D_Y,         // peak lateral force D_y
+    TBL_FX_COMB,     // Fx, combined slip
+    TBL_FY_COMB,     // Fy, combined slip
+    TBL_MZR_COMB,    // residual torque M_zr, combined slip
+    TBL_MZY_COMB,    // Mz due to Fy, combined slip
+    TBL_MZX_COMB,    // Mz due to Fx, combined slip
+    TBL_ALPHA_R,     // alpha_r
+    TBL_ALPHA_R_EQ,  // |alpha_r_eq|
+    TBL_NUM_VALUES = 12  // padded, so that the interpolation loops vectorize
+};
+
+static const double table_slip_scale = 0.1;  // nodes are dense for |slip| < scale
+static const int table_initial_nodes[4] = {17, 17, 3, 5};
+static const size_t table_max_nodes = 250000;  // about 12 MB
+
 // -----------------------------------------------------------------------------
 // Constructors
 // -----------------------------------------------------------------------------
@@ -58,7 +80,13 @@ ChPacejkaTire::ChPacejkaTire(const std::string& name, const std::string& pacTire
       m_params_defined(false),
       m_use_transient_slip(true),
       m_use_Fz_override(false),
-      m_step_size(default_step_size) {
+      m_step_size(default_step_size),
+      m_use_tables(false),
+      m_table_tolerance(0.04),
+      m_table_max_slip(0.5),
+      m_table_max_camber(0.1),
+      m_num_table_misses(0),
+      m_tables(NULL) {
 }
 
 ChPacejkaTire::ChPacejkaTire(const std::string& name,
@@ -71,7 +99,13 @@ ChPacejkaTire::ChPacejkaTire(const std::string& name,
       m_use_transient_slip(use_transient_slip),
       m_use_Fz_override(Fz_override > 0),
       m_Fz_override(Fz_override),
-      m_step_size(default_step_size) {
+      m_step_size(default_step_size),
+      m_use_tables(false),
+      m_table_tolerance(0.04),
+      m_table_max_slip(0.5),
+      m_table_max_camber(0.1),
+      m_num_table_misses(0),
+      m_tables(NULL) {
 }
 
 // -----------------------------------------------------------------------------
@@ -91,6 +125,7 @@ ChPacejkaTire::~ChPacejkaTire() {
     delete m_zeta;
     delete m_relaxation;
     delete m_bessel;
+    delete m_tables;
 }
 
 // -----------------------------------------------------------------------------
@@ -155,15 +190,22 @@ void ChPacejkaTire::Initialize(VehicleSide side, bool driven) {
     double rho = (m_R0 - m_R_l) * exp(-qV1 * m_R0 * pow(1.05 * m_params->model.longvl / m_params->model.longvl, 2));
     m_R_eff = m_R0 - rho;
 
-    m_Fz = 0;
-    m_dF_z = 0;
-
     // spin slip coefficients,  unused for now
     {
         zetaCoefs tmp = {1, 1, 1, 1, 1, 1, 1, 1, 1};
         *m_zeta = tmp;
     }
 
+    // lookup tables of the reactions
+    if (m_use_tables) {
+        delete m_tables;
+        m_tables = new PacTables;
+        build_tables();
+    }
+
+    m_Fz = 0;
+    m_dF_z = 0;
+
     m_combinedTorque->alpha_r_eq = 0.0;
     m_pureLat->D_y = m_params->vertical.fnomin;  // initial approximation
     m_C_Fx = 161000;                             // calibrated, sigma_kappa = sigma_kappa_ref = 1.29
@@ -336,11 +378,14 @@ void ChPacejkaTire::Advance(double step) {
         slip_kinematic();
     }
 
-    // Calculate the force and moment reaction, pure slip case
-    pureSlipReactions();
+    // Interpolate the reactions from the lookup tables, if possible
+    if (!tableReactions()) {
+        // Calculate the force and moment reaction, pure slip case
+        pureSlipReactions();
 
-    // Update m_FM_combined.forces, m_FM_combined.moment.z
-    combinedSlipReactions();
+        // Update m_FM_combined.forces, m_FM_combined.moment.z
+        combinedSlipReactions();
+    }
 
     // Update M_x, apply to both m_FM and m_FM_combined
     // gamma should already be corrected for L/R side, so need to swap Fy if on opposite side
@@ -1277,6 +1322,289 @@ double ChPacejkaTire::calc_My(double Fx_combined) {
     return M_y;
 }
 
+// -----------------------------------------------------------------------------
+// Lookup tables of the Magic Formula reactions.
+//
+// The reactions are tabulated over (kappaP, alphaP, gammaP, Fz) and evaluated
+// with multilinear interpolation. The pure slip reactions are stored on the 4-D
+// grid too, so that a single interpolation gives all reactions. The values of
+// each node are contiguous (and padded), so that the loops over the values
+// vectorize.
+// -----------------------------------------------------------------------------
+
+// Input corresponding to the (fractional) node index x along the given axis.
+// The slip axes are uniform in s = asinh(slip / c_slip), the others are uniform.
+static double table_input(const PacTables& tbl, int axis, double x) {
+    double u = tbl.x0[axis] + x * tbl.dx[axis];
+    return (axis < 2) ? tbl.c_slip * std::sinh(u) : u;
+}
+
+// (Fractional) node index of the given input along the given axis.
+static double table_coord(const PacTables& tbl, int axis, double input) {
+    double u = (axis < 2) ? std::asinh(input / tbl.c_slip) : input;
+    return (u - tbl.x0[axis]) / tbl.dx[axis];
+}
+
+// Outputs checked for the table error: Fx, Fy, Mz (pure and combined slip), at
+// cosPrime_alpha = 1 and V_cx > 0
+static void table_outputs(const double* values, double* out) {
+    out[0] = values[TBL_FX_PURE];
+    out[1] = values[TBL_FY_PURE];
+    out[2] = values[TBL_MZ_PURE];
+    out[3] = values[TBL_FX_COMB];
+    out[4] = values[TBL_FY_COMB];
+    out[5] = values[TBL_MZR_COMB] + values[TBL_MZY_COMB] + values[TBL_MZX_COMB];
+}
+
+// Calculate the tables, refining the axis with the largest interpolation error
+// until the tolerance is met or the tables reach their maximum size.
+void ChPacejkaTire::build_tables() {
+    PacTables& tbl = *m_tables;
+
+    // Table ranges: the valid ranges of the parameter file, limited to the
+    // specified max. slip and camber. alphaP is tan(alpha).
+    double alpha_min = m_params->slip_angle_range.alpmin;
+    double alpha_max = m_params->slip_angle_range.alpmax;
+    double range[4][2] = {
+        {std::max(m_params->long_slip_range.kpumin, -m_table_max_slip),
+         std::min(m_params->long_slip_range.kpumax, m_table_max_slip)},
+        {(alpha_min > -CH_C_PI_2) ? std::max(std::tan(alpha_min), -m_table_max_slip) : -m_table_max_slip,
+         (alpha_max < CH_C_PI_2) ? std::min(std::tan(alpha_max), m_table_max_slip) : m_table_max_slip},
+        {std::max(m_params->inclination_angle_range.cammin, -m_table_max_camber),
+         std::min(m_params->inclination_angle_range.cammax, m_table_max_camber)},
+        {m_params->vertical_force_range.fzmin, m_params->vertical_force_range.fzmax}};
+
+    tbl.c_slip = table_slip_scale;
+    for (int d = 0; d < 4; d++) {
+        tbl.n[d] = table_initial_nodes[d];
+        tbl.x0[d] = (d < 2) ? std::asinh(range[d][0] / tbl.c_slip) : range[d][0];
+        tbl.x1[d] = (d < 2) ? std::asinh(range[d][1] / tbl.c_slip) : range[d][1];
+    }
+
+    while (true) {
+        fill_tables();
+        tbl.error = table_error(-1);
+        if (tbl.error <= m_table_tolerance)
+            break;
+
+        int axis = 0;
+        double axis_error = -1;
+        for (int d = 0; d < 4; d++) {
+            double error = table_error(d);
+            if (error > axis_error) {
+                axis = d;
+                axis_error = error;
+            }
+        }
+
+        size_t num_nodes = tbl.values.size() / TBL_NUM_VALUES;
+        if (num_nodes / tbl.n[axis] * (2 * tbl.n[axis] - 1) > table_max_nodes)
+            break;
+        tbl.n[axis] = 2 * tbl.n[axis] - 1;
+    }
+
+    GetLog() << " tire " << m_name << ": lookup tables with " << tbl.n[0] << " x " << tbl.n[1] << " x " << tbl.n[2]
+             << " x " << tbl.n[3] << " nodes (kappa, alpha, gamma, Fz), max. error " << 100 * tbl.error
+             << " % of the peak reactions\n";
+    if (tbl.error > m_table_tolerance)
+        GetLog() << " tire " << m_name << ": lookup table tolerance not met\n";
+}
+
+void ChPacejkaTire::fill_tables() {
+    PacTables& tbl = *m_tables;
+
+    size_t num_nodes = 1;
+    for (int d = 0; d < 4; d++) {
+        tbl.dx[d] = (tbl.x1[d] - tbl.x0[d]) / (tbl.n[d] - 1);
+        num_nodes *= tbl.n[d];
+    }
+    tbl.values.resize(num_nodes * TBL_NUM_VALUES);
+
+    double inputs[4];
+    double values[TBL_NUM_VALUES];
+    for (size_t node = 0; node < num_nodes; node++) {
+        size_t k = node;
+        for (int d = 0; d < 4; d++) {
+            inputs[d] = table_input(tbl, d, (double)(k % tbl.n[d]));
+            k /= tbl.n[d];
+        }
+        table_values(inputs, values);
+        for (int iv = 0; iv < TBL_NUM_VALUES; iv++)
+            tbl.values[node * TBL_NUM_VALUES + iv] = (float)values[iv];
+    }
+}
+
+void ChPacejkaTire::table_values(const double* inputs, double* values) {
+    double kappa = inputs[0];
+    double alpha = inputs[1];
+    double gamma = inputs[2];
+
+    m_Fz = inputs[3];
+    m_dF_z = (m_Fz - m_params->vertical.fnomin) / m_params->vertical.fnomin;
+    m_slip->V_cx = 1;
+    m_slip->cosPrime_alpha = 1;
+
+    // same sequence as in pureSlipReactions() and combinedSlipReactions()
+    double Fx = Fx_pureLong(gamma, kappa);
+    double Fy = Fy_pureLat(alpha, gamma);
+    double Mz = Mz_pureLat(alpha, gamma, Fy);
+    double Fx_c = Fx_combined(alpha, gamma, kappa, Fx);
+    double Fy_c = Fy_combined(alpha, gamma, kappa, Fy);
+    Mz_combined(m_pureTorque->alpha_r, m_pureTorque->alpha_t, gamma, kappa, Fx_c, Fy_c);
+
+    values[TBL_FX_PURE] = Fx;
+    values[TBL_FY_PURE] = Fy;
+    values[TBL_MZ_PURE] = Mz;
+    values[TBL_D_Y] = m_pureLat->D_y;
+    values[TBL_FX_COMB] = Fx_c;
+    values[TBL_FY_COMB] = Fy_c;
+    values[TBL_MZR_COMB] = m_combinedTorque->M_zr;
+    values[TBL_MZY_COMB] = m_combinedTorque->M_z_y;
+    values[TBL_MZX_COMB] = m_combinedTorque->M_z_x;
+    values[TBL_ALPHA_R] = m_pureTorque->alpha_r;
+    values[TBL_ALPHA_R_EQ] = std::abs(m_combinedTorque->alpha_r_eq);
+    for (int iv = TBL_ALPHA_R_EQ + 1; iv < TBL_NUM_VALUES; iv++)
+        values[iv] = 0;
+}
+
+// Compare the interpolated and calculated reactions halfway between the nodes,
+// where the interpolation error is largest for smooth functions: at the cell
+// centers (axis = -1), or halfway along the given axis only. The error of each
+// reaction is relative to its peak value over the nodes.
+double ChPacejkaTire::table_error(int axis) {
+    const PacTables& tbl = *m_tables;
+    double peak[6] = {0, 0, 0, 0, 0, 0};
+    double error[6] = {0, 0, 0, 0, 0, 0};
+    double inputs[4];
+    double values[TBL_NUM_VALUES];
+    double out[6];
+    double out_tbl[6];
+
+    size_t num_nodes = tbl.values.size() / TBL_NUM_VALUES;
+    for (size_t node = 0; node < num_nodes; node++) {
+        for (int iv = 0; iv < TBL_NUM_VALUES; iv++)
+            values[iv] = tbl.values[node * TBL_NUM_VALUES + iv];
+        table_outputs(values, out);
+        for (int io = 0; io < 6; io++)
+            peak[io] = std::max(peak[io], std::abs(out[io]));
+    }
+
+    int m[4];
+    double offset[4];
+    size_t num_points = 1;
+    for (int d = 0; d < 4; d++) {
+        bool halfway = (axis < 0 || axis == d);
+        m[d] = halfway ? tbl.n[d] - 1 : tbl.n[d];
+        offset[d] = halfway ? 0.5 : 0;
+        num_points *= m[d];
+    }
+
+    for (size_t point = 0; point < num_points; point++) {
+        size_t k = point;
+        for (int d = 0; d < 4; d++) {
+            inputs[d] = table_input(tbl, d, (k % m[d]) + offset[d]);
+            k /= m[d];
+        }
+        table_values(inputs, values);
+        table_outputs(values, out);
+        interpolate_tables(inputs, values);
+        table_outputs(values, out_tbl);
+        for (int io = 0; io < 6; io++)
+            error[io] = std::max(error[io], std::abs(out_tbl[io] - out[io]));
+    }
+
+    double max_error = 0;
+    for (int io = 0; io < 6; io++) {
+        if (peak[io] > 0)
+            max_error = std::max(max_error, error[io] / peak[io]);
+    }
+
+    return max_error;
+}
+
+bool ChPacejkaTire::interpolate_tables(const double* inputs, double* values) const {
+    const PacTables& tbl = *m_tables;
+
+    // Cell and weights along each axis
+    int i[4];
+    float w[4][2];
+    for (int d = 0; d < 4; d++) {
+        double x = table_coord(tbl, d, inputs[d]);
+        if (!(x > -1e-6 && x < tbl.n[d] - 1 + 1e-6))
+            return false;
+        i[d] = std::max(std::min((int)x, tbl.n[d] - 2), 0);
+        w[d][1] = (float)std::max(std::min(x - i[d], 1.0), 0.0);
+        w[d][0] = 1 - w[d][1];
+    }
+
+    // Weighted sum over the 16 corners of the cell
+    size_t stride[4];
+    stride[0] = TBL_NUM_VALUES;
+    for (int d = 1; d < 4; d++)
+        stride[d] = stride[d - 1] * tbl.n[d - 1];
+    const float* base = &tbl.values[i[0] * stride[0] + i[1] * stride[1] + i[2] * stride[2] + i[3] * stride[3]];
+
+    float sum[TBL_NUM_VALUES] = {0};
+    for (int c = 0; c < 16; c++) {
+        int b0 = c & 1, b1 = (c >> 1) & 1, b2 = (c >> 2) & 1, b3 = (c >> 3) & 1;
+        float wc = w[0][b0] * w[1][b1] * w[2][b2] * w[3][b3];
+        const float* node = base + b0 * stride[0] + b1 * stride[1] + b2 * stride[2] + b3 * stride[3];
+        for (int iv = 0; iv < TBL_NUM_VALUES; iv++)
+            sum[iv] += wc * node[iv];
+    }
+
+    for (int iv = 0; iv < TBL_NUM_VALUES; iv++)
+        values[iv] = sum[iv];
+
+    return true;
+}
+
+bool ChPacejkaTire::tableReactions() {
+    if (!m_tables)
+        return false;
+
+    // no reactions if not in contact, as in pureSlipReactions()
+    if (!m_in_contact)
+        return true;
+
+    double inputs[4] = {m_slip->kappaP, m_slip->alphaP, m_slip->gammaP, m_Fz};
+    double values[TBL_NUM_VALUES];
+    if (!interpolate_tables(inputs, values)) {
+        m_num_table_misses++;
+        return false;
+    }
+
+    // the aligning moments scale with cosPrime_alpha and the sign of V_cx
+    // (see Mz_pureLat() and Mz_combined())
+    double sign_Vx = (m_slip->V_cx >= 0) ? 1 : -1;
+    double cosPrime = m_slip->cosPrime_alpha;
+    double M_zr = cosPrime * cosPrime * sign_Vx * values[TBL_MZR_COMB];
+    double M_z_y = cosPrime * sign_Vx * values[TBL_MZY_COMB];
+    double M_z_x = values[TBL_MZX_COMB];
+
+    m_FM_pure.force.x = values[TBL_FX_PURE];
+    m_FM_pure.force.y = m_sameSide * values[TBL_FY_PURE];
+    m_FM_pure.moment.z = m_sameSide * cosPrime * sign_Vx * values[TBL_MZ_PURE];
+
+    m_FM_combined.force.x = values[TBL_FX_COMB];
+    m_FM_combined.force.y = m_sameSide * values[TBL_FY_COMB];
+    m_FM_combined.moment.z = m_sameSide * (M_zr + M_z_y + M_z_x);
+
+    // intermediate quantities used in the transient slip model and the output;
+    // the other coefficients are not updated
+    m_pureLat->D_y = values[TBL_D_Y];
+    m_combinedTorque->alpha_r_eq = (values[TBL_ALPHA_R] >= 0) ? values[TBL_ALPHA_R_EQ] : -values[TBL_ALPHA_R_EQ];
+    m_combinedTorque->M_zr = M_zr;
+    m_combinedTorque->M_z_y = M_z_y;
+    m_combinedTorque->M_z_x = M_z_x;
+
+    return true;
+}
+
+double ChPacejkaTire::get_table_error() const {
+    return m_tables ? m_tables->error : 0;
+}
+
 // -----------------------------------------------------------------------------
 // Load a PacTire specification file.
 //
@@ -47,6 +47,7 @@ struct combinedTorqueCoefs;
 struct zetaCoefs;
 struct relaxationL;
 struct bessel;
+struct PacTables;
 
 /// Concrete tire class that implements the Pacejka tire model.
 /// Detailed description goes here...
@@ -157,6 +158,32 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
     /// Get the current value of the integration step size.
     double GetStepsize() const { return m_step_size; }
 
+    /// Use lookup tables for the Magic Formula reactions (must be called before Initialize).
+    /// The tables are calculated in Initialize() over the valid ranges of the
+    /// parameter file, limited to |kappa| and |tan(alpha)| <= max_slip and
+    /// |gamma| <= max_camber (the Magic Formula can vary sharply near the limits
+    /// of the valid ranges). They are refined until their interpolation error,
+    /// relative to the peak values of the reactions, is below the specified
+    /// tolerance or they reach their maximum size. The error is reported in
+    /// Initialize() and by get_table_error(). Outside of the table ranges, the
+    /// Magic Formula is evaluated as usual.
+    /// The combined slip aligning moment has a jump at alpha_t = 0 when kappa is
+    /// not zero (the sign of alpha_t_eq), which the interpolation smooths over:
+    /// the tolerance cannot be much lower than a few percent.
+    void SetUseLookupTables(bool val, double tolerance = 0.04, double max_slip = 0.5, double max_camber = 0.1) {
+        m_use_tables = val;
+        m_table_tolerance = tolerance;
+        m_table_max_slip = max_slip;
+        m_table_max_camber = max_camber;
+    }
+
+    /// Get the estimated max. error of the lookup tables, relative to the peak
+    /// values of the reactions (0 if no tables are used).
+    double get_table_error() const;
+
+    /// Get the number of reaction evaluations outside of the lookup table ranges.
+    int get_num_table_misses() const { return m_num_table_misses; }
+
   private:
     // where to find the input parameter file
     const std::string& getPacTireParamFile() const { return m_paramFile; }
@@ -305,6 +332,28 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
                        double Fx_combined,
                        double Fy_combined);
 
+    /// calculate the lookup tables, refined until the tolerance is met
+    void build_tables();
+
+    /// evaluate the reactions at the nodes of the lookup tables
+    void fill_tables();
+
+    /// evaluate the reactions stored in the lookup tables, for the given
+    /// inputs (kappaP, alphaP, gammaP, Fz)
+    void table_values(const double* inputs, double* values);
+
+    /// estimate the max. interpolation error of the lookup tables, at the cell
+    /// centers (axis = -1) or halfway between the nodes along the given axis
+    double table_error(int axis);
+
+    /// interpolate the reactions from the lookup tables
+    /// return false if the inputs are outside of the table ranges
+    bool interpolate_tables(const double* inputs, double* values) const;
+
+    /// assign Fx, Fy, Mz (pure and combined slip) from the lookup tables
+    /// return false if the reactions must be calculated with the Magic Formula
+    bool tableReactions();
+
     /// calculate the overturning couple moment
     /// assign m_FM.moment.x and m_FM_combined.moment.x
     double calc_Mx(double gamma, double Fy_combined);
@@ -383,6 +432,14 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
     // for transient contact point tire model
     relaxationL* m_relaxation;
     bessel* m_bessel;
+
+    // lookup tables of the reactions
+    bool m_use_tables;
+    double m_table_tolerance;
+    double m_table_max_slip;
+    double m_table_max_camber;
+    int m_num_table_misses;
+    PacTables* m_tables;
 };
 
 // -----------------------------------------------------------------------------
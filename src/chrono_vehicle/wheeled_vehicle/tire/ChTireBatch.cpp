@@ -0,0 +1,167 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batched evaluation of many tires that use contact discs.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "chrono/parallel/ChOpenMP.h"
+
+#include "chrono_vehicle/wheeled_vehicle/tire/ChTireBatch.h"
+
+namespace chrono {
+namespace vehicle {
+
+ChTireBatch::ChTireBatch() : m_num_threads(CHOMPfunctions::GetNumProcs()) {
+    m_disc_start.push_back(0);
+}
+
+int ChTireBatch::AddTire(ChTire* tire) {
+    m_tires.push_back(tire);
+    m_disc_start.push_back(0);
+    return (int)m_tires.size() - 1;
+}
+
+// -----------------------------------------------------------------------------
+// The discs of all tires are processed in passes over arrays with one entry
+// per disc (geometry, lowest points, terrain queries, contact tests), then each
+// tire is updated from the contacts of its discs. This is what
+// ChTire::UpdateDiscs() does for a single tire, with the same results.
+// -----------------------------------------------------------------------------
+void ChTireBatch::Update(double time, const WheelStates& wheel_states, const ChTerrain& terrain) {
+    int num_tires = (int)m_tires.size();
+    assert(wheel_states.size() >= m_tires.size());
+
+    // Tires can be initialized after they are added to the batch, so their
+    // discs are counted at each update.
+    for (int i = 0; i < num_tires; i++)
+        m_disc_start[i + 1] = m_disc_start[i] + m_tires[i]->GetNumContactDiscs();
+
+    int num_discs = m_disc_start[num_tires];
+    m_discs.resize(num_discs);
+    m_contacts.resize(num_discs);
+    m_x.resize(2 * num_discs);
+    m_y.resize(2 * num_discs);
+    m_cz.resize(num_discs);
+    m_pz.resize(num_discs);
+    m_nx.resize(num_discs);
+    m_ny.resize(num_discs);
+    m_nz.resize(num_discs);
+    m_radius.resize(num_discs);
+    m_has_point.resize(num_discs);
+    m_in_contact.resize(num_discs);
+    m_heights.resize(2 * num_discs);
+    m_normals.resize(num_discs);
+
+    if (num_discs > 0) {
+        // Disc geometry.
+#pragma omp parallel for num_threads(m_num_threads)
+        for (int i = 0; i < num_tires; i++) {
+            if (!HasDiscs(i))
+                continue;
+            m_tires[i]->CalculateContactDiscs(wheel_states[i], &m_discs[m_disc_start[i]]);
+            for (int id = m_disc_start[i]; id < m_disc_start[i + 1]; id++) {
+                const ChTire::ContactDisc& disc = m_discs[id];
+                m_x[id] = disc.center.x;
+                m_y[id] = disc.center.y;
+                m_cz[id] = disc.center.z;
+                m_nx[id] = disc.normal.x;
+                m_ny[id] = disc.normal.y;
+                m_nz[id] = disc.normal.z;
+                m_radius[id] = disc.radius;
+            }
+        }
+
+        // Lowest points on the discs, as in ChTire::disc_lowest_point() (the
+        // operations are in the same order, so that the results are identical).
+        // The lowest point of a horizontal disc is not used.
+        const double* cx = m_x.data();
+        const double* cy = m_y.data();
+        double* px = m_x.data() + num_discs;
+        double* py = m_y.data() + num_discs;
+        for (int id = 0; id < num_discs; id++) {
+            double nx = m_nx[id];
+            double ny = m_ny[id];
+            double nz = m_nz[id];
+            double sinTilt2 = ny * ny + nx * nx;
+            double inv = 1.0 / std::sqrt(std::max(sinTilt2, 1e-3));
+            m_has_point[id] = sinTilt2 >= 1e-3;
+            px[id] = cx[id] + (nz * (nx * inv)) * m_radius[id];
+            py[id] = cy[id] + (nz * (ny * inv)) * m_radius[id];
+            m_pz[id] = m_cz[id] - (nx * (nx * inv) + ny * (ny * inv)) * m_radius[id];
+        }
+
+        // Terrain heights below the disc centers, and heights and normals below
+        // the lowest points.
+        terrain.GetHeightNormal(num_discs, m_x.data(), m_y.data(), m_heights.data(), NULL);
+        terrain.GetHeightNormal(num_discs, px, py, m_heights.data() + num_discs, m_normals.data());
+
+        // Contact tests, as in ChTire::disc_terrain_contact().
+        const double* hc = m_heights.data();
+        const double* hp = m_heights.data() + num_discs;
+        for (int id = 0; id < num_discs; id++) {
+            m_in_contact[id] = m_has_point[id] & (m_cz[id] > hc[id]) & (m_cz[id] < hc[id] + m_radius[id]) &
+                               (m_pz[id] <= hp[id]);
+        }
+    }
+
+    // Contact frames and tire updates.
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_tires; i++) {
+        if (!HasDiscs(i))
+            continue;
+        for (int id = m_disc_start[i]; id < m_disc_start[i + 1]; id++) {
+            ChTire::DiscContact& contact = m_contacts[id];
+            contact.in_contact = m_in_contact[id] != 0;
+            if (contact.in_contact) {
+                ChTire::disc_terrain_contact(m_discs[id].center, m_discs[id].normal, m_radius[id],
+                                             ChVector<>(m_x[num_discs + id], m_y[num_discs + id], m_pz[id]),
+                                             m_heights[id], m_heights[num_discs + id], m_normals[id], contact.frame,
+                                             contact.depth);
+            }
+        }
+        m_tires[i]->UpdateContacts(time, wheel_states[i], &m_contacts[m_disc_start[i]]);
+    }
+
+    // Tires that do their own contact detection.
+    for (int i = 0; i < num_tires; i++) {
+        if (!HasDiscs(i))
+            m_tires[i]->Update(time, wheel_states[i], terrain);
+    }
+}
+
+void ChTireBatch::Advance(double step) {
+    int num_tires = (int)m_tires.size();
+
+#pragma omp parallel for num_threads(m_num_threads)
+    for (int i = 0; i < num_tires; i++) {
+        if (HasDiscs(i))
+            m_tires[i]->Advance(step);
+    }
+
+    for (int i = 0; i < num_tires; i++) {
+        if (!HasDiscs(i))
+            m_tires[i]->Advance(step);
+    }
+}
+
+void ChTireBatch::GetTireForces(int first, TireForces& tire_forces) const {
+    for (size_t i = 0; i < tire_forces.size(); i++)
+        tire_forces[i] = m_tires[first + i]->GetTireForce();
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
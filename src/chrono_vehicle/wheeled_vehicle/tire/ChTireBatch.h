@@ -0,0 +1,118 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batched evaluation of many tires (e.g. the tires of all vehicles in a
+// simulation) that use contact discs.
+//
+// =============================================================================
+
+#ifndef CH_TIRE_BATCH_H
+#define CH_TIRE_BATCH_H
+
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChSubsysDefs.h"
+#include "chrono_vehicle/ChTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/ChTire.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_tire
+/// @{
+
+/// Batched evaluation of a set of tires.
+/// This gives the same results as calling Update() and Advance() for each
+/// tire, but for the tires that use contact discs (GetNumContactDiscs() > 0,
+/// e.g. ChLugreTire and ChFialaTire) the work is grouped:
+///  - the discs of all tires are gathered in arrays with one entry per disc
+///    (structure of arrays);
+///  - the lowest points of the discs and the contact tests are computed in
+///    loops over all discs, which the compiler can vectorize;
+///  - the terrain is queried once for all discs (ChTerrain::GetHeightNormal);
+///  - the contact frames and the tire updates and advances are done in
+///    parallel over the tires.
+/// The tire force laws are those of the tire classes, evaluated one tire at a
+/// time. Other tires are updated and advanced one after the other, as usual.
+class CH_VEHICLE_API ChTireBatch {
+  public:
+    ChTireBatch();
+    ~ChTireBatch() {}
+
+    /// Add a tire to the batch and return its index in the batch.
+    /// The tire is not owned by the batch; it must be initialized before the
+    /// first call to Update().
+    int AddTire(ChTire* tire);
+
+    /// Get the number of tires in the batch.
+    int GetNumTires() const { return (int)m_tires.size(); }
+
+    /// Get the specified tire.
+    ChTire* GetTire(int i) const { return m_tires[i]; }
+
+    /// Set the number of threads used for the batch (default: number of processors).
+    void SetNumThreads(int num_threads) { m_num_threads = num_threads; }
+
+    /// Get the number of threads used for the batch.
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Update the state of all tires at the current time.
+    void Update(double time,                      ///< [in] current time
+                const WheelStates& wheel_states,  ///< [in] state of the wheel of each tire, in the order of the tires
+                const ChTerrain& terrain          ///< [in] reference to the terrain system
+                );
+
+    /// Advance the state of all tires by the specified time step.
+    void Advance(double step);
+
+    /// Get the force and moment of the specified tire.
+    TireForce GetTireForce(int i) const { return m_tires[i]->GetTireForce(); }
+
+    /// Get the forces and moments of consecutive tires, starting with the tire
+    /// with index 'first' (e.g. the tires of one vehicle, to be passed to
+    /// ChWheeledVehicle::Update()). The size of 'tire_forces' gives the number
+    /// of tires.
+    void GetTireForces(int first, TireForces& tire_forces) const;
+
+  private:
+    /// Return true if the specified tire uses contact discs.
+    bool HasDiscs(int i) const { return m_disc_start[i + 1] > m_disc_start[i]; }
+
+    std::vector<ChTire*> m_tires;
+    int m_num_threads;
+
+    std::vector<int> m_disc_start;  ///< index of the first disc of each tire (one more entry for the end)
+
+    // Data for the discs of all tires, one entry per disc
+    std::vector<ChTire::ContactDisc> m_discs;     ///< disc geometry, as given by the tires
+    std::vector<ChTire::DiscContact> m_contacts;  ///< disc-terrain contacts
+    std::vector<double> m_x;                      ///< terrain query locations
+    std::vector<double> m_y;                      ///<   (disc centers, then lowest points)
+    std::vector<double> m_cz;                     ///< height of the disc centers
+    std::vector<double> m_pz;                     ///< height of the lowest points
+    std::vector<double> m_nx;                     ///< disc normals
+    std::vector<double> m_ny;                     ///<
+    std::vector<double> m_nz;                     ///<
+    std::vector<double> m_radius;                 ///< disc radii
+    std::vector<char> m_has_point;                ///< false if the disc is (almost) horizontal
+    std::vector<char> m_in_contact;               ///< true if the disc touches the terrain
+    std::vector<double> m_heights;                ///< terrain heights at the query locations
+    std::vector<ChVector<> > m_normals;           ///< terrain normals below the lowest points
+};
+
+/// @} vehicle_wheeled_tire
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
@@ -16,8 +16,6 @@
 //
 // =============================================================================
 
-#include <cstdio>
-
 #include "chrono/assets/ChSphereShape.h"
 #include "chrono/assets/ChCylinderShape.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
@@ -44,10 +42,10 @@
 #include "chrono_vehicle/wheeled_vehicle/wheel/Wheel.h"
 #include "chrono_vehicle/wheeled_vehicle/brake/BrakeSimple.h"
 
+#include "chrono_vehicle/ChVehicleModelCache.h"
 #include "chrono_vehicle/ChVehicleModelData.h"
 
 #include "thirdparty/rapidjson/document.h"
-#include "thirdparty/rapidjson/filereadstream.h"
 
 using namespace rapidjson;
 
@@ -73,15 +71,8 @@ static ChQuaternion<> loadQuaternion(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadSteering(const std::string& filename, int which) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Check that the given file is a steering specification file.
     assert(d.HasMember("Type"));
@@ -106,15 +97,8 @@ void WheeledVehicle::LoadSteering(const std::string& filename, int which) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadDriveline(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Check that the given file is a driveline specification file.
     assert(d.HasMember("Type"));
@@ -140,15 +124,8 @@ void WheeledVehicle::LoadDriveline(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadSuspension(const std::string& filename, int axle) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Check that the given file is a suspension specification file.
     assert(d.HasMember("Type"));
@@ -178,15 +155,8 @@ void WheeledVehicle::LoadSuspension(const std::string& filename, int axle) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadAntirollbar(const std::string& filename) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Check that the given file is an antirollbar specification file.
     assert(d.HasMember("Type"));
@@ -207,15 +177,8 @@ void WheeledVehicle::LoadAntirollbar(const std::string& filename) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadWheel(const std::string& filename, int axle, int side) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Check that the given file is a wheel specification file.
     assert(d.HasMember("Type"));
@@ -237,15 +200,8 @@ void WheeledVehicle::LoadWheel(const std::string& filename, int axle, int side)
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 void WheeledVehicle::LoadBrake(const std::string& filename, int axle, int side) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Check that the given file is a wheel specification file.
     assert(d.HasMember("Type"));
@@ -280,17 +236,10 @@ WheeledVehicle::WheeledVehicle(ChSystem* system, const std::string& filename)
 // -----------------------------------------------------------------------------
 void WheeledVehicle::Create(const std::string& filename) {
     // -------------------------------------------
-    // Open and parse the input file
+    // Get the parsed input file (from the model cache)
     // -------------------------------------------
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
+    std::shared_ptr<const Document> doc = GetCachedJSON(filename);
+    const Document& d = *doc;
 
     // Read top-level data
     assert(d.HasMember("Type"));
@@ -320,8 +269,7 @@ void WheeledVehicle::Create(const std::string& filename) {
         m_chassisMeshFile = d["Visualization"]["Mesh Filename"].GetString();
         m_chassisMeshName = d["Visualization"]["Mesh Name"].GetString();
 
-        geometry::ChTriangleMeshConnected trimesh;
-        trimesh.LoadWavefrontMesh(vehicle::GetDataFile(m_chassisMeshFile), false, false);
+        auto trimesh = GetCachedMesh(vehicle::GetDataFile(m_chassisMeshFile), false, false);
 
         auto trimesh_shape = std::make_shared<ChTriangleMeshShape>();
         trimesh_shape->SetMesh(trimesh);
@@ -23,10 +23,9 @@
 #include "chrono/physics/ChGlobal.h"
 
 #include "chrono_vehicle/wheeled_vehicle/wheel/Wheel.h"
+#include "chrono_vehicle/ChVehicleModelCache.h"
 #include "chrono_vehicle/ChVehicleModelData.h"
 
-#include "thirdparty/rapidjson/filereadstream.h"
-
 using namespace rapidjson;
 
 namespace chrono {
@@ -45,17 +44,7 @@ static ChVector<> loadVector(const Value& a) {
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
 Wheel::Wheel(const std::string& filename) : m_vis(NONE) {
-    FILE* fp = fopen(filename.c_str(), "r");
-
-    char readBuffer[65536];
-    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-
-    fclose(fp);
-
-    Document d;
-    d.ParseStream(is);
-
-    Create(d);
+    Create(*GetCachedJSON(filename));
 
     GetLog() << "Loaded JSON: " << filename.c_str() << "\n";
 }
@@ -111,8 +100,7 @@ void Wheel::Initialize(std::shared_ptr<ChBody> spindle) {
             break;
         }
         case MESH: {
-            geometry::ChTriangleMeshConnected trimesh;
-            trimesh.LoadWavefrontMesh(vehicle::GetDataFile(m_meshFile), false, false);
+            auto trimesh = GetCachedMesh(vehicle::GetDataFile(m_meshFile), false, false);
 
             auto trimesh_shape = std::make_shared<ChTriangleMeshShape>();
             trimesh_shape->SetMesh(trimesh);
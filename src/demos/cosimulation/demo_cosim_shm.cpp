@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////
+//
+//   Demo on how to use a shared memory channel for
+//   cosimulation with another process on the same
+//   host, instead of a TCP socket.
+//
+//   The other process is a simple 'controller',
+//   forked from this program, that uses the
+//   ChSharedMemoryChannel class directly. The number
+//   of exchanges per second is measured, with one
+//   time step per exchange and with batches of steps.
+//
+//	 CHRONO
+//   ------
+//   Multibody dinamics engine
+//
+// ------------------------------------------------
+///////////////////////////////////////////////////
+
+#include <vector>
+
+#include "chrono/core/ChLog.h"
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_cosimulation/ChCosimulation.h"
+#include "chrono_cosimulation/ChExceptionSocket.h"
+#include "chrono_cosimulation/ChSharedMemoryChannel.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define HAVE_FORK
+#endif
+
+using namespace chrono;
+using namespace chrono::cosimul;
+
+const char* CHANNEL_NAME = "/chrono_demo_cosim_shm";
+const int NUM_EXCHANGES = 100000;
+const int BATCH = 10;
+
+#ifdef HAVE_FORK
+// The controller: receives 2 values, replies with 3 values.
+void RunController() {
+    ChSharedMemoryChannel channel;
+    while (true) {
+        try {
+            channel.Open(CHANNEL_NAME);
+            break;
+        } catch (ChExceptionSocket) {
+            usleep(1000);  // not created yet
+        }
+    }
+
+    std::vector<double> times(BATCH);
+    std::vector<double> in(BATCH * channel.GetNumInValues());
+    std::vector<double> out(BATCH * channel.GetNumOutValues());
+
+    // single steps, then batches
+    for (int pass = 0; pass < 2; pass++) {
+        int nsteps = (pass == 0) ? 1 : BATCH;
+        for (int i = 0; i < NUM_EXCHANGES; i += nsteps) {
+            channel.Receive(nsteps, &times[0], &in[0]);
+            for (int k = 0; k < nsteps; k++) {
+                out[3 * k + 0] = 0.1 * in[2 * k + 0] + 0.4 * in[2 * k + 1];
+                out[3 * k + 1] = 1.0 - in[2 * k + 1];
+                out[3 * k + 2] = times[k];
+            }
+            channel.Send(nsteps, &times[0], &out[0]);
+        }
+    }
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    GetLog() << "CHRONO demo about cosimulation through shared memory \n\n";
+
+#ifndef HAVE_FORK
+    GetLog() << "This demo needs POSIX fork() and shared memory.\n";
+    return 0;
+#else
+    pid_t pid = fork();
+    if (pid == 0) {
+        RunController();
+        _exit(0);
+    }
+
+    try {
+        ChSocketFramework socket_tools;
+        ChCosimulation cosimul_interface(socket_tools,
+                                         3,   // n.input values from the controller
+                                         2);  // n.output values to the controller
+
+        cosimul_interface.WaitConnectionSharedMemory(CHANNEL_NAME);
+
+        // One time step per exchange.
+        ChMatrixDynamic<double> data_in(3, 1);
+        ChMatrixDynamic<double> data_out(2, 1);
+        double mytime = 0;
+        double histime = 0;
+
+        ChTimer<double> timer;
+        timer.start();
+        for (int i = 0; i < NUM_EXCHANGES; i++) {
+            mytime = i * 1e-4;
+            data_out(0) = data_in(0);
+            data_out(1) = mytime;
+            cosimul_interface.SendData(mytime, &data_out);     // --> to controller
+            cosimul_interface.ReceiveData(histime, &data_in);  // <-- from controller
+        }
+        timer.stop();
+        GetLog() << "Single steps:    " << NUM_EXCHANGES / timer.GetTimeSeconds() << " steps/s\n";
+
+        // Batches of time steps per exchange.
+        ChMatrixDynamic<double> times(BATCH, 1);
+        ChMatrixDynamic<double> batch_in(BATCH, 3);
+        ChMatrixDynamic<double> batch_out(BATCH, 2);
+
+        timer.reset();
+        timer.start();
+        for (int i = 0; i < NUM_EXCHANGES; i += BATCH) {
+            for (int k = 0; k < BATCH; k++) {
+                times(k) = (i + k) * 1e-4;
+                batch_out(k, 0) = batch_in(k, 0);
+                batch_out(k, 1) = times(k);
+            }
+            cosimul_interface.SendDataBatch(&times, &batch_out);
+            cosimul_interface.ReceiveDataBatch(&times, &batch_in);
+        }
+        timer.stop();
+        GetLog() << "Batches of " << BATCH << ":    " << NUM_EXCHANGES / timer.GetTimeSeconds() << " steps/s\n";
+        GetLog() << "last time sent back: " << batch_in(BATCH - 1, 2) << "\n";
+
+    } catch (ChExceptionSocket exception) {
+        GetLog() << " ERRROR with shared memory channel: \n" << exception.what() << "\n";
+    }
+
+    waitpid(pid, NULL, 0);
+    return 0;
+#endif
+}
@@ -454,10 +454,11 @@ int main(int argc, char* argv[]) {
         //              }
         //            }
 
-        // Update collision information
-        systemG->data_manager->host_data.ObA_rigid[i] = R3(vert_pos[triangles[i].x].x-pos.x, vert_pos[triangles[i].x].y-pos.y, vert_pos[triangles[i].x].z-pos.z);
-        systemG->data_manager->host_data.ObB_rigid[i] = R3(vert_pos[triangles[i].y].x-pos.x, vert_pos[triangles[i].y].y-pos.y, vert_pos[triangles[i].y].z-pos.z);
-        systemG->data_manager->host_data.ObC_rigid[i] = R3(vert_pos[triangles[i].z].x-pos.x, vert_pos[triangles[i].z].y-pos.y, vert_pos[triangles[i].z].z-pos.z);
+        // Update collision information (each triangle has its own shape prototype)
+        int proto = systemG->data_manager->host_data.proto_rigid[i];
+        systemG->data_manager->host_data.ObA_rigid[proto] = R3(vert_pos[triangles[i].x].x-pos.x, vert_pos[triangles[i].x].y-pos.y, vert_pos[triangles[i].x].z-pos.z);
+        systemG->data_manager->host_data.ObB_rigid[proto] = R3(vert_pos[triangles[i].y].x-pos.x, vert_pos[triangles[i].y].y-pos.y, vert_pos[triangles[i].y].z-pos.z);
+        systemG->data_manager->host_data.ObC_rigid[proto] = R3(vert_pos[triangles[i].z].x-pos.x, vert_pos[triangles[i].z].y-pos.y, vert_pos[triangles[i].z].z-pos.z);
       }
       // END STEP 4
 
@@ -0,0 +1,185 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Cost of the deterministic mode of Chrono::Parallel (settings.deterministic).
+//
+// A granular pile of spheres settles in a container, with the DVI or the DEM
+// system. The same simulation is timed with the default and with the
+// deterministic mode, for 1, 2, 4, ... threads up to the number of cores. For
+// each run the program prints the time per step and the ratio of the two
+// modes, and appends a line to benchmarkDeterministic.csv.
+//
+// The deterministic mode sorts the broadphase pairs, sums the reductions of
+// the APGD solver in fixed-size blocks and, with the DEM multi-step tangential
+// displacement model, computes the contact forces sequentially.
+//
+// Usage:
+//   benchmarkDeterministic <DVI|DEM> [num_spheres] [num_steps]
+//
+// The global reference frame has Z up.
+// =============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+double radius = 0.05;
+double spacing = 2.05 * radius;
+double hdim = 1.0;
+
+// -----------------------------------------------------------------------------
+// Create the container and the lattice of spheres.
+// -----------------------------------------------------------------------------
+void AddBodies(ChSystemParallel* sys, bool dem, int num_spheres) {
+    std::shared_ptr<ChMaterialSurfaceBase> mat;
+    if (dem) {
+        auto mat_dem = std::make_shared<ChMaterialSurfaceDEM>();
+        mat_dem->SetYoungModulus(2e6f);
+        mat_dem->SetFriction(0.4f);
+        mat_dem->SetRestitution(0.4f);
+        mat = mat_dem;
+    } else {
+        auto mat_dvi = std::make_shared<ChMaterialSurface>();
+        mat_dvi->SetFriction(0.4f);
+        mat = mat_dvi;
+    }
+    ChMaterialSurfaceBase::ContactMethod method = dem ? ChMaterialSurfaceBase::DEM : ChMaterialSurfaceBase::DVI;
+
+    std::vector<std::shared_ptr<ChBody> > bodies;
+
+    auto bin = std::make_shared<ChBody>(new ChCollisionModelParallel, method);
+    bin->SetMaterialSurface(mat);
+    bin->SetIdentifier(-1);
+    bin->SetBodyFixed(true);
+    bin->SetCollide(true);
+    bin->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hdim, hdim, 0.1), ChVector<>(0, 0, -0.1));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(0.1, hdim, 4 * hdim), ChVector<>(-hdim - 0.1, 0, 4 * hdim));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(0.1, hdim, 4 * hdim), ChVector<>(hdim + 0.1, 0, 4 * hdim));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hdim, 0.1, 4 * hdim), ChVector<>(0, -hdim - 0.1, 4 * hdim));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hdim, 0.1, 4 * hdim), ChVector<>(0, hdim + 0.1, 4 * hdim));
+    bin->GetCollisionModel()->BuildModel();
+    bodies.push_back(bin);
+
+    int n = (int)(2 * (hdim - radius) / spacing);
+    double mass = 1;
+    ChVector<> inertia = (2.0 / 5.0) * mass * radius * radius * ChVector<>(1, 1, 1);
+
+    for (int id = 0; id < num_spheres; id++) {
+        int ix = id % n;
+        int iy = (id / n) % n;
+        int iz = id / (n * n);
+        ChVector<> pos(-hdim + radius + spacing * ix, -hdim + radius + spacing * iy, radius + spacing * iz);
+        // Shift every other layer so that the spheres do not stack exactly.
+        if (iz % 2 == 1)
+            pos += ChVector<>(0.3 * radius, 0.2 * radius, 0);
+
+        auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel, method);
+        ball->SetMaterialSurface(mat);
+        ball->SetIdentifier(id);
+        ball->SetMass(mass);
+        ball->SetInertiaXX(inertia);
+        ball->SetPos(pos);
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), radius);
+        ball->GetCollisionModel()->BuildModel();
+        bodies.push_back(ball);
+    }
+
+    sys->AddBodies(bodies);
+}
+
+// -----------------------------------------------------------------------------
+// Simulate the model and return the average time per step.
+// -----------------------------------------------------------------------------
+double Run(bool dem, bool deterministic, int threads, int num_spheres, int num_steps) {
+    ChSystemParallel* sys;
+    double time_step;
+    if (dem) {
+        sys = new ChSystemParallelDEM;
+        sys->GetSettings()->solver.tangential_displ_mode = ChSystemDEM::MultiStep;
+        time_step = 1e-4;
+    } else {
+        ChSystemParallelDVI* sys_dvi = new ChSystemParallelDVI;
+        sys_dvi->GetSettings()->solver.solver_mode = SLIDING;
+        sys_dvi->GetSettings()->solver.max_iteration_normal = 0;
+        sys_dvi->GetSettings()->solver.max_iteration_sliding = 100;
+        sys_dvi->GetSettings()->solver.max_iteration_spinning = 0;
+        sys_dvi->GetSettings()->solver.alpha = 0;
+        sys_dvi->GetSettings()->solver.contact_recovery_speed = 1;
+        sys_dvi->GetSettings()->collision.collision_envelope = 0.05 * radius;
+        sys_dvi->ChangeSolverType(APGD);
+        sys = sys_dvi;
+        time_step = 1e-3;
+    }
+
+    sys->Set_G_acc(ChVector<>(0, 0, -9.81));
+    CHOMPfunctions::SetNumThreads(threads);
+    sys->GetSettings()->min_threads = threads;
+    sys->GetSettings()->max_threads = threads;
+    sys->GetSettings()->perform_thread_tuning = false;
+    sys->GetSettings()->deterministic = deterministic;
+    sys->GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+    sys->GetSettings()->collision.bins_per_axis = I3(10, 10, 10);
+
+    AddBodies(sys, dem, num_spheres);
+
+    double total = 0;
+    for (int i = 0; i < num_steps; i++) {
+        sys->DoStepDynamics(time_step);
+        total += sys->GetTimerStep();
+    }
+
+    delete sys;
+    return total / num_steps;
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    if (argc < 2 || (strcmp(argv[1], "DVI") != 0 && strcmp(argv[1], "DEM") != 0)) {
+        std::cout << "Usage: " << argv[0] << " <DVI|DEM> [num_spheres] [num_steps]" << std::endl;
+        return 1;
+    }
+
+    bool dem = (strcmp(argv[1], "DEM") == 0);
+    int num_spheres = (argc > 2) ? atoi(argv[2]) : 8000;
+    int num_steps = (argc > 3) ? atoi(argv[3]) : 500;
+    int max_threads = CHOMPfunctions::GetNumProcs();
+
+    std::ofstream csv("benchmarkDeterministic.csv", std::ios::app);
+
+    std::cout << argv[1] << ", " << num_spheres << " spheres, " << num_steps << " steps" << std::endl;
+    std::cout << "threads   default (ms)   deterministic (ms)   ratio" << std::endl;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double t_default = Run(dem, false, threads, num_spheres, num_steps);
+        double t_deterministic = Run(dem, true, threads, num_spheres, num_steps);
+        printf("%7d   %12.3f   %18.3f   %5.3f\n", threads, 1e3 * t_default, 1e3 * t_deterministic,
+               t_deterministic / t_default);
+
+        csv << argv[1] << "," << num_spheres << "," << num_steps << "," << threads << "," << t_default << ","
+            << t_deterministic << std::endl;
+    }
+
+    return 0;
+}
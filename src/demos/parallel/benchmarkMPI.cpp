@@ -0,0 +1,226 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Strong and weak scaling benchmark for the distributed DEM system
+// (ChSystemParallelDistributed).
+//
+// A lattice of spheres settles in a long container. The container is split in
+// slabs along X, one per process.
+//  - strong scaling: the total number of spheres and the container are fixed;
+//  - weak scaling: the number of spheres per process is fixed and the length
+//    of the container grows with the number of processes.
+//
+// Usage:
+//   mpirun -np <N> benchmarkMPI <strong|weak> <num_spheres> [num_steps]
+// where num_spheres is the total number (strong) or the number per process
+// (weak). Rank 0 prints the timings and appends them to benchmarkMPI.csv;
+// running with N = 1, 2, 4, ... gives the scaling curves (the speedup and
+// efficiency are relative to the N = 1 line).
+//
+// The global reference frame has Z up.
+// =============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <mpi.h>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallelDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Sphere radius and lattice spacing
+double radius = 0.05;
+double spacing = 2.1 * radius;
+
+// Width (Y) of the container, and length (X) per process for weak scaling
+double width = 1.0;
+double length_weak = 1.0;
+double length_strong = 4.0;
+
+// Material properties (same on container and spheres)
+float Y = 2e6f;
+float mu = 0.4f;
+float cr = 0.4f;
+
+// -----------------------------------------------------------------------------
+// Create the container, on every process.
+// -----------------------------------------------------------------------------
+void AddContainer(ChSystemParallelDistributed* sys,
+                  std::shared_ptr<ChMaterialSurfaceDEM> mat,
+                  double length,
+                  double height) {
+    auto bin = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+    bin->SetMaterialSurface(mat);
+    bin->SetIdentifier(-1);
+    bin->SetMass(1);
+    bin->SetCollide(true);
+    bin->SetBodyFixed(true);
+
+    ChVector<> hdim(length / 2, width / 2, height / 2);
+    double hthick = 0.1;
+
+    bin->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hdim.y, hthick), ChVector<>(0, 0, -hthick));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(-hdim.x - hthick, 0, hdim.z));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(hdim.x + hthick, 0, hdim.z));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, -hdim.y - hthick, hdim.z));
+    utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, hdim.y + hthick, hdim.z));
+    bin->GetCollisionModel()->BuildModel();
+
+    sys->AddBody(bin);
+}
+
+// -----------------------------------------------------------------------------
+// Create the spheres in a lattice. Each process creates only the spheres near
+// its subdomain; AddBodies() keeps those it owns.
+// -----------------------------------------------------------------------------
+void AddSpheres(ChSystemParallelDistributed* sys,
+                std::shared_ptr<ChMaterialSurfaceDEM> mat,
+                double length,
+                int num_spheres) {
+    int nx = (int)((length - spacing) / spacing);
+    int ny = (int)((width - spacing) / spacing);
+
+    ChVector<> sub_lo, sub_hi;
+    sys->GetSubdomain(sub_lo, sub_hi);
+
+    double mass = 1;
+    ChVector<> inertia = (2.0 / 5.0) * mass * radius * radius * ChVector<>(1, 1, 1);
+
+    std::vector<std::shared_ptr<ChBody> > spheres;
+    for (int id = 0; id < num_spheres; id++) {
+        int ix = id % nx;
+        int iy = (id / nx) % ny;
+        int iz = id / (nx * ny);
+        ChVector<> pos(-length / 2 + spacing * (ix + 1), -width / 2 + spacing * (iy + 1), spacing * (iz + 0.5));
+        if (pos.x < sub_lo.x - radius || pos.x > sub_hi.x + radius)
+            continue;
+
+        auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+        ball->SetMaterialSurface(mat);
+        ball->SetIdentifier(id);
+        ball->SetMass(mass);
+        ball->SetInertiaXX(inertia);
+        ball->SetPos(pos);
+        ball->SetCollide(true);
+
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), radius);
+        ball->GetCollisionModel()->BuildModel();
+
+        spheres.push_back(ball);
+    }
+
+    sys->AddBodies(spheres);
+}
+
+// -----------------------------------------------------------------------------
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    int rank, num_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+    if (argc < 3 || (strcmp(argv[1], "strong") != 0 && strcmp(argv[1], "weak") != 0)) {
+        if (rank == 0)
+            std::cout << "Usage: mpirun -np <N> " << argv[0] << " <strong|weak> <num_spheres> [num_steps]" << std::endl;
+        MPI_Finalize();
+        return 1;
+    }
+
+    bool weak = (strcmp(argv[1], "weak") == 0);
+    int num_spheres = atoi(argv[2]);
+    int num_steps = (argc > 3) ? atoi(argv[3]) : 500;
+    double time_step = 1e-4;
+
+    double length = weak ? length_weak * num_ranks : length_strong;
+    int total_spheres = weak ? num_spheres * num_ranks : num_spheres;
+
+    // Create system
+    // -------------
+
+    ChSystemParallelDistributed msystem(MPI_COMM_WORLD);
+    msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+    msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+    msystem.GetSettings()->collision.bins_per_axis = I3(10, 10, 10);
+
+    // Height of the initial lattice
+    int per_layer = (int)((length - spacing) / spacing) * (int)((width - spacing) / spacing);
+    double height = spacing * (total_spheres / per_layer + 2);
+
+    // Slabs along X; the ghost layer covers the contacts of spheres and some motion.
+    msystem.SetDomain(ChVector<>(-length / 2, -width / 2, -1), ChVector<>(length / 2, width / 2, height), num_ranks,
+                      1, 1, 3 * radius);
+
+    auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+    mat->SetYoungModulus(Y);
+    mat->SetFriction(mu);
+    mat->SetRestitution(cr);
+
+    AddContainer(&msystem, mat, length, height);
+    AddSpheres(&msystem, mat, length, total_spheres);
+
+    // Perform the simulation
+    // ----------------------
+
+    double time_step_total = 0;
+    double time_exchange = 0;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+    for (int i = 0; i < num_steps; i++) {
+        msystem.DoStepDynamics(time_step);
+        time_step_total += msystem.GetTimerStep();
+        time_exchange += msystem.GetTimerExchange();
+    }
+    double elapsed = MPI_Wtime() - start;
+
+    // Statistics
+    // ----------
+
+    int num_global = msystem.GetNumBodiesGlobal();
+    double local[3] = {elapsed, time_step_total, time_exchange};
+    double max[3];
+    MPI_Reduce(local, max, 3, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    int ghosts = msystem.GetNumGhostBodies();
+    int total_ghosts = 0;
+    MPI_Reduce(&ghosts, &total_ghosts, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        double per_step = max[0] / num_steps;
+        std::cout << (weak ? "Weak" : "Strong") << " scaling, " << num_ranks << " processes" << std::endl;
+        std::cout << "  Spheres (created / simulated) " << total_spheres << " / " << num_global << std::endl;
+        std::cout << "  Ghost bodies                  " << total_ghosts << std::endl;
+        std::cout << "  Wall time per step            " << 1e3 * per_step << " ms" << std::endl;
+        std::cout << "    local step (max)            " << 1e3 * max[1] / num_steps << " ms" << std::endl;
+        std::cout << "    exchange (max)              " << 1e3 * max[2] / num_steps << " ms" << std::endl;
+        std::cout << "  Sphere steps per second       " << total_spheres / per_step << std::endl;
+
+        std::ofstream csv("benchmarkMPI.csv", std::ios::app);
+        csv << (weak ? "weak" : "strong") << "," << num_ranks << "," << total_spheres << "," << num_steps << ","
+            << per_step << "," << max[1] / num_steps << "," << max[2] / num_steps << "," << total_ghosts << std::endl;
+    }
+
+    MPI_Finalize();
+    return 0;
+}
@@ -0,0 +1,203 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel demo program for constraint-based fluid (DVI method).
+//
+// A block of fluid nodes collapses in a fixed container (dam break). The fluid
+// settings are the defaults: the nodes are spaced so that their mass matches
+// the rest density of the fluid.
+//
+// The global reference frame has Z up.
+//
+// Usage: fluidDVI [nodes per side] [number of steps]
+// The time spent per step and the number of nodes processed per second are
+// reported at the end of the simulation.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/ChConfig.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#ifdef CHRONO_OPENGL
+#include "chrono_opengl/ChOpenGLWindow.h"
+#endif
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Half dimensions of the container
+ChVector<> hdim(0.5, 0.25, 0.5);
+
+// -----------------------------------------------------------------------------
+// Create a bin consisting of five boxes attached to the ground.
+// -----------------------------------------------------------------------------
+void AddContainer(ChSystemParallelDVI* sys) {
+  auto mat = std::make_shared<ChMaterialSurface>();
+  mat->SetFriction(0);
+
+  auto bin = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  bin->SetMaterialSurface(mat);
+  bin->SetIdentifier(-200);
+  bin->SetMass(1);
+  bin->SetPos(ChVector<>(0, 0, 0));
+  bin->SetCollide(true);
+  bin->SetBodyFixed(true);
+
+  double hthick = 0.05;
+
+  bin->GetCollisionModel()->ClearModel();
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hdim.y, hthick), ChVector<>(0, 0, -hthick));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(-hdim.x - hthick, 0, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hthick, hdim.y, hdim.z), ChVector<>(hdim.x + hthick, 0, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, -hdim.y - hthick, hdim.z));
+  utils::AddBoxGeometry(bin.get(), ChVector<>(hdim.x, hthick, hdim.z), ChVector<>(0, hdim.y + hthick, hdim.z));
+  bin->GetCollisionModel()->BuildModel();
+
+  sys->AddBody(bin);
+}
+
+// -----------------------------------------------------------------------------
+// Create a block of fluid nodes against the -X wall of the container.
+// -----------------------------------------------------------------------------
+void AddFluid(ChSystemParallelDVI* sys, int count) {
+  fluid_settings& fluid = sys->GetSettings()->fluid;
+  double spacing = std::cbrt(fluid.mass / fluid.density);
+
+  // Keep the block inside the container along Y
+  int count_y = std::min(count, (int)(2 * (hdim.y - fluid.collision_radius) / spacing));
+
+  std::vector<ChVector<> > positions;
+  positions.reserve(count * count_y * count);
+  for (int ix = 0; ix < count; ix++) {
+    for (int iy = 0; iy < count_y; iy++) {
+      for (int iz = 0; iz < count; iz++) {
+        positions.push_back(ChVector<>(-hdim.x + fluid.collision_radius + ix * spacing,
+                                       -hdim.y + fluid.collision_radius + iy * spacing,
+                                       fluid.collision_radius + iz * spacing));
+      }
+    }
+  }
+
+  sys->AddFluid(positions);
+}
+
+// -----------------------------------------------------------------------------
+// Create the system, specify simulation parameters, and run simulation loop.
+// -----------------------------------------------------------------------------
+int main(int argc, char* argv[]) {
+  int threads = 8;
+  int count = (argc > 1) ? std::atoi(argv[1]) : 20;
+  int num_steps = (argc > 2) ? std::atoi(argv[2]) : 500;
+
+  // Simulation parameters
+  // ---------------------
+
+  double gravity = 9.81;
+  double time_step = 1e-3;
+
+  uint max_iteration = 50;
+  real tolerance = 1e-3;
+
+  // Create system
+  // -------------
+
+  ChSystemParallelDVI msystem;
+
+  // Set number of threads.
+  int max_threads = CHOMPfunctions::GetNumProcs();
+  if (threads > max_threads)
+    threads = max_threads;
+  msystem.SetParallelThreadNumber(threads);
+  CHOMPfunctions::SetNumThreads(threads);
+
+  // Set gravitational acceleration
+  msystem.Set_G_acc(ChVector<>(0, 0, -gravity));
+
+  // Set solver parameters. The fluid constraints have no friction, so the
+  // normal iterations are sufficient.
+  msystem.GetSettings()->solver.solver_mode = NORMAL;
+  msystem.GetSettings()->solver.max_iteration_normal = max_iteration;
+  msystem.GetSettings()->solver.max_iteration_sliding = 0;
+  msystem.GetSettings()->solver.max_iteration_spinning = 0;
+  msystem.GetSettings()->solver.max_iteration_bilateral = 0;
+  msystem.GetSettings()->solver.tolerance = tolerance;
+  msystem.GetSettings()->solver.alpha = 0;
+  msystem.GetSettings()->solver.contact_recovery_speed = 1;
+  msystem.ChangeSolverType(APGD);
+  msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+
+  msystem.GetSettings()->collision.collision_envelope = 0.005;
+  msystem.GetSettings()->collision.bins_per_axis = I3(2, 2, 2);
+
+  msystem.GetSettings()->fluid.tau = 4 * time_step;
+
+  // Create the container and the fluid
+  // ----------------------------------
+
+  AddContainer(&msystem);
+  AddFluid(&msystem, count);
+
+  int num_nodes = msystem.GetNumFluidBodies();
+  std::cout << "Fluid nodes: " << num_nodes << std::endl;
+
+// Perform the simulation
+// ----------------------
+
+#ifdef CHRONO_OPENGL
+  opengl::ChOpenGLWindow& gl_window = opengl::ChOpenGLWindow::getInstance();
+  gl_window.Initialize(1280, 720, "fluidDVI", &msystem);
+  gl_window.SetCamera(ChVector<>(0, -2, 0.5), ChVector<>(0, 0, 0.25), ChVector<>(0, 0, 1));
+
+  while (true) {
+    if (gl_window.Active()) {
+      gl_window.DoStepDynamics(time_step);
+      gl_window.Render();
+    } else {
+      break;
+    }
+  }
+#else
+  ChTimer<double> timer;
+  double time_collision = 0;
+  double time_lcp = 0;
+
+  for (int i = 0; i < num_steps; i++) {
+    timer.start();
+    msystem.DoStepDynamics(time_step);
+    timer.stop();
+
+    time_collision += msystem.GetTimerCollision();
+    time_lcp += msystem.GetTimerLcp();
+  }
+
+  double max_density = 0;
+  for (int i = 0; i < num_nodes; i++)
+    max_density = std::max(max_density, msystem.GetFluidDensity(i));
+
+  std::cout << "Steps: " << num_steps << "  contacts: " << msystem.GetNumContacts() << std::endl;
+  std::cout << "Max density: " << max_density << "  (rest density " << msystem.GetSettings()->fluid.density << ")"
+            << std::endl;
+  std::cout << "Time per step: " << timer() / num_steps << " s  (collision " << time_collision / num_steps
+            << " s, solver " << time_lcp / num_steps << " s)" << std::endl;
+  std::cout << "Nodes per second: " << num_nodes * num_steps / timer() << std::endl;
+#endif
+
+  return 0;
+}
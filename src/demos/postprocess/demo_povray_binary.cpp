@@ -0,0 +1,162 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+///////////////////////////////////////////////////
+//
+//   Demo code about
+//
+//     - saving POVray frames in the binary format,
+//       with a background thread, while the
+//       simulation is running;
+//     - converting the binary frames into the
+//       usual .pov and .dat files, afterwards.
+//
+//   The time spent in ExportData() is compared
+//   with the one of the text output, and the
+//   converted files are compared with the ones of
+//   the text output, also after changes of the
+//   assets.
+//
+//   Usage: demo_povray_binary [num_particles num_frames]
+//
+///////////////////////////////////////////////////
+
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+
+#include "chrono/physics/ChParticlesClones.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/assets/ChSphereShape.h"
+#include "chrono/assets/ChColorAsset.h"
+#include "chrono/core/ChFileutils.h"
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_postprocess/ChPovRay.h"
+
+using namespace chrono;
+using namespace postprocess;
+
+// Return true if the two files have the same contents, after replacing the
+// directory name of the binary output with the one of the text output.
+bool SameFiles(const std::string& name_text, const std::string& name_binary) {
+    std::ifstream file1(name_text.c_str(), std::ios::binary);
+    std::ifstream file2(name_binary.c_str(), std::ios::binary);
+    std::string text1((std::istreambuf_iterator<char>(file1)), std::istreambuf_iterator<char>());
+    std::string text2((std::istreambuf_iterator<char>(file2)), std::istreambuf_iterator<char>());
+    size_t pos;
+    while ((pos = text2.find("povray_binary")) != std::string::npos)
+        text2.replace(pos, 13, "povray_text");
+    return !text1.empty() && text1 == text2;
+}
+
+int main(int argc, char* argv[]) {
+    int num_particles = 100000;
+    int num_frames = 10;
+    if (argc > 2) {
+        num_particles = std::atoi(argv[1]);
+        num_frames = std::atoi(argv[2]);
+    }
+
+    ChSystem mphysicalSystem;
+
+    auto mfloor = std::make_shared<ChBodyEasyBox>(4, 0.2, 4, 1000, false, true);
+    mfloor->SetBodyFixed(true);
+    mphysicalSystem.Add(mfloor);
+
+    auto mbody = std::make_shared<ChBodyEasySphere>(0.2, 1000, false, true);
+    mbody->SetPos(ChVector<>(0, 1, 0));
+    mbody->SetWvel_loc(ChVector<>(1, 2, 3));
+    auto mcolor = std::make_shared<ChColorAsset>(0.9f, 0.4f, 0.2f);
+    mbody->AddAsset(mcolor);
+    mphysicalSystem.Add(mbody);
+
+    // A cloud of particles, falling without collisions
+    auto mparticles = std::make_shared<ChParticlesClones>();
+    mparticles->SetCollide(false);
+    for (int np = 0; np < num_particles; ++np)
+        mparticles->AddParticle(ChCoordsys<>(ChVector<>(ChRandom() - 0.5, ChRandom() + 1, ChRandom() - 0.5)));
+    auto mspherepart = std::make_shared<ChSphereShape>();
+    mspherepart->GetSphereGeometry().rad = 0.005;
+    mparticles->AddAsset(mspherepart);
+    mphysicalSystem.Add(mparticles);
+
+    // Two exporters: text output, and binary output in a background thread
+    ChFileutils::MakeDirectory("povray_text");
+    ChFileutils::MakeDirectory("povray_binary");
+
+    ChPovRay pov_text(&mphysicalSystem);
+    pov_text.SetOutputScriptFile("povray_text/rendering_frames.pov");
+    pov_text.SetShowCOGs(true);
+    pov_text.AddAll();
+    pov_text.ExportScript();
+
+    ChPovRay pov_binary(&mphysicalSystem);
+    pov_binary.SetOutputScriptFile("povray_binary/rendering_frames.pov");
+    pov_binary.SetShowCOGs(true);
+    pov_binary.SetBinaryOutput(true);
+    pov_binary.SetAsyncOutput(true);
+    pov_binary.AddAll();
+    pov_binary.ExportScript();
+
+    ChTimer<double> timer_text;
+    ChTimer<double> timer_binary;
+    char name_text[100];
+    char name_binary[100];
+
+    for (int i = 0; i < num_frames; i++) {
+        // Changes of the assets: a new asset is detected by the binary output,
+        // a modified asset must be signaled with InvalidateLayout().
+        if (i == num_frames / 3)
+            mfloor->AddAsset(std::make_shared<ChColorAsset>(0.2f, 0.2f, 0.8f));
+        if (i == 2 * num_frames / 3) {
+            mcolor->SetColor(ChColor(0.1f, 0.8f, 0.1f));
+            pov_binary.InvalidateLayout();
+        }
+
+        mphysicalSystem.DoStepDynamics(0.01);
+
+        sprintf(name_text, "povray_text/state%05d", i);
+        sprintf(name_binary, "povray_binary/state%05d", i);
+
+        timer_text.start();
+        pov_text.ExportData(name_text);
+        timer_text.stop();
+
+        timer_binary.start();
+        pov_binary.ExportData(name_binary);
+        timer_binary.stop();
+    }
+    pov_binary.Flush();
+
+    GetLog() << num_particles << " particles, " << num_frames << " frames\n";
+    GetLog() << "  text output:          " << 1000 * timer_text.GetTimeSeconds() / num_frames << " ms per frame\n";
+    GetLog() << "  async binary output:  " << 1000 * timer_binary.GetTimeSeconds() / num_frames << " ms per frame\n";
+
+    // Convert the binary frames afterwards, and compare with the text output
+    ChTimer<double> timer_convert;
+    bool same = true;
+    for (int i = 0; i < num_frames; i++) {
+        sprintf(name_text, "povray_text/state%05d", i);
+        sprintf(name_binary, "povray_binary/state%05d", i);
+
+        timer_convert.start();
+        ChPovRay::ConvertBinaryData(name_binary);
+        timer_convert.stop();
+
+        same &= SameFiles(std::string(name_text) + ".dat", std::string(name_binary) + ".dat");
+        same &= SameFiles(std::string(name_text) + ".pov", std::string(name_binary) + ".pov");
+    }
+    GetLog() << "  conversion:           " << 1000 * timer_convert.GetTimeSeconds() / num_frames << " ms per frame\n";
+    GetLog() << "  same .dat and .pov files: " << (same ? "yes" : "no") << "\n";
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+// Benchmark for the evaluation of internal forces and Jacobians of meshes of
+// ANCF shell elements and EAS brick elements.
+// The batched evaluation done by ChMesh::IntLoadResidual_F (element forces
+// computed in parallel into element-local buffers, then assembled) is compared
+// against the per-element path, where each element computes and assembles its
+// own forces with EleIntLoadResidual_F.
+//
+// Usage: test_ANCF_forces [num_div_x num_div_y num_repetitions]
+
+#include <cmath>
+#include <cstdlib>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_fea/ChElementBrick.h"
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace fea;
+
+int num_div_x = 20;
+int num_div_y = 10;
+int num_reps = 5;
+
+// Create a plate of ANCF shell elements, slightly bent so that internal forces are not zero.
+void CreateShellMesh(std::shared_ptr<ChMesh> mesh) {
+    double len_x = 1.0;
+    double len_y = 0.5;
+    double thickness = 0.01;
+    double dx = len_x / num_div_x;
+    double dy = len_y / num_div_y;
+    int N_x = num_div_x + 1;
+
+    for (int j = 0; j <= num_div_y; j++) {
+        for (int i = 0; i <= num_div_x; i++) {
+            double x = i * dx;
+            double y = j * dy;
+            auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>(x, y, 0), ChVector<>(0, 0, 1));
+            node->SetMass(0);
+            if (i == 0)
+                node->SetFixed(true);
+            mesh->AddNode(node);
+        }
+    }
+
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e7, 0.3);
+
+    for (int j = 0; j < num_div_y; j++) {
+        for (int i = 0; i < num_div_x; i++) {
+            int node0 = j * N_x + i;
+            auto element = std::make_shared<ChElementShellANCF>();
+            element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(node0)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(node0 + 1)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(node0 + N_x)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(node0 + 1 + N_x)));
+            element->SetDimensions(dx, dy);
+            element->AddLayer(thickness / 2, 0 * CH_C_DEG_TO_RAD, mat);
+            element->AddLayer(thickness / 2, 45 * CH_C_DEG_TO_RAD, mat);
+            element->SetAlphaDamp(0.01);
+            element->SetGravityOn(false);
+            mesh->AddElement(element);
+        }
+    }
+}
+
+// Create a block of EAS brick elements.
+void CreateBrickMesh(std::shared_ptr<ChMesh> mesh) {
+    double len_x = 1.0;
+    double len_y = 0.5;
+    double len_z = 0.05;
+    double dx = len_x / num_div_x;
+    double dy = len_y / num_div_y;
+    int N_x = num_div_x + 1;
+    int N_xy = N_x * (num_div_y + 1);
+
+    for (int k = 0; k <= 1; k++) {
+        for (int j = 0; j <= num_div_y; j++) {
+            for (int i = 0; i <= num_div_x; i++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * dx, j * dy, k * len_z));
+                node->SetMass(0);
+                if (i == 0)
+                    node->SetFixed(true);
+                mesh->AddNode(node);
+            }
+        }
+    }
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_RayleighDampingK(0.0);
+    material->Set_RayleighDampingM(0.0);
+    material->Set_density(500);
+    material->Set_E(2.1e7);
+    material->Set_G(2.1e7 / (2 + 2 * 0.3));
+    material->Set_v(0.3);
+
+    ChMatrixNM<double, 3, 1> dims;
+    dims(0, 0) = dx;
+    dims(1, 0) = dy;
+    dims(2, 0) = len_z;
+
+    int count = 0;
+    for (int j = 0; j < num_div_y; j++) {
+        for (int i = 0; i < num_div_x; i++) {
+            int n0 = j * N_x + i;
+            auto element = std::make_shared<ChElementBrick>();
+            element->SetInertFlexVec(dims);
+            element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + 1)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + N_x)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + 1 + N_x)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + N_xy)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + 1 + N_xy)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + N_x + N_xy)),
+                              std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(n0 + 1 + N_x + N_xy)));
+            element->SetMaterial(material);
+            element->SetElemNum(count++);
+            element->SetGravityOn(false);
+            element->SetMooneyRivlin(false);
+            element->SetStockAlpha(0, 0, 0, 0, 0, 0, 0, 0, 0);
+            mesh->AddElement(element);
+        }
+    }
+}
+
+// Time the internal force and Jacobian evaluation for all elements of the given mesh.
+bool RunBenchmark(const char* name, std::shared_ptr<ChMesh> mesh, ChSystem& system) {
+    mesh->SetAutomaticGravity(false);
+    system.Add(mesh);
+    system.SetupInitial();
+    system.Setup();
+    system.Update();
+
+    // Bend the mesh, so that the elements are not in their reference configuration.
+    for (unsigned int i = 0; i < mesh->GetNnodes(); i++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(i));
+        ChVector<> pos = node->GetPos();
+        pos.z += 0.02 * pos.x * pos.x + 0.01 * std::sin(3 * pos.y);
+        node->SetPos(pos);
+    }
+    system.Update();
+
+    int ndof = mesh->GetDOF_w();
+    unsigned int nelements = mesh->GetNelements();
+    ChVectorDynamic<> R_elem(ndof);
+    ChVectorDynamic<> R_mesh(ndof);
+
+    ChTimer<double> timer_elem;
+    ChTimer<double> timer_mesh;
+    ChTimer<double> timer_jac;
+
+    for (int rep = 0; rep < num_reps; rep++) {
+        // Per-element path: each element computes and assembles its own internal forces.
+        R_elem.Reset();
+        timer_elem.start();
+        for (unsigned int ie = 0; ie < nelements; ie++)
+            mesh->GetElement(ie)->EleIntLoadResidual_F(R_elem, 1.0);
+        timer_elem.stop();
+
+        // Batched path: forces of all elements in element-local buffers, then assembly.
+        R_mesh.Reset();
+        timer_mesh.start();
+        mesh->IntLoadResidual_F(0, R_mesh, 1.0);
+        timer_mesh.stop();
+
+        // Jacobians of the internal forces.
+        timer_jac.start();
+        for (unsigned int ie = 0; ie < nelements; ie++) {
+            std::shared_ptr<ChElementBase> element = mesh->GetElement(ie);
+            ChMatrixDynamic<> H(element->GetNdofs(), element->GetNdofs());
+            element->ComputeKRMmatricesGlobal(H, 1.0, 0.01, 0);
+        }
+        timer_jac.stop();
+    }
+
+    ChVectorDynamic<> diff = R_mesh;
+    diff -= R_elem;
+    double err = diff.NormInf() / (R_elem.NormInf() + 1e-20);
+
+    GetLog() << name << ": " << nelements << " elements, " << ndof << " DOFs\n";
+    GetLog() << "   internal forces, per element: " << timer_elem.GetTimeSeconds() / num_reps << " s\n";
+    GetLog() << "   internal forces, batched:     " << timer_mesh.GetTimeSeconds() / num_reps << " s\n";
+    GetLog() << "   Jacobians:                    " << timer_jac.GetTimeSeconds() / num_reps << " s\n";
+    GetLog() << "   relative difference:          " << err << "\n";
+
+    return err < 1e-10;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 3) {
+        num_div_x = std::atoi(argv[1]);
+        num_div_y = std::atoi(argv[2]);
+        num_reps = std::atoi(argv[3]);
+    }
+
+    bool passed = true;
+
+    {
+        ChSystem system;
+        auto mesh = std::make_shared<ChMesh>();
+        CreateShellMesh(mesh);
+        passed &= RunBenchmark("ANCF shell", mesh, system);
+    }
+
+    {
+        ChSystem system;
+        auto mesh = std::make_shared<ChMesh>();
+        CreateBrickMesh(mesh);
+        passed &= RunBenchmark("EAS brick", mesh, system);
+    }
+
+    return !passed;
+}
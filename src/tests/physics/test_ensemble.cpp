@@ -0,0 +1,149 @@
+//
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 Project Chrono
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file at the top level of the distribution
+// and at http://projectchrono.org/license-chrono.txt.
+//
+
+// Benchmark for ChSystemEnsemble: throughput of a sweep of independent
+// systems (a pile of spheres falling on a box, with a different friction
+// coefficient for each system).
+// The sweep is run:
+//   - serially, one system after the other, in a single thread;
+//   - as a ChSystemEnsemble, with the given number of threads;
+//   - (POSIX only) in the given number of forked processes, each of them
+//     creating and simulating its share of the systems.
+// The ensemble results must be the same as the serial ones.
+//
+// Usage: test_ensemble [num_systems num_steps num_threads]
+
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/wait.h>
+#include <unistd.h>
+#define HAVE_FORK
+#endif
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChSystemEnsemble.h"
+
+using namespace chrono;
+
+int num_systems = 16;
+int num_steps = 200;
+int num_threads = 4;
+double step = 0.005;
+
+// Create the system with the given index in the sweep.
+std::shared_ptr<ChSystem> CreateSystem(int index) {
+    auto system = std::make_shared<ChSystem>();
+    system->SetParallelThreadNumber(1);
+    system->Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    system->AddBody(ground);
+
+    double friction = 0.1 + 0.8 * index / num_systems;
+    for (int iy = 0; iy < 4; iy++) {
+        for (int ix = 0; ix < 5; ix++) {
+            for (int iz = 0; iz < 5; iz++) {
+                auto ball = std::make_shared<ChBodyEasySphere>(0.2, 1000, true, false);
+                ball->SetPos(ChVector<>(ix * 0.45 + 0.01 * iy, 0.2 + iy * 0.45, iz * 0.45 - 0.01 * iy));
+                ball->GetMaterialSurface()->SetFriction((float)friction);
+                system->AddBody(ball);
+            }
+        }
+    }
+
+    return system;
+}
+
+// Height of the center of mass of the spheres, as result of a simulation.
+double GetResult(ChSystem& system) {
+    double height = 0;
+    for (int i = 1; i < system.Get_bodylist()->size(); i++)
+        height += system.Get_bodylist()->at(i)->GetPos().y;
+    return height / (system.Get_bodylist()->size() - 1);
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 3) {
+        num_systems = std::atoi(argv[1]);
+        num_steps = std::atoi(argv[2]);
+        num_threads = std::atoi(argv[3]);
+    }
+
+    double work = (double)num_systems * num_steps;
+
+    // Serial sweep.
+    ChTimer<double> timer_serial;
+    std::vector<double> results_serial(num_systems);
+    timer_serial.start();
+    for (int i = 0; i < num_systems; i++) {
+        std::shared_ptr<ChSystem> system = CreateSystem(i);
+        for (int j = 0; j < num_steps; j++)
+            system->DoStepDynamics(step);
+        results_serial[i] = GetResult(*system);
+    }
+    timer_serial.stop();
+
+    // Ensemble.
+    ChTimer<double> timer_ensemble;
+    ChSystemEnsemble ensemble;
+    ensemble.SetNumThreads(num_threads);
+    timer_ensemble.start();
+    for (int i = 0; i < num_systems; i++)
+        ensemble.AddSystem(CreateSystem(i));
+    ensemble.DoStepDynamics(step, num_steps);
+    timer_ensemble.stop();
+
+    double max_diff = 0;
+    for (int i = 0; i < num_systems; i++)
+        max_diff = std::max(max_diff, std::abs(GetResult(*ensemble.GetSystem(i)) - results_serial[i]));
+
+    GetLog() << "Sweep of " << num_systems << " systems, " << num_steps << " steps each\n";
+    GetLog() << "   serial:                  " << timer_serial.GetTimeSeconds() << " s, "
+             << work / timer_serial.GetTimeSeconds() << " steps/s\n";
+    GetLog() << "   ensemble, " << num_threads << " threads:     " << timer_ensemble.GetTimeSeconds() << " s, "
+             << work / timer_ensemble.GetTimeSeconds() / num_threads << " steps/s per thread\n";
+
+#ifdef HAVE_FORK
+    // Forked processes, each with a contiguous share of the systems.
+    ChTimer<double> timer_fork;
+    timer_fork.start();
+    std::vector<pid_t> children;
+    for (int p = 0; p < num_threads; p++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            for (int i = p * num_systems / num_threads; i < (p + 1) * num_systems / num_threads; i++) {
+                std::shared_ptr<ChSystem> system = CreateSystem(i);
+                for (int j = 0; j < num_steps; j++)
+                    system->DoStepDynamics(step);
+            }
+            _exit(0);
+        }
+        children.push_back(pid);
+    }
+    for (size_t p = 0; p < children.size(); p++)
+        waitpid(children[p], NULL, 0);
+    timer_fork.stop();
+
+    GetLog() << "   fork, " << num_threads << " processes:     " << timer_fork.GetTimeSeconds() << " s, "
+             << work / timer_fork.GetTimeSeconds() / num_threads << " steps/s per process\n";
+#endif
+
+    GetLog() << "   max difference ensemble/serial: " << max_diff << "\n";
+
+    return !(max_diff == 0);
+}
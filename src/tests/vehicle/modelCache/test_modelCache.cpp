@@ -0,0 +1,160 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the vehicle model cache.
+// Several identical vehicles are created from a JSON specification file, first
+// with the model cache disabled (all files are read for each vehicle), then
+// with the cache enabled. The vehicles must be identical and the time spent in
+// both cases is reported.
+//
+// =============================================================================
+
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystem.h"
+
+#include "chrono_vehicle/ChVehicleModelCache.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+const std::string vehicle_file("hmmwv/vehicle/HMMWV_Vehicle_simple_lugged.json");
+
+// First triangle mesh attached to the given body (accessed without modifying
+// the asset, so that a shared mesh is not copied).
+const geometry::ChTriangleMeshConnected* GetBodyMesh(std::shared_ptr<ChBody> body) {
+    for (auto asset : body->GetAssets()) {
+        if (auto shape = std::dynamic_pointer_cast<const ChTriangleMeshShape>(asset))
+            return &shape->GetMesh();
+    }
+    return NULL;
+}
+
+// Number of vertices of the first triangle mesh attached to the given body.
+int GetMeshVertices(std::shared_ptr<ChBody> body) {
+    const geometry::ChTriangleMeshConnected* mesh = GetBodyMesh(body);
+    return mesh ? (int)mesh->getCoordsVertices().size() : -1;
+}
+
+bool SameVehicle(WheeledVehicle& a, WheeledVehicle& b) {
+    if (a.GetNumberAxles() != b.GetNumberAxles())
+        return false;
+    if (a.GetChassis()->GetMass() != b.GetChassis()->GetMass())
+        return false;
+    if (GetMeshVertices(a.GetChassis()) != GetMeshVertices(b.GetChassis()))
+        return false;
+    for (int i = 0; i < 2 * a.GetNumberAxles(); i++) {
+        WheelID id(i);
+        if (a.GetWheel(id)->GetMass() != b.GetWheel(id)->GetMass())
+            return false;
+        if (GetMeshVertices(a.GetWheelBody(id)) != GetMeshVertices(b.GetWheelBody(id)))
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    int num_vehicles = (argc > 1) ? std::atoi(argv[1]) : 5;
+
+    ChSystem system;
+    std::vector<std::shared_ptr<WheeledVehicle> > vehicles[2];
+    ChTimer<double> timer[2];
+
+    for (int k = 0; k < 2; k++) {
+        SetModelCacheEnabled(k == 1);
+        timer[k].start();
+        for (int i = 0; i < num_vehicles; i++) {
+            auto vehicle = std::make_shared<WheeledVehicle>(&system, vehicle::GetDataFile(vehicle_file));
+            vehicle->Initialize(ChCoordsys<>(ChVector<>(10.0 * i, 10.0 * k, 1), QUNIT));
+            vehicles[k].push_back(vehicle);
+        }
+        timer[k].stop();
+    }
+
+    bool ok = true;
+
+    // All vehicles must be identical to the first one.
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < num_vehicles; i++) {
+            if (!SameVehicle(*vehicles[0][0], *vehicles[k][i])) {
+                std::cout << "Vehicle " << i << (k ? " (cached)" : " (not cached)") << " is different" << std::endl;
+                ok = false;
+            }
+        }
+    }
+
+    // The wheel mesh must have been loaded.
+    if (GetMeshVertices(vehicles[1][0]->GetWheelBody(WheelID(0))) <= 0) {
+        std::cout << "Wheel mesh not loaded" << std::endl;
+        ok = false;
+    }
+
+    // Cached documents are shared.
+    if (GetCachedJSON(vehicle::GetDataFile(vehicle_file)) != GetCachedJSON(vehicle::GetDataFile(vehicle_file))) {
+        std::cout << "JSON document not cached" << std::endl;
+        ok = false;
+    }
+
+    // Cached meshes are shared by the vehicles, not copied.
+    if (num_vehicles > 1 &&
+        GetBodyMesh(vehicles[1][0]->GetWheelBody(WheelID(0))) != GetBodyMesh(vehicles[1][1]->GetWheelBody(WheelID(0)))) {
+        std::cout << "Wheel mesh not shared" << std::endl;
+        ok = false;
+    }
+
+    // Concurrent requests for the same file get the same document.
+    ClearModelCache();
+    std::shared_ptr<const rapidjson::Document> docs[4];
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++)
+        threads.push_back(std::thread([&docs, t]() { docs[t] = GetCachedJSON(vehicle::GetDataFile(vehicle_file)); }));
+    for (int t = 0; t < 4; t++)
+        threads[t].join();
+    for (int t = 1; t < 4; t++) {
+        if (!docs[t] || docs[t] != docs[0]) {
+            std::cout << "Concurrent requests got different documents" << std::endl;
+            ok = false;
+        }
+    }
+
+    // Missing files are reported.
+    bool thrown = false;
+    try {
+        GetCachedJSON(vehicle::GetDataFile("hmmwv/vehicle/no_such_file.json"));
+    } catch (ChException&) {
+        thrown = true;
+    }
+    if (!thrown) {
+        std::cout << "No exception for a missing JSON file" << std::endl;
+        ok = false;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Vehicles: " << num_vehicles << "  bodies: " << system.Get_bodylist()->size() << std::endl;
+    std::cout << "Without cache: " << 1e3 * timer[0]() / num_vehicles << " ms/vehicle" << std::endl;
+    std::cout << "With cache:    " << 1e3 * timer[1]() / num_vehicles << " ms/vehicle" << std::endl;
+
+    if (!ok) {
+        std::cout << "FAILED" << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,115 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test the lookup tables of the Pacejka tire: the reactions interpolated from
+// the tables are compared with the Magic Formula over random slips, camber and
+// vertical loads, and the time spent in Advance() is reported for both.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTire.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using std::cout;
+using std::endl;
+
+const std::string pacParamFile = vehicle::GetDataFile("hmmwv/pactest.tir");
+
+double Random(double min, double max) {
+    return min + (max - min) * std::rand() / RAND_MAX;
+}
+
+int main(int argc, char* argv[]) {
+    int num_samples = (argc > 1) ? std::atoi(argv[1]) : 5000;
+    double step = 1e-3;
+
+    FlatTerrain flat_terrain(0);
+
+    // Tires with steady-state slips, so that both see the same inputs
+    ChPacejkaTire tire_mf("MF", pacParamFile, 8000, false);
+    ChPacejkaTire tire_tbl("TABLES", pacParamFile, 8000, false);
+    tire_tbl.SetUseLookupTables(true);
+
+    tire_mf.Initialize(LEFT, true);
+    tire_tbl.Initialize(LEFT, true);
+
+    double vel = tire_mf.get_longvl();
+    double peak[3] = {0, 0, 0};
+    double error[3] = {0, 0, 0};
+    ChTimer<double> timer_mf;
+    ChTimer<double> timer_tbl;
+
+    std::srand(1);
+    for (int i = 0; i < num_samples; i++) {
+        // Inside of the default table ranges
+        double kappa = Random(-0.45, 0.45);
+        double alpha = std::atan(Random(-0.45, 0.45));
+        double gamma = Random(-0.1, 0.1);
+        double Fz = Random(1000, 10000);
+
+        tire_mf.set_Fz_override(Fz);
+        tire_tbl.set_Fz_override(Fz);
+
+        WheelState state = tire_mf.getState_from_KAG(kappa, alpha, gamma, vel);
+        tire_mf.Update(0, state, flat_terrain);
+        tire_tbl.Update(0, state, flat_terrain);
+
+        timer_mf.start();
+        tire_mf.Advance(step);
+        timer_mf.stop();
+
+        timer_tbl.start();
+        tire_tbl.Advance(step);
+        timer_tbl.stop();
+
+        TireForce f_mf = tire_mf.GetTireForce_combinedSlip(true);
+        TireForce f_tbl = tire_tbl.GetTireForce_combinedSlip(true);
+        double r_mf[3] = {f_mf.force.x, f_mf.force.y, f_mf.moment.z};
+        double r_tbl[3] = {f_tbl.force.x, f_tbl.force.y, f_tbl.moment.z};
+        for (int j = 0; j < 3; j++) {
+            peak[j] = std::max(peak[j], std::abs(r_mf[j]));
+            error[j] = std::max(error[j], std::abs(r_tbl[j] - r_mf[j]));
+        }
+    }
+
+    double max_error = 0;
+    for (int j = 0; j < 3; j++)
+        max_error = std::max(max_error, error[j] / peak[j]);
+
+    cout << "Samples: " << num_samples << endl;
+    cout << "Max error (Fx, Fy, Mz): " << error[0] << " N, " << error[1] << " N, " << error[2] << " Nm" << endl;
+    cout << "Max error relative to peak values: " << 100 * max_error << " %  (tables: "
+         << 100 * tire_tbl.get_table_error() << " %)" << endl;
+    cout << "Evaluations outside of the tables: " << tire_tbl.get_num_table_misses() << endl;
+    cout << "Advance, Magic Formula: " << 1e6 * timer_mf() / num_samples << " us" << endl;
+    cout << "Advance, lookup tables: " << 1e6 * timer_tbl() / num_samples << " us" << endl;
+
+    // The reported table error is estimated at the cell centers; allow some
+    // margin for the samples.
+    if (max_error > 1.5 * tire_tbl.get_table_error() || tire_tbl.get_num_table_misses() > 0) {
+        cout << "FAILED" << endl;
+        return 1;
+    }
+
+    cout << "PASSED" << endl;
+    return 0;
+}
@@ -0,0 +1,154 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the real-time executive (ChRealtimeExecutive).
+// A vehicle with rigid tires accelerates on a rigid plane. The simulation is
+// first run with ChVehicle::Advance() to measure the cost of a frame; the frame
+// budget is then set to 80% of the median cost (through the real-time factor)
+// and the simulation is run again with the executive. The frame latencies and
+// the budget overruns are reported for both runs.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/powertrain/SimplePowertrain.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/utils/ChRealtimeExecutive.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/RigidTire.h"
+#include "chrono_vehicle/wheeled_vehicle/vehicle/WheeledVehicle.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+double frame_step = 5e-3;
+
+// Vehicle, terrain, powertrain and tires, with constant driver inputs.
+class Simulation {
+  public:
+    Simulation()
+        : m_vehicle(vehicle::GetDataFile("generic/vehicle/Vehicle_DoubleWishbones.json")),
+          m_terrain(m_vehicle.GetSystem(), vehicle::GetDataFile("terrain/RigidPlane.json")),
+          m_powertrain(vehicle::GetDataFile("generic/powertrain/SimplePowertrain.json")) {
+        m_vehicle.Initialize(ChCoordsys<>(ChVector<>(0, 0, 1), QUNIT));
+        m_powertrain.Initialize();
+        int num_wheels = 2 * m_vehicle.GetNumberAxles();
+        for (int i = 0; i < num_wheels; i++) {
+            auto tire = std::make_shared<RigidTire>(vehicle::GetDataFile("generic/tire/RigidTire.json"));
+            tire->Initialize(m_vehicle.GetWheelBody(i));
+            m_tires.push_back(tire);
+        }
+    }
+
+    WheeledVehicle& GetVehicle() { return m_vehicle; }
+
+    // Simulate one frame; the vehicle is advanced with the executive, if any.
+    // Return the time spent in advancing the vehicle.
+    double Advance(ChRealtimeExecutive* executive) {
+        double time = m_vehicle.GetSystem()->GetChTime();
+        TireForces tire_forces(m_tires.size());
+        for (size_t i = 0; i < m_tires.size(); i++)
+            tire_forces[i] = m_tires[i]->GetTireForce();
+
+        m_powertrain.Update(time, 0.5, m_vehicle.GetDriveshaftSpeed());
+        m_vehicle.Update(time, 0.1, 0, m_powertrain.GetOutputTorque(), tire_forces);
+        m_powertrain.Advance(frame_step);
+
+        ChTimer<double> timer;
+        timer.start();
+        if (executive)
+            executive->Advance(frame_step);
+        else
+            m_vehicle.Advance(frame_step);
+        timer.stop();
+
+        return timer();
+    }
+
+  private:
+    WheeledVehicle m_vehicle;
+    RigidTerrain m_terrain;
+    SimplePowertrain m_powertrain;
+    std::vector<std::shared_ptr<RigidTire> > m_tires;
+};
+
+double Percentile(std::vector<double> values, double percentile) {
+    std::sort(values.begin(), values.end());
+    size_t i = (size_t)std::ceil(percentile / 100 * values.size());
+    return values[std::min(std::max<size_t>(i, 1), values.size()) - 1];
+}
+
+bool ValidState(WheeledVehicle& vehicle) {
+    double z = vehicle.GetChassisPos().z;
+    double speed = vehicle.GetVehicleSpeed();
+    return z > 0.5 && z < 1.5 && speed > 0 && speed < 20;
+}
+
+int main(int argc, char* argv[]) {
+    int num_frames = (argc > 1) ? std::atoi(argv[1]) : 200;
+
+    // Run without the executive.
+    std::vector<double> latencies;
+    Simulation sim0;
+    for (int i = 0; i < num_frames; i++)
+        latencies.push_back(sim0.Advance(NULL));
+
+    double budget = 0.8 * Percentile(latencies, 50);
+    int overruns = 0;
+    for (int i = 0; i < num_frames; i++) {
+        if (latencies[i] > budget)
+            overruns++;
+    }
+
+    // Run with the executive.
+    Simulation sim1;
+    int max_iters = sim1.GetVehicle().GetSystem()->GetIterLCPmaxItersSpeed();
+    ChRealtimeExecutive executive(sim1.GetVehicle());
+    executive.SetRealtimeFactor(budget / frame_step);
+    for (int i = 0; i < num_frames; i++)
+        sim1.Advance(&executive);
+
+    std::cout << std::endl;
+    std::cout << "Frames: " << num_frames << "  budget: " << 1e3 * budget << " ms/frame" << std::endl;
+    std::cout << "Without executive:  p50 " << 1e3 * Percentile(latencies, 50) << " ms  p99 "
+              << 1e3 * Percentile(latencies, 99) << " ms  p99.9 " << 1e3 * Percentile(latencies, 99.9) << " ms  max "
+              << 1e3 * Percentile(latencies, 100) << " ms  overruns " << overruns << std::endl;
+    std::cout << "With executive:     p50 " << 1e3 * executive.GetLatencyPercentile(50) << " ms  p99 "
+              << 1e3 * executive.GetLatencyPercentile(99) << " ms  p99.9 "
+              << 1e3 * executive.GetLatencyPercentile(99.9) << " ms  max " << 1e3 * executive.GetMaxLatency()
+              << " ms  overruns " << executive.GetNumOverruns() << std::endl;
+    std::cout << "Average iterations: " << executive.GetAverageIterations()
+              << "  steps without collision detection: " << executive.GetNumSkippedCollisions() << std::endl;
+
+    // The iteration limit of the system is restored after each frame.
+    if (sim1.GetVehicle().GetSystem()->GetIterLCPmaxItersSpeed() != max_iters) {
+        std::cout << "Iteration limit not restored" << std::endl;
+        std::cout << "FAILED" << std::endl;
+        return 1;
+    }
+
+    if (!ValidState(sim0.GetVehicle()) || !ValidState(sim1.GetVehicle()) ||
+        executive.GetNumOverruns() >= overruns) {
+        std::cout << "FAILED" << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,170 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Test for the batched tire evaluation (ChTireBatch).
+// The tires of many vehicles (LuGre and Fiala) roll on a wavy terrain. The same
+// tires are evaluated one at a time and with a ChTireBatch; the tire forces
+// must be identical. The time spent in both cases is reported.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChTireBatch.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/LugreTire.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/FialaTire.h"
+
+#include "thirdparty/rapidjson/document.h"
+#include "thirdparty/rapidjson/filereadstream.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace rapidjson;
+
+// Terrain with a smooth sinusoidal height, which uses the default (one query
+// at a time) implementation of ChTerrain::GetHeightNormal().
+class WavyTerrain : public ChTerrain {
+  public:
+    virtual double GetHeight(double x, double y) const override { return 0.02 * std::sin(x) * std::cos(0.5 * y); }
+    virtual ChVector<> GetNormal(double x, double y) const override {
+        ChVector<> n(-0.02 * std::cos(x) * std::cos(0.5 * y), 0.01 * std::sin(x) * std::sin(0.5 * y), 1);
+        return n.GetNormalized();
+    }
+};
+
+void ReadDocument(const std::string& filename, Document& d) {
+    FILE* fp = fopen(filename.c_str(), "r");
+    char readBuffer[65536];
+    FileReadStream is(fp, readBuffer, sizeof(readBuffer));
+    d.ParseStream(is);
+    fclose(fp);
+}
+
+// State of wheel 'i' at the given time: the wheels roll forward with a small
+// slip angle and bounce on the terrain.
+WheelState GetWheelState(int i, double time) {
+    double radius = 0.4699;
+    double speed = 10 + 0.01 * i;
+    double yaw = 0.05 * std::sin(0.1 * i + time);
+
+    WheelState state;
+    state.pos = ChVector<>(speed * time + 3 * (i / 4), 2.0 * (i % 4), radius - 0.01 + 0.005 * std::sin(20 * time + i));
+    state.rot = Q_from_AngZ(yaw);
+    state.lin_vel = ChVector<>(speed, 0.3 * std::cos(0.1 * i + time), 0.1 * std::cos(20 * time + i));
+    state.omega = 0.95 * speed / radius;
+    state.ang_vel = state.rot.Rotate(ChVector<>(0, state.omega, 0));
+    return state;
+}
+
+bool SameForce(const TireForce& a, const TireForce& b) {
+    return a.force == b.force && a.moment == b.moment && a.point == b.point;
+}
+
+int main(int argc, char* argv[]) {
+    int num_vehicles = (argc > 1) ? std::atoi(argv[1]) : 200;
+    int num_steps = (argc > 2) ? std::atoi(argv[2]) : 200;
+    int num_tires = 4 * num_vehicles;
+    double step = 1e-3;
+
+    Document lugre_doc;
+    Document fiala_doc;
+    ReadDocument(vehicle::GetDataFile("generic/tire/LugreTire.json"), lugre_doc);
+    ReadDocument(vehicle::GetDataFile("generic/tire/FialaTire.json"), fiala_doc);
+
+    // Two identical sets of tires: half of the vehicles have LuGre tires, the
+    // other half Fiala tires.
+    std::vector<std::shared_ptr<ChTire> > tires[2];
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < num_tires; i++) {
+            if ((i / 4) % 2 == 0) {
+                auto tire = std::make_shared<LugreTire>(lugre_doc);
+                tire->Initialize();
+                tires[k].push_back(tire);
+            } else {
+                auto tire = std::make_shared<FialaTire>(fiala_doc);
+                tire->Initialize();
+                tires[k].push_back(tire);
+            }
+        }
+    }
+
+    ChTireBatch batch;
+    for (int i = 0; i < num_tires; i++)
+        batch.AddTire(tires[1][i].get());
+
+    FlatTerrain flat_terrain(0);
+    WavyTerrain wavy_terrain;
+    ChTerrain* terrains[2] = {&flat_terrain, &wavy_terrain};
+
+    WheelStates wheel_states(num_tires);
+    TireForces batch_forces(4);
+    ChTimer<double> timer_single;
+    ChTimer<double> timer_batch;
+    int num_contacts = 0;
+    bool ok = true;
+
+    for (int n = 0; n < num_steps; n++) {
+        double time = n * step;
+        const ChTerrain& terrain = *terrains[(n / 50) % 2];
+        for (int i = 0; i < num_tires; i++)
+            wheel_states[i] = GetWheelState(i, time);
+
+        timer_single.start();
+        for (int i = 0; i < num_tires; i++) {
+            tires[0][i]->Update(time, wheel_states[i], terrain);
+            tires[0][i]->Advance(step);
+        }
+        timer_single.stop();
+
+        timer_batch.start();
+        batch.Update(time, wheel_states, terrain);
+        batch.Advance(step);
+        timer_batch.stop();
+
+        // Compare the forces, vehicle by vehicle.
+        for (int v = 0; v < num_vehicles; v++) {
+            batch.GetTireForces(4 * v, batch_forces);
+            for (int j = 0; j < 4; j++) {
+                TireForce force = tires[0][4 * v + j]->GetTireForce();
+                if (force.force.z != 0)
+                    num_contacts++;
+                if (!SameForce(force, batch_forces[j])) {
+                    if (ok)
+                        std::cout << "Different forces for tire " << 4 * v + j << " at step " << n << std::endl;
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    std::cout << "Tires: " << num_tires << "  steps: " << num_steps << "  threads: " << batch.GetNumThreads()
+              << std::endl;
+    std::cout << "Tires in contact (average): " << num_contacts / num_steps << std::endl;
+    std::cout << "One tire at a time: " << 1e3 * timer_single() / num_steps << " ms/step" << std::endl;
+    std::cout << "Batch:              " << 1e3 * timer_batch() / num_steps << " ms/step" << std::endl;
+
+    if (!ok || num_contacts == 0) {
+        std::cout << "FAILED" << std::endl;
+        return 1;
+    }
+
+    std::cout << "PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,161 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the serialization of contiguous arrays of numbers in binary
+// archives (matrices, std::vector of numbers and of ChVector).
+//
+// The arrays are written with the bulk path of ChArchiveOutBinary and with an
+// archive that writes them element by element: the bytes must be the same.
+// Then they are read back, with both paths, and compared with the originals.
+//
+// =============================================================================
+
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/core/ChVector.h"
+#include "chrono/core/ChVectorDynamic.h"
+#include "chrono/serialization/ChArchiveBinary.h"
+
+using namespace chrono;
+
+// Binary archives that do not use the bulk path (element-by-element serialization).
+class ChArchiveOutBinaryElements : public ChArchiveOutBinary {
+  public:
+    ChArchiveOutBinaryElements(ChStreamOutBinary& mostream) : ChArchiveOutBinary(mostream) {}
+    virtual bool out_array_bulk(const double* data, size_t msize, int ncomponents, int version) { return false; }
+    virtual bool out_array_bulk(const int* data, size_t msize, int ncomponents, int version) { return false; }
+};
+
+class ChArchiveInBinaryElements : public ChArchiveInBinary {
+  public:
+    ChArchiveInBinaryElements(ChStreamInBinary& mistream) : ChArchiveInBinary(mistream) {}
+    virtual bool in_array_bulk(double* data, size_t msize, int ncomponents, int version) { return false; }
+    virtual bool in_array_bulk(int* data, size_t msize, int ncomponents, int version) { return false; }
+};
+
+// The data to serialize.
+struct TestData {
+    ChMatrixDynamic<> matrix;
+    ChVectorDynamic<> vector;
+    std::vector<double> doubles;
+    std::vector<int> ints;
+    std::vector<bool> bools;
+    std::vector<ChVector<> > points;
+
+    void Fill(int n) {
+        matrix.Reset(n / 100, 100);
+        vector.Reset(n);
+        doubles.resize(n);
+        ints.resize(n);
+        bools.resize(100);
+        points.resize(n / 3);
+        for (int i = 0; i < n; i++) {
+            matrix.ElementN(i) = 0.5 * i;
+            vector(i) = -1.0 / (i + 1);
+            doubles[i] = 3.0 * i;
+            ints[i] = i - n / 2;
+        }
+        for (int i = 0; i < 100; i++)
+            bools[i] = (i % 3 == 0);
+        for (int i = 0; i < n / 3; i++)
+            points[i] = ChVector<>(i, 2.0 * i, -0.25 * i);
+    }
+
+    void Write(ChArchiveOut& marchive) {
+        marchive << CHNVP(matrix);
+        marchive << CHNVP(vector);
+        marchive << CHNVP(doubles);
+        marchive << CHNVP(ints);
+        marchive << CHNVP(bools);
+        marchive << CHNVP(points);
+    }
+
+    void Read(ChArchiveIn& marchive) {
+        marchive >> CHNVP(matrix);
+        marchive >> CHNVP(vector);
+        marchive >> CHNVP(doubles);
+        marchive >> CHNVP(ints);
+        marchive >> CHNVP(bools);
+        marchive >> CHNVP(points);
+    }
+
+    bool Equals(TestData& other) {
+        return matrix == other.matrix && vector == other.vector && doubles == other.doubles && ints == other.ints &&
+               bools == other.bools && points == other.points;
+    }
+};
+
+// Check that bulk and element-by-element serialization give the same bytes,
+// and that the data is restored with both paths.
+bool test_archive(int n, bool use_versions) {
+    TestData data;
+    data.Fill(n);
+
+    std::vector<char> bytes_bulk;
+    std::vector<char> bytes_elements;
+    ChTimer<double> timer_bulk;
+    ChTimer<double> timer_elements;
+
+    {
+        ChStreamOutBinaryVector mstream(&bytes_bulk);
+        ChArchiveOutBinary marchive(mstream);
+        marchive.SetUseVersions(use_versions);
+        timer_bulk.start();
+        data.Write(marchive);
+        timer_bulk.stop();
+    }
+    {
+        ChStreamOutBinaryVector mstream(&bytes_elements);
+        ChArchiveOutBinaryElements marchive(mstream);
+        marchive.SetUseVersions(use_versions);
+        timer_elements.start();
+        data.Write(marchive);
+        timer_elements.stop();
+    }
+
+    bool passed = (bytes_bulk == bytes_elements);
+
+    TestData data_bulk;
+    {
+        ChStreamInBinaryVector mstream(&bytes_bulk);
+        ChArchiveInBinary marchive(mstream);
+        marchive.SetUseVersions(use_versions);
+        data_bulk.Read(marchive);
+    }
+    TestData data_elements;
+    {
+        ChStreamInBinaryVector mstream(&bytes_bulk);
+        ChArchiveInBinaryElements marchive(mstream);
+        marchive.SetUseVersions(use_versions);
+        data_elements.Read(marchive);
+    }
+
+    passed &= data.Equals(data_bulk) && data.Equals(data_elements);
+
+    std::cout << "Binary archive, " << (use_versions ? "with" : "without") << " versions: "
+              << (passed ? "PASSED" : "FAILED") << "  (" << bytes_bulk.size() << " bytes, bulk "
+              << timer_bulk.GetTimeSeconds() << " s, per element " << timer_elements.GetTimeSeconds() << " s)"
+              << std::endl;
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_archive(300000, true);
+    passed &= test_archive(300000, false);
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,117 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the closest-point queries on a ChBezierCurve.
+//
+// The closest points found with the bounding volume hierarchy of the curve are
+// compared with a brute-force search over all intervals, for random locations
+// around a long winding path. The batched queries and the tracker (after a
+// jump along the path) must find the same points.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChBezierCurve.h"
+#include "chrono/core/ChMathematics.h"
+#include "chrono/core/ChTimer.h"
+
+using namespace chrono;
+
+// Closest point by checking all intervals, from many initial guesses.
+double BruteForceDist(const ChBezierCurve& curve, const ChVector<>& loc) {
+    double best_d2 = 1e30;
+    for (size_t i = 0; i < curve.getNumPoints() - 1; i++) {
+        for (int k = 0; k <= 16; k++) {
+            double t = k / 16.0;
+            ChVector<> Q = curve.calcClosestPoint(loc, i, t);
+            best_d2 = std::min(best_d2, (Q - loc).Length2());
+        }
+    }
+    return std::sqrt(best_d2);
+}
+
+int main(int argc, char* argv[]) {
+    // A long winding path.
+    std::vector<ChVector<> > knots;
+    for (int i = 0; i < 500; i++) {
+        double s = i * 2.0;
+        knots.push_back(ChVector<>(s, 20 * std::sin(s / 30), 0.5 * std::cos(s / 10)));
+    }
+    ChBezierCurve curve(knots);
+
+    std::vector<ChVector<> > locs(200);
+    for (size_t k = 0; k < locs.size(); k++)
+        locs[k] = ChVector<>(1000 * ChRandom(), 60 * ChRandom() - 30, 4 * ChRandom() - 2);
+
+    // Single queries against brute force.
+    bool passed_single = true;
+    ChTimer<double> timer_bvh;
+    ChTimer<double> timer_brute;
+    for (size_t k = 0; k < locs.size(); k++) {
+        size_t i;
+        double t;
+        timer_bvh.start();
+        ChVector<> Q = curve.findClosestPoint(locs[k], i, t);
+        timer_bvh.stop();
+        timer_brute.start();
+        double dist = BruteForceDist(curve, locs[k]);
+        timer_brute.stop();
+        passed_single &= ((Q - curve.eval(i, t)).Length() < 1e-12);
+        passed_single &= ((Q - locs[k]).Length() < dist + 1e-2);
+    }
+    std::cout << "Single queries:  " << (passed_single ? "PASSED" : "FAILED") << "  (hierarchy "
+              << timer_bvh.GetTimeSeconds() << " s, brute force " << timer_brute.GetTimeSeconds() << " s)"
+              << std::endl;
+
+    // Batched queries.
+    std::vector<ChVector<> > points;
+    std::vector<size_t> intervals;
+    std::vector<double> params;
+    curve.findClosestPoints(locs, points, intervals, params);
+    bool passed_batch = (points.size() == locs.size());
+    for (size_t k = 0; k < locs.size(); k++) {
+        size_t i;
+        double t;
+        ChVector<> Q = curve.findClosestPoint(locs[k], i, t);
+        passed_batch &= (Q == points[k] && i == intervals[k] && t == params[k]);
+    }
+    std::cout << "Batched queries: " << (passed_batch ? "PASSED" : "FAILED") << std::endl;
+
+    // Tracker, following a continuous sequence of locations (unbounded walk).
+    ChBezierCurveTracker follower(&curve);
+    follower.reset(knots[10]);
+    bool passed_follow = true;
+    for (int k = 10; k <= 40; k++) {
+        ChVector<> loc = knots[k] + ChVector<>(0.1, 0.5, 0);
+        ChVector<> point;
+        follower.calcClosestPoint(loc, point);
+        passed_follow &= ((point - loc).Length() < BruteForceDist(curve, loc) + 1e-2);
+    }
+    std::cout << "Tracker follow:  " << (passed_follow ? "PASSED" : "FAILED") << std::endl;
+
+    // Tracker with a limited walk, after a jump along the path.
+    ChBezierCurveTracker tracker(&curve);
+    tracker.setMaxWalk(4);
+    tracker.reset(knots[10]);
+    ChVector<> point;
+    tracker.calcClosestPoint(knots[10] + ChVector<>(0.1, 0.5, 0), point);
+    ChVector<> loc = knots[400] + ChVector<>(0.3, 1, 0);
+    tracker.calcClosestPoint(loc, point);
+    bool passed_tracker = ((point - loc).Length() < BruteForceDist(curve, loc) + 1e-2);
+    std::cout << "Tracker:         " << (passed_tracker ? "PASSED" : "FAILED") << std::endl;
+
+    // Return 0 if all tests passed.
+    return !(passed_single && passed_batch && passed_follow && passed_tracker);
+}
@@ -0,0 +1,122 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for binary checkpoint and restart.
+// A few spheres slide on a fixed ground (DEM); a checkpoint written midway is
+// read into a second, identically built system, which must start with the
+// same contacts and contact forces and then follow the same trajectory.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+const int num_spheres = 5;
+
+void CreateSystem(ChSystemParallelDEM& msystem) {
+  msystem.Set_G_acc(ChVector<>(0, -9.81, 0));
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->solver.tangential_displ_mode = ChSystemDEM::MultiStep;
+  msystem.GetSettings()->collision.bins_per_axis = I3(5, 2, 2);
+
+  auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+  mat->SetFriction(0.4f);
+
+  for (int i = 0; i <= num_spheres; i++) {
+    auto body = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+    body->SetMaterialSurface(mat);
+    body->SetIdentifier(i);
+    body->SetMass(1);
+    body->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    body->SetCollide(true);
+    body->GetCollisionModel()->ClearModel();
+    if (i == 0) {
+      body->SetPos(ChVector<>(0, -0.5, 0));
+      body->SetBodyFixed(true);
+      AddBoxGeometry(body.get(), ChVector<>(20, 0.5, 2));
+    } else {
+      body->SetPos(ChVector<>(-10 + 3.0 * i, 0.5, 0));
+      body->SetPos_dt(ChVector<>(1.0 * i, 0, 0));
+      AddSphereGeometry(body.get(), 0.5);
+    }
+    body->GetCollisionModel()->BuildModel();
+    msystem.AddBody(body);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  double time_step = 1e-4;
+  const char* filename = "test_checkpoint.dat";
+
+  ChSystemParallelDEM msystem;
+  CreateSystem(msystem);
+
+  for (int i = 0; i < 500; i++)
+    msystem.DoStepDynamics(time_step);
+
+  StrictEqual(msystem.WriteBinaryCheckpoint(filename), true);
+
+  int num_contacts = msystem.GetNcontacts();
+  std::vector<real3> contact_force(num_spheres + 1);
+  std::vector<real3> contact_torque(num_spheres + 1);
+  for (int i = 1; i <= num_spheres; i++) {
+    contact_force[i] = msystem.GetBodyContactForce(i);
+    contact_torque[i] = msystem.GetBodyContactTorque(i);
+  }
+
+  for (int i = 0; i < 500; i++)
+    msystem.DoStepDynamics(time_step);
+
+  // Restart from the checkpoint in a new system.
+  ChSystemParallelDEM rsystem;
+  CreateSystem(rsystem);
+  StrictEqual(rsystem.ReadBinaryCheckpoint(filename), true);
+  WeakEqual(rsystem.GetChTime(), 500 * time_step, 1e-12);
+
+  // The contacts and contact forces of the last step are restored as well.
+  StrictEqual(rsystem.GetNcontacts(), num_contacts);
+  for (int i = 1; i <= num_spheres; i++) {
+    WeakEqual(rsystem.GetBodyContactForce(i), contact_force[i], 1e-6);
+    WeakEqual(rsystem.GetBodyContactTorque(i), contact_torque[i], 1e-6);
+  }
+
+  for (int i = 0; i < 500; i++)
+    rsystem.DoStepDynamics(time_step);
+
+  for (int i = 1; i <= num_spheres; i++) {
+    std::shared_ptr<ChBody> body = msystem.Get_bodylist()->at(i);
+    std::shared_ptr<ChBody> rbody = rsystem.Get_bodylist()->at(i);
+    WeakEqual(ToReal3(rbody->GetPos()), ToReal3(body->GetPos()), 1e-6);
+    WeakEqual(ToReal3(rbody->GetPos_dt()), ToReal3(body->GetPos_dt()), 1e-6);
+    WeakEqual(ToReal3(rbody->GetWvel_loc()), ToReal3(body->GetWvel_loc()), 1e-6);
+  }
+
+  // A system with a different number of bodies must reject the checkpoint.
+  ChSystemParallelDEM osystem;
+  StrictEqual(osystem.ReadBinaryCheckpoint(filename), false);
+
+  remove(filename);
+
+  return 0;
+}
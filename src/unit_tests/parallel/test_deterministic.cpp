@@ -0,0 +1,178 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the deterministic mode.
+// Spheres and boxes fall in a container, with the DVI (APGD) and with the DEM
+// (multi-step tangential displacement) systems. With settings.deterministic,
+// the final states must be identical, bit for bit, whatever the number of
+// threads.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+const int num_objects = 200;
+const int num_steps = 200;
+
+// Add the container and a lattice of spheres and boxes; the boxes give pairs
+// with several contact points.
+void AddBodies(ChSystemParallel* msystem, ChMaterialSurfaceBase::ContactMethod method) {
+  std::shared_ptr<ChMaterialSurfaceBase> mat;
+  if (method == ChMaterialSurfaceBase::DEM) {
+    auto mat_dem = std::make_shared<ChMaterialSurfaceDEM>();
+    mat_dem->SetYoungModulus(1e6f);
+    mat_dem->SetFriction(0.4f);
+    mat_dem->SetRestitution(0.2f);
+    mat = mat_dem;
+  } else {
+    auto mat_dvi = std::make_shared<ChMaterialSurface>();
+    mat_dvi->SetFriction(0.4f);
+    mat = mat_dvi;
+  }
+
+  std::vector<std::shared_ptr<ChBody> > bodies;
+
+  auto bin = std::make_shared<ChBody>(new ChCollisionModelParallel, method);
+  bin->SetMaterialSurface(mat);
+  bin->SetIdentifier(-1);
+  bin->SetBodyFixed(true);
+  bin->SetCollide(true);
+  bin->GetCollisionModel()->ClearModel();
+  AddBoxGeometry(bin.get(), ChVector<>(1, 1, 0.1), ChVector<>(0, 0, -0.1));
+  AddBoxGeometry(bin.get(), ChVector<>(0.1, 1, 1), ChVector<>(-1.1, 0, 1));
+  AddBoxGeometry(bin.get(), ChVector<>(0.1, 1, 1), ChVector<>(1.1, 0, 1));
+  AddBoxGeometry(bin.get(), ChVector<>(1, 0.1, 1), ChVector<>(0, -1.1, 1));
+  AddBoxGeometry(bin.get(), ChVector<>(1, 0.1, 1), ChVector<>(0, 1.1, 1));
+  bin->GetCollisionModel()->BuildModel();
+  bodies.push_back(bin);
+
+  for (int i = 0; i < num_objects; i++) {
+    ChVector<> pos(-0.8 + 0.2 * (i % 9), -0.8 + 0.2 * ((i / 9) % 9), 0.1 + 0.2 * (i / 81));
+    // Shift every other layer so that the objects do not stack exactly.
+    if ((i / 81) % 2 == 1)
+      pos += ChVector<>(0.05, 0.03, 0);
+
+    auto body = std::make_shared<ChBody>(new ChCollisionModelParallel, method);
+    body->SetMaterialSurface(mat);
+    body->SetIdentifier(i);
+    body->SetMass(1);
+    body->SetInertiaXX(ChVector<>(0.004, 0.004, 0.004));
+    body->SetPos(pos);
+    body->SetRot(Q_from_AngAxis(0.1 * i, ChVector<>(0, 0, 1)));
+    body->SetCollide(true);
+    body->GetCollisionModel()->ClearModel();
+    if (i % 2 == 0)
+      AddSphereGeometry(body.get(), 0.08);
+    else
+      AddBoxGeometry(body.get(), ChVector<>(0.07, 0.07, 0.07));
+    body->GetCollisionModel()->BuildModel();
+    bodies.push_back(body);
+  }
+
+  msystem->AddBodies(bodies);
+}
+
+void SetupSystem(ChSystemParallel* msystem, int threads) {
+  msystem->Set_G_acc(ChVector<>(0, 0, -9.81));
+  CHOMPfunctions::SetNumThreads(threads);
+  msystem->GetSettings()->min_threads = threads;
+  msystem->GetSettings()->max_threads = threads;
+  msystem->GetSettings()->perform_thread_tuning = false;
+  msystem->GetSettings()->deterministic = true;
+  msystem->GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+  msystem->GetSettings()->collision.bins_per_axis = I3(4, 4, 4);
+}
+
+// Simulate the model and return the final positions and rotations.
+void RunDVI(int threads, std::vector<real3>& pos, std::vector<real4>& rot) {
+  ChSystemParallelDVI msystem;
+  SetupSystem(&msystem, threads);
+  msystem.GetSettings()->solver.solver_mode = SLIDING;
+  msystem.GetSettings()->solver.max_iteration_normal = 0;
+  msystem.GetSettings()->solver.max_iteration_sliding = 50;
+  msystem.GetSettings()->solver.max_iteration_spinning = 0;
+  msystem.GetSettings()->solver.alpha = 0;
+  msystem.GetSettings()->solver.contact_recovery_speed = 1;
+  msystem.GetSettings()->collision.collision_envelope = 0.01;
+  msystem.ChangeSolverType(APGD);
+  AddBodies(&msystem, ChMaterialSurfaceBase::DVI);
+
+  for (int i = 0; i < num_steps; i++)
+    msystem.DoStepDynamics(1e-3);
+
+  pos = std::vector<real3>(msystem.data_manager->host_data.pos_rigid.begin(),
+                           msystem.data_manager->host_data.pos_rigid.end());
+  rot = std::vector<real4>(msystem.data_manager->host_data.rot_rigid.begin(),
+                           msystem.data_manager->host_data.rot_rigid.end());
+  printf("DVI, %d threads: %d contacts\n", threads, msystem.GetNcontacts());
+}
+
+void RunDEM(int threads, std::vector<real3>& pos, std::vector<real4>& rot) {
+  ChSystemParallelDEM msystem;
+  SetupSystem(&msystem, threads);
+  msystem.GetSettings()->solver.tangential_displ_mode = ChSystemDEM::MultiStep;
+  AddBodies(&msystem, ChMaterialSurfaceBase::DEM);
+
+  for (int i = 0; i < num_steps; i++)
+    msystem.DoStepDynamics(1e-4);
+
+  pos = std::vector<real3>(msystem.data_manager->host_data.pos_rigid.begin(),
+                           msystem.data_manager->host_data.pos_rigid.end());
+  rot = std::vector<real4>(msystem.data_manager->host_data.rot_rigid.begin(),
+                           msystem.data_manager->host_data.rot_rigid.end());
+  printf("DEM, %d threads: %d contacts\n", threads, msystem.GetNcontacts());
+}
+
+void Compare(const std::vector<real3>& pos1,
+             const std::vector<real4>& rot1,
+             const std::vector<real3>& pos2,
+             const std::vector<real4>& rot2) {
+  StrictEqual((int)pos1.size(), (int)pos2.size());
+  for (int i = 0; i < pos1.size(); i++) {
+    StrictEqual(pos1[i], pos2[i]);
+    StrictEqual(rot1[i], rot2[i]);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  // Compare one thread with several, even if there are fewer cores.
+  int max_threads = CHOMPfunctions::GetNumProcs();
+  if (max_threads < 4)
+    max_threads = 4;
+
+  std::vector<real3> pos1, pos2;
+  std::vector<real4> rot1, rot2;
+
+  RunDVI(1, pos1, rot1);
+  for (int threads = 2; threads <= max_threads; threads *= 2) {
+    RunDVI(threads, pos2, rot2);
+    Compare(pos1, rot1, pos2, rot2);
+  }
+
+  RunDEM(1, pos1, rot1);
+  for (int threads = 2; threads <= max_threads; threads *= 2) {
+    RunDEM(threads, pos2, rot2);
+    Compare(pos1, rot1, pos2, rot2);
+  }
+
+  return 0;
+}
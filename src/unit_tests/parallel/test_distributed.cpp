@@ -0,0 +1,174 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for the distributed DEM system, to be run with
+//   mpirun -np 4 test_distributed
+// Spheres with random velocities bounce on a fixed ground, across the four
+// subdomains of a 2 x 2 grid. The bodies must be neither lost nor duplicated
+// when they change subdomain, and their final states must match those of the
+// same model simulated by a single ChSystemParallelDEM.
+// =============================================================================
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+#include <cmath>
+
+#include <mpi.h>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallelDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+const int num_side = 10;
+const double radius = 0.05;
+
+// Create the same bodies for the distributed and the reference systems.
+std::vector<std::shared_ptr<ChBody> > CreateBodies() {
+  auto mat = std::make_shared<ChMaterialSurfaceDEM>();
+  mat->SetYoungModulus(1e6f);
+  mat->SetFriction(0.3f);
+  mat->SetRestitution(0.5f);
+
+  std::vector<std::shared_ptr<ChBody> > bodies;
+
+  auto ground = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+  ground->SetMaterialSurface(mat);
+  ground->SetIdentifier(-1);
+  ground->SetBodyFixed(true);
+  ground->SetCollide(true);
+  ground->GetCollisionModel()->ClearModel();
+  AddBoxGeometry(ground.get(), ChVector<>(2, 2, 0.1), ChVector<>(0, 0, -0.1));
+  ground->GetCollisionModel()->BuildModel();
+  bodies.push_back(ground);
+
+  srand(1);
+  for (int i = 0; i < num_side * num_side; i++) {
+    ChVector<> pos(-0.9 + 0.2 * (i % num_side), -0.9 + 0.2 * (i / num_side), 0.1 + 0.1 * (i % 3));
+    ChVector<> vel(2.0 * rand() / RAND_MAX - 1, 2.0 * rand() / RAND_MAX - 1, 0);
+
+    auto ball = std::make_shared<ChBody>(new ChCollisionModelParallel, ChMaterialSurfaceBase::DEM);
+    ball->SetMaterialSurface(mat);
+    ball->SetIdentifier(i);
+    ball->SetMass(1);
+    ball->SetInertiaXX(0.4 * radius * radius * ChVector<>(1, 1, 1));
+    ball->SetPos(pos);
+    ball->SetPos_dt(vel);
+    ball->SetCollide(true);
+    ball->GetCollisionModel()->ClearModel();
+    AddSphereGeometry(ball.get(), radius);
+    ball->GetCollisionModel()->BuildModel();
+    bodies.push_back(ball);
+  }
+
+  return bodies;
+}
+
+void SetupSystem(ChSystemParallelDEM& msystem) {
+  msystem.Set_G_acc(ChVector<>(0, 0, -9.81));
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->collision.narrowphase_algorithm = NARROWPHASE_HYBRID_MPR;
+  msystem.GetSettings()->collision.bins_per_axis = I3(5, 5, 2);
+}
+
+int main(int argc, char* argv[]) {
+  MPI_Init(&argc, &argv);
+
+  double time_step = 1e-4;
+  int num_steps = 4000;
+  int num_spheres = num_side * num_side;
+
+  CHOMPfunctions::SetNumThreads(1);
+
+  ChSystemParallelDistributed msystem(MPI_COMM_WORLD);
+  SetupSystem(msystem);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.SetDomain(ChVector<>(-1, -1, -1), ChVector<>(1, 1, 1), 2, 2, 1, 3 * radius);
+  msystem.AddBodies(CreateBodies());
+
+  StrictEqual(msystem.GetNumBodiesGlobal(), num_spheres);
+
+  int changes = 0;
+  for (int i = 0; i < num_steps; i++) {
+    int owned = msystem.GetNumOwnedBodies();
+    msystem.DoStepDynamics(time_step);
+    changes += std::abs(msystem.GetNumOwnedBodies() - owned);
+    StrictEqual(msystem.GetNumBodiesGlobal(), num_spheres);
+  }
+
+  // Gather the owned spheres on rank 0: identifier and position.
+  std::vector<double> local;
+  for (int i = 0; i < msystem.Get_bodylist()->size(); i++) {
+    std::shared_ptr<ChBody> body = msystem.Get_bodylist()->at(i);
+    if (!msystem.IsOwned(body))
+      continue;
+    local.push_back(body->GetIdentifier());
+    local.push_back(body->GetPos().x);
+    local.push_back(body->GetPos().y);
+    local.push_back(body->GetPos().z);
+  }
+
+  int rank = msystem.GetRank();
+  int num_ranks = msystem.GetNumRanks();
+  int local_size = local.size();
+  std::vector<int> sizes(num_ranks), offsets(num_ranks, 0);
+  MPI_Gather(&local_size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+  for (int r = 1; r < num_ranks; r++)
+    offsets[r] = offsets[r - 1] + sizes[r - 1];
+  std::vector<double> global(rank == 0 ? offsets[num_ranks - 1] + sizes[num_ranks - 1] : 0);
+  MPI_Gatherv(local.data(), local_size, MPI_DOUBLE, global.data(), sizes.data(), offsets.data(), MPI_DOUBLE, 0,
+              MPI_COMM_WORLD);
+
+  int total_changes = 0;
+  MPI_Reduce(&changes, &total_changes, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+  if (rank == 0) {
+    // Each sphere exactly once.
+    StrictEqual((int)global.size(), 4 * num_spheres);
+    std::vector<int> count(num_spheres, 0);
+    for (int i = 0; i < global.size(); i += 4)
+      count[(int)global[i]]++;
+    for (int i = 0; i < num_spheres; i++)
+      StrictEqual(count[i], 1);
+
+    // Some spheres must have changed subdomain.
+    printf("Ownership changes: %d\n", total_changes);
+    if (total_changes == 0) {
+      printf("No sphere changed subdomain\n");
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    // Same model on a single system.
+    ChSystemParallelDEM reference;
+    SetupSystem(reference);
+    reference.GetSettings()->max_threads = 1;
+    std::vector<std::shared_ptr<ChBody> > bodies = CreateBodies();
+    reference.AddBodies(bodies);
+    for (int i = 0; i < num_steps; i++)
+      reference.DoStepDynamics(time_step);
+
+    for (int i = 0; i < global.size(); i += 4) {
+      int id = (int)global[i];
+      const ChVector<>& pos = bodies[id + 1]->GetPos();
+      WeakEqual(R3(global[i + 1], global[i + 2], global[i + 3]), R3(pos.x, pos.y, pos.z), 1e-5);
+    }
+  }
+
+  MPI_Finalize();
+  return 0;
+}
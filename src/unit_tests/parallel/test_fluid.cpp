@@ -0,0 +1,125 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for constraint-based fluid.
+// A block of fluid nodes settles on a fixed ground, with the APGD and with the
+// Jacobi solver. The nodes must find their neighbours and the ground, stay
+// above the ground, and the density must not exceed the rest density by more
+// than the compliance allows. The Gauss-Seidel solver must refuse fluid.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+const double time_step = 1e-3;
+
+void InitializeSystem(ChSystemParallelDVI& msystem, SOLVERTYPE solver_type) {
+  msystem.Set_G_acc(ChVector<>(0, -9.81, 0));
+  msystem.SetStep(time_step);
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->solver.solver_mode = NORMAL;
+  msystem.GetSettings()->solver.max_iteration_normal = 100;
+  msystem.GetSettings()->solver.contact_recovery_speed = 1;
+  msystem.GetSettings()->collision.collision_envelope = 0.005;
+  msystem.GetSettings()->collision.bins_per_axis = I3(2, 2, 2);
+  msystem.GetSettings()->fluid.tau = 4 * time_step;
+  msystem.ChangeSolverType(solver_type);
+
+  auto ground = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  ground->SetIdentifier(-1);
+  ground->SetPos(ChVector<>(0, -0.5, 0));
+  ground->SetBodyFixed(true);
+  ground->SetCollide(true);
+  ground->GetCollisionModel()->ClearModel();
+  AddBoxGeometry(ground.get(), ChVector<>(1, 0.5, 1));
+  ground->GetCollisionModel()->BuildModel();
+  msystem.AddBody(ground);
+}
+
+void TestSettling(SOLVERTYPE solver_type) {
+  ChSystemParallelDVI msystem;
+  InitializeSystem(msystem, solver_type);
+
+  // A 6 x 6 x 6 block of nodes, at the spacing of the rest density.
+  const fluid_settings& fluid = msystem.GetSettings()->fluid;
+  const int count = 6;
+  double spacing = std::cbrt(fluid.mass / fluid.density);
+  std::vector<ChVector<> > positions;
+  for (int ix = 0; ix < count; ix++)
+    for (int iy = 0; iy < count; iy++)
+      for (int iz = 0; iz < count; iz++)
+        positions.push_back(ChVector<>(ix * spacing, fluid.collision_radius + iy * spacing, iz * spacing));
+
+  StrictEqual(msystem.AddFluid(positions), 0);
+  StrictEqual(msystem.AddFluid(std::vector<ChVector<> >(1, ChVector<>(0, 1, 0))), count * count * count);
+  const int num_nodes = count * count * count + 1;
+  StrictEqual(msystem.GetNumFluidBodies(), num_nodes);
+
+  // The single node falls freely until it reaches the block.
+  msystem.DoStepDynamics(time_step);
+  WeakEqual(msystem.GetFluidVel(num_nodes - 1).y, -9.81 * time_step, 1e-6);
+  WeakEqual(msystem.GetFluidPos(num_nodes - 1).y, 1 - 9.81 * time_step * time_step, 1e-6);
+
+  StrictEqual((int)(msystem.data_manager->num_fluid_contacts > 0), 1);
+  StrictEqual((int)(msystem.data_manager->num_rigid_fluid_contacts >= count * count), 1);
+
+  // Every node is among its own neighbours, and the lists are sorted.
+  const host_container& host = msystem.data_manager->host_data;
+  for (int i = 0; i < num_nodes; i++) {
+    const int* list = &host.neighbor_fluid_fluid[i * fluid.max_neighbors];
+    int count_i = host.c_counts_fluid_fluid[i];
+    StrictEqual((int)(count_i >= 1 && count_i <= fluid.max_neighbors), 1);
+    StrictEqual((int)std::binary_search(list, list + count_i, i), 1);
+    StrictEqual((int)std::is_sorted(list, list + count_i), 1);
+  }
+
+  for (int i = 0; i < 500; i++)
+    msystem.DoStepDynamics(time_step);
+
+  for (int i = 0; i < num_nodes; i++) {
+    StrictEqual((int)(msystem.GetFluidPos(i).y > -fluid.collision_radius), 1);
+    StrictEqual((int)(msystem.GetFluidDensity(i) < 1.1 * fluid.density), 1);
+    WeakEqual(msystem.GetFluidVel(i).y, 0, 0.1);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  TestSettling(APGD);
+  TestSettling(JACOBI);
+
+  ChSystemParallelDVI msystem;
+  InitializeSystem(msystem, GAUSS_SEIDEL);
+  msystem.AddFluid(std::vector<ChVector<> >(1, ChVector<>(0, 0.1, 0)));
+  bool thrown = false;
+  try {
+    msystem.DoStepDynamics(time_step);
+  } catch (const ChException&) {
+    thrown = true;
+  }
+  StrictEqual((int)thrown, 1);
+
+  return 0;
+}
@@ -0,0 +1,173 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for particle clouds.
+// A layer of spheres falls on a fixed ground, once as ChBody objects and once
+// as the particles of a ChParticleCloudParallel; the two systems must give the
+// same results. Bodies and particles added afterwards must keep the body slots
+// before the particle slots (once the new body slots are moved) and the
+// particles of each cloud contiguous.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+const double radius = 0.5;
+const double mass = 1;
+const double time_step = 1e-3;
+
+void InitializeSystem(ChSystemParallelDVI& msystem) {
+  msystem.Set_G_acc(ChVector<>(0, -9.81, 0));
+  msystem.SetStep(time_step);
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->solver.solver_mode = SLIDING;
+  msystem.GetSettings()->solver.max_iteration_normal = 0;
+  msystem.GetSettings()->solver.max_iteration_sliding = 50;
+  msystem.GetSettings()->collision.bins_per_axis = I3(10, 2, 10);
+
+  auto ground = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  ground->SetIdentifier(-1);
+  ground->SetPos(ChVector<>(0, -0.5, 0));
+  ground->SetBodyFixed(true);
+  ground->SetCollide(true);
+  ground->GetCollisionModel()->ClearModel();
+  AddBoxGeometry(ground.get(), ChVector<>(10, 0.5, 10));
+  ground->GetCollisionModel()->BuildModel();
+  msystem.AddBody(ground);
+}
+
+ChVector<> SpherePosition(int i) {
+  return ChVector<>(-4.5 + (i % 10), 1 + 0.01 * i, -4.5 + (i / 10));
+}
+
+std::shared_ptr<ChBody> CreateBox(const ChVector<>& pos) {
+  auto body = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  body->SetMass(mass);
+  body->SetPos(pos);
+  body->SetCollide(true);
+  body->GetCollisionModel()->ClearModel();
+  AddBoxGeometry(body.get(), ChVector<>(0.5, 0.5, 0.5));
+  body->GetCollisionModel()->BuildModel();
+  return body;
+}
+
+std::shared_ptr<ChParticleCloudParallel> CreateCloud() {
+  auto cloud = std::make_shared<ChParticleCloudParallel>();
+  cloud->GetPrototype()->SetMass(mass);
+  cloud->GetPrototype()->GetCollisionModel()->ClearModel();
+  AddSphereGeometry(cloud->GetPrototype().get(), radius);
+  cloud->GetPrototype()->GetCollisionModel()->BuildModel();
+  return cloud;
+}
+
+int main(int argc, char* argv[]) {
+  const int num_spheres = 100;
+
+  // Spheres as ChBody objects.
+  ChSystemParallelDVI system_bodies;
+  InitializeSystem(system_bodies);
+  for (int i = 0; i < num_spheres; i++) {
+    auto body = std::make_shared<ChBody>(new ChCollisionModelParallel);
+    body->SetMass(mass);
+    body->SetPos(SpherePosition(i));
+    body->SetCollide(true);
+    body->GetCollisionModel()->ClearModel();
+    AddSphereGeometry(body.get(), radius);
+    body->GetCollisionModel()->BuildModel();
+    system_bodies.AddBody(body);
+  }
+
+  // Spheres as particles.
+  ChSystemParallelDVI system_cloud;
+  InitializeSystem(system_cloud);
+  auto cloud = CreateCloud();
+  system_cloud.AddOtherPhysicsItem(cloud);
+  std::vector<ChVector<> > positions(num_spheres);
+  for (int i = 0; i < num_spheres; i++)
+    positions[i] = SpherePosition(i);
+  cloud->AddParticles(positions);
+
+  StrictEqual(cloud->GetNparticles(), num_spheres);
+  StrictEqual(cloud->GetFirstSlot(), 1);
+  StrictEqual(system_cloud.GetNumParticles(), num_spheres);
+  StrictEqual((int)system_cloud.Get_bodylist()->size(), 1);
+  StrictEqual((int)system_cloud.data_manager->num_rigid_shapes, num_spheres + 1);
+  StrictEqual((int)system_cloud.data_manager->host_data.typ_rigid.size(), 2);
+  WeakEqual(ToReal3(cloud->GetInertiaXX(0)), ToReal3(system_bodies.Get_bodylist()->at(1)->GetInertiaXX()), 1e-10);
+
+  for (int i = 0; i < 500; i++) {
+    system_bodies.DoStepDynamics(time_step);
+    system_cloud.DoStepDynamics(time_step);
+  }
+
+  StrictEqual(system_cloud.GetNumContacts(), system_bodies.GetNumContacts());
+  for (int i = 0; i < num_spheres; i++) {
+    std::shared_ptr<ChBody> body = system_bodies.Get_bodylist()->at(i + 1);
+    WeakEqual(ToReal3(cloud->GetPos(i)), ToReal3(body->GetPos()), 1e-6);
+    WeakEqual(ToReal4(cloud->GetRot(i)), ToReal4(body->GetRot()), 1e-6);
+    WeakEqual(ToReal3(cloud->GetPos_dt(i)), ToReal3(body->GetPos_dt()), 1e-6);
+    WeakEqual(ToReal3(cloud->GetWvel_loc(i)), ToReal3(body->GetWvel_loc()), 1e-6);
+  }
+
+  // A body added after the particles first takes the slot after them; the
+  // particles are still found at their slots.
+  auto box = CreateBox(ChVector<>(7, 1, -7));
+  system_cloud.AddBody(box);
+  StrictEqual((int)box->GetId(), 1 + num_spheres);
+  StrictEqual(cloud->GetFirstSlot(), 1);
+  WeakEqual(ToReal3(cloud->GetPos(0)), ToReal3(system_bodies.Get_bodylist()->at(1)->GetPos()), 1e-10);
+
+  // A second cloud, then more particles in the first one: the particles of
+  // each cloud stay contiguous.
+  auto cloud2 = CreateCloud();
+  system_cloud.AddOtherPhysicsItem(cloud2);
+  cloud2->AddParticle(ChCoordsys<>(ChVector<>(7, 3, -7)));
+  cloud->AddParticle(ChCoordsys<>(ChVector<>(-7, 3, -7)));
+
+  // Adding particles moved the body slot before the particle slots, together
+  // with the shapes of the body.
+  StrictEqual((int)box->GetId(), 1);
+  StrictEqual(cloud->GetFirstSlot(), 2);
+  WeakEqual(ToReal3(cloud->GetPos(0)), ToReal3(system_bodies.Get_bodylist()->at(1)->GetPos()), 1e-10);
+  StrictEqual(cloud->GetNparticles(), num_spheres + 1);
+  StrictEqual(cloud2->GetFirstSlot(), 2 + num_spheres + 1);
+  WeakEqual(ToReal3(cloud->GetPos(num_spheres)), R3(-7, 3, -7), 1e-10);
+  WeakEqual(ToReal3(cloud2->GetPos(0)), R3(7, 3, -7), 1e-10);
+
+  const host_container& host = system_cloud.data_manager->host_data;
+  for (int i = 0; i < system_cloud.data_manager->num_rigid_shapes; i++)
+    StrictEqual((int)(host.id_rigid[i] < system_cloud.data_manager->num_rigid_bodies), 1);
+
+  // Everything comes to rest on the ground, away from the layer, except the
+  // particle of the second cloud, which lands on the box.
+  for (int i = 0; i < 1500; i++)
+    system_cloud.DoStepDynamics(time_step);
+
+  WeakEqual(cloud->GetPos(num_spheres).y, radius, 2e-2);
+  WeakEqual(box->GetPos().y, 0.5, 2e-2);
+  WeakEqual(cloud2->GetPos(0).y, 1 + radius, 2e-2);
+
+  return 0;
+}
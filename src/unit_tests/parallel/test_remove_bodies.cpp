@@ -0,0 +1,107 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for bulk addition and removal of bodies.
+// A row of spheres rests on a fixed ground; every other sphere is removed and
+// the system-wide vectors must be compacted consistently with the body list.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+std::shared_ptr<ChBody> CreateBody(int id, const ChVector<>& pos) {
+  auto body = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  body->SetIdentifier(id);
+  body->SetMass(1);
+  body->SetInertiaXX(ChVector<>(1, 1, 1));
+  body->SetPos(pos);
+  body->SetCollide(true);
+  body->GetCollisionModel()->ClearModel();
+  if (id == 0)
+    AddBoxGeometry(body.get(), ChVector<>(20, 0.5, 1));
+  else
+    AddSphereGeometry(body.get(), 0.5);
+  body->GetCollisionModel()->BuildModel();
+  return body;
+}
+
+int main(int argc, char* argv[]) {
+  const int num_spheres = 20;
+  double time_step = 1e-3;
+
+  ChSystemParallelDVI msystem;
+  msystem.Set_G_acc(ChVector<>(0, -9.81, 0));
+  msystem.SetStep(time_step);
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->collision.bins_per_axis = I3(10, 2, 2);
+
+  std::vector<std::shared_ptr<ChBody> > bodies;
+  bodies.push_back(CreateBody(0, ChVector<>(0, -0.5, 0)));
+  bodies[0]->SetBodyFixed(true);
+  for (int i = 1; i <= num_spheres; i++)
+    bodies.push_back(CreateBody(i, ChVector<>(-num_spheres + 2.0 * i - 1, 0.5, 0)));
+  msystem.AddBodies(bodies);
+
+  StrictEqual(msystem.GetNumBodies(), num_spheres + 1);
+  StrictEqual((int)msystem.data_manager->num_rigid_shapes, num_spheres + 1);
+  // Identical spheres share one shape prototype (plus the one of the ground).
+  StrictEqual((int)msystem.data_manager->host_data.typ_rigid.size(), 2);
+  StrictEqual((int)msystem.data_manager->host_data.proto_rigid.size(), num_spheres + 1);
+
+  for (int i = 0; i < 100; i++)
+    msystem.DoStepDynamics(time_step);
+
+  // Remove the spheres with an odd identifier.
+  std::vector<std::shared_ptr<ChBody> > removed;
+  for (int i = 1; i <= num_spheres; i += 2)
+    removed.push_back(bodies[i]);
+  msystem.RemoveBodies(removed);
+
+  int num_kept = num_spheres + 1 - removed.size();
+  StrictEqual(msystem.GetNumBodies(), num_kept);
+  StrictEqual((int)msystem.Get_bodylist()->size(), num_kept);
+  StrictEqual((int)msystem.data_manager->num_rigid_shapes, num_kept);
+  StrictEqual((int)msystem.data_manager->host_data.pos_rigid.size(), num_kept);
+  StrictEqual((int)msystem.data_manager->host_data.fric_data.size(), num_kept);
+  StrictEqual((int)msystem.data_manager->host_data.typ_rigid.size(), 2);
+
+  // The remaining bodies keep their order and are renumbered; their shapes
+  // must refer to the new indices.
+  for (int i = 0; i < num_kept; i++) {
+    std::shared_ptr<ChBody> body = msystem.Get_bodylist()->at(i);
+    StrictEqual(body->GetIdentifier(), 2 * i);
+    StrictEqual((int)body->GetId(), i);
+    StrictEqual((int)msystem.data_manager->host_data.id_rigid[i], i);
+  }
+
+  // The remaining spheres keep resting on the ground.
+  for (int i = 0; i < 100; i++)
+    msystem.DoStepDynamics(time_step);
+
+  for (int i = 1; i < num_kept; i++)
+    WeakEqual(msystem.Get_bodylist()->at(i)->GetPos().y, 0.5, 1e-2);
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// ChronoParallel unit test for body sleeping.
+// A stack of boxes settles on a fixed ground until it falls asleep as a single
+// island; then a ball dropped on the top box must wake up the whole stack.
+// =============================================================================
+
+#include <stdio.h>
+#include <vector>
+#include <cmath>
+
+#include "unit_testing.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+using namespace chrono::utils;
+
+std::shared_ptr<ChBody> CreateBox(ChSystemParallel* system, const ChVector<>& hdims, const ChVector<>& pos) {
+  auto mat = std::make_shared<ChMaterialSurface>();
+  mat->SetFriction(0.5f);
+
+  auto body = std::make_shared<ChBody>(new ChCollisionModelParallel);
+  body->SetMaterialSurface(mat);
+  body->SetMass(1);
+  body->SetInertiaXX(ChVector<>(1, 1, 1));
+  body->SetPos(pos);
+  body->SetCollide(true);
+  body->GetCollisionModel()->ClearModel();
+  AddBoxGeometry(body.get(), hdims);
+  body->GetCollisionModel()->BuildModel();
+  system->AddBody(body);
+  return body;
+}
+
+int main(int argc, char* argv[]) {
+  const int num_boxes = 4;
+  double time_step = 1e-3;
+
+  ChSystemParallelDVI msystem;
+  msystem.SetUseSleeping(true);
+  msystem.Set_G_acc(ChVector<>(0, -9.81, 0));
+  msystem.SetStep(time_step);
+  CHOMPfunctions::SetNumThreads(1);
+  msystem.GetSettings()->max_threads = 1;
+  msystem.GetSettings()->perform_thread_tuning = false;
+  msystem.GetSettings()->solver.max_iteration_sliding = 100;
+  msystem.GetSettings()->collision.collision_envelope = 0.01;
+  msystem.GetSettings()->collision.bins_per_axis = I3(4, 4, 4);
+
+  auto ground = CreateBox(&msystem, ChVector<>(5, 0.5, 5), ChVector<>(0, -0.5, 0));
+  ground->SetBodyFixed(true);
+
+  std::vector<std::shared_ptr<ChBody> > boxes;
+  for (int i = 0; i < num_boxes; i++)
+    boxes.push_back(CreateBox(&msystem, ChVector<>(0.5, 0.5, 0.5), ChVector<>(0, 0.5 + i * 1.0, 0)));
+
+  // Let the stack settle, until all boxes fall asleep as one island.
+  while (msystem.GetChTime() < 3)
+    msystem.DoStepDynamics(time_step);
+
+  for (int i = 0; i < num_boxes; i++)
+    StrictEqual(boxes[i]->GetSleeping(), true);
+  // ground and stack
+  StrictEqual(msystem.GetNumIslands(), 2);
+
+  // Drop a ball (a small box) on the top box: the whole stack must wake up.
+  auto ball = CreateBox(&msystem, ChVector<>(0.2, 0.2, 0.2), ChVector<>(0.1, num_boxes + 0.3, 0));
+  ball->SetPos_dt(ChVector<>(0, -5, 0));
+
+  for (int i = 0; i < 200 && boxes[num_boxes - 1]->GetSleeping(); i++)
+    msystem.DoStepDynamics(time_step);
+
+  for (int i = 0; i < num_boxes; i++)
+    StrictEqual(boxes[i]->GetSleeping(), false);
+
+  return 0;
+}
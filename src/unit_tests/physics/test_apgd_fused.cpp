@@ -0,0 +1,103 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the APGD solver with a single Schur complement product per
+// iteration (ChLcpIterativeAPGDfused).
+//
+// A pile of boxes resting on a fixed ground is simulated with ChIterativeAPGD
+// and with ChLcpIterativeAPGDfused: the two solvers implement the same
+// algorithm, so the velocities after each step must be the same (up to
+// round-off), while the fused solver must compute less than two products per
+// iteration.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/lcp/ChLcpIterativeAPGDfused.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystem.h"
+
+using namespace chrono;
+
+// =============================================================================
+
+void CreateScene(ChSystem& system, ChSystem::eCh_lcpSolver solver) {
+    system.SetLcpSolverType(solver);
+    system.SetIterLCPmaxItersSpeed(100);
+    system.SetTolForce(0);
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    ground->GetMaterialSurface()->SetFriction(0.4f);
+    system.AddBody(ground);
+
+    for (int iy = 0; iy < 3; iy++) {
+        for (int ix = 0; ix < 3; ix++) {
+            auto box = std::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, true, false);
+            box->SetPos(ChVector<>(ix * 0.6 + 0.05 * iy, 0.24 + iy * 0.49, 0.1 * ix));
+            box->GetMaterialSurface()->SetFriction(0.4f);
+            system.AddBody(box);
+        }
+    }
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    double step = 0.01;
+    int num_steps = 20;
+
+    ChSystem system_apgd;
+    ChSystem system_fused;
+    CreateScene(system_apgd, ChSystem::LCP_ITERATIVE_APGD);
+    CreateScene(system_fused, ChSystem::LCP_ITERATIVE_APGD_FUSED);
+
+    ChLcpIterativeAPGDfused* solver = dynamic_cast<ChLcpIterativeAPGDfused*>(system_fused.GetLcpSolverSpeed());
+    if (!solver) {
+        std::cout << "Solver type:  FAILED" << std::endl;
+        return 1;
+    }
+
+    double max_diff = 0;
+    double max_vel = 0;
+    int num_products = 0;
+    int num_iterations = 0;
+    for (int i = 0; i < num_steps; i++) {
+        system_apgd.DoStepDynamics(step);
+        system_fused.DoStepDynamics(step);
+        num_products += solver->GetNumShurProducts();
+        num_iterations += (int)solver->GetTotalIterations();
+
+        for (int j = 0; j < system_apgd.Get_bodylist()->size(); j++) {
+            ChVector<> v1 = system_apgd.Get_bodylist()->at(j)->GetPos_dt();
+            ChVector<> v2 = system_fused.Get_bodylist()->at(j)->GetPos_dt();
+            max_diff = std::max(max_diff, (v1 - v2).Length());
+            max_vel = std::max(max_vel, v1.Length());
+        }
+    }
+
+    bool same_results = system_apgd.GetNcontacts() > 0 && max_diff < 1e-6 * std::max(max_vel, 1.0);
+    std::cout << "Same results: " << (same_results ? "PASSED" : "FAILED") << "  (contacts: "
+              << system_apgd.GetNcontacts() << ", max velocity difference: " << max_diff << ")" << std::endl;
+
+    double products_per_iter = (double)num_products / std::max(num_iterations, 1);
+    bool fewer_products = products_per_iter < 2;
+    std::cout << "Products:     " << (fewer_products ? "PASSED" : "FAILED") << "  (" << products_per_iter
+              << " products per iteration)" << std::endl;
+
+    // Return 0 if all tests passed.
+    return !(same_results && fewer_products);
+}
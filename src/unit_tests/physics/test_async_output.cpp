@@ -0,0 +1,178 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the asynchronous output of body states (utils::ChAsyncBodyWriter).
+//
+// The files written asynchronously (CSV, and binary converted to CSV) must be
+// identical to those of utils::WriteBodies. The backpressure policies must
+// account for all snapshots. The time spent in the simulation thread with
+// synchronous and asynchronous output is reported.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChUtilsAsyncOutput.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+std::string ReadFile(const std::string& filename) {
+    std::ifstream ifile(filename.c_str());
+    std::stringstream ss;
+    ss << ifile.rdbuf();
+    return ss.str();
+}
+
+// Move the bodies, so that each frame has different states.
+void SetStates(ChSystem& system, int frame) {
+    for (size_t i = 0; i < system.Get_bodylist()->size(); i++) {
+        auto body = system.Get_bodylist()->at(i);
+        double a = 0.001 * i + 0.1 * frame;
+        body->SetPos(ChVector<>(std::sin(a), std::cos(a), 1e-3 * i));
+        body->SetRot(Q_from_AngZ(a));
+        body->SetPos_dt(ChVector<>(a, -a, 0.5 * a));
+        body->SetWvel_loc(ChVector<>(0, 0, 1 / (1 + a)));
+        body->SetBodyFixed(i % 7 == 0);
+    }
+}
+
+bool TestOutput(ChSystem& system, int num_frames) {
+    bool passed = true;
+
+    ChAsyncBodyWriter csv_writer(4, ChAsyncBodyWriter::BLOCK, ChAsyncBodyWriter::CSV, " ");
+    ChAsyncBodyWriter bin_writer(4, ChAsyncBodyWriter::BLOCK, ChAsyncBodyWriter::BINARY);
+
+    for (int frame = 0; frame < num_frames; frame++) {
+        SetStates(system, frame);
+        bool active_only = (frame % 2 == 1);
+        bool dump_vel = (frame % 3 != 0);
+
+        std::stringstream suffix;
+        suffix << "_" << frame;
+        WriteBodies(&system, "bodies_sync" + suffix.str() + ".csv", active_only, dump_vel, " ");
+        csv_writer.WriteBodies(&system, "bodies_async" + suffix.str() + ".csv", active_only, dump_vel);
+        bin_writer.WriteBodies(&system, "bodies_async" + suffix.str() + ".bin", active_only, dump_vel);
+    }
+
+    csv_writer.Flush();
+    bin_writer.Flush();
+
+    for (int frame = 0; frame < num_frames; frame++) {
+        std::stringstream suffix;
+        suffix << "_" << frame;
+        ChAsyncBodyWriter::ConvertBinaryToCSV("bodies_async" + suffix.str() + ".bin",
+                                              "bodies_converted" + suffix.str() + ".csv", " ");
+
+        std::string sync = ReadFile("bodies_sync" + suffix.str() + ".csv");
+        if (sync.empty() || sync != ReadFile("bodies_async" + suffix.str() + ".csv") ||
+            sync != ReadFile("bodies_converted" + suffix.str() + ".csv")) {
+            std::cout << "Different output for frame " << frame << std::endl;
+            passed = false;
+        }
+
+        std::remove(("bodies_sync" + suffix.str() + ".csv").c_str());
+        std::remove(("bodies_async" + suffix.str() + ".csv").c_str());
+        std::remove(("bodies_async" + suffix.str() + ".bin").c_str());
+        std::remove(("bodies_converted" + suffix.str() + ".csv").c_str());
+    }
+
+    if (csv_writer.GetNumWritten() != num_frames || bin_writer.GetNumWritten() != num_frames) {
+        std::cout << "Missing files" << std::endl;
+        passed = false;
+    }
+
+    return passed;
+}
+
+bool TestBackpressure(ChSystem& system, ChAsyncBodyWriter::Backpressure policy, int num_frames) {
+    int accepted = 0;
+    {
+        ChAsyncBodyWriter writer(2, policy);
+        for (int frame = 0; frame < num_frames; frame++) {
+            if (writer.WriteBodies(&system, "bodies_policy.csv", false, true))
+                accepted++;
+        }
+        writer.Flush();
+
+        bool passed = true;
+        if (writer.GetNumWritten() + writer.GetNumDropped() != num_frames)
+            passed = false;
+        if (policy == ChAsyncBodyWriter::BLOCK && writer.GetNumDropped() != 0)
+            passed = false;
+        if (policy == ChAsyncBodyWriter::DROP_NEWEST && accepted != writer.GetNumWritten())
+            passed = false;
+        if (policy == ChAsyncBodyWriter::DROP_OLDEST && accepted != num_frames)
+            passed = false;
+
+        std::cout << "Policy " << policy << ": written " << writer.GetNumWritten() << "  dropped "
+                  << writer.GetNumDropped() << "  wait " << 1e3 * writer.GetWaitTime() << " ms" << std::endl;
+
+        if (!passed) {
+            std::cout << "Inconsistent counts for policy " << policy << std::endl;
+            return false;
+        }
+    }
+
+    std::remove("bodies_policy.csv");
+    return true;
+}
+
+void ReportTimes(ChSystem& system, int num_frames) {
+    ChTimer<double> timer_sync;
+    ChTimer<double> timer_async;
+
+    timer_sync.start();
+    for (int frame = 0; frame < num_frames; frame++)
+        WriteBodies(&system, "bodies_timing.csv", false, true);
+    timer_sync.stop();
+
+    {
+        ChAsyncBodyWriter writer(4, ChAsyncBodyWriter::BLOCK, ChAsyncBodyWriter::BINARY);
+        timer_async.start();
+        for (int frame = 0; frame < num_frames; frame++)
+            writer.WriteBodies(&system, "bodies_timing.bin", false, true);
+        timer_async.stop();
+        writer.Flush();
+    }
+
+    std::remove("bodies_timing.csv");
+    std::remove("bodies_timing.bin");
+
+    std::cout << "Simulation thread time per frame (" << system.Get_bodylist()->size() << " bodies):" << std::endl;
+    std::cout << "  WriteBodies:               " << 1e3 * timer_sync() / num_frames << " ms" << std::endl;
+    std::cout << "  ChAsyncBodyWriter, binary: " << 1e3 * timer_async() / num_frames << " ms" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystem system;
+    for (int i = 0; i < 2000; i++)
+        system.AddBody(std::make_shared<ChBody>());
+
+    bool passed = true;
+    passed &= TestOutput(system, 6);
+    passed &= TestBackpressure(system, ChAsyncBodyWriter::BLOCK, 20);
+    passed &= TestBackpressure(system, ChAsyncBodyWriter::DROP_NEWEST, 20);
+    passed &= TestBackpressure(system, ChAsyncBodyWriter::DROP_OLDEST, 20);
+    ReportTimes(system, 10);
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return !passed;
+}
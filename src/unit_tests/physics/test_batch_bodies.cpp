@@ -0,0 +1,138 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the batch creation of bodies (ChSystem::AddBodies and
+// utils::Generator).
+//
+// A box of spheres is created with utils::Generator, which shares the collision
+// shapes of a prototype body and adds all bodies with a single call, and with
+// the equivalent one-body-at-a-time code. The two systems must give the same
+// results. Then bodies queued with AddBatch() must be added by FlushBatch().
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/collision/ChCModelBullet.h"
+#include "chrono/collision/bullet/btBulletCollisionCommon.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChUtilsCreators.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+const double radius = 0.1;
+const double density = 1000;
+const ChVector<> center(0, 1, 0);
+const ChVector<> hdims(0.5, 0.5, 0.5);
+const double dist = 2.01 * radius;
+
+// =============================================================================
+
+void CreateGround(ChSystem& system) {
+    auto ground = std::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+}
+
+// Create the spheres one at a time, as utils::Generator used to do.
+void CreateSpheresOneByOne(ChSystem& system) {
+    utils::GridSampler<> sampler(dist);
+    utils::Generator::PointVector points = sampler.SampleBox(center, hdims);
+
+    for (int i = 0; i < points.size(); i++) {
+        ChBody* body = system.NewBody();
+        body->SetPos(points[i]);
+        body->SetCollide(true);
+
+        double mass = density * utils::CalcSphereVolume(radius);
+        body->SetMass(mass);
+        body->SetInertiaXX(mass * utils::CalcSphereGyration(radius).Get_Diag());
+
+        body->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(body, radius);
+        body->GetCollisionModel()->BuildModel();
+
+        system.AddBody(std::shared_ptr<ChBody>(body));
+    }
+}
+
+// Create the spheres with utils::Generator.
+void CreateSpheresGenerator(ChSystem& system) {
+    utils::Generator gen(&system);
+    auto ingredient = gen.AddMixtureIngredient(utils::SPHERE, 1.0);
+    ingredient->setDefaultSize(ChVector<>(radius, radius, radius));
+    ingredient->setDefaultDensity(density);
+    gen.createObjectsBox(utils::REGULAR_GRID, dist, center, hdims);
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    ChSystem system_single;
+    ChSystem system_batch;
+    CreateGround(system_single);
+    CreateGround(system_batch);
+
+    CreateSpheresOneByOne(system_single);
+    CreateSpheresGenerator(system_batch);
+
+    // The generated spheres must share the same collision shape.
+    std::vector<std::shared_ptr<ChBody> >& bodies = *system_batch.Get_bodylist();
+    btCollisionShape* shape = ((ChModelBullet*)bodies[1]->GetCollisionModel())->GetBulletModel()->getCollisionShape();
+    bool shared = bodies.size() > 2 && system_batch.Get_bodylist()->size() == system_single.Get_bodylist()->size();
+    for (int j = 1; j < bodies.size(); j++) {
+        ChModelBullet* model = (ChModelBullet*)bodies[j]->GetCollisionModel();
+        shared &= (model->GetBulletModel()->getCollisionShape() == shape);
+        shared &= (model->GetBulletModel()->getBroadphaseHandle() != 0);
+    }
+    std::cout << "Shared shapes: " << (shared ? "PASSED" : "FAILED") << std::endl;
+
+    // The two systems must behave the same.
+    double max_diff = 0;
+    for (int i = 0; i < 20; i++) {
+        system_single.DoStepDynamics(0.01);
+        system_batch.DoStepDynamics(0.01);
+    }
+    for (int j = 0; j < bodies.size(); j++) {
+        ChVector<> p1 = system_single.Get_bodylist()->at(j)->GetPos();
+        ChVector<> p2 = bodies[j]->GetPos();
+        max_diff = std::max(max_diff, (p1 - p2).Length());
+    }
+    bool same_results = system_batch.GetNcontacts() > 0 && max_diff < 1e-10;
+    std::cout << "Same results: " << (same_results ? "PASSED" : "FAILED") << "  (contacts: "
+              << system_batch.GetNcontacts() << ", max position difference: " << max_diff << ")" << std::endl;
+
+    // Bodies queued with AddBatch() are added at the next step (after the
+    // collision detection of that step, so their contacts appear in the following one).
+    ChSystem system_queue;
+    CreateGround(system_queue);
+    for (int i = 0; i < 10; i++) {
+        auto sphere = std::make_shared<ChBodyEasySphere>(radius, density, true, false);
+        sphere->SetPos(ChVector<>(0, 0.1 + i * dist, 0));
+        system_queue.AddBatch(sphere);
+    }
+    system_queue.DoStepDynamics(0.01);
+    system_queue.DoStepDynamics(0.01);
+    bool queued = system_queue.Get_bodylist()->size() == 11;
+    for (int j = 0; j < system_queue.Get_bodylist()->size(); j++)
+        queued &= system_queue.Get_bodylist()->at(j)->GetSystem() == &system_queue;
+    queued &= system_queue.GetNcontacts() > 0;
+    std::cout << "Queued bodies: " << (queued ? "PASSED" : "FAILED") << std::endl;
+
+    // Return 0 if all tests passed.
+    return !(shared && same_results && queued);
+}
@@ -0,0 +1,142 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the multithreaded narrow phase of ChCollisionSystemBullet.
+//
+// A pile of convex hulls, boxes and spheres falls on a fixed ground. The same
+// scene is simulated with one thread and with several threads in the collision
+// system: the first collision detection must find the same contacts, in the
+// same order, and two multithreaded runs must give exactly the same trajectories.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChBodyEasy.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// =============================================================================
+
+void CreateScene(ChSystem& system, int num_threads) {
+    ((ChCollisionSystemBullet*)system.GetCollisionSystem())->SetNumThreads(num_threads);
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 1, 20, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    std::vector<ChVector<> > points;
+    for (int i = 0; i < 12; ++i) {
+        double a = i * CH_C_2PI / 12;
+        points.push_back(ChVector<>(0.3 * std::cos(a), 0.2 * (i % 3) - 0.2, 0.3 * std::sin(a)));
+    }
+
+    // Bodies are placed in slightly overlapping layers, so that contacts are
+    // found at the first collision detection.
+    for (int iy = 0; iy < 4; ++iy) {
+        for (int ix = 0; ix < 5; ++ix) {
+            for (int iz = 0; iz < 5; ++iz) {
+                ChVector<> pos(ix * 0.55 - 1.1, 0.25 + iy * 0.45, iz * 0.55 - 1.1);
+                std::shared_ptr<ChBody> body;
+                switch ((ix + iy + iz) % 3) {
+                    case 0:
+                        body = std::make_shared<ChBodyEasyConvexHull>(points, 1000, true, false);
+                        break;
+                    case 1:
+                        body = std::make_shared<ChBodyEasyBox>(0.5, 0.5, 0.5, 1000, true, false);
+                        break;
+                    default:
+                        body = std::make_shared<ChBodyEasySphere>(0.26, 1000, true, false);
+                        break;
+                }
+                body->SetPos(body->GetPos() + pos);
+                system.AddBody(body);
+            }
+        }
+    }
+}
+
+// Collect the contact points, in the order of the contact container.
+class ContactCollector : public ChReportContactCallback {
+  public:
+    virtual bool ReportContactCallback(const ChVector<>& pA,
+                                       const ChVector<>& pB,
+                                       const ChMatrix33<>& plane_coord,
+                                       const double& distance,
+                                       const float& mfriction,
+                                       const ChVector<>& react_forces,
+                                       const ChVector<>& react_torques,
+                                       ChCollisionModel* modA,
+                                       ChCollisionModel* modB) {
+        points.push_back(pA);
+        return true;
+    }
+
+    std::vector<ChVector<> > points;
+};
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    double step = 0.005;
+    int num_steps = 50;
+
+    ChSystem system_st;
+    ChSystem system_mt1;
+    ChSystem system_mt2;
+    CreateScene(system_st, 1);
+    CreateScene(system_mt1, 4);
+    CreateScene(system_mt2, 4);
+
+    // First collision detection, on identical states.
+    system_st.DoStepDynamics(step);
+    system_mt1.DoStepDynamics(step);
+    system_mt2.DoStepDynamics(step);
+
+    bool same_contacts = (system_st.GetNcontacts() > 0) && (system_st.GetNcontacts() == system_mt1.GetNcontacts());
+    std::cout << "Contacts:    " << (same_contacts ? "PASSED" : "FAILED") << "  (single thread: "
+              << system_st.GetNcontacts() << ", multithread: " << system_mt1.GetNcontacts() << ")" << std::endl;
+
+    // At the first step all manifolds are new, so the single-threaded dispatcher also
+    // creates them in the order of the broadphase pairs.
+    ContactCollector collector_st;
+    ContactCollector collector_mt;
+    system_st.GetContactContainer()->ReportAllContacts(&collector_st);
+    system_mt1.GetContactContainer()->ReportAllContacts(&collector_mt);
+    bool same_order = (collector_st.points.size() == collector_mt.points.size());
+    for (size_t i = 0; same_order && i < collector_st.points.size(); ++i)
+        same_order = (collector_st.points[i] == collector_mt.points[i]);
+    std::cout << "Order:       " << (same_order ? "PASSED" : "FAILED") << std::endl;
+
+    for (int i = 1; i < num_steps; ++i) {
+        system_mt1.DoStepDynamics(step);
+        system_mt2.DoStepDynamics(step);
+    }
+
+    bool deterministic = (system_mt1.GetNcontacts() == system_mt2.GetNcontacts());
+    for (int i = 0; i < system_mt1.Get_bodylist()->size(); ++i) {
+        deterministic &= (system_mt1.Get_bodylist()->at(i)->GetPos() == system_mt2.Get_bodylist()->at(i)->GetPos());
+        deterministic &= (system_mt1.Get_bodylist()->at(i)->GetRot() == system_mt2.Get_bodylist()->at(i)->GetRot());
+    }
+    std::cout << "Determinism: " << (deterministic ? "PASSED" : "FAILED") << "  (contacts: "
+              << system_mt1.GetNcontacts() << ")" << std::endl;
+
+    // Return 0 if all tests passed.
+    return !(same_contacts && same_order && deterministic);
+}
@@ -0,0 +1,139 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the island-based sleeping policy of ChSystem.
+//
+// First the concurrent union-find in ChSimulationIslands is checked on a small
+// graph. Then two stacks of boxes are left to settle on a fixed ground, until
+// each stack falls asleep as a single island. A ball is dropped on the top box
+// of one stack: that whole island must be waken, including the bottom box that
+// is not in direct contact with the ball, while the other stack keeps sleeping.
+// Finally a box of the sleeping stack is moved with SetPos(), which must wake
+// it together with its island.
+//
+// =============================================================================
+
+#include <iostream>
+
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSimulationIslands.h"
+
+using namespace chrono;
+
+// =============================================================================
+
+bool test_union_find() {
+    ChSimulationIslands islands;
+    islands.Reset(10);
+
+    // islands: {0,1,2,3} {4} {5,7,9} {6,8}
+    int pairs[][2] = {{0, 1}, {3, 2}, {2, 1}, {7, 5}, {9, 7}, {8, 6}, {1, 3}};
+    int npairs = sizeof(pairs) / sizeof(pairs[0]);
+
+#pragma omp parallel for
+    for (int i = 0; i < npairs; ++i)
+        islands.Union(pairs[i][0], pairs[i][1]);
+
+    bool passed = (islands.Finalize() == 4);
+    passed &= islands.GetIsland(0) == islands.GetIsland(3);
+    passed &= islands.GetIsland(0) != islands.GetIsland(4);
+    passed &= islands.GetIsland(5) == islands.GetIsland(9);
+    passed &= islands.GetIsland(6) == islands.GetIsland(8);
+    passed &= islands.GetIsland(6) != islands.GetIsland(5);
+
+    std::cout << "Union-find: " << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed;
+}
+
+// =============================================================================
+
+bool test_stack() {
+    const int num_boxes = 4;
+    double step = 0.01;
+
+    ChSystem system;
+    system.SetUseSleeping(true);
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(10, 1, 10, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    // Two separate stacks; all boxes have the same (negative) identifier, which
+    // must not matter for the sleeping policy.
+    std::vector<std::shared_ptr<ChBody> > boxes[2];
+    for (int s = 0; s < 2; ++s) {
+        for (int i = 0; i < num_boxes; ++i) {
+            auto box = std::make_shared<ChBodyEasyBox>(1, 1, 1, 1000, true, false);
+            box->SetIdentifier(-1);
+            box->SetPos(ChVector<>(-3.0 + 6.0 * s, 0.5 + i * 1.0, 0));
+            system.AddBody(box);
+            boxes[s].push_back(box);
+        }
+    }
+
+    // Let the stacks settle, until each stack falls asleep as one island.
+    while (system.GetChTime() < 3)
+        system.DoStepDynamics(step);
+
+    // ground and two stacks: three islands
+    bool asleep = (system.GetNumIslands() == 3);
+    for (int s = 0; s < 2; ++s)
+        for (int i = 0; i < num_boxes; ++i)
+            asleep &= boxes[s][i]->GetSleeping();
+    std::cout << "Stacks asleep: " << (asleep ? "PASSED" : "FAILED") << "  (islands: " << system.GetNumIslands()
+              << ")" << std::endl;
+
+    // Drop a ball on the top box of the first stack: the whole stack must wake
+    // up at once, while the other stack keeps sleeping.
+    auto ball = std::make_shared<ChBodyEasySphere>(0.3, 1000, true, false);
+    ball->SetPos(ChVector<>(-2.9, num_boxes + 0.4, 0));
+    ball->SetPos_dt(ChVector<>(0, -5, 0));
+    system.AddBody(ball);
+
+    for (int i = 0; i < 20 && boxes[0][num_boxes - 1]->GetSleeping(); ++i)
+        system.DoStepDynamics(step);
+
+    bool awake = true;
+    for (int i = 0; i < num_boxes; ++i)
+        awake &= !boxes[0][i]->GetSleeping() && boxes[1][i]->GetSleeping();
+    std::cout << "Stack waken:   " << (awake ? "PASSED" : "FAILED") << std::endl;
+
+    // Move the bottom box of the sleeping stack from outside: it must be waken,
+    // with its island, and its collision model must follow it.
+    ChVector<> old_pos = boxes[1][0]->GetPos();
+    boxes[1][0]->SetPos(old_pos + ChVector<>(0, 0, 3));
+    system.DoStepDynamics(step);
+
+    bool moved = true;
+    for (int i = 0; i < num_boxes; ++i)
+        moved &= !boxes[1][i]->GetSleeping();
+    ChVector<> bbmin, bbmax;
+    boxes[1][0]->GetCollisionModel()->GetAABB(bbmin, bbmax);
+    moved &= (bbmin.z > old_pos.z + 2 && bbmax.z < old_pos.z + 4);
+    std::cout << "Moved waken:   " << (moved ? "PASSED" : "FAILED") << std::endl;
+
+    return asleep && awake && moved;
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_union_find();
+    passed &= test_stack();
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
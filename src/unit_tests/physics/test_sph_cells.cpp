@@ -0,0 +1,121 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2016 projectchrono.org
+// All right reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tests for the cell-list neighbour search of SPH nodes.
+//
+// First the neighbours found by ChCellListSPH for a random cloud of points are
+// compared with a brute-force search. Then a block of SPH fluid is simulated
+// with the cell list: the internal SPH forces must be balanced (zero net force)
+// and the nodes must have a positive density.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono/physics/ChCellListSPH.h"
+#include "chrono/physics/ChMatterSPH.h"
+
+using namespace chrono;
+
+// =============================================================================
+
+// Count the neighbours of a point within the search radius.
+struct NeighborCounter {
+    const ChCellListSPH* cells;
+    int k;
+    double radius;
+    int count;
+    void operator()(int m) {
+        if ((cells->GetSortedPos(m) - cells->GetSortedPos(k)).Length() < radius)
+            count++;
+    }
+};
+
+bool test_neighbors() {
+    const int npoints = 2000;
+    const double radius = 0.1;
+
+    std::vector<ChVector<> > points(npoints);
+    for (int i = 0; i < npoints; ++i)
+        points[i] = ChVector<>(ChRandom(), 0.5 * ChRandom(), 0.5 * ChRandom() - 1);
+
+    ChCellListSPH cells;
+    cells.Build(points, radius);
+
+    bool passed = (cells.GetNumPoints() == npoints);
+    for (int k = 0; k < npoints; ++k) {
+        NeighborCounter counter = {&cells, k, radius, 0};
+        cells.ForEachNeighbor(k, counter);
+
+        const ChVector<>& pk = points[cells.GetSortedIndex(k)];
+        passed &= (pk == cells.GetSortedPos(k));
+
+        int count = 0;
+        for (int i = 0; i < npoints; ++i) {
+            if (i != cells.GetSortedIndex(k) && (points[i] - pk).Length() < radius)
+                count++;
+        }
+        passed &= (count == counter.count);
+    }
+
+    std::cout << "Neighbor search: " << (passed ? "PASSED" : "FAILED") << "  (cells: " << cells.GetNumCells()
+              << ")" << std::endl;
+    return passed;
+}
+
+// =============================================================================
+
+bool test_forces() {
+    ChSystem system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto fluid = std::make_shared<ChMatterSPH>();
+    fluid->SetUseCellList(true);
+    fluid->FillBox(ChVector<>(0.4, 0.4, 0.4), 0.04, 1000, CSYSNORM, true, 2.2, 0.1);
+    fluid->GetMaterial().Set_viscosity(0.5);
+    fluid->GetMaterial().Set_pressure_stiffness(300);
+    system.Add(fluid);
+
+    for (int i = 0; i < 5; ++i)
+        system.DoStepDynamics(0.001);
+
+    // Internal forces are exchanged in pairs: their sum must vanish.
+    ChVector<> sum_forces = VNULL;
+    double max_force = 0;
+    bool positive_density = true;
+    for (unsigned int i = 0; i < fluid->GetNnodes(); ++i) {
+        auto node = std::dynamic_pointer_cast<ChNodeSPH>(fluid->GetNode(i));
+        sum_forces += node->UserForce;
+        max_force = std::max(max_force, node->UserForce.Length());
+        positive_density &= (node->density > 0);
+    }
+
+    bool passed = positive_density && max_force > 0 && sum_forces.Length() < 1e-8 * max_force * fluid->GetNnodes();
+    std::cout << "SPH forces:      " << (passed ? "PASSED" : "FAILED") << "  (nodes: " << fluid->GetNnodes()
+              << ", net force: " << sum_forces.Length() << ")" << std::endl;
+    return passed;
+}
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_neighbors();
+    passed &= test_forces();
+
+    // Return 0 if all tests passed.
+    return !passed;
+}